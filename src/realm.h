@@ -77,6 +77,7 @@ typedef struct realm_dictionary realm_dictionary_t;
 /* Query types */
 typedef struct realm_query realm_query_t;
 typedef struct realm_results realm_results_t;
+typedef struct realm_group_by_result realm_group_by_result_t;
 
 /* Config types */
 typedef struct realm_config realm_config_t;
@@ -910,6 +911,21 @@ RLM_API bool realm_config_get_cached(realm_config_t*) RLM_API_NOEXCEPT;
  */
 RLM_API void realm_config_set_automatic_backlink_handling(realm_config_t*, bool) RLM_API_NOEXCEPT;
 
+/**
+ * Collect latency histograms and counters of the transactions and commits of
+ * the realm file. See `realm_get_db_metrics()`.
+ *
+ * This function cannot fail.
+ */
+RLM_API void realm_config_set_db_metrics_enabled(realm_config_t*, bool) RLM_API_NOEXCEPT;
+
+/**
+ * Check if metrics are collected for the realm file.
+ *
+ * This function cannot fail.
+ */
+RLM_API bool realm_config_get_db_metrics_enabled(const realm_config_t*) RLM_API_NOEXCEPT;
+
 /**
  * Create a custom scheduler object from callback functions.
  *
@@ -1468,6 +1484,47 @@ RLM_API bool realm_get_num_objects(const realm_t*, realm_class_key_t, size_t* ou
  */
 RLM_API bool realm_get_num_versions(const realm_t*, uint64_t* out_versions_count);
 
+#define RLM_LATENCY_HISTOGRAM_BUCKETS 24
+
+/**
+ * The distribution of the durations of an operation. Bucket 0 counts the
+ * durations below 1 microsecond, bucket i those of at least 2^(i-1) and below
+ * 2^i microseconds, and the last bucket all longer durations.
+ */
+typedef struct realm_latency_histogram {
+    uint64_t count;
+    uint64_t total_ns;
+    uint64_t max_ns;
+    uint64_t buckets[RLM_LATENCY_HISTOGRAM_BUCKETS];
+} realm_latency_histogram_t;
+
+typedef struct realm_db_metrics {
+    // Time spent waiting for the write lock when beginning a write transaction
+    realm_latency_histogram_t write_lock_wait;
+    // Time spent acquiring the version read by a transaction
+    realm_latency_histogram_t read_lock;
+    // Time spent by each commit writing the modified data
+    realm_latency_histogram_t write_group;
+    // Time spent by each commit finding free space in the file
+    realm_latency_histogram_t free_space_search;
+    // Time spent by each commit flushing the file
+    realm_latency_histogram_t sync;
+    // Number of bytes written to the file by commits
+    uint64_t bytes_written;
+    // Number of versions kept in the file at the latest commit
+    uint64_t live_versions;
+} realm_db_metrics_t;
+
+/**
+ * Get the metrics collected for the realm file since it was opened. The
+ * metrics are all zero unless enabled with `realm_config_set_db_metrics_enabled()`.
+ *
+ * @param out_metrics A pointer to a `realm_db_metrics_t` that will contain the
+ *                    metrics, if successful.
+ * @return True if no exception occurred.
+ */
+RLM_API bool realm_get_db_metrics(const realm_t*, realm_db_metrics_t* out_metrics);
+
 /**
  * Get an object with a particular object key.
  *
@@ -2461,6 +2518,17 @@ RLM_API realm_query_t* realm_query_parse(const realm_t*, realm_class_key_t targe
  */
 RLM_API const char* realm_query_get_description(realm_query_t*);
 
+/**
+ * Get a report of how the query is evaluated: the conditions in the order they
+ * are tested and whether a search index is used.
+ *
+ * @param profile If true, run the query and include the number of probes and
+ *                matches of each condition, the clusters visited and skipped,
+ *                and the time taken.
+ * @return a string containing the report. The string memory is managed by the query object.
+ */
+RLM_API const char* realm_query_explain(realm_query_t*, bool profile);
+
 
 /**
  * Parse a query string and append it to an existing query via logical &&.
@@ -2536,6 +2604,57 @@ RLM_API realm_query_t* realm_query_parse_for_results(const realm_results_t* targ
  */
 RLM_API bool realm_query_count(const realm_query_t*, size_t* out_count);
 
+typedef enum realm_group_by_aggregate_type {
+    RLM_GROUP_BY_COUNT,
+    RLM_GROUP_BY_SUM,
+    RLM_GROUP_BY_MIN,
+    RLM_GROUP_BY_MAX,
+    RLM_GROUP_BY_AVG,
+} realm_group_by_aggregate_type_e;
+
+typedef struct realm_group_by_aggregate {
+    realm_group_by_aggregate_type_e type;
+    // The property aggregated. Ignored by RLM_GROUP_BY_COUNT.
+    realm_property_key_t property;
+} realm_group_by_aggregate_t;
+
+/**
+ * Group the objects found by this query by the values of some properties, and
+ * compute aggregates for each group in a single pass over the objects.
+ *
+ * @param properties The properties to group by.
+ * @param num_properties The number of properties. If 0, the `GROUP BY` and
+ *                       `AGGREGATE` clauses of the query string are used.
+ * @param aggregates The aggregates to compute for each group.
+ * @param num_aggregates The number of aggregates.
+ * @return A non-null pointer if no exception occurred. The string and binary
+ *         values of the result are valid until the realm is refreshed or written to.
+ */
+RLM_API realm_group_by_result_t* realm_query_group_by(const realm_query_t*, const realm_property_key_t* properties,
+                                                      size_t num_properties,
+                                                      const realm_group_by_aggregate_t* aggregates,
+                                                      size_t num_aggregates);
+
+/**
+ * Get the number of groups.
+ *
+ * @return True if no exception occurred.
+ */
+RLM_API bool realm_group_by_result_count(const realm_group_by_result_t*, size_t* out_count);
+
+/**
+ * Get the values of the grouping properties and the aggregates of a group.
+ *
+ * @param group The index of the group, in the order the first object of each group was found.
+ * @param out_keys Where to write the values of the grouping properties, one
+ *                 per property. May be NULL.
+ * @param out_values Where to write the results of the aggregates, one per
+ *                   aggregate. May be NULL.
+ * @return True if no exception occurred.
+ */
+RLM_API bool realm_group_by_result_get(const realm_group_by_result_t*, size_t group, realm_value_t* out_keys,
+                                       realm_value_t* out_values);
+
 /**
  * Return the first object matched by this query.
  *
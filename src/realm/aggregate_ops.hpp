@@ -178,6 +178,17 @@ public:
         return false;
     }
 
+    void merge(const Sum& other)
+    {
+        if constexpr (std::is_integral_v<ResultType> && std::is_signed_v<ResultType>) {
+            m_result = std::make_unsigned_t<ResultType>(m_result) + other.m_result;
+        }
+        else {
+            m_result += other.m_result;
+        }
+        m_count += other.m_count;
+    }
+
     bool is_null() const
     {
         return false;
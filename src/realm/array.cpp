@@ -353,6 +353,8 @@ void Array::move(Array& dst, size_t ndx)
     size_t nb_to_move = m_size - ndx;
     dst.copy_on_write();
     dst.ensure_minimum_width(this->m_ubound);
+    if (m_has_base)
+        dst.ensure_minimum_width(this->m_lbound);
     dst.alloc(dst.m_size + nb_to_move, dst.m_width); // Make room for the new elements
 
     // cache variables used in tight loop
@@ -429,6 +431,9 @@ void Array::insert(size_t ndx, int_fast64_t value)
 {
     REALM_ASSERT_DEBUG(ndx <= m_size);
 
+    if (REALM_UNLIKELY(m_has_base))
+        decode_offsets(); // Throws
+
     const auto old_width = m_width;
     const auto old_size = m_size;
     const Getter old_getter = m_getter; // Save old getter before potential width expansion
@@ -532,6 +537,11 @@ void Array::truncate_and_destroy_children(size_t new_size)
 
 void Array::do_ensure_minimum_width(int_fast64_t value)
 {
+    if (REALM_UNLIKELY(m_has_base)) {
+        decode_offsets(); // Throws
+        if (value >= m_lbound && value <= m_ubound)
+            return;
+    }
 
     // Make room for the new value
     const size_t width = bit_width(value);
@@ -550,8 +560,45 @@ void Array::do_ensure_minimum_width(int_fast64_t value)
     }
 }
 
+void Array::decode_offsets()
+{
+    REALM_ASSERT_DEBUG(m_has_base);
+
+    int64_t min_value = m_ubound;
+    int64_t max_value = m_lbound;
+    for (size_t i = 0; i < m_size; ++i) {
+        int64_t v = get(i);
+        min_value = std::min(min_value, v);
+        max_value = std::max(max_value, v);
+    }
+    size_t width = m_size ? std::max(bit_width(min_value), bit_width(max_value)) : 0;
+
+    Array decoded(m_alloc);
+    decoded.create(get_type(), m_context_flag); // Throws
+    decoded.alloc(m_size, width);               // Throws
+    auto setter = decoded.m_vtable->setter;
+    for (size_t i = 0; i < m_size; ++i)
+        (decoded.*setter)(i, get(i));
+
+    ref_type old_ref = m_ref;
+    const char* old_header = get_header();
+    init_from_mem(decoded.get_mem());
+    update_parent(); // Throws
+
+    // Mark original as deleted, so that the space can be reclaimed in
+    // future commits, when no versions are using it anymore
+    m_alloc.free_(old_ref, old_header);
+}
+
 int64_t Array::sum(size_t start, size_t end) const
 {
+    if (REALM_UNLIKELY(m_has_base)) {
+        if (end == size_t(-1))
+            end = m_size;
+        int64_t s;
+        REALM_TEMPEX(s = sum, m_width, (start, end));
+        return int64_t(uint64_t(s) + uint64_t(m_base) * (end - start));
+    }
     REALM_TEMPEX(return sum, m_width, (start, end));
 }
 
@@ -720,6 +767,9 @@ int64_t Array::sum(size_t start, size_t end) const
 
 size_t Array::count(int64_t value) const noexcept
 {
+    if (REALM_UNLIKELY(m_has_base))
+        value = value_to_offset(value);
+
     const uint64_t* next = reinterpret_cast<uint64_t*>(m_data);
     size_t value_count = 0;
     const size_t end = m_size;
@@ -1035,6 +1085,20 @@ bool Array::find_vtable(int64_t value, size_t start, size_t end, size_t baseinde
     return ArrayWithFind(*this).find_optimized<cond, bitwidth>(value, start, end, baseindex, state);
 }
 
+template <size_t w>
+int64_t Array::get_with_base(size_t ndx) const noexcept
+{
+    return get<w>(ndx) + m_base;
+}
+
+template <size_t w>
+void Array::get_chunk_with_base(size_t ndx, int64_t res[8]) const noexcept
+{
+    get_chunk<w>(ndx, res);
+    for (size_t i = 0; i < 8 && ndx + i < m_size; ++i)
+        res[i] += m_base;
+}
+
 
 template <size_t width>
 struct Array::VTableForWidth {
@@ -1056,18 +1120,110 @@ struct Array::VTableForWidth {
 template <size_t width>
 const typename Array::VTableForWidth<width>::PopulatedVTable Array::VTableForWidth<width>::vtable;
 
+// Used for arrays using the frame-of-reference encoding. The finders take care
+// of translating the search value to an offset themselves.
+template <size_t width>
+struct Array::VTableForOffsetWidth {
+    struct PopulatedVTable : Array::VTable {
+        PopulatedVTable()
+        {
+            getter = &Array::get_with_base<width>;
+            setter = &Array::set<width>;
+            chunk_getter = &Array::get_chunk_with_base<width>;
+            finder[cond_Equal] = &Array::find_vtable<Equal, width>;
+            finder[cond_NotEqual] = &Array::find_vtable<NotEqual, width>;
+            finder[cond_Greater] = &Array::find_vtable<Greater, width>;
+            finder[cond_Less] = &Array::find_vtable<Less, width>;
+        }
+    };
+    static const PopulatedVTable vtable;
+};
+
+template <size_t width>
+const typename Array::VTableForOffsetWidth<width>::PopulatedVTable Array::VTableForOffsetWidth<width>::vtable;
+
 void Array::update_width_cache_from_header() noexcept
 {
-    auto width = get_width_from_header(get_header());
+    const char* header = get_header();
+    auto width = get_width_from_header(header);
     m_lbound = lbound_for_width(width);
     m_ubound = ubound_for_width(width);
 
     m_width = width;
 
-    REALM_TEMPEX(m_vtable = &VTableForWidth, width, ::vtable);
+    m_has_base = get_wtype_from_header(header) == wtype_Offset;
+    if (REALM_UNLIKELY(m_has_base)) {
+        // The bounds are those of the values, not of the offsets
+        m_base = get_base_from_header(header);
+        if (util::int_add_with_overflow_detect(m_lbound, m_base))
+            m_lbound = std::numeric_limits<int64_t>::min();
+        if (util::int_add_with_overflow_detect(m_ubound, m_base))
+            m_ubound = std::numeric_limits<int64_t>::max();
+        REALM_TEMPEX(m_vtable = &VTableForOffsetWidth, width, ::vtable);
+    }
+    else {
+        m_base = 0;
+        REALM_TEMPEX(m_vtable = &VTableForWidth, width, ::vtable);
+    }
     m_getter = m_vtable->getter;
 }
 
+bool Array::encode_offsets() noexcept
+{
+    REALM_ASSERT(!is_read_only());
+    const char* header = get_header();
+    if (m_has_base || m_has_refs || m_size == 0 || get_wtype_from_header(header) != wtype_Bits)
+        return false;
+
+    int64_t min_value = get(0);
+    int64_t max_value = min_value;
+    for (size_t i = 1; i < m_size; ++i) {
+        int64_t v = get(i);
+        min_value = std::min(min_value, v);
+        max_value = std::max(max_value, v);
+    }
+
+    // Find the narrowest width that can hold the distance between the smallest
+    // and the largest value.
+    uint64_t range = uint64_t(max_value) - uint64_t(min_value);
+    size_t width = 0;
+    while (width < m_width && uint64_t(ubound_for_width(width) - lbound_for_width(width)) < range)
+        width = (width == 0) ? 1 : width * 2;
+    if (width >= m_width)
+        return false;
+
+    size_t plain_size = calc_byte_size(wtype_Bits, m_size, m_width);
+    if (calc_byte_size(wtype_Offset, m_size, uint_least8_t(width)) >= plain_size)
+        return false;
+
+    // The smallest value is stored as the smallest offset, unless that makes
+    // the base overflow, in which case the largest value is stored as the
+    // largest offset.
+    int64_t base = min_value;
+    if (util::int_subtract_with_overflow_detect(base, lbound_for_width(width))) {
+        base = max_value;
+        if (util::int_subtract_with_overflow_detect(base, ubound_for_width(width)))
+            return false;
+    }
+
+    // The offsets are never wider than the values they replace, so each element
+    // can be rewritten in ascending order without clobbering values that are
+    // yet to be read.
+    char* h = get_header();
+    Getter old_getter = m_getter;
+    set_wtype_in_header(wtype_Offset, h);
+    set_width_in_header(int(width), h);
+    Setter setter;
+    REALM_TEMPEX(setter = VTableForOffsetWidth, width, ::vtable.setter);
+    for (size_t i = 0; i < m_size; ++i) {
+        int64_t v = (this->*old_getter)(i);
+        (this->*setter)(i, v - base);
+    }
+    set_base_in_header(base, h);
+    update_width_cache_from_header();
+    return true;
+}
+
 // This method reads 8 concecutive values into res[8], starting from index 'ndx'. It's allowed for the 8 values to
 // exceed array length; in this case, remainder of res[8] will be be set to 0.
 template <size_t w>
@@ -1263,11 +1419,15 @@ void Array::verify() const
 
 size_t Array::lower_bound_int(int64_t value) const noexcept
 {
+    if (REALM_UNLIKELY(m_has_base))
+        value = value_to_offset(value);
     REALM_TEMPEX(return lower_bound, m_width, (m_data, m_size, value));
 }
 
 size_t Array::upper_bound_int(int64_t value) const noexcept
 {
+    if (REALM_UNLIKELY(m_has_base))
+        value = value_to_offset(value);
     REALM_TEMPEX(return upper_bound, m_width, (m_data, m_size, value));
 }
 
@@ -1282,6 +1442,8 @@ int_fast64_t Array::get(const char* header, size_t ndx) noexcept
 {
     const char* data = get_data_from_header(header);
     uint_least8_t width = get_width_from_header(header);
+    if (REALM_UNLIKELY(get_wtype_from_header(header) == wtype_Offset))
+        return get_direct(data, width, ndx) + get_base_from_header(header);
     return get_direct(data, width, ndx);
 }
 
@@ -1290,6 +1452,10 @@ std::pair<int64_t, int64_t> Array::get_two(const char* header, size_t ndx) noexc
 {
     const char* data = get_data_from_header(header);
     uint_least8_t width = get_width_from_header(header);
+    if (REALM_UNLIKELY(get_wtype_from_header(header) == wtype_Offset)) {
+        int64_t base = get_base_from_header(header);
+        return std::make_pair(get_direct(data, width, ndx) + base, get_direct(data, width, ndx + 1) + base);
+    }
     std::pair<int64_t, int64_t> p = ::get_two(data, width, ndx);
     return std::make_pair(p.first, p.second);
 }
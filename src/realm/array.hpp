@@ -23,6 +23,7 @@
 #include <realm/query_state.hpp>
 #include <realm/column_fwd.hpp>
 #include <realm/array_direct.hpp>
+#include <realm/util/safe_int_ops.hpp>
 
 namespace realm {
 
@@ -198,6 +199,8 @@ public:
 
     void alloc(size_t init_size, size_t new_width)
     {
+        if (REALM_UNLIKELY(m_has_base))
+            decode_offsets(); // Throws
         REALM_ASSERT_3(m_width, ==, get_width_from_header(get_header()));
         REALM_ASSERT_3(m_size, ==, get_size_from_header(get_header()));
         Node::alloc(init_size, new_width);
@@ -443,6 +446,24 @@ public:
     /// FIXME: Belongs in IntegerArray
     static size_t calc_aligned_byte_size(size_t size, int width);
 
+    /// Rewrite this array in place using the frame-of-reference encoding
+    /// (`wtype_Offset`): every element is stored as a narrow offset from a
+    /// common 64-bit base. This is only done if the result takes up less space
+    /// than the current representation, which is the case for values that are
+    /// large, but close to each other, such as timestamps or increasing
+    /// identifiers. Returns true if the array was re-encoded.
+    ///
+    /// The array must be writable, and must hold plain integers (no refs). All
+    /// read and search functions understand the encoding. Any modification will
+    /// first expand the array back to the regular representation.
+    bool encode_offsets() noexcept;
+
+    /// True if this array uses the frame-of-reference encoding.
+    bool has_base() const noexcept
+    {
+        return m_has_base;
+    }
+
 #ifdef REALM_DEBUG
     class MemUsageHandler {
     public:
@@ -460,6 +481,22 @@ public:
     Array(const Array&) = delete;            // not allowed
 
 protected:
+    // Hides the versions in Node, as an array using the frame-of-reference
+    // encoding must be expanded to the regular representation before it can be
+    // modified.
+    void copy_on_write()
+    {
+        if (REALM_UNLIKELY(m_has_base))
+            decode_offsets(); // Throws
+        Node::copy_on_write();
+    }
+    void copy_on_write(size_t min_size)
+    {
+        if (REALM_UNLIKELY(m_has_base))
+            decode_offsets(); // Throws
+        Node::copy_on_write(min_size);
+    }
+
     // This returns the minimum value ("lower bound") of the representable values
     // for the given bit width. Valid widths are 0, 1, 2, 4, 8, 16, 32, and 64.
     static constexpr int_fast64_t lbound_for_width(size_t width) noexcept;
@@ -476,6 +513,10 @@ private:
 
     void do_ensure_minimum_width(int_fast64_t);
 
+    // Replace an array using the frame-of-reference encoding with a regular
+    // array holding the same values.
+    void decode_offsets();
+
     int64_t sum(size_t start, size_t end) const;
 
     template <size_t w>
@@ -510,6 +551,24 @@ protected:
     };
     template <size_t w>
     struct VTableForWidth;
+    template <size_t w>
+    struct VTableForOffsetWidth;
+
+    template <size_t w>
+    int64_t get_with_base(size_t ndx) const noexcept;
+    template <size_t w>
+    void get_chunk_with_base(size_t ndx, int64_t res[8]) const noexcept;
+
+    // Translate a value to the offset domain of an array using the
+    // frame-of-reference encoding. Values that cannot be represented saturate,
+    // which preserves the outcome of every comparison as no offset can be
+    // equal to the min or max value of a 64-bit integer.
+    int64_t value_to_offset(int64_t value) const noexcept
+    {
+        if (util::int_subtract_with_overflow_detect(value, m_base))
+            return m_base < 0 ? std::numeric_limits<int64_t>::max() : std::numeric_limits<int64_t>::min();
+        return value;
+    }
 
     // This is the one installed into the m_vtable->finder slots.
     template <class cond, size_t bitwidth>
@@ -531,10 +590,12 @@ protected:
     uint_least8_t m_width = 0; // Size of an element (meaning depend on type of array).
     int64_t m_lbound;          // min number that can be stored with current m_width
     int64_t m_ubound;          // max number that can be stored with current m_width
+    int64_t m_base = 0;        // added to every element if m_has_base is set
 
     bool m_is_inner_bptree_node; // This array is an inner node of B+-tree.
     bool m_has_refs;             // Elements whose first bit is zero are refs to subarrays.
     bool m_context_flag;         // Meaning depends on context.
+    bool m_has_base = false;     // Elements are offsets from m_base (wtype_Offset).
 
 private:
     ref_type do_write_shallow(_impl::ArrayWriterBase&) const;
@@ -550,6 +611,7 @@ private:
     friend class SlabAlloc;
     friend class GroupWriter;
     friend class ArrayWithFind;
+    friend class NodeTree;
 };
 
 // Implementation:
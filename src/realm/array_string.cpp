@@ -314,10 +314,9 @@ size_t ArrayString::find_first(StringData value, size_t begin, size_t end) const
             break;
         }
         case Type::enum_strings: {
-            size_t sz = m_string_enum_values->size();
-            size_t res = m_string_enum_values->find_first(value, 0, sz);
+            size_t res = find_key(value);
             if (res != realm::not_found) {
-                return static_cast<Array*>(m_arr)->find_first(res, begin, end);
+                return find_first_key(res, begin, end);
             }
             break;
         }
@@ -325,6 +324,18 @@ size_t ArrayString::find_first(StringData value, size_t begin, size_t end) const
     return not_found;
 }
 
+size_t ArrayString::find_key(StringData value) const noexcept
+{
+    REALM_ASSERT_DEBUG(m_type == Type::enum_strings);
+    return m_string_enum_values->find_first(value, 0, m_string_enum_values->size());
+}
+
+size_t ArrayString::find_first_key(size_t key, size_t begin, size_t end) const noexcept
+{
+    REALM_ASSERT_DEBUG(m_type == Type::enum_strings);
+    return static_cast<Array*>(m_arr)->find_first(int64_t(key), begin, end);
+}
+
 namespace {
 
 template <class T>
@@ -109,6 +109,18 @@ public:
 
     size_t find_first(StringData value, size_t begin, size_t end) const noexcept;
 
+    /// True if this is a leaf of an enumerated string column. The elements
+    /// are then stored as indexes into the list of distinct values (keys)
+    /// which is shared by all leaves of the column.
+    bool is_enum() const noexcept
+    {
+        return m_type == Type::enum_strings;
+    }
+    /// Find the index of `value` in the keys of an enumerated column.
+    size_t find_key(StringData value) const noexcept;
+    /// Find the first element referring to the key with the specified index.
+    size_t find_first_key(size_t key, size_t begin, size_t end) const noexcept;
+
     size_t lower_bound(StringData value);
 
     /// Get the specified element without the cost of constructing an
@@ -48,6 +48,9 @@ Searching: The main finding function is:
 #include <emmintrin.h>             // SSE2
 #include <realm/realm_nmmintrin.h> // SSE42
 #endif
+#ifdef REALM_COMPILER_AVX
+#include <immintrin.h> // AVX2, only used in functions marked REALM_TARGET_AVX2
+#endif
 
 namespace realm {
 
@@ -131,6 +134,13 @@ public:
 
 #endif
 
+// AVX2 find for the four functions Equal/NotEqual/Less/Greater
+#ifdef REALM_COMPILER_AVX
+    template <class cond, size_t width>
+    REALM_TARGET_AVX2 bool find_avx2(int64_t value, __m256i* data, size_t items, QueryStateBase* state,
+                                     size_t baseindex) const;
+#endif
+
     template <size_t width>
     inline bool test_zero(uint64_t value) const; // Tests value for 0-elements
 
@@ -308,6 +318,11 @@ bool ArrayWithFind::find_optimized(int64_t value, size_t start, size_t end, size
     if (!(m_array.m_size > start2 && start2 < end))
         return true;
 
+    // The search is done directly on the offsets of an array using the
+    // frame-of-reference encoding
+    if (REALM_UNLIKELY(m_array.m_has_base))
+        value = m_array.value_to_offset(value);
+
     constexpr int64_t lbound = Array::lbound_for_width(bitwidth);
     constexpr int64_t ubound = Array::ubound_for_width(bitwidth);
 
@@ -324,6 +339,35 @@ bool ArrayWithFind::find_optimized(int64_t value, size_t start, size_t end, size
     // finder cannot handle this bitwidth
     REALM_ASSERT_3(m_array.m_width, !=, 0);
 
+#if defined(REALM_COMPILER_AVX)
+    // Use AVX2 if the CPU supports it and the payload spans at least one AVX2 chunk (256 bits). Unlike SSE, AVX2
+    // handles all four conditions for every byte-sized width, including Less for 64-bit values. Widths below 8 bits
+    // are handled by the bit-twiddling compare() below.
+    constexpr bool avx2_cond = std::is_same_v<cond, Equal> || std::is_same_v<cond, NotEqual> ||
+                               std::is_same_v<cond, Greater> || std::is_same_v<cond, Less>;
+    if constexpr (bitwidth >= 8 && avx2_cond) {
+        if (sseavx<2>() && (end - start2) * bitwidth / 8 >= sizeof(__m256i)) {
+            // find_avx2() must start at a 32-byte boundary, so search area before that using compare()
+            __m256i* const a =
+                reinterpret_cast<__m256i*>(round_up(m_array.m_data + start2 * bitwidth / 8, sizeof(__m256i)));
+            __m256i* const b =
+                reinterpret_cast<__m256i*>(round_down(m_array.m_data + end * bitwidth / 8, sizeof(__m256i)));
+            const size_t a_ndx = (reinterpret_cast<char*>(a) - m_array.m_data) * 8 / no0(bitwidth);
+            const size_t b_ndx = (reinterpret_cast<char*>(b) - m_array.m_data) * 8 / no0(bitwidth);
+
+            if (!compare<cond, bitwidth>(value, start2, a_ndx, baseindex, state))
+                return false;
+
+            if (b > a) {
+                if (!find_avx2<cond, bitwidth>(value, a, b - a, state, baseindex + a_ndx))
+                    return false;
+            }
+
+            return compare<cond, bitwidth>(value, b_ndx, end, baseindex, state);
+        }
+    }
+#endif
+
 #if defined(REALM_COMPILER_SSE)
     // Only use SSE if payload is at least one SSE chunk (128 bits) in size. Also note taht SSE doesn't support
     // Less-than comparison for 64-bit values.
@@ -738,6 +782,63 @@ REALM_FORCEINLINE bool ArrayWithFind::find_sse_intern(__m128i* action_data, __m1
 }
 #endif // REALM_COMPILER_SSE
 
+#ifdef REALM_COMPILER_AVX
+// 'items' is the number of 32-byte AVX2 chunks. Calls QueryStateBase::match() for each matching element, where the
+// index of the first element of the first chunk is 'baseindex'. Must only be called if sseavx<2>() is true.
+template <class cond, size_t width>
+REALM_TARGET_AVX2 bool ArrayWithFind::find_avx2(int64_t value, __m256i* data, size_t items, QueryStateBase* state,
+                                                size_t baseindex) const
+{
+    static_assert(width == 8 || width == 16 || width == 32 || width == 64, "AVX2 find requires byte-sized width");
+    constexpr bool is_eq = std::is_same_v<cond, Equal> || std::is_same_v<cond, NotEqual>;
+    static_assert(is_eq || std::is_same_v<cond, Greater> || std::is_same_v<cond, Less>,
+                  "Unsupported condition for AVX2 find");
+
+    __m256i search;
+    if constexpr (width == 8)
+        search = _mm256_set1_epi8(static_cast<char>(value));
+    else if constexpr (width == 16)
+        search = _mm256_set1_epi16(static_cast<short int>(value));
+    else if constexpr (width == 32)
+        search = _mm256_set1_epi32(static_cast<int>(value));
+    else
+        search = _mm256_set1_epi64x(value);
+
+    for (size_t i = 0; i < items; ++i) {
+        const __m256i chunk = _mm256_load_si256(data + i);
+        // AVX2 has no "less than" instruction, so Less is computed as Greater with swapped operands
+        const __m256i lhs = std::is_same_v<cond, Less> ? search : chunk;
+        const __m256i rhs = std::is_same_v<cond, Less> ? chunk : search;
+        __m256i compare_result;
+        if constexpr (width == 8)
+            compare_result = is_eq ? _mm256_cmpeq_epi8(lhs, rhs) : _mm256_cmpgt_epi8(lhs, rhs);
+        else if constexpr (width == 16)
+            compare_result = is_eq ? _mm256_cmpeq_epi16(lhs, rhs) : _mm256_cmpgt_epi16(lhs, rhs);
+        else if constexpr (width == 32)
+            compare_result = is_eq ? _mm256_cmpeq_epi32(lhs, rhs) : _mm256_cmpgt_epi32(lhs, rhs);
+        else
+            compare_result = is_eq ? _mm256_cmpeq_epi64(lhs, rhs) : _mm256_cmpgt_epi64(lhs, rhs);
+
+        // One bit per byte; 64 bits wide so that shifting out the last element is well defined
+        uint64_t resmask = uint32_t(_mm256_movemask_epi8(compare_result));
+        if constexpr (std::is_same_v<cond, NotEqual>)
+            resmask = ~resmask & 0xffffffffULL;
+
+        size_t s = i * sizeof(__m256i) * 8 / width;
+        while (resmask != 0) {
+            size_t idx = first_set_bit64(resmask) * 8 / width;
+            s += idx;
+            if (!state->match(s + baseindex))
+                return false;
+            resmask >>= (idx + 1) * width / 8;
+            ++s;
+        }
+    }
+
+    return true;
+}
+#endif // REALM_COMPILER_AVX
+
 template <class cond>
 bool ArrayWithFind::compare_leafs(const Array* foreign, size_t start, size_t end, size_t baseindex,
                                   QueryStateBase* state) const
@@ -388,6 +388,48 @@ public:
         return value;
     }
 
+    // First position in [begin, end) where `pred(value)` is false. `pred` must be true for a
+    // (possibly empty) prefix of the range. Every descent into the tree either completes the
+    // search within the leaf it reaches or excludes that whole leaf from the range, so the
+    // tree is only descended O(log(number of leaves)) times.
+    template <class Pred>
+    size_t partition_point(size_t begin, size_t end, Pred&& pred) const
+    {
+        size_t result = npos;
+        while (begin < end && result == npos) {
+            size_t mid = begin + (end - begin) / 2;
+            auto func = [&](BPlusTreeNode* node, size_t ndx) {
+                LeafNode* leaf = static_cast<LeafNode*>(node);
+                size_t leaf_begin = mid - ndx;
+                size_t lo = std::max(begin, leaf_begin) - leaf_begin;
+                size_t hi = std::min(end, leaf_begin + leaf->size()) - leaf_begin;
+                if (pred(leaf->get(hi - 1))) {
+                    begin = leaf_begin + hi;
+                    return;
+                }
+                if (!pred(leaf->get(lo))) {
+                    end = leaf_begin + lo;
+                    return;
+                }
+                // pred(lo) holds and pred(hi - 1) does not, so the point is in (lo, hi - 1]
+                ++lo;
+                --hi;
+                while (lo < hi) {
+                    size_t m = lo + (hi - lo) / 2;
+                    if (pred(leaf->get(m))) {
+                        lo = m + 1;
+                    }
+                    else {
+                        hi = m;
+                    }
+                }
+                result = leaf_begin + lo;
+            };
+            m_root->bptree_access(mid, func);
+        }
+        return result == npos ? begin : result;
+    }
+
     std::vector<T> get_all() const
     {
         std::vector<T> all_values;
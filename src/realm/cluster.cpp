@@ -277,6 +277,10 @@ inline void Cluster::do_insert_row(size_t ndx, ColKey col, Mixed init_val, bool
     else {
         arr.insert(ndx, init_val.get<U>());
     }
+    if constexpr (realm::is_any_v<T, ArrayInteger, ArrayIntNull, ArrayFloatNull, ArrayDoubleNull, ArrayTimestamp>) {
+        if (has_value_ranges())
+            update_value_range(*this, col, arr.get_any(ndx));
+    }
 }
 
 inline void Cluster::do_insert_key(size_t ndx, ColKey col_key, Mixed init_val, ObjKey origin_key)
@@ -530,6 +534,8 @@ void Cluster::move(size_t ndx, ClusterNode* new_node, int64_t offset)
         new_leaf->m_keys.add(m_keys.get(i) - offset);
     }
     m_keys.truncate(ndx);
+    // The ranges of this cluster still cover the objects left in it
+    new_leaf->remove_value_ranges();
 }
 
 Cluster::~Cluster() {}
@@ -557,6 +563,7 @@ void Cluster::ensure_general_form()
 template <class T>
 inline void Cluster::do_insert_column(ColKey col_key, bool nullable)
 {
+    remove_value_ranges();
     size_t sz = node_size();
 
     T arr(m_alloc);
@@ -583,6 +590,7 @@ void Cluster::insert_column(ColKey col_key)
     auto attr = col_key.get_attrs();
     auto type = col_key.get_type();
     if (attr.test(col_attr_Collection)) {
+        remove_value_ranges();
         size_t sz = node_size();
 
         ArrayRef arr(m_alloc);
@@ -652,6 +660,7 @@ void Cluster::insert_column(ColKey col_key)
 
 void Cluster::remove_column(ColKey col_key)
 {
+    remove_value_ranges();
     auto col_ndx = col_key.get_index();
     unsigned idx = col_ndx.val + s_first_col_index;
     ref_type ref = to_ref(Array::get(idx));
@@ -955,6 +964,8 @@ size_t Cluster::erase(ObjKey key, CascadeState& state)
             m_keys.erase(ndx);
         }
     }
+    // The ranges become unknown, and are computed again on commit
+    remove_value_ranges();
 
     return node_size();
 }
@@ -1019,6 +1030,22 @@ void Cluster::upgrade_string_to_enum(ColKey col_key, ArrayString& keys)
     Array::destroy_deep(ref, m_alloc);
 }
 
+void Cluster::encode_integer_leaves(const std::vector<ColKey>& cols)
+{
+    if (is_read_only())
+        return;
+
+    for (auto col_key : cols) {
+        ref_type ref = Array::get_as_ref(col_key.get_index().val + s_first_col_index);
+        // Leaves that were not modified in this transaction are left as they are
+        if (m_alloc.is_read_only(ref))
+            continue;
+        Array values(m_alloc);
+        values.init_from_ref(ref);
+        values.encode_offsets();
+    }
+}
+
 void Cluster::init_leaf(ColKey col_key, ArrayPayload* leaf) const
 {
     auto col_ndx = col_key.get_index();
@@ -1037,11 +1064,175 @@ void Cluster::init_leaf(ColKey col_key, ArrayPayload* leaf) const
 
 void Cluster::add_leaf(ColKey col_key, ref_type ref)
 {
+    remove_value_ranges();
     auto col_ndx = col_key.get_index();
     REALM_ASSERT((col_ndx.val + 1) == size());
     Array::insert(col_ndx.val + 1, from_ref(ref));
 }
 
+namespace {
+
+bool is_floating_point(ColKey col_key)
+{
+    return col_key.get_type() == col_type_Float || col_key.get_type() == col_type_Double;
+}
+
+// The range of a column holding no values, where `min` is larger than `max`
+std::pair<int64_t, int64_t> empty_value_range(ColKey col_key)
+{
+    if (is_floating_point(col_key))
+        return {type_punning<int64_t>(std::numeric_limits<double>::infinity()),
+                type_punning<int64_t>(-std::numeric_limits<double>::infinity())};
+    return {std::numeric_limits<int64_t>::max(), std::numeric_limits<int64_t>::min()};
+}
+
+Mixed get_range_value(ColKey col_key, int64_t value)
+{
+    if (is_floating_point(col_key))
+        return type_punning<double>(value);
+    return value;
+}
+
+// Widen the range from `min` to `max` to include `value`. Returns false if
+// it already did, or if the value is not part of the range.
+bool widen_value_range(ColKey col_key, Mixed value, int64_t& min, int64_t& max)
+{
+    if (value.is_null())
+        return false;
+    if (is_floating_point(col_key)) {
+        double v = value.is_type(type_Float) ? double(value.get_float()) : value.get_double();
+        double lo = type_punning<double>(min);
+        double hi = type_punning<double>(max);
+        if (std::isnan(v) || (lo <= v && v <= hi))
+            return false;
+        min = type_punning<int64_t>(std::min(lo, v));
+        max = type_punning<int64_t>(std::max(hi, v));
+        return true;
+    }
+    int64_t v = value.is_type(type_Timestamp) ? value.get_timestamp().get_seconds() : value.get_int();
+    if (min <= v && v <= max)
+        return false;
+    min = std::min(min, v);
+    max = std::max(max, v);
+    return true;
+}
+
+} // anonymous namespace
+
+bool Cluster::has_value_range(ColKey col_key) noexcept
+{
+    auto type = col_key.get_type();
+    return !col_key.is_collection() &&
+           (type == col_type_Int || type == col_type_Float || type == col_type_Double || type == col_type_Timestamp);
+}
+
+bool Cluster::get_value_range(ColKey col_key, Mixed& min, Mixed& max) const
+{
+    if (!has_value_ranges())
+        return false;
+    const char* ranges = m_alloc.translate(Array::get_as_ref(size() - 1));
+    size_t ndx = col_key.get_index().val * s_value_range_size;
+    if (ndx >= Array::get_size_from_header(ranges) || Array::get(ranges, ndx) == 0)
+        return false;
+
+    min = get_range_value(col_key, Array::get(ranges, ndx + 1));
+    max = get_range_value(col_key, Array::get(ranges, ndx + 2));
+    return true;
+}
+
+void Cluster::update_value_range(Array& fields, ColKey col_key, Mixed value)
+{
+    if (!fields.get_context_flag() || value.is_null())
+        return;
+
+    Array ranges(fields.get_alloc());
+    ranges.set_parent(&fields, fields.size() - 1);
+    ranges.init_from_parent();
+    size_t ndx = col_key.get_index().val * s_value_range_size;
+    if (ndx >= ranges.size() || ranges.get(ndx) == 0)
+        return;
+    int64_t min = ranges.get(ndx + 1);
+    int64_t max = ranges.get(ndx + 2);
+    // Most values fall within the range, in which case nothing is written
+    if (widen_value_range(col_key, value, min, max)) {
+        ranges.set(ndx + 1, min);
+        ranges.set(ndx + 2, max);
+    }
+}
+
+void Cluster::update_value_ranges()
+{
+    std::vector<ColKey> cols;
+    m_tree_top.m_owner->for_each_public_column([&cols](ColKey col_key) {
+        if (has_value_range(col_key))
+            cols.push_back(col_key);
+        return IteratorControl::AdvanceToNext;
+    });
+    if (cols.empty())
+        return;
+
+    if (!has_value_ranges()) {
+        Array ranges(m_alloc);
+        ranges.create(type_Normal, false, nb_columns() * s_value_range_size, 0);
+        Array::add(from_ref(ranges.get_ref()));
+        set_context_flag(true);
+    }
+
+    Array ranges(m_alloc);
+    ranges.set_parent(this, size() - 1);
+    ranges.init_from_parent();
+    for (auto col_key : cols) {
+        size_t ndx = col_key.get_index().val * s_value_range_size;
+        if (ranges.get(ndx) != 0)
+            continue;
+        auto [min, max] = compute_value_range(col_key);
+        ranges.set(ndx + 1, min);
+        ranges.set(ndx + 2, max);
+        ranges.set(ndx, 1);
+    }
+}
+
+std::pair<int64_t, int64_t> Cluster::compute_value_range(ColKey col_key) const
+{
+    auto [min, max] = empty_value_range(col_key);
+    size_t sz = node_size();
+    auto widen = [&](ArrayPayload&& leaf) {
+        init_leaf(col_key, &leaf);
+        for (size_t i = 0; i < sz; i++)
+            widen_value_range(col_key, leaf.get_any(i), min, max);
+    };
+    switch (col_key.get_type()) {
+        case col_type_Int:
+            if (col_key.is_nullable())
+                widen(ArrayIntNull(m_alloc));
+            else
+                widen(ArrayInteger(m_alloc));
+            break;
+        case col_type_Float:
+            widen(ArrayFloatNull(m_alloc));
+            break;
+        case col_type_Double:
+            widen(ArrayDoubleNull(m_alloc));
+            break;
+        case col_type_Timestamp:
+            widen(ArrayTimestamp(m_alloc));
+            break;
+        default:
+            REALM_UNREACHABLE();
+    }
+    return {min, max};
+}
+
+void Cluster::remove_value_ranges()
+{
+    if (!has_value_ranges())
+        return;
+    size_t ndx = size() - 1;
+    Array::destroy(Array::get_as_ref(ndx), m_alloc);
+    Array::erase(ndx);
+    set_context_flag(false);
+}
+
 template <typename ArrayType>
 void Cluster::verify(ref_type ref, size_t index, util::Optional<size_t>& sz) const
 {
@@ -1286,6 +1477,18 @@ void Cluster::verify() const
     };
 
     m_tree_top.m_owner->for_each_and_every_column(verify_column);
+
+    // No value may lie outside of the range kept for its column
+    m_tree_top.m_owner->for_each_public_column([this](ColKey col_key) {
+        Mixed min, max;
+        if (has_value_range(col_key) && get_value_range(col_key, min, max)) {
+            auto [lo, hi] = compute_value_range(col_key);
+            Mixed actual_min = get_range_value(col_key, lo);
+            Mixed actual_max = get_range_value(col_key, hi);
+            REALM_ASSERT(actual_min > actual_max || (min <= actual_min && actual_max <= max));
+        }
+        return IteratorControl::AdvanceToNext;
+    });
 #endif
 }
 
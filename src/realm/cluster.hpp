@@ -298,7 +298,7 @@ public:
     void remove_column(ColKey col) override; // Does not move columns - may leave a 'hole'
     size_t nb_columns() const override
     {
-        return size() - s_first_col_index;
+        return size() - s_first_col_index - (has_value_ranges() ? 1 : 0);
     }
     ref_type insert(ObjKey k, const FieldValues& init_values, State& state) override;
     bool try_get(ObjKey k, State& state) const noexcept override;
@@ -307,10 +307,28 @@ public:
     size_t erase(ObjKey k, CascadeState& state) override;
     void nullify_incoming_links(ObjKey key, CascadeState& state) override;
     void upgrade_string_to_enum(ColKey col, ArrayString& keys);
+    void encode_integer_leaves(const std::vector<ColKey>& cols);
 
     void init_leaf(ColKey col, ArrayPayload* leaf) const;
     void add_leaf(ColKey col, ref_type ref);
 
+    /// Check if the range of values in the cluster is kept for `col`. This is
+    /// the case for integer, float, double and timestamp columns.
+    static bool has_value_range(ColKey col) noexcept;
+    /// Get the smallest and largest value of `col` in the cluster, so that
+    /// queries can skip clusters which cannot hold any matches. Null and NaN
+    /// values are left out, and timestamps are only ranged by their seconds.
+    /// Integers and seconds are given as type_Int, floats and doubles as
+    /// type_Double. If the column holds no other values, `min` is larger than
+    /// `max`. Returns false if the range is not known.
+    bool get_value_range(ColKey col, Mixed& min, Mixed& max) const;
+    /// Widen the range of `col` to include `value`, which has been stored in
+    /// the cluster `fields`.
+    static void update_value_range(Array& fields, ColKey col, Mixed value);
+    /// Compute the ranges which are not known, as is the case after objects
+    /// were erased or moved. Called for the modified clusters on commit.
+    void update_value_ranges();
+
     void verify() const;
     void dump_objects(int64_t key_offset, std::string lead) const override;
     static void remove_backlinks(const Table* origin_table, ObjKey origin_key, ColKey col,
@@ -324,6 +342,22 @@ private:
     static constexpr size_t s_key_ref_or_size_index = 0;
     static constexpr size_t s_first_col_index = 1;
 
+    // The value ranges are kept in an array whose ref follows the columns.
+    // Its presence is indicated by the context flag of the cluster. Each
+    // column has an entry which is zero if the range is unknown, followed by
+    // the smallest and the largest value. Floats and doubles are stored as
+    // the bits of a double.
+    static constexpr size_t s_value_range_size = 3;
+
+    bool has_value_ranges() const noexcept
+    {
+        return get_context_flag();
+    }
+    // Columns are addressed by the size of the cluster when they are added
+    // or removed, so the ranges are removed first and recomputed on commit
+    void remove_value_ranges();
+    std::pair<int64_t, int64_t> compute_value_range(ColKey col) const;
+
     size_t get_size_in_compact_form() const
     {
         return size_t(Array::get(s_key_ref_or_size_index)) >> 1; // Size is stored as tagged value
@@ -29,7 +29,14 @@
 #include "realm/array_mixed.hpp"
 #include "realm/array_fixed_bytes.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <iostream>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
 
 /*
  * Node-splitting is done in the way that if the new element comes after all the
@@ -73,6 +80,7 @@ public:
 
     bool traverse(ClusterTree::TraverseFunction func, int64_t) const;
     void update(ClusterTree::UpdateFunction func, int64_t);
+    void update_modified(ClusterTree::UpdateFunction func);
 
     size_t node_size() const override
     {
@@ -736,6 +744,36 @@ void ClusterNodeInner::update(ClusterTree::UpdateFunction func, int64_t key_offs
     }
 }
 
+void ClusterNodeInner::update_modified(ClusterTree::UpdateFunction func)
+{
+    // A node which is still read-only cannot contain any modified nodes
+    if (is_read_only())
+        return;
+
+    auto sz = node_size();
+
+    for (unsigned i = 0; i < sz; i++) {
+        ref_type ref = _get_child_ref(i);
+        if (m_alloc.is_read_only(ref))
+            continue;
+        char* header = m_alloc.translate(ref);
+        bool child_is_leaf = !Array::get_is_inner_bptree_node_from_header(header);
+        MemRef mem(header, ref, m_alloc);
+        if (child_is_leaf) {
+            Cluster leaf(0, m_alloc, m_tree_top);
+            leaf.init(mem);
+            leaf.set_parent(this, i + s_first_node_index);
+            func(&leaf);
+        }
+        else {
+            ClusterNodeInner node(m_alloc, m_tree_top);
+            node.init(mem);
+            node.set_parent(this, i + s_first_node_index);
+            node.update_modified(func);
+        }
+    }
+}
+
 int64_t ClusterNodeInner::get_last_key_value() const
 {
     auto last_ndx = node_size() - 1;
@@ -888,6 +926,27 @@ void ClusterTree::enumerate_string_column(ColKey col_key)
     update(upgrade);
 }
 
+size_t ClusterTree::count_distinct_strings(ColKey col_key, size_t limit) const
+{
+    ArrayString leaf(get_alloc());
+    std::unordered_set<StringData> values;
+
+    auto collect_strings = [col_key, limit, &leaf, &values](const Cluster* cluster) {
+        cluster->init_leaf(col_key, &leaf);
+        size_t sz = leaf.size();
+        for (size_t i = 0; i < sz; i++) {
+            values.insert(leaf.get(i));
+            if (values.size() > limit)
+                return IteratorControl::Stop;
+        }
+
+        return IteratorControl::AdvanceToNext;
+    };
+
+    traverse(collect_strings);
+    return values.size();
+}
+
 void ClusterTree::replace_root(std::unique_ptr<ClusterNode> new_root)
 {
     if (new_root != m_root) {
@@ -1043,6 +1102,142 @@ bool ClusterTree::traverse(TraverseFunction func) const
     }
 }
 
+namespace {
+
+// The threads used for running queries on several threads. They are kept
+// around between queries, as starting new threads would cost more than running
+// most queries. The pool grows to the largest number of threads asked for.
+class QueryThreadPool {
+public:
+    using Work = util::FunctionRef<void(size_t thread_ndx)>;
+
+    static QueryThreadPool& get()
+    {
+        static QueryThreadPool pool;
+        return pool;
+    }
+
+    ~QueryThreadPool()
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_stop = true;
+        }
+        m_work_available.notify_all();
+        for (auto& thread : m_threads)
+            thread.join();
+    }
+
+    // Call `work` on `num_threads` threads, the calling thread being the first
+    // one. `work` must not throw. If the threads of the pool are busy, the
+    // calling thread does not wait for them to start but returns as soon as the
+    // work which has already been started is done.
+    void run(size_t num_threads, Work work)
+    {
+        Job job{work};
+        {
+            std::lock_guard lock(m_mutex);
+            while (m_threads.size() < num_threads - 1)
+                m_threads.emplace_back(&QueryThreadPool::worker, this);
+            for (size_t t = 1; t < num_threads; t++)
+                m_tasks.push_back({&job, t});
+        }
+        m_work_available.notify_all();
+
+        work(0);
+
+        std::unique_lock lock(m_mutex);
+        m_tasks.erase(std::remove_if(m_tasks.begin(), m_tasks.end(),
+                                     [&job](const Task& task) {
+                                         return task.job == &job;
+                                     }),
+                      m_tasks.end());
+        m_job_done.wait(lock, [&job] {
+            return job.running == 0;
+        });
+    }
+
+private:
+    struct Job {
+        Work work;
+        size_t running = 0;
+    };
+    struct Task {
+        Job* job;
+        size_t thread_ndx;
+    };
+
+    std::mutex m_mutex;
+    std::condition_variable m_work_available;
+    std::condition_variable m_job_done;
+    std::vector<std::thread> m_threads;
+    std::deque<Task> m_tasks;
+    bool m_stop = false;
+
+    void worker()
+    {
+        std::unique_lock lock(m_mutex);
+        for (;;) {
+            m_work_available.wait(lock, [this] {
+                return m_stop || !m_tasks.empty();
+            });
+            if (m_stop)
+                return;
+            Task task = m_tasks.front();
+            m_tasks.pop_front();
+            ++task.job->running;
+            lock.unlock();
+            task.job->work(task.thread_ndx);
+            lock.lock();
+            if (--task.job->running == 0)
+                m_job_done.notify_all();
+        }
+    }
+};
+
+} // anonymous namespace
+
+size_t ClusterTree::traverse_parallel(size_t num_threads, ParallelTraverseFunction func) const
+{
+    std::vector<std::pair<ref_type, int64_t>> leaves;
+    traverse([&leaves](const Cluster* cluster) {
+        leaves.emplace_back(cluster->get_ref(), cluster->get_offset());
+        return IteratorControl::AdvanceToNext;
+    });
+
+    std::atomic<size_t> next_leaf = 0;
+    std::mutex error_mutex;
+    std::exception_ptr error;
+    auto work = [&](size_t thread_ndx) {
+        try {
+            Cluster leaf(0, m_alloc, *this);
+            for (size_t i = next_leaf++; i < leaves.size(); i = next_leaf++) {
+                auto [ref, offset] = leaves[i];
+                leaf.set_offset(offset);
+                leaf.init(MemRef(m_alloc.translate(ref), ref, m_alloc));
+                func(thread_ndx, i, &leaf);
+            }
+        }
+        catch (...) {
+            // Make the other threads stop as soon as possible
+            next_leaf = leaves.size();
+            std::lock_guard lock(error_mutex);
+            if (!error)
+                error = std::current_exception();
+        }
+    };
+
+    num_threads = std::min(num_threads, leaves.size());
+    if (num_threads > 1)
+        QueryThreadPool::get().run(num_threads, work);
+    else
+        work(0);
+    if (error)
+        std::rethrow_exception(error);
+
+    return leaves.size();
+}
+
 void ClusterTree::update(UpdateFunction func)
 {
     if (m_root->is_leaf()) {
@@ -1053,6 +1248,49 @@ void ClusterTree::update(UpdateFunction func)
     }
 }
 
+void ClusterTree::update_modified(UpdateFunction func)
+{
+    // A node which is still read-only cannot contain any modified nodes
+    if (m_root->is_read_only())
+        return;
+
+    if (m_root->is_leaf()) {
+        func(static_cast<Cluster*>(m_root.get()));
+    }
+    else {
+        static_cast<ClusterNodeInner*>(m_root.get())->update_modified(func);
+    }
+}
+
+void ClusterTree::encode_integer_leaves()
+{
+    // Only plain integer columns are encoded. Nullable integers use a magic
+    // value derived from the width of the leaf to represent null.
+    std::vector<ColKey> cols;
+    m_owner->for_each_public_column([&cols](ColKey col_key) {
+        if (col_key.get_type() == col_type_Int && !col_key.is_nullable() && !col_key.is_collection())
+            cols.push_back(col_key);
+        return IteratorControl::AdvanceToNext;
+    });
+    if (cols.empty())
+        return;
+
+    update_modified([&cols](Cluster* cluster) {
+        cluster->encode_integer_leaves(cols);
+    });
+}
+
+void ClusterTree::update_value_ranges(bool all)
+{
+    auto update = [](Cluster* cluster) {
+        cluster->update_value_ranges();
+    };
+    if (all)
+        this->update(update);
+    else
+        update_modified(update);
+}
+
 void ClusterTree::set_spec(ArrayPayload& arr, ColKey::Idx col_ndx) const
 {
     // Check for owner. This function may be called in context of DictionaryClusterTree
@@ -33,6 +33,7 @@ public:
     using TraverseFunction = util::FunctionRef<IteratorControl(const Cluster*)>;
     using UpdateFunction = util::FunctionRef<void(Cluster*)>;
     using ColIterateFunction = util::FunctionRef<IteratorControl(ColKey)>;
+    using ParallelTraverseFunction = util::FunctionRef<void(size_t thread_ndx, size_t leaf_ndx, const Cluster*)>;
 
     ClusterTree(Table* owner, Allocator& alloc, size_t top_position_for_cluster_tree);
     virtual ~ClusterTree();
@@ -154,6 +155,16 @@ public:
 
     void clear(CascadeState&);
     void enumerate_string_column(ColKey col_key);
+    /// Count the distinct values of a string column. The scan stops as soon
+    /// as more than `limit` values have been seen, in which case `limit + 1`
+    /// is returned.
+    size_t count_distinct_strings(ColKey col_key, size_t limit) const;
+    /// Apply the frame-of-reference encoding to the modified leaves of all
+    /// non-nullable integer columns where it saves space.
+    void encode_integer_leaves();
+    /// Compute the value ranges of the modified leaves which are not known,
+    /// or of all leaves if `all` is set. See Cluster::get_value_range().
+    void update_value_ranges(bool all = false);
 
     const Table* get_owning_table() const noexcept
     {
@@ -179,6 +190,14 @@ public:
     bool traverse(TraverseFunction func) const;
     // Visit all leaves and call the supplied function. The function can modify the leaf.
     void update(UpdateFunction func);
+    // Like update(), but only visit the leaves modified in the current transaction.
+    void update_modified(UpdateFunction func);
+    // Visit all leaves from up to `num_threads` threads, including the calling thread. Leaves are
+    // handed out one at a time, so a thread which is done with its leaf picks up the next one. The
+    // function is called with the index of the thread and the position of the leaf in key order.
+    // The other threads are taken from a pool kept by the process, so they are reused by later
+    // calls. Returns the number of leaves. Not allowed to modify the tree.
+    size_t traverse_parallel(size_t num_threads, ParallelTraverseFunction func) const;
 
     void set_spec(ArrayPayload& arr, ColKey::Idx col_ndx) const;
 
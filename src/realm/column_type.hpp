@@ -133,7 +133,7 @@ static_assert(!col_type_OldStringEnum.is_valid());
 static_assert(!col_type_OldTable.is_valid());
 static_assert(!col_type_OldDateTime.is_valid());
 
-enum class IndexType { None, General, Fulltext };
+enum class IndexType { None, General, Fulltext, Ordered, Hash, Geospatial };
 
 inline std::ostream& operator<<(std::ostream& ostr, IndexType type)
 {
@@ -147,6 +147,15 @@ inline std::ostream& operator<<(std::ostream& ostr, IndexType type)
         case IndexType::Fulltext:
             ostr << "fulltext index";
             break;
+        case IndexType::Ordered:
+            ostr << "ordered index";
+            break;
+        case IndexType::Hash:
+            ostr << "hash index";
+            break;
+        case IndexType::Geospatial:
+            ostr << "geospatial index";
+            break;
     }
     return ostr;
 }
@@ -182,6 +191,18 @@ enum ColumnAttr {
     /// Specifies that elements in the column are full-text indexed
     col_attr_FullText_Indexed = 256,
 
+    /// Specifies that the column has an ordered index supporting range lookups. Added in file format 25.
+    col_attr_Ordered_Indexed = 512,
+
+    /// Specifies that the primary key column has a hash index. Added in file format 25.
+    col_attr_Hash_Indexed = 1024,
+
+    /// Specifies that the points held by the column have a geospatial index. Added in file format 25.
+    col_attr_Geo_Indexed = 2048,
+
+    /// Specifies that the full-text index of the column stores compressed posting lists. Added in file format 25.
+    col_attr_FullText_Postings = 4096,
+
     /// Either list, dictionary, or set
     col_attr_Collection = 128 + 64 + 32
 };
@@ -521,8 +521,11 @@ DB::SharedInfo::SharedInfo(Durability dura, Replication::HistoryType ht, int hsv
 
 class DB::VersionManager {
 public:
-    VersionManager(util::InterprocessMutex& mutex)
+    // `newest` must be the index of the newest version in a mapping of the
+    // lock file which is never remapped, so that it can be read without a lock
+    VersionManager(util::InterprocessMutex& mutex, const std::atomic<uint32_t>& newest)
         : m_mutex(mutex)
+        , m_newest(newest)
     {
     }
     virtual ~VersionManager() {}
@@ -549,13 +552,10 @@ public:
             // a stale value (acceptable for a racing write on one thread and
             // a read on another), or a new value which is guaranteed to not
             // be an active index in the local cache.
-            util::CheckedLockGuard lock(m_local_readers_mutex);
-            util::CheckedLockGuard info_lock(m_info_mutex);
-            auto index = m_info->readers.newest.load();
-            if (index < m_local_readers.size()) {
-                auto& r = m_local_readers[index];
-                if (r.is_active()) {
-                    return {r.version, index};
+            auto index = m_newest.load();
+            if (auto r = m_local_readers.get(index)) {
+                if (auto version = r->version.load(std::memory_order_acquire)) {
+                    return {version, index};
                 }
             }
         }
@@ -569,27 +569,34 @@ public:
 
     void release_read_lock(const ReadLockInfo& read_lock) REQUIRES(!m_local_readers_mutex, !m_info_mutex)
     {
-        {
-            util::CheckedLockGuard lock(m_local_readers_mutex);
-            REALM_ASSERT(read_lock.m_reader_idx < m_local_readers.size());
-            auto& r = m_local_readers[read_lock.m_reader_idx];
-            auto& f = field_for_type(r, read_lock.m_type);
-            REALM_ASSERT(f > 0);
-            if (--f > 0)
+        auto r = m_local_readers.get(read_lock.m_reader_idx);
+        REALM_ASSERT(r);
+        auto& count = r->counts[read_lock.m_type];
+        // As long as another lock of the same type is held on the version by
+        // this process, only the local count is decremented.
+        auto c = count.load(std::memory_order_relaxed);
+        while (c > 1) {
+            if (count.compare_exchange_weak(c, c - 1, std::memory_order_release, std::memory_order_relaxed))
                 return;
-            if (r.count_live == 0 && r.count_full == 0 && r.count_frozen == 0)
-                r.version = 0;
         }
 
+        util::CheckedLockGuard local_lock(m_local_readers_mutex);
+        c = count.fetch_sub(1, std::memory_order_acq_rel);
+        REALM_ASSERT(c > 0);
+        if (c > 1)
+            return; // Another lock was grabbed concurrently
+        if (!r->is_active())
+            r->version.store(0, std::memory_order_relaxed);
+
         std::lock_guard lock(m_mutex);
         util::CheckedLockGuard info_lock(m_info_mutex);
         // we should not need to call ensure_full_reader_mapping,
         // since releasing a read lock means it has been grabbed
         // earlier - and hence must reside in mapped memory:
         REALM_ASSERT(read_lock.m_reader_idx < m_local_max_entry);
-        auto& r = m_info->readers.get(read_lock.m_reader_idx);
-        REALM_ASSERT(read_lock.m_version == r.version);
-        --field_for_type(r, read_lock.m_type);
+        auto& rc = m_info->readers.get(read_lock.m_reader_idx);
+        REALM_ASSERT(read_lock.m_version == rc.version);
+        --field_for_type(rc, read_lock.m_type);
     }
 
     ReadLockInfo grab_read_lock(ReadLockInfo::Type type, VersionID version_id = {})
@@ -599,42 +606,79 @@ public:
         if (try_grab_local_read_lock(read_lock, type, version_id))
             return read_lock;
 
-        {
-            const bool pick_specific = version_id.version != VersionID().version;
-            std::lock_guard lock(m_mutex);
-            util::CheckedLockGuard info_lock(m_info_mutex);
-            auto newest = m_info->readers.newest.load();
-            REALM_ASSERT(newest != VersionList::nil);
-            read_lock.m_reader_idx = pick_specific ? version_id.index : newest;
-            ensure_reader_mapping((unsigned int)read_lock.m_reader_idx);
-            bool picked_newest = read_lock.m_reader_idx == (unsigned)newest;
-            auto& r = m_info->readers.get(read_lock.m_reader_idx);
-            if (pick_specific && version_id.version != r.version)
+        // The version is not locked by this process, so it must be locked in
+        // the VersionList. The local mutex serializes this with the release of
+        // the last local lock on a version.
+        const bool pick_specific = version_id.version != VersionID().version;
+        util::CheckedLockGuard local_lock(m_local_readers_mutex);
+        std::lock_guard lock(m_mutex);
+        util::CheckedLockGuard info_lock(m_info_mutex);
+        auto newest = m_info->readers.newest.load();
+        REALM_ASSERT(newest != VersionList::nil);
+        read_lock.m_reader_idx = pick_specific ? version_id.index : newest;
+        ensure_reader_mapping((unsigned int)read_lock.m_reader_idx);
+        bool picked_newest = read_lock.m_reader_idx == (unsigned)newest;
+        auto& r = m_info->readers.get(read_lock.m_reader_idx);
+        if (pick_specific && version_id.version != r.version)
+            throw BadVersion(version_id.version);
+        if (!picked_newest) {
+            if (type == ReadLockInfo::Frozen && r.count_frozen == 0 && r.count_live == 0)
                 throw BadVersion(version_id.version);
-            if (!picked_newest) {
-                if (type == ReadLockInfo::Frozen && r.count_frozen == 0 && r.count_live == 0)
-                    throw BadVersion(version_id.version);
-                if (type != ReadLockInfo::Frozen && r.count_live == 0)
-                    throw BadVersion(version_id.version);
-            }
-            populate_read_lock(read_lock, r, type);
+            if (type != ReadLockInfo::Frozen && r.count_live == 0)
+                throw BadVersion(version_id.version);
+        }
+
+        auto& local = m_local_readers.get_or_create(read_lock.m_reader_idx); // Throws
+        read_lock.m_type = type;
+        read_lock.m_version = r.version;
+        read_lock.m_top_ref = static_cast<ref_type>(r.current_top);
+        read_lock.m_file_size = static_cast<size_t>(r.filesize);
+        if (local.counts[type].load(std::memory_order_relaxed) > 0) {
+            // Locked by another thread since the local lock was tried
+            REALM_ASSERT(local.version.load(std::memory_order_relaxed) == r.version);
+            local.counts[type].fetch_add(1, std::memory_order_relaxed);
+            return read_lock;
         }
+        ++field_for_type(r, type);
+        if (!local.is_active()) {
+            local.filesize = r.filesize;
+            local.current_top = r.current_top;
+            local.version.store(r.version, std::memory_order_relaxed);
+        }
+        REALM_ASSERT_EX(local.version.load(std::memory_order_relaxed) == r.version,
+                        local.version.load(std::memory_order_relaxed), r.version);
+        local.counts[type].store(1, std::memory_order_release);
+        return read_lock;
+    }
 
+    // Keep the version of the read lock locked in the VersionList until the
+    // end of the session, and release the lock in this process.
+    void leak_read_lock(const ReadLockInfo& read_lock) REQUIRES(!m_local_readers_mutex, !m_info_mutex)
+    {
         {
-            util::CheckedLockGuard local_lock(m_local_readers_mutex);
-            grow_local_cache(read_lock.m_reader_idx + 1);
-            auto& r2 = m_local_readers[read_lock.m_reader_idx];
-            if (!r2.is_active()) {
-                r2.version = read_lock.m_version;
-                r2.filesize = read_lock.m_file_size;
-                r2.current_top = read_lock.m_top_ref;
-                r2.count_full = r2.count_live = r2.count_frozen = 0;
-            }
-            REALM_ASSERT_EX(field_for_type(r2, type) == 0, type, r2.count_full, r2.count_live, r2.count_frozen);
-            field_for_type(r2, type) = 1;
+            std::lock_guard lock(m_mutex);
+            util::CheckedLockGuard info_lock(m_info_mutex);
+            ++field_for_type(m_info->readers.get(read_lock.m_reader_idx), read_lock.m_type);
         }
+        release_read_lock(read_lock);
+    }
 
-        return read_lock;
+    // Release all the read locks held by this process
+    void release_all_read_locks() REQUIRES(!m_local_readers_mutex, !m_info_mutex)
+    {
+        util::CheckedLockGuard local_lock(m_local_readers_mutex);
+        std::lock_guard lock(m_mutex);
+        util::CheckedLockGuard info_lock(m_info_mutex);
+        m_local_readers.for_each([&](uint32_t index, LocalReadCount& local) {
+            if (!local.is_active())
+                return;
+            auto& rc = m_info->readers.get(index);
+            for (auto type : {ReadLockInfo::Frozen, ReadLockInfo::Live, ReadLockInfo::Full}) {
+                if (local.counts[type].exchange(0, std::memory_order_relaxed) > 0)
+                    --field_for_type(rc, type);
+            }
+            local.version.store(0, std::memory_order_relaxed);
+        });
     }
 
     void init_versioning(ref_type top_ref, size_t file_size, uint64_t initial_version) REQUIRES(!m_info_mutex)
@@ -664,44 +708,121 @@ public:
 
 
 private:
-    void grow_local_cache(size_t new_size) REQUIRES(m_local_readers_mutex)
-    {
-        if (new_size > m_local_readers.size())
-            m_local_readers.resize(new_size, VersionList::ReadCount{});
-    }
+    // The read locks held by this process on a version of the VersionList. The
+    // version is locked once in the VersionList for each type of lock with a
+    // nonzero count, so most read locks are grabbed and released by only
+    // updating these counts.
+    //
+    // A count only goes from zero to one, and back, under m_local_readers_mutex.
+    // The other fields are only written then, while all counts are zero, and
+    // are stable while a count is held.
+    struct LocalReadCount {
+        std::atomic<uint64_t> version{0};
+        uint64_t filesize = 0;
+        uint64_t current_top = 0;
+        std::atomic<uint32_t> counts[3] = {}; // Indexed by ReadLockInfo::Type
+
+        bool is_active() const noexcept
+        {
+            return counts[0].load(std::memory_order_relaxed) || counts[1].load(std::memory_order_relaxed) ||
+                   counts[2].load(std::memory_order_relaxed);
+        }
+    };
 
-    void populate_read_lock(ReadLockInfo& read_lock, VersionList::ReadCount& r, ReadLockInfo::Type type)
-    {
-        ++field_for_type(r, type);
-        read_lock.m_type = type;
-        read_lock.m_version = r.version;
-        read_lock.m_top_ref = static_cast<ref_type>(r.current_top);
-        read_lock.m_file_size = static_cast<size_t>(r.filesize);
-    }
+    // The LocalReadCounts indexed like the VersionList. They are allocated in
+    // chunks of doubling size which are never moved, so that an entry can be
+    // found without a lock.
+    class LocalReadCounts {
+    public:
+        ~LocalReadCounts()
+        {
+            for (auto& chunk : m_chunks)
+                delete[] chunk.load(std::memory_order_relaxed);
+        }
+
+        // Returns nullptr if the entry has not been created
+        LocalReadCount* get(uint32_t index) const noexcept
+        {
+            auto [chunk, offset] = locate(index);
+            auto entries = m_chunks[chunk].load(std::memory_order_acquire);
+            return entries ? entries + offset : nullptr;
+        }
+
+        // Must be called with m_local_readers_mutex locked
+        LocalReadCount& get_or_create(uint32_t index)
+        {
+            auto [chunk, offset] = locate(index);
+            auto entries = m_chunks[chunk].load(std::memory_order_relaxed);
+            if (!entries) {
+                entries = new LocalReadCount[s_first_chunk_size << chunk]; // Throws
+                m_chunks[chunk].store(entries, std::memory_order_release);
+            }
+            return entries[offset];
+        }
+
+        // Must be called with m_local_readers_mutex locked
+        template <class F>
+        void for_each(F fn)
+        {
+            for (size_t chunk = 0; chunk < s_num_chunks; ++chunk) {
+                auto entries = m_chunks[chunk].load(std::memory_order_relaxed);
+                if (!entries)
+                    continue;
+                uint32_t first = uint32_t(s_first_chunk_size * ((size_t(1) << chunk) - 1));
+                for (size_t i = 0; i < s_first_chunk_size << chunk; ++i)
+                    fn(first + uint32_t(i), entries[i]);
+            }
+        }
+
+    private:
+        // The size of the VersionList of a new lock file
+        static constexpr size_t s_first_chunk_size = VersionList::init_readers_size;
+        // Enough chunks for any uint32_t index
+        static constexpr size_t s_num_chunks = 28;
+
+        // Chunk `n` holds the entries from s_first_chunk_size * (2^n - 1)
+        static std::pair<size_t, size_t> locate(uint32_t index) noexcept
+        {
+            size_t n = index / s_first_chunk_size + 1;
+            size_t chunk = 0;
+            while (n >>= 1)
+                ++chunk;
+            return {chunk, index - s_first_chunk_size * ((size_t(1) << chunk) - 1)};
+        }
+
+        std::atomic<LocalReadCount*> m_chunks[s_num_chunks] = {};
+    };
 
     bool try_grab_local_read_lock(ReadLockInfo& read_lock, ReadLockInfo::Type type, VersionID version_id)
         REQUIRES(!m_local_readers_mutex, !m_info_mutex)
     {
         const bool pick_specific = version_id.version != VersionID().version;
-        auto index = version_id.index;
-        if (!pick_specific) {
-            util::CheckedLockGuard lock(m_info_mutex);
-            index = m_info->readers.newest.load();
-        }
-        util::CheckedLockGuard local_lock(m_local_readers_mutex);
-        if (index >= m_local_readers.size())
-            return false;
-
-        auto& r = m_local_readers[index];
-        if (!r.is_active())
-            return false;
-        if (pick_specific && r.version != version_id.version)
+        auto index = pick_specific ? uint32_t(version_id.index) : m_newest.load();
+        if (index == VersionList::nil)
             return false;
-        if (field_for_type(r, type) == 0)
+        auto r = m_local_readers.get(index);
+        if (!r)
             return false;
 
+        // Only a lock already held by this process can be shared without a lock
+        auto& count = r->counts[type];
+        auto c = count.load(std::memory_order_relaxed);
+        do {
+            if (c == 0)
+                return false;
+        } while (!count.compare_exchange_weak(c, c + 1, std::memory_order_acquire, std::memory_order_relaxed));
+
+        // The entry may have been reused for another version before the count
+        // was incremented, but cannot change while the count is held.
         read_lock.m_reader_idx = index;
-        populate_read_lock(read_lock, r, type);
+        read_lock.m_type = type;
+        read_lock.m_version = r->version.load(std::memory_order_relaxed);
+        read_lock.m_top_ref = static_cast<ref_type>(r->current_top);
+        read_lock.m_file_size = static_cast<size_t>(r->filesize);
+        if (pick_specific && read_lock.m_version != version_id.version) {
+            release_read_lock(read_lock);
+            return false;
+        }
         return true;
     }
 
@@ -749,8 +870,9 @@ private:
 
 protected:
     util::InterprocessMutex& m_mutex;
+    const std::atomic<uint32_t>& m_newest;
     util::CheckedMutex m_local_readers_mutex;
-    std::vector<VersionList::ReadCount> m_local_readers GUARDED_BY(m_local_readers_mutex);
+    LocalReadCounts m_local_readers;
 
     util::CheckedMutex m_info_mutex;
     unsigned int m_local_max_entry GUARDED_BY(m_info_mutex) = 0;
@@ -763,8 +885,8 @@ protected:
 
 class DB::FileVersionManager final : public DB::VersionManager {
 public:
-    FileVersionManager(File& file, util::InterprocessMutex& mutex)
-        : VersionManager(mutex)
+    FileVersionManager(File& file, util::InterprocessMutex& mutex, const SharedInfo& info)
+        : VersionManager(mutex, info.readers.newest)
         , m_file(file)
     {
         size_t size = 0, required_size = sizeof(SharedInfo);
@@ -860,7 +982,7 @@ private:
 class DB::InMemoryVersionManager final : public DB::VersionManager {
 public:
     InMemoryVersionManager(SharedInfo* info, util::InterprocessMutex& mutex)
-        : VersionManager(mutex)
+        : VersionManager(mutex, info->readers.newest)
     {
         m_info = info;
         m_local_max_entry = m_info->readers.capacity();
@@ -1133,7 +1255,7 @@ void DB::open(const std::string& path, bool no_create_file, const DBOptions& opt
         // - Waiting for and signalling database changes
         {
             std::lock_guard<InterprocessMutex> lock(m_controlmutex); // Throws
-            auto version_manager = std::make_unique<FileVersionManager>(m_file, m_versionlist_mutex);
+            auto version_manager = std::make_unique<FileVersionManager>(m_file, m_versionlist_mutex, *info);
 
             // proceed to initialize versioning and other metadata information related to
             // the database. Also create the database if we're beginning a new session
@@ -1655,9 +1777,13 @@ bool DB::compact(bool bump_version_number, util::Optional<const char*> output_en
 
         // local lock blocking any transaction from starting (and stopping)
         CheckedLockGuard local_lock(m_mutex);
+        block_lock_free_read_locks();
+        auto unblock_guard = make_scope_exit([&]() noexcept NO_THREAD_SAFETY_ANALYSIS {
+            unblock_lock_free_read_locks();
+        });
 
         // We should be the only transaction active - otherwise back out
-        if (m_transaction_count != 1)
+        if (get_transaction_count() != 1)
             return false;
 
         // group::write() will throw if the file already exists.
@@ -1779,13 +1905,26 @@ size_t DB::get_allocated_size() const
 void DB::release_all_read_locks() noexcept
 {
     REALM_ASSERT(!m_fake_read_lock_if_immutable);
-    CheckedLockGuard local_lock(m_mutex); // mx on m_local_locks_held
-    for (auto& read_lock : m_local_locks_held) {
-        --m_transaction_count;
-        m_version_manager->release_read_lock(read_lock);
+    CheckedLockGuard local_lock(m_mutex);
+    // The DB is being closed, so the read locks are never unblocked
+    block_lock_free_read_locks();
+    m_version_manager->release_all_read_locks();
+    m_read_lock_state.fetch_and(s_read_locks_blocked, std::memory_order_release);
+    m_read_locks_released = true;
+}
+
+void DB::block_lock_free_read_locks() noexcept
+{
+    auto state = m_read_lock_state.fetch_or(s_read_locks_blocked, std::memory_order_acq_rel);
+    while ((state & ~(s_read_locks_blocked | s_read_lock_count_mask)) != 0) {
+        std::this_thread::yield();
+        state = m_read_lock_state.load(std::memory_order_acquire);
     }
-    m_local_locks_held.clear();
-    REALM_ASSERT(m_transaction_count == 0);
+}
+
+void DB::unblock_lock_free_read_locks() noexcept
+{
+    m_read_lock_state.fetch_and(~s_read_locks_blocked, std::memory_order_release);
 }
 
 class DB::AsyncCommitHelper {
@@ -1949,6 +2088,79 @@ private:
     }
 };
 
+// Collects the metrics of a DB opened with DBOptions::enable_metrics. The
+// metrics are recorded by several threads without any lock, so every counter
+// is a relaxed atomic, and a snapshot is not guaranteed to be consistent
+// across counters.
+class DB::MetricsCollector {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    class Histogram {
+    public:
+        void add(Clock::duration duration) noexcept
+        {
+            auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration);
+            m_buckets[LatencyHistogram::bucket_of(ns)].fetch_add(1, std::memory_order_relaxed);
+            m_count.fetch_add(1, std::memory_order_relaxed);
+            m_total.fetch_add(ns.count(), std::memory_order_relaxed);
+            int64_t max = m_max.load(std::memory_order_relaxed);
+            while (ns.count() > max && !m_max.compare_exchange_weak(max, ns.count(), std::memory_order_relaxed))
+                ;
+        }
+
+        void add_since(Clock::time_point start) noexcept
+        {
+            add(Clock::now() - start);
+        }
+
+        LatencyHistogram snapshot() const noexcept
+        {
+            LatencyHistogram result;
+            result.count = m_count.load(std::memory_order_relaxed);
+            result.total = std::chrono::nanoseconds(m_total.load(std::memory_order_relaxed));
+            result.max = std::chrono::nanoseconds(m_max.load(std::memory_order_relaxed));
+            for (size_t i = 0; i < LatencyHistogram::num_buckets; ++i)
+                result.buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+            return result;
+        }
+
+    private:
+        std::atomic<uint64_t> m_count{0};
+        std::atomic<int64_t> m_total{0};
+        std::atomic<int64_t> m_max{0};
+        std::array<std::atomic<uint64_t>, LatencyHistogram::num_buckets> m_buckets = {};
+    };
+
+    Histogram write_lock_wait;
+    Histogram read_lock;
+    Histogram write_group;
+    Histogram free_space_search;
+    Histogram sync;
+    std::atomic<uint64_t> bytes_written{0};
+    std::atomic<uint64_t> live_versions{0};
+
+    DBMetrics snapshot() const noexcept
+    {
+        DBMetrics result;
+        result.write_lock_wait = write_lock_wait.snapshot();
+        result.read_lock = read_lock.snapshot();
+        result.write_group = write_group.snapshot();
+        result.free_space_search = free_space_search.snapshot();
+        result.sync = sync.snapshot();
+        result.bytes_written = bytes_written.load(std::memory_order_relaxed);
+        result.live_versions = live_versions.load(std::memory_order_relaxed);
+        return result;
+    }
+};
+
+DBMetrics DB::get_metrics() const
+{
+    if (m_metrics)
+        return m_metrics->snapshot();
+    return {};
+}
+
 DB::~DB() noexcept
 {
     close();
@@ -1965,11 +2177,8 @@ void DB::close(bool allow_open_read_transactions)
     if (m_fake_read_lock_if_immutable) {
         if (!is_attached())
             return;
-        {
-            CheckedLockGuard local_lock(m_mutex);
-            if (!allow_open_read_transactions && m_transaction_count)
-                throw WrongTransactionState("Closing with open read transactions");
-        }
+        if (!allow_open_read_transactions && get_transaction_count())
+            throw WrongTransactionState("Closing with open read transactions");
         if (m_alloc.is_attached())
             m_alloc.detach();
         m_fake_read_lock_if_immutable.reset();
@@ -1989,7 +2198,7 @@ void DB::close_internal(std::unique_lock<InterprocessMutex> lock, bool allow_ope
         CheckedLockGuard local_lock(m_mutex);
         if (m_write_transaction_open)
             throw WrongTransactionState("Closing with open write transactions");
-        if (!allow_open_read_transactions && m_transaction_count)
+        if (!allow_open_read_transactions && get_transaction_count())
             throw WrongTransactionState("Closing with open read transactions");
     }
     SharedInfo* info = m_info;
@@ -2297,60 +2506,67 @@ void DB::release_read_lock(ReadLockInfo& read_lock) noexcept
     // ignore if opened with immutable file (then we have no lockfile)
     if (m_fake_read_lock_if_immutable)
         return;
-    CheckedLockGuard lock(m_mutex); // mx on m_local_locks_held
-    do_release_read_lock(read_lock);
+    if (m_read_lock_state.fetch_add(s_read_lock_in_progress, std::memory_order_acquire) & s_read_locks_blocked) {
+        m_read_lock_state.fetch_sub(s_read_lock_in_progress, std::memory_order_relaxed);
+        CheckedLockGuard lock(m_mutex);
+        do_release_read_lock(read_lock);
+        return;
+    }
+    m_version_manager->release_read_lock(read_lock);
+    m_read_lock_state.fetch_sub(s_read_lock_in_progress + 1, std::memory_order_release);
 }
 
 // this is called with m_mutex locked
 void DB::do_release_read_lock(ReadLockInfo& read_lock) noexcept
 {
     REALM_ASSERT(!m_fake_read_lock_if_immutable);
-    bool found_match = false;
-    // simple linear search and move-last-over if a match is found.
-    // common case should have only a modest number of transactions in play..
-    for (size_t j = 0; j < m_local_locks_held.size(); ++j) {
-        if (m_local_locks_held[j].m_version == read_lock.m_version) {
-            m_local_locks_held[j] = m_local_locks_held.back();
-            m_local_locks_held.pop_back();
-            found_match = true;
-            break;
-        }
-    }
-    if (!found_match) {
-        REALM_ASSERT(!is_attached());
+    if (m_read_locks_released) {
         // it's OK, someone called close() and all locks where released
         return;
     }
-    --m_transaction_count;
     m_version_manager->release_read_lock(read_lock);
+    m_read_lock_state.fetch_sub(1, std::memory_order_release);
 }
 
 
 DB::ReadLockInfo DB::grab_read_lock(ReadLockInfo::Type type, VersionID version_id)
 {
-    CheckedLockGuard lock(m_mutex); // mx on m_local_locks_held
-    REALM_ASSERT_RELEASE(is_attached());
-    auto read_lock = m_version_manager->grab_read_lock(type, version_id);
-
-    m_local_locks_held.emplace_back(read_lock);
-    ++m_transaction_count;
+    MetricsCollector::Clock::time_point start;
+    if (m_metrics)
+        start = MetricsCollector::Clock::now();
+    ReadLockInfo read_lock;
+    // The lock is counted while it is being grabbed, so that compact() and
+    // close() can wait for it without blocking other readers
+    if (m_read_lock_state.fetch_add(s_read_lock_in_progress + 1, std::memory_order_acquire) & s_read_locks_blocked) {
+        m_read_lock_state.fetch_sub(s_read_lock_in_progress + 1, std::memory_order_relaxed);
+        CheckedLockGuard lock(m_mutex);
+        REALM_ASSERT_RELEASE(is_attached() && !m_read_locks_released);
+        read_lock = m_version_manager->grab_read_lock(type, version_id); // Throws
+        m_read_lock_state.fetch_add(1, std::memory_order_relaxed);
+    }
+    else {
+        try {
+            read_lock = m_version_manager->grab_read_lock(type, version_id); // Throws
+        }
+        catch (...) {
+            m_read_lock_state.fetch_sub(s_read_lock_in_progress + 1, std::memory_order_release);
+            throw;
+        }
+        m_read_lock_state.fetch_sub(s_read_lock_in_progress, std::memory_order_release);
+    }
     REALM_ASSERT(read_lock.m_file_size > read_lock.m_top_ref);
+    if (m_metrics)
+        m_metrics->read_lock.add_since(start);
     return read_lock;
 }
 
 void DB::leak_read_lock(ReadLockInfo& read_lock) noexcept
 {
-    CheckedLockGuard lock(m_mutex); // mx on m_local_locks_held
-    // simple linear search and move-last-over if a match is found.
-    // common case should have only a modest number of transactions in play..
-    for (size_t j = 0; j < m_local_locks_held.size(); ++j) {
-        if (m_local_locks_held[j].m_version == read_lock.m_version) {
-            m_local_locks_held[j] = m_local_locks_held.back();
-            m_local_locks_held.pop_back();
-            --m_transaction_count;
-            return;
-        }
-    }
+    CheckedLockGuard lock(m_mutex);
+    if (m_read_locks_released)
+        return;
+    m_version_manager->leak_read_lock(read_lock);
+    m_read_lock_state.fetch_sub(1, std::memory_order_release);
 }
 
 bool DB::do_try_begin_write()
@@ -2372,6 +2588,9 @@ void DB::do_begin_write()
     }
 
     SharedInfo* info = m_info;
+    MetricsCollector::Clock::time_point start;
+    if (m_metrics)
+        start = MetricsCollector::Clock::now();
 
     // Get write lock - the write lock is held until do_end_write().
     //
@@ -2429,6 +2648,8 @@ void DB::do_begin_write()
     // should take this situation into account by comparing with '>' instead of '!='
     info->next_served = my_ticket;
     finish_begin_write();
+    if (m_metrics)
+        m_metrics->write_lock_wait.add_since(start);
     if (m_logger) {
         m_logger->log(util::LogCategory::transaction, util::Logger::Level::trace, "writemutex acquired");
     }
@@ -2545,6 +2766,7 @@ void DB::low_level_commit(uint_fast64_t new_version, Transaction& transaction, b
 
     GroupWriter out(transaction, Durability(info->durability), m_marker_observer.get()); // Throws
     out.set_versions(new_version, top_refs, any_new_unreachables);
+    out.set_measure_free_space_search(bool(m_metrics));
     out.prepare_evacuation();
     auto t1 = std::chrono::steady_clock::now();
     auto commit_size = m_alloc.get_commit_size();
@@ -2564,7 +2786,15 @@ void DB::low_level_commit(uint_fast64_t new_version, Transaction& transaction, b
     {
         // protect against race with any other DB trying to attach to the file
         std::lock_guard<InterprocessMutex> lock(m_controlmutex); // Throws
-        new_top_ref = out.write_group();                         // Throws
+        MetricsCollector::Clock::time_point write_start;
+        if (m_metrics)
+            write_start = MetricsCollector::Clock::now();
+        new_top_ref = out.write_group(); // Throws
+        if (m_metrics) {
+            m_metrics->write_group.add_since(write_start);
+            m_metrics->free_space_search.add(out.get_free_space_search_time());
+            m_metrics->bytes_written.fetch_add(out.get_bytes_written(), std::memory_order_relaxed);
+        }
     }
     {
         // protect access to shared variables and m_reader_mapping from here
@@ -2573,6 +2803,9 @@ void DB::low_level_commit(uint_fast64_t new_version, Transaction& transaction, b
         m_locked_space = out.get_locked_space_size();
         m_used_space = out.get_logical_size() - m_free_space;
         m_evac_stage.store(EvacStage(out.get_evacuation_stage()));
+        MetricsCollector::Clock::time_point sync_start;
+        if (m_metrics)
+            sync_start = MetricsCollector::Clock::now();
         out.sync_according_to_durability();
         if (Durability(info->durability) == Durability::Full || Durability(info->durability) == Durability::Unsafe) {
             if (commit_to_disk) {
@@ -2580,6 +2813,8 @@ void DB::low_level_commit(uint_fast64_t new_version, Transaction& transaction, b
                 cm.commit(new_top_ref);
             }
         }
+        if (m_metrics)
+            m_metrics->sync.add_since(sync_start);
         size_t new_file_size = out.get_logical_size();
         // We must reset the allocators free space tracking before communicating the new
         // version through the ring buffer. If not, a reader may start updating the allocators
@@ -2607,6 +2842,8 @@ void DB::low_level_commit(uint_fast64_t new_version, Transaction& transaction, b
 
         info->number_of_versions = live_versions + 1;
         info->latest_version_number = new_version;
+        if (m_metrics)
+            m_metrics->live_versions.store(live_versions + 1, std::memory_order_relaxed);
 
         m_new_commit_available.notify_all();
     }
@@ -2801,11 +3038,15 @@ void DB::async_request_write_mutex(TransactionRef& tr, util::UniqueFunction<void
 
 inline DB::DB(Private, const DBOptions& options)
     : m_upgrade_callback(std::move(options.upgrade_callback))
+    , m_commit_encodings{options.encode_integer_leaves, options.enumerate_string_columns}
     , m_log_id(util::gen_log_id(this))
 {
     if (options.enable_async_writes) {
         m_commit_helper = std::make_unique<AsyncCommitHelper>(this);
     }
+    if (options.enable_metrics) {
+        m_metrics = std::make_unique<MetricsCollector>();
+    }
 }
 
 DBRef DB::create(const std::string& file, bool no_create, const DBOptions& options) NO_THREAD_SAFETY_ANALYSIS
@@ -19,6 +19,7 @@
 #ifndef REALM_DB_HPP
 #define REALM_DB_HPP
 
+#include <realm/db_metrics.hpp>
 #include <realm/db_options.hpp>
 #include <realm/group.hpp>
 #include <realm/handover_defs.hpp>
@@ -306,6 +307,13 @@ public:
     /// a read transaction will not immediately release any versions.
     uint_fast64_t get_number_of_versions();
 
+    /// Get a snapshot of the metrics collected since this DB was opened. The
+    /// metrics are only collected if DBOptions::enable_metrics was set, and
+    /// are all zero otherwise. The histograms are updated independently of
+    /// each other, so a snapshot taken during a commit may include only some
+    /// of the metrics of that commit.
+    DBMetrics get_metrics() const;
+
     /// Get the size of the currently allocated slab area
     size_t get_allocated_size() const;
 
@@ -453,6 +461,7 @@ public:
 
 private:
     class AsyncCommitHelper;
+    class MetricsCollector;
     class VersionManager;
     class EncryptionMarkerObserver;
     class FileVersionManager;
@@ -485,7 +494,15 @@ private:
 
     // Member variables
     util::CheckedMutex m_mutex;
-    int m_transaction_count GUARDED_BY(m_mutex) = 0;
+    // The number of read locks held through this DB in the low 32 bits, and
+    // the number of read locks being grabbed or released without m_mutex in the
+    // next 31 bits. The top bit is set while compact() or close() requires read
+    // locks to be grabbed and released with m_mutex held.
+    std::atomic<uint64_t> m_read_lock_state{0};
+    static constexpr uint64_t s_read_lock_count_mask = 0xffffffff;
+    static constexpr uint64_t s_read_lock_in_progress = uint64_t(1) << 32;
+    static constexpr uint64_t s_read_locks_blocked = uint64_t(1) << 63;
+    bool m_read_locks_released GUARDED_BY(m_mutex) = false; // by close()
     SlabAlloc m_alloc;
     std::unique_ptr<Replication> m_history;
     std::unique_ptr<VersionManager> m_version_manager;
@@ -494,7 +511,6 @@ private:
     size_t m_free_space GUARDED_BY(m_mutex) = 0;
     size_t m_locked_space GUARDED_BY(m_mutex) = 0;
     size_t m_used_space GUARDED_BY(m_mutex) = 0;
-    std::vector<ReadLockInfo> m_local_locks_held GUARDED_BY(m_mutex); // tracks all read locks held by this DB
     std::atomic<EvacStage> m_evac_stage = EvacStage::idle;
     util::File m_file;
     util::File::Map<SharedInfo> m_file_map; // Never remapped, provides access to everything but the ringbuffer
@@ -516,6 +532,8 @@ private:
     std::mutex m_commit_listener_mutex;
     std::vector<CommitListener*> m_commit_listeners;
     bool m_is_sync_agent = false;
+    CommitEncodings m_commit_encodings;
+    std::unique_ptr<MetricsCollector> m_metrics; // Null unless DBOptions::enable_metrics is set
     // Id for this DB to be used in logging. We will just use some bits from the pointer.
     // The path cannot be used as this would not allow us to distinguish between two DBs opening
     // the same realm.
@@ -599,6 +617,16 @@ private:
     // release_read_lock for locks already released must be avoided.
     void release_all_read_locks() noexcept REQUIRES(!m_mutex);
 
+    // Number of read locks held through this DB
+    int get_transaction_count() const noexcept
+    {
+        return int(m_read_lock_state.load(std::memory_order_acquire) & s_read_lock_count_mask);
+    }
+    // Make read locks be grabbed and released with m_mutex held, and wait for
+    // those being grabbed or released without it.
+    void block_lock_free_read_locks() noexcept REQUIRES(m_mutex);
+    void unblock_lock_free_read_locks() noexcept REQUIRES(m_mutex);
+
     /// return true if write transaction can commence, false otherwise.
     bool do_try_begin_write() REQUIRES(!m_mutex);
     void do_begin_write() REQUIRES(!m_mutex);
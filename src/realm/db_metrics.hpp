@@ -0,0 +1,97 @@
+/*************************************************************************
+ *
+ * Copyright 2024 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+#ifndef REALM_DB_METRICS_HPP
+#define REALM_DB_METRICS_HPP
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace realm {
+
+/// The distribution of the durations of an operation.
+///
+/// Durations are counted in buckets of exponentially growing size: bucket 0
+/// holds the durations below 1 microsecond, bucket i (0 < i < num_buckets - 1)
+/// those of at least 2^(i-1) and below 2^i microseconds, and the last bucket
+/// all longer durations.
+struct LatencyHistogram {
+    static constexpr size_t num_buckets = 24;
+
+    uint64_t count = 0;
+    std::chrono::nanoseconds total{0};
+    std::chrono::nanoseconds max{0};
+    std::array<uint64_t, num_buckets> buckets = {};
+
+    std::chrono::nanoseconds average() const noexcept
+    {
+        return count ? total / int64_t(count) : std::chrono::nanoseconds(0);
+    }
+
+    /// The bucket counting the given duration
+    static size_t bucket_of(std::chrono::nanoseconds duration) noexcept
+    {
+        uint64_t us = uint64_t(duration.count() > 0 ? duration.count() : 0) / 1000;
+        size_t ndx = 0;
+        while (us != 0 && ndx < num_buckets - 1) {
+            us >>= 1;
+            ++ndx;
+        }
+        return ndx;
+    }
+
+    /// The smallest duration not counted in the bucket, or
+    /// std::chrono::nanoseconds::max() for the last one
+    static std::chrono::nanoseconds bucket_limit(size_t ndx) noexcept
+    {
+        if (ndx >= num_buckets - 1)
+            return std::chrono::nanoseconds::max();
+        return std::chrono::microseconds(uint64_t(1) << ndx);
+    }
+};
+
+/// A snapshot of the metrics collected by a DB opened with
+/// DBOptions::enable_metrics set. The metrics cover the transactions made
+/// through that DB object since it was opened, not those made by other DB
+/// objects or processes accessing the same file.
+struct DBMetrics {
+    /// Time spent waiting for the write lock when beginning a write transaction
+    LatencyHistogram write_lock_wait;
+    /// Time spent acquiring a read lock (a version to read) for a transaction
+    LatencyHistogram read_lock;
+    /// Time spent by each commit writing the modified arrays and the free lists
+    LatencyHistogram write_group;
+    /// Time spent by each commit finding free space for the arrays it writes,
+    /// including extending the file when no free space is large enough
+    LatencyHistogram free_space_search;
+    /// Time spent by each commit flushing the file and writing the new top ref,
+    /// as required by the durability. The flush made in the background for an
+    /// asynchronous commit is not included.
+    LatencyHistogram sync;
+
+    /// Number of bytes written to the file by commits
+    uint64_t bytes_written = 0;
+    /// Number of versions kept in the file at the latest commit
+    uint64_t live_versions = 0;
+};
+
+} // namespace realm
+
+#endif // REALM_DB_METRICS_HPP
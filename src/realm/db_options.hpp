@@ -99,6 +99,29 @@ struct DBOptions {
     /// a performance impact.
     bool enable_async_writes = false;
 
+    /// If set to true, integer leaves modified by a write transaction are
+    /// stored using a frame-of-reference encoding (a common base plus narrow
+    /// offsets) when that takes up less space. This benefits columns holding
+    /// large values that are close to each other, like timestamps or
+    /// increasing identifiers. The encoding is part of file format version 25,
+    /// so files written with this option enabled cannot be opened by versions
+    /// of Realm which predate it.
+    bool encode_integer_leaves = false;
+
+    /// If set to true, string columns of larger tables which hold only a
+    /// small number of distinct values are converted to enumerated
+    /// (dictionary encoded) storage when a write transaction is committed.
+    /// Every value is then stored as an index into a list of the distinct
+    /// strings of the column, and equality queries compare indexes instead
+    /// of string contents.
+    bool enumerate_string_columns = false;
+
+    /// If set to true, the DB collects latency histograms and counters for
+    /// its transactions and commits, available through DB::get_metrics().
+    /// When not set, the only cost is a check of a pointer at each place
+    /// where a metric would be recorded.
+    bool enable_metrics = false;
+
     /// sys_tmp_dir will be used if the temp_dir is empty when creating DBOptions.
     /// It must be writable and allowed to create pipe/fifo file on it.
     /// set_sys_tmp_dir is not a thread-safe call and it is only supposed to be called once
@@ -185,6 +185,12 @@ protected:
             case 2:
                 num_bytes = size;
                 break;
+            case 3: {
+                // Bit packed offsets followed by a 64 bit base
+                unsigned num_bits = size * width;
+                num_bytes = ((((num_bits + 7) >> 3) + 7) & ~7u) + 8;
+                break;
+            }
         }
 
         // Ensure 8-byte alignment
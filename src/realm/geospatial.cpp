@@ -37,6 +37,7 @@
 #include <s2/s2cap.h>
 #include <s2/s2latlng.h>
 #include <s2/s2polygon.h>
+#include <s2/s2regioncoverer.h>
 
 #ifdef _WIN32
 #pragma warning(pop)
@@ -557,4 +558,42 @@ Status GeoRegion::get_conversion_status() const noexcept
     return m_status;
 }
 
+std::vector<std::pair<uint64_t, uint64_t>> GeoRegion::get_cell_ranges() const
+{
+    std::vector<std::pair<uint64_t, uint64_t>> ranges;
+    if (!m_status.is_ok()) {
+        return ranges;
+    }
+
+    // More cells fit the region more tightly, at the cost of more range lookups
+    S2RegionCoverer coverer;
+    coverer.set_max_cells(16);
+    std::vector<S2CellId> cells;
+    coverer.GetCovering(*m_region, &cells);
+    std::sort(cells.begin(), cells.end());
+
+    for (auto& cell : cells) {
+        uint64_t first = cell.range_min().id();
+        uint64_t last = cell.range_max().id();
+        if (!ranges.empty() && first <= ranges.back().second + 2) {
+            // Leaf cell ids are odd, so adjacent ranges are 2 apart
+            ranges.back().second = std::max(ranges.back().second, last);
+        }
+        else {
+            ranges.emplace_back(first, last);
+        }
+    }
+    return ranges;
+}
+
+std::optional<uint64_t> GeoRegion::get_cell_id(const GeoPoint& geo_point) noexcept
+{
+    // Must match the conversion done by contains()
+    auto point = S2LatLng::FromDegrees(geo_point.latitude, geo_point.longitude);
+    if (!point.is_valid()) {
+        return {};
+    }
+    return S2CellId::FromLatLng(point).id();
+}
+
 } // namespace realm
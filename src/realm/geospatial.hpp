@@ -139,6 +139,12 @@ public:
     bool contains(const std::optional<GeoPoint>& point) const noexcept;
     Status get_conversion_status() const noexcept;
 
+    // The ranges [first, last] of S2 leaf cell ids covered by a set of cells containing the
+    // region, sorted and not overlapping. Empty if the region is not valid.
+    std::vector<std::pair<uint64_t, uint64_t>> get_cell_ranges() const;
+    // The id of the S2 leaf cell holding the point, if the point is valid
+    static std::optional<uint64_t> get_cell_id(const GeoPoint& point) noexcept;
+
 private:
     std::unique_ptr<S2Region> m_region;
     Status m_status;
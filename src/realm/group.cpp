@@ -324,13 +324,11 @@ int Group::get_target_file_format_version_for_session(int current_file_format_ve
     // Please see Group::get_file_format_version() for information about the
     // individual file format versions.
 
-    if (requested_history_type == Replication::hist_None) {
-        if (current_file_format_version == 24) {
-            // We are able to open these file formats in RO mode
-            return current_file_format_version;
-        }
-    }
-
+    // Files of version 24 are opened in read-only mode without an upgrade (see
+    // Group::read_only_version_check()), but are upgraded by any session
+    // which may write to them, so that structures introduced by version 25 are
+    // never added to a file which older versions accept.
+    static_cast<void>(requested_history_type);
     return g_current_file_format_version;
 }
 
@@ -419,6 +417,7 @@ int Group::read_only_version_check(SlabAlloc& alloc, ref_type top_ref, const std
         case 0:
             file_format_ok = (top_ref == 0);
             break;
+        case 24:
         case g_current_file_format_version:
             file_format_ok = true;
             break;
@@ -442,11 +441,12 @@ void Group::open(ref_type top_ref, const std::string& file_path)
     if (m_file_format_version == 0) {
         set_file_format_version(target_file_format_version);
     }
-    else {
-        // From a technical point of view, we could upgrade the Realm file
-        // format in memory here, but since upgrading can be expensive, it is
-        // currently disallowed.
-        REALM_ASSERT(target_file_format_version == m_file_format_version);
+    else if (m_file_format_version != target_file_format_version) {
+        // Version 24 is read without any conversion. As the group may gain
+        // structures of the current version in memory, it is written out as a
+        // file of that version (see Group::write()).
+        REALM_ASSERT(m_file_format_version == 24);
+        set_file_format_version(target_file_format_version);
     }
 
     // Make all dynamically allocated memory (space beyond the attached file) as
@@ -1282,11 +1282,11 @@ void Group::update_allocator_wrappers(bool writable)
     }
 }
 
-void Group::flush_accessors_for_commit()
+void Group::flush_accessors_for_commit(const CommitEncodings& encodings)
 {
     for (auto& acc : m_table_accessors)
         if (acc)
-            acc->flush_for_commit();
+            acc->flush_for_commit(encodings);
 }
 
 void Group::refresh_dirty_accessors()
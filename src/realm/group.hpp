@@ -679,7 +679,7 @@ private:
     /// calling advance_transact()
     void advance_transact(ref_type new_top_ref, util::InputStream*, bool writable);
     void refresh_dirty_accessors();
-    void flush_accessors_for_commit();
+    void flush_accessors_for_commit(const CommitEncodings& encodings = {});
 
     /// \brief The version of the format of the node structure (in file or in
     /// memory) in use by Realm objects associated with this group.
@@ -763,6 +763,18 @@ private:
     ///     Backlinks in BPlusTree
     ///     Sort order of Strings changed (affects sets and the string index)
     ///
+    ///  25 Integer leaves with frame-of-reference encoding (wtype_Offset).
+    ///     Ordered search indexes (col_attr_Ordered_Indexed).
+    ///     Composite indexes (slot 14 of the table top array).
+    ///     Hash indexes on primary keys (col_attr_Hash_Indexed).
+    ///     Geospatial indexes (col_attr_Geo_Indexed).
+    ///     Fulltext indexes holding posting lists (col_attr_FullText_Postings).
+    ///     Value ranges of the numeric columns in each cluster (following the
+    ///     columns if the context flag of the cluster is set).
+    ///     Version 24 is a subset of this format, so version 24 files are
+    ///     upgraded by only computing the value ranges, and can be opened in
+    ///     read-only mode without an upgrade.
+    ///
     /// IMPORTANT: When introducing a new file format version, be sure to review
     /// the file validity checks in Group::open() and DB::do_open, the file
     /// format selection logic in
@@ -770,7 +782,7 @@ private:
     /// upgrade logic in Group::upgrade_file_format(), AND the lists of accepted
     /// file formats and the version deletion list residing in "backup_restore.cpp"
 
-    static constexpr int g_current_file_format_version = 24;
+    static constexpr int g_current_file_format_version = 25;
 
     int get_file_format_version() const noexcept;
     void set_file_format_version(int) noexcept;
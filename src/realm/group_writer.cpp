@@ -1144,7 +1144,16 @@ size_t GroupWriter::get_free_space(size_t size)
 {
     REALM_ASSERT_3(size % 8, ==, 0); // 8-byte alignment
 
-    auto p = reserve_free_space(size);
+    FreeListElement p;
+    if (m_measure_free_space_search) {
+        auto start = std::chrono::steady_clock::now();
+        p = reserve_free_space(size);
+        m_free_space_search_time += std::chrono::steady_clock::now() - start;
+    }
+    else {
+        p = reserve_free_space(size);
+    }
+    m_bytes_written += size;
 
     // Claim space from identified chunk
     size_t chunk_pos = p->second;
@@ -1368,6 +1377,7 @@ void GroupWriter::write_array_at(T* translator, ref_type ref, const char* data,
     uint32_t dummy_checksum = 0x41414141UL; // "AAAA" in ASCII
     memcpy(dest_addr, &dummy_checksum, 4);
     memcpy(dest_addr + 4, data + 4, size - 4);
+    m_bytes_written += size;
 }
 
 
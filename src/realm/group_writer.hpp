@@ -19,6 +19,7 @@
 #ifndef REALM_GROUP_WRITER_HPP
 #define REALM_GROUP_WRITER_HPP
 
+#include <chrono>
 #include <cstdint> // unint8_t etc
 #include <utility>
 #include <map>
@@ -195,6 +196,24 @@ public:
     }
     void sync_according_to_durability();
 
+    /// Measure the time spent finding free space for the written arrays. This
+    /// is off by default, as it reads the clock for every array written.
+    void set_measure_free_space_search(bool value) noexcept
+    {
+        m_measure_free_space_search = value;
+    }
+
+    std::chrono::nanoseconds get_free_space_search_time() const noexcept
+    {
+        return m_free_space_search_time;
+    }
+
+    /// Number of bytes written to the file by write_group()
+    uint64_t get_bytes_written() const noexcept
+    {
+        return m_bytes_written;
+    }
+
 private:
     friend class InMemoryWriter;
     struct FreeSpaceEntry {
@@ -229,6 +248,9 @@ private:
     size_t m_evacuation_limit;
     int64_t m_backoff;
     size_t m_logical_size = 0;
+    bool m_measure_free_space_search = false;
+    std::chrono::nanoseconds m_free_space_search_time{0};
+    uint64_t m_bytes_written = 0;
 
     //  m_free_in_file;
     std::vector<FreeSpaceEntry> m_not_free_in_file;
@@ -0,0 +1,265 @@
+/*************************************************************************
+ *
+ * Copyright 2023 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+#include <realm/index_composite.hpp>
+#include <realm/array_mixed.hpp>
+#include <realm/bplustree.hpp>
+
+#include <algorithm>
+
+using namespace realm;
+
+namespace {
+constexpr size_t s_col_keys_ndx = 0;
+constexpr size_t s_keys_ndx = 1;
+constexpr size_t s_first_values_ndx = 2;
+} // namespace
+
+// Accessors for the trees of the index, created on demand for each operation
+class CompositeIndex::Entries {
+public:
+    Entries(const Array& top, size_t num_columns)
+        : keys(top.get_alloc())
+    {
+        // The parent is only used to propagate changes of the root refs, which
+        // never happens through a const index.
+        auto parent = const_cast<Array*>(&top);
+        keys.set_parent(parent, s_keys_ndx);
+        keys.init_from_parent();
+        for (size_t i = 0; i < num_columns; ++i) {
+            auto& tree = values.emplace_back(std::make_unique<BPlusTree<Mixed>>(top.get_alloc()));
+            tree->set_parent(parent, s_first_values_ndx + i);
+            tree->init_from_parent();
+        }
+    }
+
+    size_t size() const
+    {
+        return keys.size();
+    }
+
+    // Compare the values of the entry at `ndx` with the first `values.size()` columns
+    int compare(size_t ndx, const std::vector<Mixed>& prefix) const
+    {
+        for (size_t i = 0; i < prefix.size(); ++i) {
+            if (int cmp = values[i]->get(ndx).compare(prefix[i]))
+                return cmp;
+        }
+        return 0;
+    }
+
+    // First position where `pred(position)` is false. `pred` must be true for
+    // a (possibly empty) prefix of the entries.
+    template <class Pred>
+    size_t partition_point(Pred pred) const
+    {
+        size_t lo = 0;
+        size_t hi = size();
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (pred(mid)) {
+                lo = mid + 1;
+            }
+            else {
+                hi = mid;
+            }
+        }
+        return lo;
+    }
+
+    BPlusTree<int64_t> keys;
+    std::vector<std::unique_ptr<BPlusTree<Mixed>>> values;
+};
+
+CompositeIndex::CompositeIndex(Allocator& alloc) noexcept
+    : m_top(alloc)
+{
+}
+
+void CompositeIndex::create(const std::vector<ColKey>& col_keys)
+{
+    REALM_ASSERT(col_keys.size() >= min_columns && col_keys.size() <= max_columns);
+    Allocator& alloc = m_top.get_alloc();
+    m_top.create(Array::type_HasRefs, false, s_first_values_ndx + col_keys.size()); // Throws
+    try {
+        Array cols(alloc);
+        cols.set_parent(&m_top, s_col_keys_ndx);
+        cols.create(Array::type_Normal); // Throws
+        cols.update_parent();            // Throws
+        for (auto col_key : col_keys) {
+            cols.add(col_key.value); // Throws
+        }
+        BPlusTree<int64_t> keys(alloc);
+        keys.set_parent(&m_top, s_keys_ndx);
+        keys.create(); // Throws
+        for (size_t i = 0; i < col_keys.size(); ++i) {
+            BPlusTree<Mixed> values(alloc);
+            values.set_parent(&m_top, s_first_values_ndx + i);
+            values.create(); // Throws
+        }
+    }
+    catch (...) {
+        m_top.destroy_deep();
+        throw;
+    }
+    m_col_keys = col_keys;
+}
+
+void CompositeIndex::init_from_ref(ref_type ref)
+{
+    m_top.init_from_ref(ref);
+    Array cols(m_top.get_alloc());
+    cols.init_from_ref(m_top.get_as_ref(s_col_keys_ndx));
+    m_col_keys.clear();
+    for (size_t i = 0; i < cols.size(); ++i) {
+        m_col_keys.push_back(ColKey(cols.get(i)));
+    }
+}
+
+void CompositeIndex::set_parent(ArrayParent* parent, size_t ndx_in_parent) noexcept
+{
+    m_top.set_parent(parent, ndx_in_parent);
+}
+
+void CompositeIndex::destroy() noexcept
+{
+    m_top.destroy_deep();
+}
+
+bool CompositeIndex::type_supported(ColKey col_key)
+{
+    if (col_key.is_collection())
+        return false;
+    switch (col_key.get_type()) {
+        case col_type_Int:
+        case col_type_Bool:
+        case col_type_String:
+        case col_type_Timestamp:
+        case col_type_ObjectId:
+        case col_type_UUID:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool CompositeIndex::covers(ColKey col_key) const noexcept
+{
+    return std::find(m_col_keys.begin(), m_col_keys.end(), col_key) != m_col_keys.end();
+}
+
+size_t CompositeIndex::find_position(const Entries& entries, const std::vector<Mixed>& values, ObjKey key) const
+{
+    return entries.partition_point([&](size_t ndx) {
+        int cmp = entries.compare(ndx, values);
+        return cmp < 0 || (cmp == 0 && entries.keys.get(ndx) < key.value);
+    });
+}
+
+void CompositeIndex::insert(ObjKey key, const std::vector<Mixed>& values)
+{
+    REALM_ASSERT_3(values.size(), ==, m_col_keys.size());
+    Entries entries(m_top, m_col_keys.size());
+    size_t ndx = find_position(entries, values, key);
+    entries.keys.insert(ndx, key.value);
+    for (size_t i = 0; i < values.size(); ++i) {
+        entries.values[i]->insert(ndx, values[i]);
+    }
+}
+
+void CompositeIndex::erase(ObjKey key, const std::vector<Mixed>& values)
+{
+    REALM_ASSERT_3(values.size(), ==, m_col_keys.size());
+    Entries entries(m_top, m_col_keys.size());
+    size_t ndx = find_position(entries, values, key);
+    REALM_ASSERT_3(ndx, <, entries.size());
+    REALM_ASSERT_3(entries.keys.get(ndx), ==, key.value);
+    entries.keys.erase(ndx);
+    for (auto& tree : entries.values) {
+        tree->erase(ndx);
+    }
+}
+
+void CompositeIndex::clear()
+{
+    Entries entries(m_top, m_col_keys.size());
+    entries.keys.clear();
+    for (auto& tree : entries.values) {
+        tree->clear();
+    }
+}
+
+size_t CompositeIndex::size() const
+{
+    return Entries(m_top, 0).size();
+}
+
+void CompositeIndex::find(const std::vector<Mixed>& prefix, const std::optional<Bound>& lower,
+                          const std::optional<Bound>& upper, std::vector<ObjKey>& result) const
+{
+    REALM_ASSERT(prefix.size() <= m_col_keys.size());
+    REALM_ASSERT((!lower && !upper) || prefix.size() < m_col_keys.size());
+    Entries entries(m_top, m_col_keys.size());
+    const size_t range_col = prefix.size();
+
+    size_t begin = entries.partition_point([&](size_t ndx) {
+        int cmp = entries.compare(ndx, prefix);
+        if (cmp != 0 || !lower)
+            return cmp < 0;
+        int cmp_bound = entries.values[range_col]->get(ndx).compare(lower->value);
+        return cmp_bound < 0 || (cmp_bound == 0 && !lower->inclusive);
+    });
+    size_t end = entries.partition_point([&](size_t ndx) {
+        int cmp = entries.compare(ndx, prefix);
+        if (cmp != 0 || !upper)
+            return cmp <= 0;
+        int cmp_bound = entries.values[range_col]->get(ndx).compare(upper->value);
+        return cmp_bound < 0 || (cmp_bound == 0 && upper->inclusive);
+    });
+
+    if (begin < end) {
+        result.reserve(result.size() + (end - begin));
+        for (size_t ndx = begin; ndx < end; ++ndx) {
+            result.push_back(ObjKey(entries.keys.get(ndx)));
+        }
+    }
+}
+
+void CompositeIndex::verify() const
+{
+#ifdef REALM_DEBUG
+    m_top.verify();
+    REALM_ASSERT(m_top.has_refs());
+    REALM_ASSERT_3(m_top.size(), ==, s_first_values_ndx + m_col_keys.size());
+    Entries entries(m_top, m_col_keys.size());
+    size_t sz = entries.size();
+    for (auto& tree : entries.values) {
+        REALM_ASSERT_3(tree->size(), ==, sz);
+    }
+    std::vector<Mixed> previous(m_col_keys.size());
+    for (size_t ndx = 0; ndx < sz; ++ndx) {
+        if (ndx > 0) {
+            int cmp = entries.compare(ndx, previous);
+            REALM_ASSERT(cmp > 0 || (cmp == 0 && entries.keys.get(ndx - 1) < entries.keys.get(ndx)));
+        }
+        for (size_t i = 0; i < previous.size(); ++i) {
+            previous[i] = entries.values[i]->get(ndx);
+        }
+    }
+#endif
+}
@@ -0,0 +1,106 @@
+/*************************************************************************
+ *
+ * Copyright 2023 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+#ifndef REALM_INDEX_COMPOSITE_HPP
+#define REALM_INDEX_COMPOSITE_HPP
+
+#include <realm/array.hpp>
+#include <realm/keys.hpp>
+#include <realm/mixed.hpp>
+
+#include <optional>
+#include <vector>
+
+/*
+A CompositeIndex covers 2 to 4 columns of a table. It keeps the objects sorted by their values
+of the first column, then by the values of the second column, and so on, so it can find the
+objects having given values for a leading subset of the columns, optionally combined with a
+range of values for the following column.
+
+The index consists of a top array holding:
+
+    [0] column keys: Array of the ColKey values of the covered columns, in index order
+    [1] keys:        BPlusTree<Int>, the ObjKey of the object of each entry
+    [2..n+1]         BPlusTree<Mixed> for each of the n columns, holding the value of the
+                     object at the same position
+
+Entries with equal values are ordered by key. Null is ordered before all other values.
+
+Only non-collection columns of type Int, Bool, String, Timestamp, ObjectId and UUID are supported.
+*/
+
+namespace realm {
+
+class CompositeIndex {
+public:
+    static constexpr size_t min_columns = 2;
+    static constexpr size_t max_columns = 4;
+
+    // Limits the values of the column following the equality prefix in a lookup
+    struct Bound {
+        Mixed value;
+        bool inclusive;
+    };
+
+    CompositeIndex(Allocator& alloc) noexcept;
+
+    // Create a new, empty index for the columns
+    void create(const std::vector<ColKey>& col_keys);
+    // Attach to an existing index
+    void init_from_ref(ref_type ref);
+    void set_parent(ArrayParent* parent, size_t ndx_in_parent) noexcept;
+    void destroy() noexcept;
+    ref_type get_ref() const noexcept
+    {
+        return m_top.get_ref();
+    }
+
+    static bool type_supported(ColKey col_key);
+
+    const std::vector<ColKey>& get_column_keys() const noexcept
+    {
+        return m_col_keys;
+    }
+    bool covers(ColKey col_key) const noexcept;
+
+    // `values` holds the values of the object for the covered columns, in index order
+    void insert(ObjKey key, const std::vector<Mixed>& values);
+    void erase(ObjKey key, const std::vector<Mixed>& values);
+    void clear();
+    size_t size() const;
+
+    // Append the keys of the objects whose values for the first `prefix.size()` columns are equal
+    // to `prefix`, and whose value for the next column is within the given bounds, if any. The keys
+    // are appended in index order.
+    void find(const std::vector<Mixed>& prefix, const std::optional<Bound>& lower,
+              const std::optional<Bound>& upper, std::vector<ObjKey>& result) const;
+
+    void verify() const;
+
+private:
+    class Entries;
+
+    Array m_top;
+    std::vector<ColKey> m_col_keys;
+
+    size_t find_position(const Entries& entries, const std::vector<Mixed>& values, ObjKey key) const;
+};
+
+} // namespace realm
+
+#endif // REALM_INDEX_COMPOSITE_HPP
@@ -0,0 +1,791 @@
+/*************************************************************************
+ *
+ * Copyright 2023 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+#include <realm/index_fulltext.hpp>
+#include <realm/bplustree.hpp>
+#include <realm/array_binary.hpp>
+#include <realm/array_integer.hpp>
+#include <realm/array_string.hpp>
+#include <realm/exceptions.hpp>
+#include <realm/table.hpp>
+#include <realm/unicode.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <numeric>
+#include <unordered_map>
+
+using namespace realm;
+
+namespace {
+
+void encode_varint(std::string& out, uint64_t value)
+{
+    while (value >= 0x80) {
+        out += char(value | 0x80);
+        value >>= 7;
+    }
+    out += char(value);
+}
+
+uint64_t decode_varint(const char*& p, const char* end)
+{
+    uint64_t value = 0;
+    unsigned shift = 0;
+    while (p != end) {
+        auto byte = uint8_t(*p++);
+        value |= uint64_t(byte & 0x7f) << shift;
+        if (!(byte & 0x80))
+            break;
+        shift += 7;
+    }
+    return value;
+}
+
+// First position in [lo, hi) where `pred(position)` is false. `pred` must be
+// true for a (possibly empty) prefix of the range.
+template <class Pred>
+size_t partition_point(size_t lo, size_t hi, Pred pred)
+{
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (pred(mid)) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+// Number of entries given to insert_all() which are tokenized at a time, to
+// bound the memory used while building a large index
+constexpr size_t s_bulk_batch_size = 0x10000;
+
+} // anonymous namespace
+
+// Accessors for the trees of the index. They are created on demand for each
+// operation, as the trees may have been modified through other accessors since
+// the last time the index was used.
+class FulltextIndex::Blocks {
+public:
+    using Range = std::pair<size_t, size_t>;
+
+    Blocks(const Array& top)
+        : tokens(top.get_alloc())
+        , first_keys(top.get_alloc())
+        , sizes(top.get_alloc())
+        , postings(top.get_alloc())
+    {
+        // The parent is only used to propagate changes of the root refs, which
+        // never happens through a const index.
+        auto parent = const_cast<Array*>(&top);
+        tokens.set_parent(parent, 0);
+        first_keys.set_parent(parent, 1);
+        sizes.set_parent(parent, 2);
+        postings.set_parent(parent, 3);
+        tokens.init_from_parent();
+        first_keys.init_from_parent();
+        sizes.init_from_parent();
+        postings.init_from_parent();
+    }
+
+    size_t size() const
+    {
+        return tokens.size();
+    }
+
+    // The blocks of the token
+    Range find_token(StringData token) const
+    {
+        return find_token(token, 0, size());
+    }
+
+    // The blocks of the token within [begin, end)
+    Range find_token(StringData token, size_t begin, size_t end) const
+    {
+        begin = partition_point(begin, end, [&](size_t ndx) {
+            return tokens.get(ndx) < token;
+        });
+        end = partition_point(begin, end, [&](size_t ndx) {
+            return tokens.get(ndx) == token;
+        });
+        return {begin, end};
+    }
+
+    // The blocks of all tokens starting with the prefix
+    Range find_prefix(StringData prefix) const
+    {
+        size_t begin = partition_point(0, size(), [&](size_t ndx) {
+            return tokens.get(ndx) < prefix;
+        });
+        size_t end = partition_point(begin, size(), [&](size_t ndx) {
+            return tokens.get(ndx).begins_with(prefix);
+        });
+        return {begin, end};
+    }
+
+    // The block of the range which may hold the key: the last one starting at
+    // or before the key, or the first one of the range
+    size_t find_block(Range range, int64_t key) const
+    {
+        return partition_point(range.first + 1, range.second, [&](size_t ndx) {
+                   return first_keys.get(ndx) <= key;
+               }) -
+               1;
+    }
+
+    // Number of postings in the blocks of the range
+    size_t count(Range range) const
+    {
+        size_t n = 0;
+        for (size_t ndx = range.first; ndx < range.second; ++ndx) {
+            n += size_t(sizes.get(ndx));
+        }
+        return n;
+    }
+
+    Postings get_postings(size_t ndx) const
+    {
+        return decode(postings.get(ndx));
+    }
+
+    void set_postings(size_t ndx, const Postings& block)
+    {
+        REALM_ASSERT(!block.empty());
+        std::string data = encode(block);
+        first_keys.set(ndx, block.front().key);
+        sizes.set(ndx, int64_t(block.size()));
+        postings.set(ndx, BinaryData(data.data(), data.size()));
+    }
+
+    void insert_block(size_t ndx, StringData token, const Postings& block)
+    {
+        REALM_ASSERT(!block.empty());
+        std::string data = encode(block);
+        tokens.insert(ndx, token);
+        first_keys.insert(ndx, block.front().key);
+        sizes.insert(ndx, int64_t(block.size()));
+        postings.insert(ndx, BinaryData(data.data(), data.size()));
+    }
+
+    void erase_block(size_t ndx)
+    {
+        tokens.erase(ndx);
+        first_keys.erase(ndx);
+        sizes.erase(ndx);
+        postings.erase(ndx);
+    }
+
+    void clear()
+    {
+        tokens.clear();
+        first_keys.clear();
+        sizes.clear();
+        postings.clear();
+    }
+
+    BPlusTree<StringData> tokens;
+    BPlusTree<int64_t> first_keys;
+    BPlusTree<int64_t> sizes;
+    BPlusTree<BinaryData> postings;
+};
+
+FulltextIndex::FulltextIndex(const ClusterColumn& target_column, Allocator& alloc)
+    : SearchIndex(target_column, &m_top)
+    , m_top(alloc)
+{
+    m_top.create(Array::type_HasRefs, false, 4); // Throws
+    try {
+        BPlusTree<StringData> tokens(alloc);
+        tokens.set_parent(&m_top, 0);
+        tokens.create(); // Throws
+        BPlusTree<int64_t> first_keys(alloc);
+        first_keys.set_parent(&m_top, 1);
+        first_keys.create(); // Throws
+        BPlusTree<int64_t> sizes(alloc);
+        sizes.set_parent(&m_top, 2);
+        sizes.create(); // Throws
+        BPlusTree<BinaryData> postings(alloc);
+        postings.set_parent(&m_top, 3);
+        postings.create(); // Throws
+    }
+    catch (...) {
+        m_top.destroy_deep();
+        throw;
+    }
+}
+
+FulltextIndex::FulltextIndex(ref_type ref, ArrayParent* parent, size_t ndx_in_parent,
+                             const ClusterColumn& target_column, Allocator& alloc)
+    : SearchIndex(target_column, &m_top)
+    , m_top(alloc)
+{
+    m_top.init_from_ref(ref);
+    m_top.set_parent(parent, ndx_in_parent);
+}
+
+TokenFrequencies FulltextIndex::get_tokens(const Mixed& value)
+{
+    if (!value.is_type(type_String))
+        return {};
+    StringData str = value.get_string();
+    return Tokenizer::get_instance()->reset({str.data(), str.size()}).get_token_frequencies();
+}
+
+FulltextIndex::Postings FulltextIndex::decode(BinaryData data)
+{
+    Postings postings;
+    const char* p = data.data();
+    const char* end = p + data.size();
+    int64_t key = 0;
+    while (p != end) {
+        key += int64_t(decode_varint(p, end));
+        auto frequency = uint32_t(decode_varint(p, end));
+        postings.push_back({key, frequency});
+    }
+    return postings;
+}
+
+std::string FulltextIndex::encode(const Postings& postings)
+{
+    std::string data;
+    int64_t prev = 0;
+    for (auto& posting : postings) {
+        encode_varint(data, uint64_t(posting.key - prev));
+        encode_varint(data, posting.frequency);
+        prev = posting.key;
+    }
+    return data;
+}
+
+void FulltextIndex::add_posting(Blocks& blocks, StringData token, int64_t key, uint32_t frequency)
+{
+    auto range = blocks.find_token(token);
+    if (range.first == range.second) {
+        blocks.insert_block(range.first, token, {{key, frequency}});
+        return;
+    }
+
+    size_t ndx = blocks.find_block(range, key);
+    Postings block = blocks.get_postings(ndx);
+    auto it = std::lower_bound(block.begin(), block.end(), key, [](const Posting& posting, int64_t k) {
+        return posting.key < k;
+    });
+    if (it != block.end() && it->key == key) {
+        it->frequency = frequency;
+    }
+    else {
+        block.insert(it, {key, frequency});
+    }
+
+    if (block.size() > s_max_block_size) {
+        // Split the block in two
+        Postings tail(block.begin() + block.size() / 2, block.end());
+        block.resize(block.size() / 2);
+        blocks.set_postings(ndx, block);
+        blocks.insert_block(ndx + 1, token, tail);
+    }
+    else {
+        blocks.set_postings(ndx, block);
+    }
+}
+
+void FulltextIndex::remove_posting(Blocks& blocks, StringData token, int64_t key)
+{
+    auto range = blocks.find_token(token);
+    REALM_ASSERT(range.first != range.second);
+    size_t ndx = blocks.find_block(range, key);
+    Postings block = blocks.get_postings(ndx);
+    auto it = std::lower_bound(block.begin(), block.end(), key, [](const Posting& posting, int64_t k) {
+        return posting.key < k;
+    });
+    REALM_ASSERT(it != block.end() && it->key == key);
+    block.erase(it);
+    if (block.empty()) {
+        blocks.erase_block(ndx);
+    }
+    else {
+        blocks.set_postings(ndx, block);
+    }
+}
+
+void FulltextIndex::insert(ObjKey key, const Mixed& value)
+{
+    auto tokens = get_tokens(value);
+    if (tokens.empty())
+        return;
+    Blocks blocks(m_top);
+    for (auto& [token, frequency] : tokens) {
+        add_posting(blocks, token, key.value, frequency);
+    }
+}
+
+void FulltextIndex::set(ObjKey key, const Mixed& new_value)
+{
+    auto old_tokens = get_tokens(m_target_column.get_value(key));
+    auto new_tokens = get_tokens(new_value);
+    Blocks blocks(m_top);
+
+    // Both are sorted by token, so a merge finds the postings to remove, add or update
+    auto old_it = old_tokens.begin();
+    auto new_it = new_tokens.begin();
+    while (old_it != old_tokens.end() || new_it != new_tokens.end()) {
+        if (new_it == new_tokens.end() || (old_it != old_tokens.end() && old_it->first < new_it->first)) {
+            remove_posting(blocks, old_it->first, key.value);
+            ++old_it;
+        }
+        else if (old_it == old_tokens.end() || new_it->first < old_it->first) {
+            add_posting(blocks, new_it->first, key.value, new_it->second);
+            ++new_it;
+        }
+        else {
+            if (old_it->second != new_it->second) {
+                add_posting(blocks, new_it->first, key.value, new_it->second);
+            }
+            ++old_it;
+            ++new_it;
+        }
+    }
+}
+
+void FulltextIndex::erase(ObjKey key)
+{
+    auto tokens = get_tokens(m_target_column.get_value(key));
+    if (tokens.empty())
+        return;
+    Blocks blocks(m_top);
+    for (auto& token : tokens) {
+        remove_posting(blocks, token.first, key.value);
+    }
+}
+
+void FulltextIndex::clear()
+{
+    Blocks(m_top).clear();
+}
+
+bool FulltextIndex::is_empty() const
+{
+    return Blocks(m_top).size() == 0;
+}
+
+bool FulltextIndex::has_duplicate_values() const noexcept
+{
+    // The index holds tokens rather than values
+    return false;
+}
+
+template <class F>
+void FulltextIndex::find_equal(const Mixed& value, bool case_insensitive, F fn) const
+{
+    std::optional<std::string> folded;
+    if (case_insensitive && value.is_type(type_String)) {
+        folded = case_map(value.get_string(), false, IgnoreErrors);
+    }
+    auto matches = [&](const Mixed& val) {
+        return folded ? val.is_type(type_String) && case_map(val.get_string(), false, IgnoreErrors) == *folded
+                      : val == value;
+    };
+
+    // The tokenizer only folds the case of Latin-1 characters, so other strings compared
+    // ignoring case may not share their tokens
+    auto tokens = get_tokens(value);
+    bool use_postings = !tokens.empty();
+    if (use_postings && folded) {
+        StringData str = value.get_string();
+        use_postings = std::all_of(str.data(), str.data() + str.size(), [](char c) {
+            return (c & 0x80) == 0;
+        });
+    }
+
+    if (!use_postings) {
+        // Strings without any token, and values of other types, are not found in the
+        // postings, so the column is scanned
+        ColKey col_key = m_target_column.get_column_key();
+        for (auto it = m_target_column.begin(); it != m_target_column.end(); ++it) {
+            if (matches(it->get_any(col_key)) && !fn(it->get_key()))
+                return;
+        }
+        return;
+    }
+
+    // An object holding the value holds all its tokens. The posting lists of the tokens are
+    // intersected starting with the shortest, and the candidates left are compared with the value.
+    Blocks blocks(m_top);
+    std::vector<std::pair<size_t, Blocks::Range>> ranges;
+    for (auto& token : tokens) {
+        auto range = blocks.find_token(token.first);
+        if (range.first == range.second)
+            return;
+        ranges.emplace_back(blocks.count(range), range);
+    }
+    std::sort(ranges.begin(), ranges.end());
+
+    std::vector<int64_t> keys;
+    for (size_t ndx = ranges.front().second.first; ndx < ranges.front().second.second; ++ndx) {
+        for (auto& posting : blocks.get_postings(ndx)) {
+            keys.push_back(posting.key);
+        }
+    }
+    for (size_t i = 1; i < ranges.size() && !keys.empty(); ++i) {
+        std::vector<int64_t> found;
+        match_postings(blocks, ranges[i].second, keys, [&](size_t pos, uint32_t) {
+            found.push_back(keys[pos]);
+        });
+        keys = std::move(found);
+    }
+
+    for (auto key : keys) {
+        if (matches(m_target_column.get_value(ObjKey(key))) && !fn(ObjKey(key)))
+            return;
+    }
+}
+
+ObjKey FulltextIndex::find_first(const Mixed& value) const
+{
+    ObjKey result;
+    find_equal(value, false, [&](ObjKey key) {
+        result = key;
+        return false;
+    });
+    return result;
+}
+
+void FulltextIndex::find_all(std::vector<ObjKey>& result, Mixed value, bool case_insensitive) const
+{
+    find_equal(value, case_insensitive, [&](ObjKey key) {
+        result.push_back(key);
+        return true;
+    });
+}
+
+FindRes FulltextIndex::find_all_no_copy(Mixed, InternalFindResult&) const
+{
+    // Only used for columns with a general index
+    REALM_UNREACHABLE();
+}
+
+size_t FulltextIndex::count(const Mixed& value) const
+{
+    size_t n = 0;
+    find_equal(value, false, [&](ObjKey) {
+        ++n;
+        return true;
+    });
+    return n;
+}
+
+void FulltextIndex::insert_bulk(const ArrayUnsigned* keys, uint64_t key_offset, size_t num_values,
+                                ArrayPayload& values)
+{
+    for (size_t i = 0; i < num_values; ++i) {
+        ObjKey key(keys ? int64_t(keys->get(i) + key_offset) : int64_t(i + key_offset));
+        insert(key, values.get_any(i));
+    }
+}
+
+void FulltextIndex::insert_bulk_list(const ArrayUnsigned*, uint64_t, size_t, ArrayInteger&)
+{
+    // Lists of strings use a StringIndex
+    REALM_UNREACHABLE();
+}
+
+void FulltextIndex::insert_all(std::vector<Entry>& entries)
+{
+    REALM_ASSERT(is_empty());
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return a.key < b.key;
+    });
+
+    // The postings of each batch of entries follow those of the previous batches,
+    // so they are appended to the last block of each token
+    Blocks blocks(m_top);
+    std::unordered_map<std::string, Postings> batch;
+    for (size_t begin = 0; begin < entries.size(); begin += s_bulk_batch_size) {
+        size_t end = std::min(begin + s_bulk_batch_size, entries.size());
+        batch.clear();
+        for (size_t i = begin; i < end; ++i) {
+            for (auto& [token, frequency] : get_tokens(entries[i].value)) {
+                batch[token].push_back({entries[i].key.value, frequency});
+            }
+        }
+
+        for (auto& [token, postings] : batch) {
+            auto range = blocks.find_token(token);
+            auto it = postings.begin();
+            if (range.first != range.second) {
+                size_t last = range.second - 1;
+                Postings block = blocks.get_postings(last);
+                size_t n = std::min(s_max_block_size - block.size(), size_t(postings.end() - it));
+                if (n > 0) {
+                    block.insert(block.end(), it, it + n);
+                    blocks.set_postings(last, block);
+                    it += n;
+                }
+            }
+            size_t ndx = range.second;
+            while (it != postings.end()) {
+                size_t n = std::min(s_max_block_size, size_t(postings.end() - it));
+                blocks.insert_block(ndx++, token, Postings(it, it + n));
+                it += n;
+            }
+        }
+    }
+}
+
+size_t FulltextIndex::get_document_frequency(StringData token) const
+{
+    Blocks blocks(m_top);
+    return blocks.count(blocks.find_token(token));
+}
+
+template <class F>
+void FulltextIndex::match_postings(const Blocks& blocks, std::pair<size_t, size_t> range,
+                                   const std::vector<int64_t>& keys, F fn)
+{
+    size_t num_blocks = range.second - range.first;
+    if (keys.size() >= num_blocks) {
+        // Merge the keys with all the postings
+        size_t pos = 0;
+        for (size_t ndx = range.first; ndx < range.second && pos < keys.size(); ++ndx) {
+            if (ndx + 1 < range.second && blocks.first_keys.get(ndx + 1) <= keys[pos])
+                continue; // No key left in this block
+            for (auto& posting : blocks.get_postings(ndx)) {
+                while (pos < keys.size() && keys[pos] < posting.key)
+                    ++pos;
+                if (pos == keys.size())
+                    break;
+                if (keys[pos] == posting.key)
+                    fn(pos++, posting.frequency);
+            }
+        }
+        return;
+    }
+
+    // Few keys, so only decode the blocks which may hold them
+    size_t loaded = npos;
+    size_t ndx = range.first;
+    Postings block;
+    for (size_t pos = 0; pos < keys.size(); ++pos) {
+        ndx = blocks.find_block({ndx, range.second}, keys[pos]);
+        if (ndx != loaded) {
+            block = blocks.get_postings(ndx);
+            loaded = ndx;
+        }
+        auto it = std::lower_bound(block.begin(), block.end(), keys[pos], [](const Posting& posting, int64_t k) {
+            return posting.key < k;
+        });
+        if (it != block.end() && it->key == keys[pos])
+            fn(pos, it->frequency);
+    }
+}
+
+void FulltextIndex::find_matches(const Blocks& blocks, StringData terms, std::vector<int64_t>& keys,
+                                 std::vector<TermBlocks>& includes) const
+{
+    auto tokenizer = Tokenizer::get_instance();
+    tokenizer->reset({terms.data(), terms.size()});
+    auto [include_terms, exclude_terms] = tokenizer->get_search_tokens();
+    if (include_terms.empty() && exclude_terms.empty()) {
+        throw InvalidArgument("Missing search token");
+    }
+
+    // The blocks of each token matched by the term
+    auto get_term_blocks = [&](const std::string& term) {
+        TermBlocks term_blocks;
+        if (!term.empty() && term.back() == '*') {
+            auto [begin, end] = blocks.find_prefix(StringData(term.data(), term.size() - 1));
+            while (begin < end) {
+                std::string token(blocks.tokens.get(begin));
+                auto range = blocks.find_token(token, begin, end);
+                term_blocks.push_back(range);
+                begin = range.second;
+            }
+        }
+        else {
+            auto range = blocks.find_token(term);
+            if (range.first != range.second)
+                term_blocks.push_back(range);
+        }
+        return term_blocks;
+    };
+    auto keep = [&](const std::vector<bool>& flags, bool value) {
+        size_t n = 0;
+        for (size_t pos = 0; pos < keys.size(); ++pos) {
+            if (flags[pos] == value)
+                keys[n++] = keys[pos];
+        }
+        keys.resize(n);
+    };
+
+    // The terms are intersected starting with the one with the fewest postings
+    std::vector<std::pair<size_t, TermBlocks>> sorted_terms;
+    for (auto& term : include_terms) {
+        TermBlocks term_blocks = get_term_blocks(term);
+        if (term_blocks.empty())
+            return; // No object holds the term
+        size_t num_postings = 0;
+        for (auto& range : term_blocks) {
+            num_postings += blocks.count(range);
+        }
+        sorted_terms.emplace_back(num_postings, std::move(term_blocks));
+    }
+    std::sort(sorted_terms.begin(), sorted_terms.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+
+    if (sorted_terms.empty()) {
+        for (auto key : m_target_column.get_all_keys()) {
+            keys.push_back(key.value);
+        }
+    }
+    else {
+        for (auto& range : sorted_terms.front().second) {
+            for (size_t ndx = range.first; ndx < range.second; ++ndx) {
+                for (auto& posting : blocks.get_postings(ndx)) {
+                    keys.push_back(posting.key);
+                }
+            }
+        }
+        if (sorted_terms.front().second.size() > 1) {
+            std::sort(keys.begin(), keys.end());
+            keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+        }
+        for (size_t i = 1; i < sorted_terms.size() && !keys.empty(); ++i) {
+            std::vector<bool> found(keys.size());
+            for (auto& range : sorted_terms[i].second) {
+                match_postings(blocks, range, keys, [&](size_t pos, uint32_t) {
+                    found[pos] = true;
+                });
+            }
+            keep(found, true);
+        }
+    }
+
+    for (auto& term : exclude_terms) {
+        if (keys.empty())
+            break;
+        std::vector<bool> found(keys.size());
+        for (auto& range : get_term_blocks(term)) {
+            match_postings(blocks, range, keys, [&](size_t pos, uint32_t) {
+                found[pos] = true;
+            });
+        }
+        keep(found, false);
+    }
+
+    for (auto& term : sorted_terms) {
+        includes.push_back(std::move(term.second));
+    }
+}
+
+void FulltextIndex::find_all_fulltext(std::vector<ObjKey>& result, StringData terms) const
+{
+    REALM_ASSERT(result.empty());
+    Blocks blocks(m_top);
+    std::vector<int64_t> keys;
+    std::vector<TermBlocks> includes;
+    find_matches(blocks, terms, keys, includes);
+    result.reserve(keys.size());
+    for (auto key : keys) {
+        result.emplace_back(key);
+    }
+}
+
+void FulltextIndex::find_all_fulltext(std::vector<ObjKey>& result, StringData terms, size_t limit) const
+{
+    REALM_ASSERT(result.empty());
+    Blocks blocks(m_top);
+    std::vector<int64_t> keys;
+    std::vector<TermBlocks> includes;
+    find_matches(blocks, terms, keys, includes);
+
+    std::vector<double> scores(keys.size());
+    double num_objects = double(m_target_column.size());
+    for (auto& term_blocks : includes) {
+        for (auto& range : term_blocks) {
+            double idf = std::log(1 + num_objects / double(blocks.count(range)));
+            match_postings(blocks, range, keys, [&](size_t pos, uint32_t frequency) {
+                scores[pos] += frequency * idf;
+            });
+        }
+    }
+
+    std::vector<size_t> order(keys.size());
+    std::iota(order.begin(), order.end(), 0);
+    auto more_relevant = [&](size_t a, size_t b) {
+        return scores[a] > scores[b] || (scores[a] == scores[b] && keys[a] < keys[b]);
+    };
+    size_t n = std::min(limit, order.size());
+    std::partial_sort(order.begin(), order.begin() + n, order.end(), more_relevant);
+    result.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        result.emplace_back(keys[order[i]]);
+    }
+}
+
+void FulltextIndex::verify() const
+{
+#ifdef REALM_DEBUG
+    m_top.verify();
+    REALM_ASSERT(m_top.has_refs());
+    REALM_ASSERT_3(m_top.size(), ==, 4);
+    Blocks blocks(m_top);
+    size_t sz = blocks.size();
+    REALM_ASSERT_3(blocks.first_keys.size(), ==, sz);
+    REALM_ASSERT_3(blocks.sizes.size(), ==, sz);
+    REALM_ASSERT_3(blocks.postings.size(), ==, sz);
+    int64_t prev_key = 0;
+    for (size_t ndx = 0; ndx < sz; ++ndx) {
+        Postings block = blocks.get_postings(ndx);
+        REALM_ASSERT(!block.empty());
+        REALM_ASSERT_3(block.size(), <=, s_max_block_size);
+        REALM_ASSERT_3(size_t(blocks.sizes.get(ndx)), ==, block.size());
+        REALM_ASSERT_3(blocks.first_keys.get(ndx), ==, block.front().key);
+        if (ndx > 0) {
+            StringData prev_token = blocks.tokens.get(ndx - 1);
+            StringData token = blocks.tokens.get(ndx);
+            REALM_ASSERT(prev_token < token || (prev_token == token && prev_key < block.front().key));
+        }
+        for (size_t i = 0; i < block.size(); ++i) {
+            REALM_ASSERT_3(block[i].frequency, >, 0);
+            REALM_ASSERT(i == 0 || block[i - 1].key < block[i].key);
+        }
+        prev_key = block.back().key;
+    }
+#endif
+}
+
+#ifdef REALM_DEBUG
+void FulltextIndex::print() const
+{
+    Blocks blocks(m_top);
+    size_t sz = blocks.size();
+    std::cout << "FulltextIndex: " << sz << " blocks" << std::endl;
+    for (size_t ndx = 0; ndx < sz; ++ndx) {
+        std::cout << "  " << blocks.tokens.get(ndx) << ":";
+        for (auto& posting : blocks.get_postings(ndx)) {
+            std::cout << " " << posting.key << "(" << posting.frequency << ")";
+        }
+        std::cout << std::endl;
+    }
+}
+#endif // REALM_DEBUG
@@ -0,0 +1,134 @@
+/*************************************************************************
+ *
+ * Copyright 2023 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+#ifndef REALM_INDEX_FULLTEXT_HPP
+#define REALM_INDEX_FULLTEXT_HPP
+
+#include <realm/array.hpp>
+#include <realm/search_index.hpp>
+#include <realm/tokenizer.hpp>
+
+/*
+The FulltextIndex is an inverted index mapping each token found in the strings of a column to
+the posting list of the token: the keys of the objects whose string holds the token, with the
+number of times it occurs there (the term frequency).
+
+Posting lists are split into blocks of at most s_max_block_size postings, kept in four B+ trees
+of equal size, one entry per block:
+
+    [0] tokens:     BPlusTree<String>, the token of the block
+    [1] first keys: BPlusTree<Int>, the smallest key in the block
+    [2] sizes:      BPlusTree<Int>, the number of postings in the block
+    [3] postings:   BPlusTree<Binary>, the postings of the block, delta compressed
+
+The blocks are sorted by token and then by first key, so the blocks of a token, or of all tokens
+starting with a prefix, form a range found by binary search. A block holds the postings sorted by
+key, each one stored as the varint encoded difference to the previous key followed by the varint
+encoded term frequency.
+
+Intersecting the posting lists of several terms starts with the rarest term, and only decodes
+the blocks of the other terms which may hold one of the remaining keys.
+
+Only non-collection string columns use this index. Fulltext indexes on lists of strings, and
+those created by earlier versions, are StringIndex instances using tokenization.
+*/
+
+namespace realm {
+
+class FulltextIndex : public SearchIndex {
+public:
+    // Create a new, empty index
+    FulltextIndex(const ClusterColumn& target_column, Allocator&);
+    // Attach to an existing index
+    FulltextIndex(ref_type, ArrayParent*, size_t ndx_in_parent, const ClusterColumn& target_column, Allocator&);
+
+    static bool type_supported(ColKey col_key)
+    {
+        return col_key.get_type() == col_type_String && !col_key.is_collection();
+    }
+
+    // SearchIndex interface:
+
+    void insert(ObjKey key, const Mixed& value) final;
+    void set(ObjKey key, const Mixed& new_value) final;
+    // Lookups of whole values compare the objects holding all the tokens of the value with the
+    // value, in key order
+    ObjKey find_first(const Mixed& value) const final;
+    void find_all(std::vector<ObjKey>& result, Mixed value, bool case_insensitive = false) const final;
+    FindRes find_all_no_copy(Mixed value, InternalFindResult& result) const final;
+    size_t count(const Mixed& value) const final;
+    void erase(ObjKey key) final;
+    void clear() final;
+    bool has_duplicate_values() const noexcept final;
+    bool is_empty() const final;
+    void insert_bulk(const ArrayUnsigned* keys, uint64_t key_offset, size_t num_values,
+                     ArrayPayload& values) final;
+    void insert_bulk_list(const ArrayUnsigned* keys, uint64_t key_offset, size_t num_values,
+                          ArrayInteger& ref_array) final;
+    void insert_all(std::vector<Entry>& entries) final;
+    void verify() const final;
+
+#ifdef REALM_DEBUG
+    void print() const final;
+#endif // REALM_DEBUG
+
+    // Find the objects matching the search terms, sorted by key. All terms must match, except
+    // those prefixed with '-', which must not. A term ending with '*' matches all tokens
+    // starting with the term.
+    void find_all_fulltext(std::vector<ObjKey>& result, StringData terms) const;
+    // Find up to `limit` objects matching the search terms, the most relevant first. The
+    // relevance of an object is the sum over the matching tokens of the term frequency weighted
+    // by the inverse document frequency of the token, ties are ordered by key.
+    void find_all_fulltext(std::vector<ObjKey>& result, StringData terms, size_t limit) const;
+
+    // Number of postings of the token
+    size_t get_document_frequency(StringData token) const;
+
+    static constexpr size_t s_max_block_size = 128;
+
+private:
+    class Blocks;
+    struct Posting {
+        int64_t key;
+        uint32_t frequency;
+    };
+    using Postings = std::vector<Posting>;
+    // The ranges of blocks of the tokens matched by a search term
+    using TermBlocks = std::vector<std::pair<size_t, size_t>>;
+
+    Array m_top;
+
+    static TokenFrequencies get_tokens(const Mixed& value);
+    static Postings decode(BinaryData data);
+    static std::string encode(const Postings& postings);
+
+    void add_posting(Blocks& blocks, StringData token, int64_t key, uint32_t frequency);
+    void remove_posting(Blocks& blocks, StringData token, int64_t key);
+    void find_matches(const Blocks& blocks, StringData terms, std::vector<int64_t>& keys,
+                      std::vector<TermBlocks>& includes) const;
+    // Call `fn` with the key of each object holding the value until it returns false
+    template <class F>
+    void find_equal(const Mixed& value, bool case_insensitive, F fn) const;
+    template <class F>
+    static void match_postings(const Blocks& blocks, std::pair<size_t, size_t> range,
+                               const std::vector<int64_t>& keys, F fn);
+};
+
+} // namespace realm
+
+#endif // REALM_INDEX_FULLTEXT_HPP
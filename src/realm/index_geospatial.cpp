@@ -0,0 +1,310 @@
+/*************************************************************************
+ *
+ * Copyright 2023 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+#include <realm/index_geospatial.hpp>
+#include <realm/bplustree.hpp>
+#include <realm/array_integer.hpp>
+#include <realm/geospatial.hpp>
+#include <realm/list.hpp>
+
+#include <algorithm>
+#include <iostream>
+
+using namespace realm;
+
+namespace {
+
+int64_t to_stored(uint64_t cell_id)
+{
+    return int64_t(cell_id ^ (uint64_t(1) << 63));
+}
+
+// The cell of the point held by a list of coordinates, if it holds a valid point
+template <class List>
+std::optional<int64_t> cell_of_coordinates(const List& coords)
+{
+    if (coords.size() < 2)
+        return {};
+    auto cell = GeoRegion::get_cell_id(GeoPoint{coords.get(0), coords.get(1)});
+    if (!cell)
+        return {};
+    return to_stored(*cell);
+}
+
+} // anonymous namespace
+
+// Accessors for the two trees of the index. They are created on demand for each
+// operation, as the trees may have been modified through other accessors since
+// the last time the index was used.
+class GeospatialIndex::Entries {
+public:
+    Entries(const Array& top)
+        : cells(top.get_alloc())
+        , keys(top.get_alloc())
+    {
+        // The parent is only used to propagate changes of the root refs, which
+        // never happens through a const index.
+        auto parent = const_cast<Array*>(&top);
+        cells.set_parent(parent, 0);
+        keys.set_parent(parent, 1);
+        cells.init_from_parent();
+        keys.init_from_parent();
+    }
+
+    size_t size() const
+    {
+        return cells.size();
+    }
+
+    // First position where `pred(position)` is false. `pred` must be true for
+    // a (possibly empty) prefix of the entries.
+    template <class Pred>
+    size_t partition_point(Pred pred) const
+    {
+        size_t lo = 0;
+        size_t hi = size();
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (pred(mid)) {
+                lo = mid + 1;
+            }
+            else {
+                hi = mid;
+            }
+        }
+        return lo;
+    }
+
+    BPlusTree<int64_t> cells;
+    BPlusTree<int64_t> keys;
+};
+
+GeospatialIndex::GeospatialIndex(const ClusterColumn& target_column, Allocator& alloc)
+    : SearchIndex(target_column, &m_top)
+    , m_top(alloc)
+{
+    m_top.create(Array::type_HasRefs, false, 2); // Throws
+    try {
+        BPlusTree<int64_t> cells(alloc);
+        cells.set_parent(&m_top, 0);
+        cells.create(); // Throws
+        BPlusTree<int64_t> keys(alloc);
+        keys.set_parent(&m_top, 1);
+        keys.create(); // Throws
+    }
+    catch (...) {
+        m_top.destroy_deep();
+        throw;
+    }
+}
+
+GeospatialIndex::GeospatialIndex(ref_type ref, ArrayParent* parent, size_t ndx_in_parent,
+                                 const ClusterColumn& target_column, Allocator& alloc)
+    : SearchIndex(target_column, &m_top)
+    , m_top(alloc)
+{
+    m_top.init_from_ref(ref);
+    m_top.set_parent(parent, ndx_in_parent);
+}
+
+std::optional<int64_t> GeospatialIndex::get_cell(ObjKey key) const
+{
+    const Obj obj = m_target_column.get_object(key);
+    return cell_of_coordinates(obj.get_list<double>(m_target_column.get_column_key()));
+}
+
+size_t GeospatialIndex::find_position(const Entries& entries, int64_t cell, ObjKey key) const
+{
+    return entries.partition_point([&](size_t ndx) {
+        int64_t c = entries.cells.get(ndx);
+        return c < cell || (c == cell && entries.keys.get(ndx) < key.value);
+    });
+}
+
+void GeospatialIndex::insert(ObjKey key, const Mixed&)
+{
+    auto cell = get_cell(key);
+    if (!cell)
+        return;
+    Entries entries(m_top);
+    size_t ndx = find_position(entries, *cell, key);
+    entries.cells.insert(ndx, *cell);
+    entries.keys.insert(ndx, key.value);
+}
+
+void GeospatialIndex::set(ObjKey, const Mixed&)
+{
+    // Lists are updated through erase() and insert()
+    REALM_UNREACHABLE();
+}
+
+void GeospatialIndex::erase(ObjKey key)
+{
+    auto cell = get_cell(key);
+    if (!cell)
+        return;
+    Entries entries(m_top);
+    size_t ndx = find_position(entries, *cell, key);
+    REALM_ASSERT_3(ndx, <, entries.size());
+    REALM_ASSERT_3(entries.keys.get(ndx), ==, key.value);
+    entries.cells.erase(ndx);
+    entries.keys.erase(ndx);
+}
+
+void GeospatialIndex::clear()
+{
+    Entries entries(m_top);
+    entries.cells.clear();
+    entries.keys.clear();
+}
+
+size_t GeospatialIndex::size() const
+{
+    return Entries(m_top).size();
+}
+
+bool GeospatialIndex::is_empty() const
+{
+    return size() == 0;
+}
+
+void GeospatialIndex::find_candidates(const GeoRegion& region, std::vector<ObjKey>& result) const
+{
+    Entries entries(m_top);
+    size_t first = result.size();
+    for (auto& range : region.get_cell_ranges()) {
+        int64_t lo = to_stored(range.first);
+        int64_t hi = to_stored(range.second);
+        size_t begin = entries.partition_point([&](size_t ndx) {
+            return entries.cells.get(ndx) < lo;
+        });
+        for (size_t ndx = begin; ndx < entries.size() && entries.cells.get(ndx) <= hi; ++ndx) {
+            result.push_back(ObjKey(entries.keys.get(ndx)));
+        }
+    }
+    // The ranges do not overlap, so no key is found twice
+    std::sort(result.begin() + first, result.end());
+}
+
+ObjKey GeospatialIndex::find_first(const Mixed&) const
+{
+    // Value lookups are not supported by this index
+    REALM_UNREACHABLE();
+}
+
+void GeospatialIndex::find_all(std::vector<ObjKey>&, Mixed, bool) const
+{
+    REALM_UNREACHABLE();
+}
+
+FindRes GeospatialIndex::find_all_no_copy(Mixed, InternalFindResult&) const
+{
+    REALM_UNREACHABLE();
+}
+
+size_t GeospatialIndex::count(const Mixed&) const
+{
+    REALM_UNREACHABLE();
+}
+
+bool GeospatialIndex::has_duplicate_values() const noexcept
+{
+    // Only meaningful for the values of a column, not for the points of lists
+    return false;
+}
+
+void GeospatialIndex::insert_bulk(const ArrayUnsigned*, uint64_t, size_t, ArrayPayload&)
+{
+    // Only list columns are supported by this index
+    REALM_UNREACHABLE();
+}
+
+void GeospatialIndex::insert_all(std::vector<Entry>&)
+{
+    REALM_UNREACHABLE();
+}
+
+void GeospatialIndex::insert_bulk_list(const ArrayUnsigned* keys, uint64_t key_offset, size_t num_values,
+                                       ArrayInteger& ref_array)
+{
+    // Gather the entries of the cluster, and merge them into the index in one pass
+    std::vector<std::pair<int64_t, int64_t>> new_entries;
+    BPlusTree<double> coords(m_top.get_alloc());
+    for (size_t i = 0; i < num_values; ++i) {
+        ref_type ref = to_ref(ref_array.get(i));
+        if (!ref)
+            continue;
+        coords.init_from_ref(ref);
+        if (auto cell = cell_of_coordinates(coords)) {
+            ObjKey key(keys ? keys->get(i) + key_offset : i + key_offset);
+            new_entries.emplace_back(*cell, key.value);
+        }
+    }
+    if (new_entries.empty())
+        return;
+    std::sort(new_entries.begin(), new_entries.end());
+
+    Entries entries(m_top);
+    if (entries.size() == 0 || entries.cells.get(entries.size() - 1) < new_entries.front().first) {
+        for (auto& entry : new_entries) {
+            entries.cells.add(entry.first);
+            entries.keys.add(entry.second);
+        }
+        return;
+    }
+    for (auto& entry : new_entries) {
+        size_t ndx = find_position(entries, entry.first, ObjKey(entry.second));
+        entries.cells.insert(ndx, entry.first);
+        entries.keys.insert(ndx, entry.second);
+    }
+}
+
+void GeospatialIndex::verify() const
+{
+#ifdef REALM_DEBUG
+    m_top.verify();
+    REALM_ASSERT(m_top.has_refs());
+    REALM_ASSERT_3(m_top.size(), ==, 2);
+    Entries entries(m_top);
+    size_t sz = entries.size();
+    REALM_ASSERT_3(entries.keys.size(), ==, sz);
+    for (size_t ndx = 0; ndx < sz; ++ndx) {
+        ObjKey key(entries.keys.get(ndx));
+        auto cell = get_cell(key);
+        REALM_ASSERT(cell);
+        REALM_ASSERT_3(*cell, ==, entries.cells.get(ndx));
+        if (ndx > 0) {
+            int64_t prev = entries.cells.get(ndx - 1);
+            REALM_ASSERT(prev < *cell || (prev == *cell && entries.keys.get(ndx - 1) < key.value));
+        }
+    }
+#endif
+}
+
+#ifdef REALM_DEBUG
+void GeospatialIndex::print() const
+{
+    Entries entries(m_top);
+    size_t sz = entries.size();
+    std::cout << "GeospatialIndex: " << sz << " entries" << std::endl;
+    for (size_t ndx = 0; ndx < sz; ++ndx) {
+        uint64_t cell = uint64_t(entries.cells.get(ndx)) ^ (uint64_t(1) << 63);
+        std::cout << "  " << std::hex << cell << std::dec << " -> " << ObjKey(entries.keys.get(ndx)) << std::endl;
+    }
+}
+#endif // REALM_DEBUG
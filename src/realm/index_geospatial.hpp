@@ -0,0 +1,105 @@
+/*************************************************************************
+ *
+ * Copyright 2023 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+#ifndef REALM_INDEX_GEOSPATIAL_HPP
+#define REALM_INDEX_GEOSPATIAL_HPP
+
+#include <realm/array.hpp>
+#include <realm/search_index.hpp>
+
+/*
+The GeospatialIndex indexes the points held by the embedded objects used in geoWithin queries,
+where the "coordinates" list of an object holds the longitude and latitude of its point. It maps
+the S2 leaf cell holding each point to the key of the object, so that the objects within a region
+can be found by looking up the ranges of cells covering the region.
+
+The index consists of a top array holding two B+ trees of equal size:
+
+    [0] cells: BPlusTree<Int>, the cell id of each point, sorted ascending
+    [1] keys:  BPlusTree<Int>, the ObjKey of the object holding the point at the same position
+
+Cell ids are unsigned, so they are stored with the top bit flipped, which makes the signed order
+of the stored values follow the cells along the Hilbert curve. Entries in the same cell are
+ordered by key. Objects whose list does not hold a valid point are not in the index.
+
+The index is maintained from the whole list of the object, so both insert() and erase() read
+the point from the list rather than taking a value. Only list columns of type Double are
+supported, and value lookups are not: the objects are found with find_candidates().
+*/
+
+namespace realm {
+
+class GeoRegion;
+
+class GeospatialIndex : public SearchIndex {
+public:
+    // Create a new, empty index
+    GeospatialIndex(const ClusterColumn& target_column, Allocator&);
+    // Attach to an existing index
+    GeospatialIndex(ref_type, ArrayParent*, size_t ndx_in_parent, const ClusterColumn& target_column, Allocator&);
+
+    static bool type_supported(ColKey col_key)
+    {
+        return col_key.is_list() && col_key.get_type() == col_type_Double;
+    }
+
+    // SearchIndex interface:
+
+    // Add the point currently held by the list of the object. The value is ignored.
+    void insert(ObjKey key, const Mixed& value) final;
+    void set(ObjKey key, const Mixed& new_value) final;
+    ObjKey find_first(const Mixed& value) const final;
+    void find_all(std::vector<ObjKey>& result, Mixed value, bool case_insensitive = false) const final;
+    FindRes find_all_no_copy(Mixed value, InternalFindResult& result) const final;
+    size_t count(const Mixed& value) const final;
+    // Remove the point currently held by the list of the object
+    void erase(ObjKey key) final;
+    void clear() final;
+    bool has_duplicate_values() const noexcept final;
+    bool is_empty() const final;
+    void insert_bulk(const ArrayUnsigned* keys, uint64_t key_offset, size_t num_values,
+                     ArrayPayload& values) final;
+    void insert_bulk_list(const ArrayUnsigned* keys, uint64_t key_offset, size_t num_values,
+                          ArrayInteger& ref_array) final;
+    void insert_all(std::vector<Entry>& entries) final;
+    void verify() const final;
+
+#ifdef REALM_DEBUG
+    void print() const final;
+#endif // REALM_DEBUG
+
+    // Number of entries in the index
+    size_t size() const;
+
+    // Append the keys of the objects whose point is in a cell covering the region, sorted by
+    // key. The result is a superset of the objects within the region, so the points of the
+    // candidates must still be tested against the region.
+    void find_candidates(const GeoRegion& region, std::vector<ObjKey>& result) const;
+
+private:
+    class Entries;
+
+    Array m_top;
+
+    std::optional<int64_t> get_cell(ObjKey key) const;
+    size_t find_position(const Entries& entries, int64_t cell, ObjKey key) const;
+};
+
+} // namespace realm
+
+#endif // REALM_INDEX_GEOSPATIAL_HPP
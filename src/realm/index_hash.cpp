@@ -0,0 +1,416 @@
+/*************************************************************************
+ *
+ * Copyright 2023 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+#include <realm/index_hash.hpp>
+#include <realm/array_integer.hpp>
+
+#include <algorithm>
+#include <iostream>
+
+using namespace realm;
+
+HashIndex::HashIndex(const ClusterColumn& target_column, Allocator& alloc)
+    : SearchIndex(target_column, &m_top)
+    , m_top(alloc)
+{
+    m_top.create(Array::type_HasRefs, false, 2); // Throws
+    try {
+        set_size(0);
+        create_pages(s_min_capacity_bits); // Throws
+    }
+    catch (...) {
+        m_top.destroy_deep();
+        throw;
+    }
+}
+
+HashIndex::HashIndex(ref_type ref, ArrayParent* parent, size_t ndx_in_parent, const ClusterColumn& target_column,
+                     Allocator& alloc)
+    : SearchIndex(target_column, &m_top)
+    , m_top(alloc)
+{
+    m_top.init_from_ref(ref);
+    m_top.set_parent(parent, ndx_in_parent);
+}
+
+uint32_t HashIndex::hash(const Mixed& value)
+{
+    // FNV-1a over the bytes of the value
+    uint64_t h = 0xcbf29ce484222325ULL;
+    auto add = [&h](const unsigned char* data, size_t size) {
+        for (size_t i = 0; i < size; ++i) {
+            h ^= data[i];
+            h *= 0x100000001b3ULL;
+        }
+    };
+
+    if (!value.is_null()) {
+        switch (value.get_type()) {
+            case type_Int: {
+                // Little endian on all platforms
+                uint64_t v = uint64_t(value.get_int());
+                unsigned char bytes[8];
+                for (size_t i = 0; i < 8; ++i) {
+                    bytes[i] = static_cast<unsigned char>(v >> (8 * i));
+                }
+                add(bytes, 8);
+                break;
+            }
+            case type_String: {
+                StringData str = value.get_string();
+                add(reinterpret_cast<const unsigned char*>(str.data()), str.size());
+                break;
+            }
+            case type_ObjectId: {
+                auto bytes = value.get_object_id().to_bytes();
+                add(bytes.data(), bytes.size());
+                break;
+            }
+            case type_UUID: {
+                auto bytes = value.get_uuid().to_bytes();
+                add(bytes.data(), bytes.size());
+                break;
+            }
+            default:
+                REALM_UNREACHABLE();
+        }
+    }
+
+    // FNV mixes the low bits poorly, so finish with the MurmurHash3 finalizer
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return uint32_t(h & 0x7fffffff);
+}
+
+size_t HashIndex::size() const
+{
+    return size_t(m_top.get_as_ref_or_tagged(0).get_as_int());
+}
+
+size_t HashIndex::capacity() const
+{
+    return size_t(1) << get_capacity_bits();
+}
+
+bool HashIndex::is_empty() const
+{
+    return size() == 0;
+}
+
+bool HashIndex::get_slot(size_t ndx, uint32_t& h, ObjKey& key) const
+{
+    ref_type ref = m_top.get_as_ref(2 + (ndx >> s_page_bits));
+    const char* header = m_top.get_alloc().translate(ref);
+    size_t offset = 2 * (ndx & ((size_t(1) << s_page_bits) - 1));
+    int64_t stored_hash = Array::get(header, offset);
+    if (stored_hash == 0)
+        return false;
+    h = uint32_t(stored_hash - 1);
+    key = ObjKey(Array::get(header, offset + 1));
+    return true;
+}
+
+void HashIndex::set_slot(size_t ndx, uint32_t h, ObjKey key)
+{
+    Array page(m_top.get_alloc());
+    page.set_parent(&m_top, 2 + (ndx >> s_page_bits));
+    page.init_from_parent();
+    size_t offset = 2 * (ndx & ((size_t(1) << s_page_bits) - 1));
+    page.set(offset, int64_t(h) + 1); // Throws
+    page.set(offset + 1, key.value);  // Throws
+}
+
+void HashIndex::clear_slot(size_t ndx)
+{
+    Array page(m_top.get_alloc());
+    page.set_parent(&m_top, 2 + (ndx >> s_page_bits));
+    page.init_from_parent();
+    size_t offset = 2 * (ndx & ((size_t(1) << s_page_bits) - 1));
+    page.set(offset, 0);     // Throws
+    page.set(offset + 1, 0); // Throws
+}
+
+template <class F>
+bool HashIndex::for_each_candidate(uint32_t h, F&& func) const
+{
+    // The table is never full, so the probe sequence always ends in an empty slot
+    size_t mask = capacity() - 1;
+    uint32_t slot_hash;
+    ObjKey key;
+    for (size_t ndx = h & mask; get_slot(ndx, slot_hash, key); ndx = (ndx + 1) & mask) {
+        if (slot_hash == h && func(key, ndx))
+            return true;
+    }
+    return false;
+}
+
+bool HashIndex::matches(ObjKey key, const Mixed& value) const
+{
+    Mixed stored = m_target_column.get_value(key);
+    return stored.is_null() == value.is_null() && stored == value;
+}
+
+void HashIndex::create_pages(size_t capacity_bits)
+{
+    REALM_ASSERT_3(m_top.size(), ==, 2);
+    size_t page_bits = std::min(capacity_bits, s_page_bits);
+    size_t num_pages = size_t(1) << (capacity_bits - page_bits);
+    m_top.set(1, RefOrTagged::make_tagged(capacity_bits)); // Throws
+    for (size_t i = 0; i < num_pages; ++i) {
+        Array page(m_top.get_alloc());
+        page.create(Array::type_Normal, false, size_t(2) << page_bits, 0); // Throws
+        m_top.add(page.get_ref());                                          // Throws
+    }
+}
+
+void HashIndex::destroy_pages()
+{
+    m_top.truncate_and_destroy_children(2);
+}
+
+void HashIndex::reserve(size_t num_entries)
+{
+    // Keep the load factor at or below 3/4
+    size_t bits = get_capacity_bits();
+    size_t new_bits = bits;
+    while (num_entries * 4 > (size_t(3) << new_bits)) {
+        ++new_bits;
+    }
+    if (new_bits == bits)
+        return;
+
+    std::vector<std::pair<uint32_t, ObjKey>> entries;
+    entries.reserve(size());
+    size_t cap = capacity();
+    uint32_t h;
+    ObjKey key;
+    for (size_t ndx = 0; ndx < cap; ++ndx) {
+        if (get_slot(ndx, h, key))
+            entries.emplace_back(h, key);
+    }
+
+    destroy_pages();
+    create_pages(new_bits); // Throws
+    for (auto& entry : entries) {
+        do_insert(entry.first, entry.second);
+    }
+}
+
+void HashIndex::do_insert(uint32_t h, ObjKey key)
+{
+    size_t mask = capacity() - 1;
+    uint32_t slot_hash;
+    ObjKey slot_key;
+    size_t ndx = h & mask;
+    while (get_slot(ndx, slot_hash, slot_key)) {
+        ndx = (ndx + 1) & mask;
+    }
+    set_slot(ndx, h, key);
+}
+
+void HashIndex::insert(ObjKey key, const Mixed& value)
+{
+    size_t sz = size();
+    reserve(sz + 1);             // Throws
+    do_insert(hash(value), key); // Throws
+    set_size(sz + 1);
+}
+
+void HashIndex::set(ObjKey key, const Mixed& new_value)
+{
+    Mixed old_value = m_target_column.get_value(key);
+    if (old_value == new_value && old_value.is_null() == new_value.is_null())
+        return;
+
+    do_erase(key, old_value);
+    insert(key, new_value);
+}
+
+void HashIndex::erase(ObjKey key)
+{
+    do_erase(key, m_target_column.get_value(key));
+}
+
+void HashIndex::do_erase(ObjKey key, const Mixed& value)
+{
+    size_t ndx = 0;
+    bool found = for_each_candidate(hash(value), [&](ObjKey candidate, size_t candidate_ndx) {
+        ndx = candidate_ndx;
+        return candidate == key;
+    });
+    REALM_ASSERT(found);
+
+    // Move later entries of the probe sequence back into the hole, so that lookups
+    // can keep stopping at the first empty slot
+    size_t mask = capacity() - 1;
+    uint32_t h;
+    ObjKey moved;
+    for (size_t next = (ndx + 1) & mask; get_slot(next, h, moved); next = (next + 1) & mask) {
+        size_t home = h & mask;
+        bool home_in_range = ndx <= next ? (ndx < home && home <= next) : (ndx < home || home <= next);
+        if (!home_in_range) {
+            set_slot(ndx, h, moved);
+            ndx = next;
+        }
+    }
+    clear_slot(ndx);
+    set_size(size() - 1);
+}
+
+void HashIndex::clear()
+{
+    destroy_pages();
+    set_size(0);
+    create_pages(s_min_capacity_bits); // Throws
+}
+
+ObjKey HashIndex::find_first(const Mixed& value) const
+{
+    ObjKey result;
+    for_each_candidate(hash(value), [&](ObjKey key, size_t) {
+        if (!matches(key, value))
+            return false;
+        result = key;
+        return true;
+    });
+    return result;
+}
+
+void HashIndex::find_all(std::vector<ObjKey>& result, Mixed value, bool) const
+{
+    size_t first = result.size();
+    for_each_candidate(hash(value), [&](ObjKey key, size_t) {
+        if (matches(key, value))
+            result.push_back(key);
+        return false;
+    });
+    std::sort(result.begin() + first, result.end());
+}
+
+FindRes HashIndex::find_all_no_copy(Mixed value, InternalFindResult& result) const
+{
+    // The values of a primary key are unique, so there is at most one match
+    ObjKey key = find_first(value);
+    if (!key)
+        return FindRes_not_found;
+    result.payload = key.value;
+    return FindRes_single;
+}
+
+size_t HashIndex::count(const Mixed& value) const
+{
+    size_t cnt = 0;
+    for_each_candidate(hash(value), [&](ObjKey key, size_t) {
+        if (matches(key, value))
+            ++cnt;
+        return false;
+    });
+    return cnt;
+}
+
+bool HashIndex::has_duplicate_values() const noexcept
+{
+    size_t cap = capacity();
+    uint32_t h;
+    ObjKey key;
+    for (size_t ndx = 0; ndx < cap; ++ndx) {
+        if (!get_slot(ndx, h, key))
+            continue;
+        Mixed value = m_target_column.get_value(key);
+        bool duplicate = for_each_candidate(h, [&](ObjKey other, size_t) {
+            return other != key && matches(other, value);
+        });
+        if (duplicate)
+            return true;
+    }
+    return false;
+}
+
+void HashIndex::insert_bulk(const ArrayUnsigned* keys, uint64_t key_offset, size_t num_values, ArrayPayload& values)
+{
+    reserve(size() + num_values); // Throws
+    for (size_t i = 0; i < num_values; ++i) {
+        ObjKey key(keys ? keys->get(i) + key_offset : i + key_offset);
+        insert(key, values.get_any(i));
+    }
+}
+
+void HashIndex::insert_all(std::vector<Entry>& entries)
+{
+    REALM_ASSERT(is_empty());
+    // Size the table up front, so that no entry is moved more than once
+    reserve(entries.size()); // Throws
+    for (auto& entry : entries) {
+        do_insert(hash(entry.value), entry.key);
+    }
+    set_size(entries.size());
+}
+
+void HashIndex::insert_bulk_list(const ArrayUnsigned*, uint64_t, size_t, ArrayInteger&)
+{
+    // Collections are not supported by this index
+    REALM_UNREACHABLE();
+}
+
+void HashIndex::verify() const
+{
+#ifdef REALM_DEBUG
+    m_top.verify();
+    REALM_ASSERT(m_top.has_refs());
+    size_t bits = get_capacity_bits();
+    size_t page_bits = std::min(bits, s_page_bits);
+    REALM_ASSERT_3(m_top.size(), ==, 2 + (size_t(1) << (bits - page_bits)));
+
+    size_t cap = capacity();
+    size_t mask = cap - 1;
+    size_t used = 0;
+    uint32_t h;
+    ObjKey key;
+    for (size_t ndx = 0; ndx < cap; ++ndx) {
+        if (!get_slot(ndx, h, key))
+            continue;
+        ++used;
+        REALM_ASSERT_3(h, ==, hash(m_target_column.get_value(key)));
+        // All slots between the home slot and the actual slot must be in use
+        uint32_t other_hash;
+        ObjKey other_key;
+        for (size_t probe = h & mask; probe != ndx; probe = (probe + 1) & mask) {
+            REALM_ASSERT(get_slot(probe, other_hash, other_key));
+        }
+    }
+    REALM_ASSERT_3(used, ==, size());
+    REALM_ASSERT_3(used * 4, <=, cap * 3);
+#endif
+}
+
+#ifdef REALM_DEBUG
+void HashIndex::print() const
+{
+    size_t cap = capacity();
+    std::cout << "HashIndex: " << size() << " entries in " << cap << " slots" << std::endl;
+    uint32_t h;
+    ObjKey key;
+    for (size_t ndx = 0; ndx < cap; ++ndx) {
+        if (get_slot(ndx, h, key))
+            std::cout << "  " << ndx << ": " << h << " -> " << key << std::endl;
+    }
+}
+#endif // REALM_DEBUG
@@ -0,0 +1,128 @@
+/*************************************************************************
+ *
+ * Copyright 2023 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+#ifndef REALM_INDEX_HASH_HPP
+#define REALM_INDEX_HASH_HPP
+
+#include <realm/array.hpp>
+#include <realm/search_index.hpp>
+
+/*
+The HashIndex is an open addressing hash table mapping the values of the primary key column
+to the keys of the objects holding them. Lookups, insertions and deletions take constant
+expected time regardless of the size of the table.
+
+The index consists of a top array:
+
+    [0] number of entries (tagged)
+    [1] log2 of the number of slots (tagged)
+    [2..] refs to the pages holding the slots
+
+A slot is a pair of integers (hash + 1, key) stored next to each other in a page. A hash of
+zero marks an empty slot. The slots are split over several pages as a single array can only
+hold a limited number of elements. Collisions are resolved by linear probing, and the table is
+doubled when it becomes three quarters full. The stored hashes make it possible to rehash
+without looking up the values, and to skip most of the value comparisons during lookup.
+
+The hash of a value only depends on its bytes, so the layout is the same on all platforms.
+
+Only non-collection columns of type Int, String, ObjectId and UUID are supported, and only as
+the index of the primary key column, where all values are unique.
+*/
+
+namespace realm {
+
+class HashIndex : public SearchIndex {
+public:
+    // Create a new, empty index
+    HashIndex(const ClusterColumn& target_column, Allocator&);
+    // Attach to an existing index
+    HashIndex(ref_type, ArrayParent*, size_t ndx_in_parent, const ClusterColumn& target_column, Allocator&);
+
+    static bool type_supported(ColKey col_key)
+    {
+        auto type = col_key.get_type();
+        return !col_key.is_collection() && (type == col_type_Int || type == col_type_String ||
+                                            type == col_type_ObjectId || type == col_type_UUID);
+    }
+
+    // SearchIndex interface:
+
+    void insert(ObjKey key, const Mixed& value) final;
+    void set(ObjKey key, const Mixed& new_value) final;
+    ObjKey find_first(const Mixed& value) const final;
+    void find_all(std::vector<ObjKey>& result, Mixed value, bool case_insensitive = false) const final;
+    FindRes find_all_no_copy(Mixed value, InternalFindResult& result) const final;
+    size_t count(const Mixed& value) const final;
+    void erase(ObjKey key) final;
+    void clear() final;
+    bool has_duplicate_values() const noexcept final;
+    bool is_empty() const final;
+    void insert_bulk(const ArrayUnsigned* keys, uint64_t key_offset, size_t num_values,
+                     ArrayPayload& values) final;
+    void insert_bulk_list(const ArrayUnsigned* keys, uint64_t key_offset, size_t num_values,
+                          ArrayInteger& ref_array) final;
+    void insert_all(std::vector<Entry>& entries) final;
+    void verify() const final;
+
+#ifdef REALM_DEBUG
+    void print() const final;
+#endif // REALM_DEBUG
+
+    // Number of entries in the index
+    size_t size() const;
+    // Number of slots in the table
+    size_t capacity() const;
+
+    // The hash of a value as stored in the index. Only depends on the bytes of the value.
+    static uint32_t hash(const Mixed& value);
+
+private:
+    static constexpr size_t s_min_capacity_bits = 4;
+    static constexpr size_t s_page_bits = 11;
+
+    Array m_top;
+
+    size_t get_capacity_bits() const
+    {
+        return size_t(m_top.get_as_ref_or_tagged(1).get_as_int());
+    }
+    void set_size(size_t size)
+    {
+        m_top.set(0, RefOrTagged::make_tagged(size));
+    }
+
+    // Read the slot at `ndx`. Returns false if the slot is empty.
+    bool get_slot(size_t ndx, uint32_t& h, ObjKey& key) const;
+    void set_slot(size_t ndx, uint32_t h, ObjKey key);
+    void clear_slot(size_t ndx);
+
+    // Call `func` with the key of every entry whose hash is `h`, until it returns true
+    template <class F>
+    bool for_each_candidate(uint32_t h, F&& func) const;
+    bool matches(ObjKey key, const Mixed& value) const;
+    void create_pages(size_t capacity_bits);
+    void destroy_pages();
+    void reserve(size_t num_entries);
+    void do_insert(uint32_t h, ObjKey key);
+    void do_erase(ObjKey key, const Mixed& value);
+};
+
+} // namespace realm
+
+#endif // REALM_INDEX_HASH_HPP
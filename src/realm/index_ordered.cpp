@@ -0,0 +1,310 @@
+/*************************************************************************
+ *
+ * Copyright 2023 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+#include <realm/index_ordered.hpp>
+#include <realm/bplustree.hpp>
+#include <realm/array_mixed.hpp>
+#include <realm/array_integer.hpp>
+
+#include <iostream>
+
+using namespace realm;
+
+// Accessors for the two trees of the index. They are created on demand for each
+// operation, as the trees may have been modified through other accessors since
+// the last time the index was used.
+class OrderedIndex::Entries {
+public:
+    Entries(const Array& top)
+        : values(top.get_alloc())
+        , keys(top.get_alloc())
+    {
+        // The parent is only used to propagate changes of the root refs, which
+        // never happens through a const index.
+        auto parent = const_cast<Array*>(&top);
+        values.set_parent(parent, 0);
+        keys.set_parent(parent, 1);
+        values.init_from_parent();
+        keys.init_from_parent();
+    }
+
+    size_t size() const
+    {
+        return values.size();
+    }
+
+    // Range of the entries whose value compares equal to `value`, searched within [begin, end)
+    std::pair<size_t, size_t> equal_range(const Mixed& value, size_t begin, size_t end) const
+    {
+        begin = values.partition_point(begin, end, [&](const Mixed& v) {
+            return v.compare(value) < 0;
+        });
+        end = values.partition_point(begin, end, [&](const Mixed& v) {
+            return v.compare(value) <= 0;
+        });
+        return {begin, end};
+    }
+
+    BPlusTree<Mixed> values;
+    BPlusTree<int64_t> keys;
+};
+
+OrderedIndex::OrderedIndex(const ClusterColumn& target_column, Allocator& alloc)
+    : SearchIndex(target_column, &m_top)
+    , m_top(alloc)
+{
+    m_top.create(Array::type_HasRefs, false, 2); // Throws
+    try {
+        BPlusTree<Mixed> values(alloc);
+        values.set_parent(&m_top, 0);
+        values.create(); // Throws
+        BPlusTree<int64_t> keys(alloc);
+        keys.set_parent(&m_top, 1);
+        keys.create(); // Throws
+    }
+    catch (...) {
+        m_top.destroy_deep();
+        throw;
+    }
+}
+
+OrderedIndex::OrderedIndex(ref_type ref, ArrayParent* parent, size_t ndx_in_parent,
+                           const ClusterColumn& target_column, Allocator& alloc)
+    : SearchIndex(target_column, &m_top)
+    , m_top(alloc)
+{
+    m_top.init_from_ref(ref);
+    m_top.set_parent(parent, ndx_in_parent);
+}
+
+size_t OrderedIndex::find_position(const Entries& entries, const Mixed& value, ObjKey key) const
+{
+    // Equal values are ordered by key
+    auto [begin, end] = entries.equal_range(value, 0, entries.size());
+    return entries.keys.partition_point(begin, end, [&](int64_t k) {
+        return k < key.value;
+    });
+}
+
+void OrderedIndex::insert(ObjKey key, const Mixed& value)
+{
+    Entries entries(m_top);
+    size_t ndx = find_position(entries, value, key);
+    entries.values.insert(ndx, value);
+    entries.keys.insert(ndx, key.value);
+}
+
+void OrderedIndex::set(ObjKey key, const Mixed& new_value)
+{
+    Mixed old_value = m_target_column.get_value(key);
+    if (old_value == new_value && old_value.is_null() == new_value.is_null())
+        return;
+
+    do_erase(key, old_value);
+    insert(key, new_value);
+}
+
+void OrderedIndex::erase(ObjKey key)
+{
+    do_erase(key, m_target_column.get_value(key));
+}
+
+void OrderedIndex::do_erase(ObjKey key, const Mixed& value)
+{
+    Entries entries(m_top);
+    size_t ndx = find_position(entries, value, key);
+    REALM_ASSERT_3(ndx, <, entries.size());
+    REALM_ASSERT_3(entries.keys.get(ndx), ==, key.value);
+    entries.values.erase(ndx);
+    entries.keys.erase(ndx);
+}
+
+void OrderedIndex::clear()
+{
+    Entries entries(m_top);
+    entries.values.clear();
+    entries.keys.clear();
+}
+
+size_t OrderedIndex::size() const
+{
+    return Entries(m_top).size();
+}
+
+bool OrderedIndex::is_empty() const
+{
+    return size() == 0;
+}
+
+size_t OrderedIndex::lower_bound(const Mixed& value) const
+{
+    Entries entries(m_top);
+    return entries.values.partition_point(0, entries.size(), [&](const Mixed& v) {
+        return v.compare(value) < 0;
+    });
+}
+
+size_t OrderedIndex::upper_bound(const Mixed& value) const
+{
+    Entries entries(m_top);
+    return entries.values.partition_point(0, entries.size(), [&](const Mixed& v) {
+        return v.compare(value) <= 0;
+    });
+}
+
+void OrderedIndex::get_keys(size_t begin, size_t end, std::vector<ObjKey>& result) const
+{
+    REALM_ASSERT_3(begin, <=, end);
+    Entries entries(m_top);
+    REALM_ASSERT_3(end, <=, entries.size());
+    result.reserve(result.size() + (end - begin));
+    for (size_t ndx = begin; ndx < end; ++ndx) {
+        result.push_back(ObjKey(entries.keys.get(ndx)));
+    }
+}
+
+void OrderedIndex::for_each_in_order(bool ascending, util::FunctionRef<IteratorControl(ObjKey)> func) const
+{
+    Entries entries(m_top);
+    if (ascending) {
+        entries.keys.for_all([&](int64_t key) {
+            return func(ObjKey(key)) == IteratorControl::AdvanceToNext;
+        });
+        return;
+    }
+
+    // Walk backwards one run of equal values at a time, emitting each run in ascending key order
+    size_t end = entries.size();
+    while (end > 0) {
+        size_t begin = entries.equal_range(entries.values.get(end - 1), 0, end).first;
+        for (size_t ndx = begin; ndx < end; ++ndx) {
+            if (func(ObjKey(entries.keys.get(ndx))) == IteratorControl::Stop)
+                return;
+        }
+        end = begin;
+    }
+}
+
+ObjKey OrderedIndex::find_first(const Mixed& value) const
+{
+    Entries entries(m_top);
+    size_t ndx = entries.values.partition_point(0, entries.size(), [&](const Mixed& v) {
+        return v.compare(value) < 0;
+    });
+    if (ndx < entries.size() && entries.values.get(ndx).compare(value) == 0)
+        return ObjKey(entries.keys.get(ndx));
+    return {};
+}
+
+void OrderedIndex::find_all(std::vector<ObjKey>& result, Mixed value, bool) const
+{
+    Entries entries(m_top);
+    auto [begin, end] = entries.equal_range(value, 0, entries.size());
+    get_keys(begin, end, result);
+}
+
+FindRes OrderedIndex::find_all_no_copy(Mixed value, InternalFindResult& result) const
+{
+    Entries entries(m_top);
+    auto [begin, end] = entries.equal_range(value, 0, entries.size());
+    if (begin == end)
+        return FindRes_not_found;
+
+    if (end - begin == 1) {
+        result.payload = entries.keys.get(begin);
+        return FindRes_single;
+    }
+    // Equal values are ordered by key, so the range can be used directly
+    result.payload = int64_t(entries.keys.get_ref());
+    result.start_ndx = begin;
+    result.end_ndx = end;
+    return FindRes_column;
+}
+
+size_t OrderedIndex::count(const Mixed& value) const
+{
+    Entries entries(m_top);
+    auto [begin, end] = entries.equal_range(value, 0, entries.size());
+    return end - begin;
+}
+
+bool OrderedIndex::has_duplicate_values() const noexcept
+{
+    Entries entries(m_top);
+    size_t sz = entries.size();
+    for (size_t ndx = 1; ndx < sz; ++ndx) {
+        if (entries.values.get(ndx - 1) == entries.values.get(ndx))
+            return true;
+    }
+    return false;
+}
+
+void OrderedIndex::insert_bulk(const ArrayUnsigned* keys, uint64_t key_offset, size_t num_values,
+                               ArrayPayload& values)
+{
+    for (size_t i = 0; i < num_values; ++i) {
+        ObjKey key(keys ? keys->get(i) + key_offset : i + key_offset);
+        insert(key, values.get_any(i));
+    }
+}
+
+void OrderedIndex::insert_all(std::vector<Entry>& entries)
+{
+    REALM_ASSERT(is_empty());
+    // The entries are sorted in the same order as the index, so they can be appended
+    sort_entries(entries);
+    Entries index_entries(m_top);
+    for (auto& entry : entries) {
+        index_entries.values.add(entry.value);
+        index_entries.keys.add(entry.key.value);
+    }
+}
+
+void OrderedIndex::insert_bulk_list(const ArrayUnsigned*, uint64_t, size_t, ArrayInteger&)
+{
+    // Collections are not supported by this index
+    REALM_UNREACHABLE();
+}
+
+void OrderedIndex::verify() const
+{
+#ifdef REALM_DEBUG
+    m_top.verify();
+    REALM_ASSERT(m_top.has_refs());
+    REALM_ASSERT_3(m_top.size(), ==, 2);
+    Entries entries(m_top);
+    size_t sz = entries.size();
+    REALM_ASSERT_3(entries.keys.size(), ==, sz);
+    for (size_t ndx = 1; ndx < sz; ++ndx) {
+        int cmp = entries.values.get(ndx - 1).compare(entries.values.get(ndx));
+        REALM_ASSERT(cmp < 0 || (cmp == 0 && entries.keys.get(ndx - 1) < entries.keys.get(ndx)));
+    }
+#endif
+}
+
+#ifdef REALM_DEBUG
+void OrderedIndex::print() const
+{
+    Entries entries(m_top);
+    size_t sz = entries.size();
+    std::cout << "OrderedIndex: " << sz << " entries" << std::endl;
+    for (size_t ndx = 0; ndx < sz; ++ndx) {
+        std::cout << "  " << entries.values.get(ndx) << " -> " << ObjKey(entries.keys.get(ndx)) << std::endl;
+    }
+}
+#endif // REALM_DEBUG
@@ -0,0 +1,106 @@
+/*************************************************************************
+ *
+ * Copyright 2023 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+#ifndef REALM_INDEX_ORDERED_HPP
+#define REALM_INDEX_ORDERED_HPP
+
+#include <realm/array.hpp>
+#include <realm/search_index.hpp>
+#include <realm/util/function_ref.hpp>
+
+/*
+The OrderedIndex keeps the values of a column sorted, so that it can answer range lookups
+(greater/less than) in addition to equality lookups, and so that objects can be visited in
+the order of their values without sorting them first.
+
+The index consists of a top array holding two B+ trees of equal size:
+
+    [0] values: BPlusTree<Mixed>, sorted ascending using Mixed::compare (null first)
+    [1] keys:   BPlusTree<Int>, the ObjKey of the object holding the value at the same position
+
+Entries with equal values are ordered by key, so any run of equal values is a sorted list of
+keys. This allows equality lookups to hand out a range of the key tree directly.
+
+Only non-collection columns of type Int and Timestamp are supported.
+*/
+
+namespace realm {
+
+class OrderedIndex : public SearchIndex {
+public:
+    // Create a new, empty index
+    OrderedIndex(const ClusterColumn& target_column, Allocator&);
+    // Attach to an existing index
+    OrderedIndex(ref_type, ArrayParent*, size_t ndx_in_parent, const ClusterColumn& target_column, Allocator&);
+
+    static bool type_supported(ColKey col_key)
+    {
+        auto type = col_key.get_type();
+        return !col_key.is_collection() && (type == col_type_Int || type == col_type_Timestamp);
+    }
+
+    // SearchIndex interface:
+
+    void insert(ObjKey key, const Mixed& value) final;
+    void set(ObjKey key, const Mixed& new_value) final;
+    ObjKey find_first(const Mixed& value) const final;
+    void find_all(std::vector<ObjKey>& result, Mixed value, bool case_insensitive = false) const final;
+    FindRes find_all_no_copy(Mixed value, InternalFindResult& result) const final;
+    size_t count(const Mixed& value) const final;
+    void erase(ObjKey key) final;
+    void clear() final;
+    bool has_duplicate_values() const noexcept final;
+    bool is_empty() const final;
+    void insert_bulk(const ArrayUnsigned* keys, uint64_t key_offset, size_t num_values,
+                     ArrayPayload& values) final;
+    void insert_bulk_list(const ArrayUnsigned* keys, uint64_t key_offset, size_t num_values,
+                          ArrayInteger& ref_array) final;
+    void insert_all(std::vector<Entry>& entries) final;
+    void verify() const final;
+
+#ifdef REALM_DEBUG
+    void print() const final;
+#endif // REALM_DEBUG
+
+    // Ordered access:
+
+    // Number of entries in the index
+    size_t size() const;
+    // Position of the first entry with a value not less than `value`
+    size_t lower_bound(const Mixed& value) const;
+    // Position of the first entry with a value greater than `value`
+    size_t upper_bound(const Mixed& value) const;
+    // Append the keys of the entries in [begin, end) to `result` in index order
+    void get_keys(size_t begin, size_t end, std::vector<ObjKey>& result) const;
+    // Call `func` with the keys of all entries, ordered by value. Entries with equal values are
+    // visited in ascending key order also when `ascending` is false, which matches the stable
+    // ordering of a sort. Iteration stops when `func` returns IteratorControl::Stop.
+    void for_each_in_order(bool ascending, util::FunctionRef<IteratorControl(ObjKey)> func) const;
+
+private:
+    class Entries;
+
+    Array m_top;
+
+    size_t find_position(const Entries& entries, const Mixed& value, ObjKey key) const;
+    void do_erase(ObjKey key, const Mixed& value);
+};
+
+} // namespace realm
+
+#endif // REALM_INDEX_ORDERED_HPP
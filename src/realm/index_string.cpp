@@ -19,6 +19,7 @@
 #include <cstdio>
 #include <iomanip>
 #include <list>
+#include <thread>
 
 #ifdef REALM_DEBUG
 #include <iostream>
@@ -113,6 +114,11 @@ Lst<String> ClusterColumn::get_list(ObjKey key) const
     return obj.get_list<String>(m_column_key);
 }
 
+Obj ClusterColumn::get_object(ObjKey key) const
+{
+    return m_cluster_tree->get(key);
+}
+
 std::vector<ObjKey> ClusterColumn::get_all_keys() const
 {
     std::vector<ObjKey> ret;
@@ -1584,6 +1590,150 @@ void StringIndex::find_all_fulltext(std::vector<ObjKey>& result, StringData valu
     }
 }
 
+void StringIndex::insert_all(std::vector<Entry>& entries)
+{
+    REALM_ASSERT(is_empty());
+    if (m_target_column.full_word()) {
+        // Tokenized values do not map one to one to the entries
+        for (auto& entry : entries) {
+            insert(entry.key, entry.value);
+        }
+        return;
+    }
+    if (entries.empty())
+        return;
+
+    sort_entries(entries);
+    Allocator& alloc = m_array->get_alloc();
+    ref_type ref = build_from_sorted(alloc, entries.data(), entries.data() + entries.size(), 0);
+    m_array->destroy_deep();
+    m_array->init_from_ref(ref);
+    m_array->update_parent();
+}
+
+ref_type StringIndex::build_from_sorted(Allocator& alloc, Entry* begin, Entry* end, size_t offset)
+{
+    auto chunk = [offset](const Entry& entry) {
+        StringConversionBuffer buffer;
+        return create_key(entry.value.get_index_data(buffer), offset);
+    };
+    auto same_index_data = [](const Entry* first, const Entry* last) {
+        StringConversionBuffer buffer;
+        StringData index_data = first->value.get_index_data(buffer);
+        return std::all_of(first + 1, last, [&](const Entry& entry) {
+            StringConversionBuffer buffer_2;
+            return entry.value.get_index_data(buffer_2) == index_data;
+        });
+    };
+
+    // The slots are ordered by key, while the values sharing a key stay ordered by value
+    const size_t num_entries = end - begin;
+    std::vector<std::pair<key_type, size_t>> chunks;
+    chunks.reserve(num_entries);
+    for (size_t i = 0; i < num_entries; ++i) {
+        chunks.emplace_back(chunk(begin[i]), i);
+    }
+    auto by_chunk = [](const std::pair<key_type, size_t>& a, const std::pair<key_type, size_t>& b) {
+        return a.first < b.first;
+    };
+    if (!std::is_sorted(chunks.begin(), chunks.end(), by_chunk)) {
+        std::stable_sort(chunks.begin(), chunks.end(), by_chunk);
+        std::vector<Entry> sorted;
+        sorted.reserve(num_entries);
+        for (auto& c : chunks) {
+            sorted.push_back(std::move(begin[c.second]));
+        }
+        std::move(sorted.begin(), sorted.end(), begin);
+    }
+
+    // Create the slot of each key. This gives the same structure as inserting the
+    // values one by one.
+    std::vector<std::pair<key_type, int64_t>> slots;
+    for (size_t group_begin = 0; group_begin < num_entries;) {
+        key_type key = chunks[group_begin].first;
+        size_t group_end = group_begin + 1;
+        while (group_end < num_entries && chunks[group_end].first == key)
+            ++group_end;
+        Entry* group = begin + group_begin;
+        Entry* group_last = begin + group_end;
+        int64_t slot;
+        if (group_end - group_begin == 1) {
+            slot = int64_t((uint64_t(group->key.value) << 1) + 1); // shift to indicate literal
+        }
+        else if (offset + s_index_key_length > s_max_offset || same_index_data(group, group_last)) {
+            // A list of duplicates, or of values sharing a long prefix, sorted by value and then by key
+            IntegerColumn list(alloc);
+            list.create(); // Throws
+            for (Entry* entry = group; entry != group_last; ++entry) {
+                list.add(entry->key.value);
+            }
+            slot = int64_t(list.get_ref());
+        }
+        else {
+            slot = int64_t(build_from_sorted(alloc, group, group_last, offset + s_index_key_length));
+        }
+        slots.emplace_back(key, slot);
+        group_begin = group_end;
+    }
+
+    // Pack the slots into full leaves, and add levels of inner nodes until there is a single root
+    bool is_leaf = true;
+    for (;;) {
+        std::vector<std::pair<key_type, int64_t>> nodes;
+        for (size_t begin_ndx = 0; begin_ndx < slots.size(); begin_ndx += REALM_MAX_BPNODE_SIZE) {
+            size_t end_ndx = std::min(slots.size(), begin_ndx + REALM_MAX_BPNODE_SIZE);
+            std::unique_ptr<IndexArray> node = create_node(alloc, is_leaf); // Throws
+            Array keys(alloc);
+            get_child(*node, 0, keys);
+            for (size_t i = begin_ndx; i < end_ndx; ++i) {
+                keys.add(slots[i].first);
+                node->add(slots[i].second);
+            }
+            nodes.emplace_back(slots[end_ndx - 1].first, int64_t(node->get_ref()));
+        }
+        if (nodes.size() == 1)
+            return ref_type(nodes.front().second);
+        slots = std::move(nodes);
+        is_leaf = false;
+    }
+}
+
+void SearchIndex::sort_entries(std::vector<Entry>& entries)
+{
+    // Below this number of entries per thread it is faster to sort on a single thread
+    constexpr size_t min_entries_per_thread = 50000;
+
+    auto less = [](const Entry& a, const Entry& b) {
+        int cmp = a.value.compare(b.value);
+        return cmp < 0 || (cmp == 0 && a.key < b.key);
+    };
+    size_t num_threads =
+        std::min(size_t(std::thread::hardware_concurrency()), entries.size() / min_entries_per_thread);
+    if (num_threads < 2) {
+        std::sort(entries.begin(), entries.end(), less);
+        return;
+    }
+
+    // Sort a part of the entries on each thread, then merge the parts pairwise
+    std::vector<std::vector<Entry>::iterator> bounds;
+    for (size_t i = 0; i <= num_threads; ++i) {
+        bounds.push_back(entries.begin() + entries.size() * i / num_threads);
+    }
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < num_threads; ++i) {
+        threads.emplace_back([&, i] {
+            std::sort(bounds[i], bounds[i + 1], less);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (size_t width = 1; width < num_threads; width *= 2) {
+        for (size_t i = 0; i + width < num_threads; i += 2 * width) {
+            std::inplace_merge(bounds[i], bounds[i + width], bounds[std::min(i + 2 * width, num_threads)], less);
+        }
+    }
+}
 
 void StringIndex::clear()
 {
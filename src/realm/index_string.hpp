@@ -156,6 +156,7 @@ public:
     void insert_bulk(const ArrayUnsigned* keys, uint64_t key_offset, size_t num_values, ArrayPayload& values) final;
     void insert_bulk_list(const ArrayUnsigned* keys, uint64_t key_offset, size_t num_values,
                           ArrayInteger& ref_array) final;
+    void insert_all(std::vector<Entry>& entries) final;
 
     void find_all_fulltext(std::vector<ObjKey>& result, StringData value) const;
 
@@ -215,6 +216,9 @@ private:
     }
 
     static std::unique_ptr<IndexArray> create_node(Allocator&, bool is_leaf);
+    // Build the (sub)index holding entries which are sorted by value and share the
+    // first `offset` bytes of index data. Returns the ref of the root node.
+    static ref_type build_from_sorted(Allocator&, Entry* begin, Entry* end, size_t offset);
 
     void insert_with_offset(ObjKey key, StringData index_data, const Mixed& value, size_t offset);
     void insert_row_list(size_t ref, size_t offset, StringData value);
@@ -210,6 +210,30 @@ inline void Lst<StringData>::do_clear()
     m_tree->clear();
 }
 
+/******************************* Lst<double> ********************************/
+
+template <>
+SearchIndex* Lst<double>::erase_from_point_index(size_t ndx)
+{
+    // Only the first two elements make up the point
+    if (ndx >= 2)
+        return nullptr;
+    // A list of doubles can only have a geospatial index
+    auto index = get_table_unchecked()->get_search_index(m_col_key);
+    if (index) {
+        index->erase(get_owner_key());
+    }
+    return index;
+}
+
+template <>
+void Lst<double>::insert_into_point_index(SearchIndex* index)
+{
+    if (index) {
+        index->insert(get_owner_key(), Mixed());
+    }
+}
+
 /********************************* Lst<Key> *********************************/
 
 template <>
@@ -42,6 +42,7 @@ namespace realm {
 class TableView;
 class SortDescriptor;
 class Group;
+class SearchIndex;
 template <class>
 class Lst;
 
@@ -243,6 +244,13 @@ protected:
     void do_remove(size_t ndx);
     void do_clear();
 
+    // A list of doubles may hold the coordinates of a point in a geospatial
+    // index. If a change from position `ndx` may move the point, the owner is
+    // removed from the index, which is returned so that the owner can be
+    // inserted again once the list has been changed. No-ops for other types.
+    SearchIndex* erase_from_point_index(size_t ndx);
+    void insert_into_point_index(SearchIndex* index);
+
     // BPlusTree must be wrapped in an `std::unique_ptr` because it is not
     // default-constructible, due to its `Allocator&` member.
     mutable std::unique_ptr<BPlusTree<T>> m_tree;
@@ -548,6 +556,11 @@ template <>
 void Lst<StringData>::do_remove(size_t);
 template <>
 void Lst<StringData>::do_clear();
+// Specialization of Lst<double>:
+template <>
+SearchIndex* Lst<double>::erase_from_point_index(size_t);
+template <>
+void Lst<double>::insert_into_point_index(SearchIndex*);
 // Specialization of Lst<ObjKey>:
 template <>
 void Lst<ObjKey>::do_set(size_t, ObjKey);
@@ -870,28 +883,47 @@ inline Mixed Lst<T>::get_any(size_t ndx) const
     return get(ndx);
 }
 
+template <class T>
+inline SearchIndex* Lst<T>::erase_from_point_index(size_t)
+{
+    return nullptr;
+}
+
+template <class T>
+inline void Lst<T>::insert_into_point_index(SearchIndex*)
+{
+}
+
 template <class T>
 inline void Lst<T>::do_set(size_t ndx, T value)
 {
+    auto index = erase_from_point_index(ndx);
     m_tree->set(ndx, value);
+    insert_into_point_index(index);
 }
 
 template <class T>
 inline void Lst<T>::do_insert(size_t ndx, T value)
 {
+    auto index = erase_from_point_index(ndx);
     m_tree->insert(ndx, value);
+    insert_into_point_index(index);
 }
 
 template <class T>
 inline void Lst<T>::do_remove(size_t ndx)
 {
+    auto index = erase_from_point_index(ndx);
     m_tree->erase(ndx);
+    insert_into_point_index(index);
 }
 
 template <class T>
 inline void Lst<T>::do_clear()
 {
+    auto index = erase_from_point_index(0);
     m_tree->clear();
+    insert_into_point_index(index);
 }
 
 template <typename U>
@@ -1093,9 +1125,11 @@ void Lst<T>::move(size_t from, size_t to)
         // 'to' and 'from' points into the same array. In this case you cannot
         // set an entry with the result of a get from another entry in the same
         // leaf.
+        auto index = erase_from_point_index(std::min(from, to));
         m_tree->insert(to, BPlusTree<T>::default_value(m_nullable));
         m_tree->swap(from, to);
         m_tree->erase(from);
+        insert_into_point_index(index);
 
         bump_content_version();
     }
@@ -1112,7 +1146,9 @@ void Lst<T>::swap(size_t ndx1, size_t ndx2)
         if (Replication* repl = Base::get_replication()) {
             LstBase::swap_repl(repl, ndx1, ndx2);
         }
+        auto index = erase_from_point_index(std::min(ndx1, ndx2));
         m_tree->swap(ndx1, ndx2);
+        insert_into_point_index(index);
         bump_content_version();
     }
 }
@@ -653,6 +653,94 @@ size_t Mixed::hash() const
     return hash;
 }
 
+namespace {
+
+// A hash shared by all decimals comparing equal to `value`, and by the floats and
+// doubles comparing equal to it after being converted to a decimal. Fractions are
+// rounded to 7 digits like Decimal128(float) does, so that a float and the double
+// it converts to exactly also hash alike.
+size_t hash_decimal(const Decimal128& value) noexcept
+{
+    if (value.is_nan())
+        return 0x7ff8;
+    int64_t i;
+    if (value.to_int(i) && Decimal128(i) == value)
+        return std::hash<int64_t>()(i);
+
+    Decimal128::Bid128 coefficient;
+    int exponent;
+    bool sign;
+    value.unpack(coefficient, exponent, sign);
+    constexpr uint64_t infinity_bits = 0x7800000000000000;
+    if ((value.raw()->w[1] & infinity_bits) == infinity_bits)
+        return sign ? 0xfff0 : 0x7ff0;
+
+    // Drop the digits beyond the first 7, rounding half to even like the conversion does
+    constexpr uint64_t max_coefficient = 10'000'000;
+    uint64_t high = coefficient.w[1];
+    uint64_t low = coefficient.w[0];
+    uint64_t last_dropped = 0;
+    bool more_dropped = false;
+    while (high != 0 || low >= max_coefficient) {
+        uint32_t parts[4] = {uint32_t(high >> 32), uint32_t(high), uint32_t(low >> 32), uint32_t(low)};
+        uint64_t rest = 0;
+        for (auto& part : parts) {
+            uint64_t current = (rest << 32) | part;
+            part = uint32_t(current / 10);
+            rest = current % 10;
+        }
+        high = (uint64_t(parts[0]) << 32) | parts[1];
+        low = (uint64_t(parts[2]) << 32) | parts[3];
+        more_dropped = more_dropped || last_dropped != 0;
+        last_dropped = rest;
+        ++exponent;
+    }
+    if (last_dropped > 5 || (last_dropped == 5 && (more_dropped || low % 2))) {
+        if (++low == max_coefficient) {
+            low /= 10;
+            ++exponent;
+        }
+    }
+    // Equal values may differ in the number of trailing zeros
+    while (low != 0 && low % 10 == 0) {
+        low /= 10;
+        ++exponent;
+    }
+    return std::hash<uint64_t>()(low | (uint64_t(uint16_t(exponent)) << 32) | (uint64_t(sign) << 63));
+}
+
+size_t hash_numeric(double value, Decimal128::RoundTo digits) noexcept
+{
+    // Integral values hash as the integer they represent, which also makes 0.0 and -0.0 alike
+    if (value >= -9.2e18 && value <= 9.2e18 && std::trunc(value) == value)
+        return std::hash<int64_t>()(int64_t(value));
+    // Other values compare to decimals after being converted to a decimal
+    return hash_decimal(Decimal128(value, digits));
+}
+
+} // anonymous namespace
+
+size_t Mixed::compare_hash() const noexcept
+{
+    if (is_null())
+        return 0;
+
+    switch (get_type()) {
+        case type_Int:
+            return std::hash<int64_t>()(int_val);
+        case type_Float:
+            return hash_numeric(double(float_val), Decimal128::RoundTo::Digits7);
+        case type_Double:
+            return hash_numeric(double_val, Decimal128::RoundTo::Digits15);
+        case type_Decimal:
+            return hash_decimal(decimal_val);
+        case type_Link:
+            return std::hash<int64_t>()(get<ObjKey>().value);
+        default:
+            return hash();
+    }
+}
+
 StringData Mixed::get_index_data(std::array<char, 16>& buffer) const noexcept
 {
     if (is_null()) {
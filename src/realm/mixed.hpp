@@ -261,6 +261,9 @@ public:
     Mixed operator/(const Mixed&) const noexcept;
 
     size_t hash() const;
+    // Hash consistent with compare(), so numeric values of different types
+    // comparing equal, like 1 and 1.0, hash alike. Not persisted, unlike hash().
+    size_t compare_hash() const noexcept;
     // Used when inserting values into index
     StringData get_index_data(std::array<char, 16>&) const noexcept;
     // Used when logging values
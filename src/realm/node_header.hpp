@@ -52,6 +52,8 @@ public:
         wtype_Bits = 0,     // width indicates how many bits every element occupies
         wtype_Multiply = 1, // width indicates how many bytes every element occupies
         wtype_Ignore = 2,   // each element is 1 byte
+        wtype_Offset = 3,   // like wtype_Bits, but every element is an offset from a
+                            // 64-bit base stored after the (8-byte aligned) elements
     };
 
     static const int header_size = 8; // Number of bytes used by header
@@ -229,6 +231,11 @@ public:
             case wtype_Ignore:
                 num_bytes = size;
                 break;
+            case wtype_Offset: {
+                REALM_ASSERT_3(size, <, 0x1000000);
+                num_bytes = calc_offset_base_pos(size, width) + sizeof(int64_t);
+                break;
+            }
         }
 
         // Ensure 8-byte alignment
@@ -238,6 +245,28 @@ public:
 
         return num_bytes;
     }
+
+    /// Position of the base value relative to the start of the data area for
+    /// an array using `wtype_Offset`.
+    static size_t calc_offset_base_pos(size_t size, uint_least8_t width) noexcept
+    {
+        size_t num_bytes = (size * width + 7) >> 3;
+        return (num_bytes + 7) & ~size_t(7);
+    }
+
+    static int64_t get_base_from_header(const char* header) noexcept
+    {
+        REALM_ASSERT_DEBUG(get_wtype_from_header(header) == wtype_Offset);
+        size_t pos = calc_offset_base_pos(get_size_from_header(header), get_width_from_header(header));
+        return *reinterpret_cast<const int64_t*>(header + header_size + pos);
+    }
+
+    static void set_base_in_header(int64_t base, char* header) noexcept
+    {
+        REALM_ASSERT_DEBUG(get_wtype_from_header(header) == wtype_Offset);
+        size_t pos = calc_offset_base_pos(get_size_from_header(header), get_width_from_header(header));
+        *reinterpret_cast<int64_t*>(header + header_size + pos) = base;
+    }
 };
 }
 
@@ -554,6 +554,8 @@ int64_t Obj::_get<int64_t>(ColKey::Idx col_ndx) const
     char* header = alloc.translate(ref);
     int width = Array::get_width_from_header(header);
     char* data = Array::get_data_from_header(header);
+    if (REALM_UNLIKELY(Array::get_wtype_from_header(header) == Array::wtype_Offset))
+        return Array::get(header, m_row_ndx);
     REALM_TEMPEX(return get_direct, width, (data, m_row_ndx));
 }
 
@@ -1304,6 +1306,7 @@ Obj& Obj::set<int64_t>(ColKey col_key, int64_t value, bool is_default)
     if (index && !m_key.is_unresolved()) {
         index->set(m_key, value);
     }
+    m_table->update_composite_indexes(m_key, col_key, value);
 
     Allocator& alloc = get_alloc();
     alloc.bump_content_version();
@@ -1323,6 +1326,7 @@ Obj& Obj::set<int64_t>(ColKey col_key, int64_t value, bool is_default)
         values.init_from_parent();
         values.set(m_row_ndx, value);
     }
+    Cluster::update_value_range(fields, col_key, value);
 
     sync(fields);
 
@@ -1383,7 +1387,9 @@ Obj& Obj::add_int(ColKey col_key, int64_t value)
                 if (SearchIndex* index = m_table->get_search_index(col_key)) {
                     index->set(m_key, new_val);
                 }
+                m_table->update_composite_indexes(m_key, col_key, new_val);
                 values.set(m_row_ndx, new_val);
+                Cluster::update_value_range(fields, col_key, new_val);
             }
             else {
                 throw IllegalOperation("No prior value");
@@ -1398,7 +1404,9 @@ Obj& Obj::add_int(ColKey col_key, int64_t value)
             if (SearchIndex* index = m_table->get_search_index(col_key)) {
                 index->set(m_key, new_val);
             }
+            m_table->update_composite_indexes(m_key, col_key, new_val);
             values.set(m_row_ndx, new_val);
+            Cluster::update_value_range(fields, col_key, new_val);
         }
     }
 
@@ -1678,6 +1686,7 @@ Obj& Obj::set(ColKey col_key, T value, bool is_default)
     if (index && !m_key.is_unresolved()) {
         index->set(m_key, value);
     }
+    m_table->update_composite_indexes(m_key, col_key, value);
 
     Allocator& alloc = get_alloc();
     alloc.bump_content_version();
@@ -1690,6 +1699,8 @@ Obj& Obj::set(ColKey col_key, T value, bool is_default)
     set_spec<LeafType>(values, col_key);
     values.init_from_parent();
     values.set(m_row_ndx, value);
+    if constexpr (realm::is_any_v<T, float, double, Timestamp>)
+        Cluster::update_value_range(fields, col_key, value);
 
     sync(fields);
 
@@ -2371,6 +2382,7 @@ Obj& Obj::set_null(ColKey col_key, bool is_default)
         if (index && !m_key.is_unresolved()) {
             index->set(m_key, null{});
         }
+        m_table->update_composite_indexes(m_key, col_key, Mixed());
 
         switch (col_type) {
             case col_type_Int:
@@ -243,3 +243,13 @@ RLM_API void realm_config_set_automatic_backlink_handling(realm_config_t* realm_
 {
     realm_config->automatically_handle_backlinks_in_migrations = enable_automatic_handling;
 }
+
+RLM_API void realm_config_set_db_metrics_enabled(realm_config_t* realm_config, bool enabled) noexcept
+{
+    realm_config->enable_db_metrics = enabled;
+}
+
+RLM_API bool realm_config_get_db_metrics_enabled(const realm_config_t* realm_config) noexcept
+{
+    return realm_config->enable_db_metrics;
+}
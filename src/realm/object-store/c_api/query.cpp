@@ -205,6 +205,13 @@ RLM_API const char* realm_query_get_description(realm_query_t* query)
     });
 }
 
+RLM_API const char* realm_query_explain(realm_query_t* query, bool profile)
+{
+    return wrap_err([&]() {
+        return query->explain(profile);
+    });
+}
+
 RLM_API realm_query_t* realm_query_append_query(const realm_query_t* existing_query, const char* query_string,
                                                 size_t num_args, const realm_query_arg_t* args)
 {
@@ -298,6 +305,70 @@ RLM_API bool realm_query_find_first(realm_query_t* query, realm_value_t* out_val
     });
 }
 
+RLM_API realm_group_by_result_t* realm_query_group_by(const realm_query_t* query,
+                                                      const realm_property_key_t* properties, size_t num_properties,
+                                                      const realm_group_by_aggregate_t* aggregates,
+                                                      size_t num_aggregates)
+{
+    return wrap_err([&]() {
+        GroupBy group_by;
+        if (num_properties == 0) {
+            if (!query->query.get_group_by())
+                throw InvalidArgument("No properties to group by");
+            group_by = *query->query.get_group_by();
+        }
+        else {
+            for (size_t i = 0; i < num_properties; ++i) {
+                group_by.columns.push_back(ColKey(properties[i]));
+            }
+            for (size_t i = 0; i < num_aggregates; ++i) {
+                GroupByAggregate aggregate;
+                aggregate.type = GroupByAggregate::Type(aggregates[i].type);
+                if (aggregate.type != GroupByAggregate::Type::Count)
+                    aggregate.column = ColKey(aggregates[i].property);
+                group_by.aggregates.push_back(aggregate);
+            }
+        }
+        auto result = query->query.group_by(group_by.columns, group_by.aggregates);
+        return new realm_group_by_result_t{std::move(result), query->query.get_table(), std::move(group_by.columns),
+                                           group_by.aggregates.size()};
+    });
+}
+
+RLM_API bool realm_group_by_result_count(const realm_group_by_result_t* result, size_t* out_count)
+{
+    return wrap_err([&]() {
+        if (out_count)
+            *out_count = result->result.size();
+        return true;
+    });
+}
+
+RLM_API bool realm_group_by_result_get(const realm_group_by_result_t* result, size_t group, realm_value_t* out_keys,
+                                       realm_value_t* out_values)
+{
+    return wrap_err([&]() {
+        if (group >= result->result.size())
+            throw OutOfBounds{"realm_group_by_result_get", group, result->result.size()};
+        if (out_keys) {
+            for (size_t i = 0; i < result->columns.size(); ++i) {
+                Mixed key = result->result.get_key(group, i);
+                if (key.is_type(type_Link)) {
+                    // Links are returned with their target table
+                    key = ObjLink(result->table->get_opposite_table_key(result->columns[i]), key.get<ObjKey>());
+                }
+                out_keys[i] = to_capi(key);
+            }
+        }
+        if (out_values) {
+            for (size_t i = 0; i < result->num_aggregates; ++i) {
+                out_values[i] = to_capi(result->result.get_value(group, i));
+            }
+        }
+        return true;
+    });
+}
+
 RLM_API realm_results_t* realm_query_find_all(realm_query_t* query)
 {
     return wrap_err([&]() {
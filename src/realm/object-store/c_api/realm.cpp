@@ -54,6 +54,35 @@ RLM_API bool realm_get_num_versions(const realm_t* realm, uint64_t* out_versions
     });
 }
 
+static_assert(RLM_LATENCY_HISTOGRAM_BUCKETS == LatencyHistogram::num_buckets);
+
+static realm_latency_histogram_t to_capi(const LatencyHistogram& histogram)
+{
+    realm_latency_histogram_t result;
+    result.count = histogram.count;
+    result.total_ns = uint64_t(histogram.total.count());
+    result.max_ns = uint64_t(histogram.max.count());
+    std::copy(histogram.buckets.begin(), histogram.buckets.end(), result.buckets);
+    return result;
+}
+
+RLM_API bool realm_get_db_metrics(const realm_t* realm, realm_db_metrics_t* out_metrics)
+{
+    return wrap_err([&]() {
+        if (out_metrics) {
+            DBMetrics metrics = (*realm)->get_db_metrics();
+            out_metrics->write_lock_wait = to_capi(metrics.write_lock_wait);
+            out_metrics->read_lock = to_capi(metrics.read_lock);
+            out_metrics->write_group = to_capi(metrics.write_group);
+            out_metrics->free_space_search = to_capi(metrics.free_space_search);
+            out_metrics->sync = to_capi(metrics.sync);
+            out_metrics->bytes_written = metrics.bytes_written;
+            out_metrics->live_versions = metrics.live_versions;
+        }
+        return true;
+    });
+}
+
 RLM_API const char* realm_get_library_version()
 {
     return REALM_VERSION_STRING;
@@ -532,13 +532,36 @@ struct realm_query : realm::c_api::WrapC {
         return m_description.c_str();
     }
 
+    const char* explain(bool run)
+    {
+        m_explanation = (run ? query.profile() : query.explain()).to_string();
+        return m_explanation.c_str();
+    }
+
 private:
     realm::util::bind_ptr<realm::DescriptorOrdering> m_ordering;
     std::string m_description;
+    std::string m_explanation;
 
     realm_query(const realm_query&) = default;
 };
 
+struct realm_group_by_result : realm::c_api::WrapC {
+    realm::GroupByResult result;
+    realm::ConstTableRef table;
+    std::vector<realm::ColKey> columns;
+    size_t num_aggregates;
+
+    realm_group_by_result(realm::GroupByResult result, realm::ConstTableRef table,
+                          std::vector<realm::ColKey> columns, size_t num_aggregates)
+        : result(std::move(result))
+        , table(std::move(table))
+        , columns(std::move(columns))
+        , num_aggregates(num_aggregates)
+    {
+    }
+};
+
 struct realm_results : realm::c_api::WrapC, realm::Results {
     explicit realm_results(realm::Results results)
         : realm::Results(std::move(results))
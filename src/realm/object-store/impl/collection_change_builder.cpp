@@ -499,7 +499,74 @@ private:
     }
 };
 
-void calculate_moves_sorted(std::vector<RowInfo>& rows, CollectionChangeSet& changeset)
+// Above this many rows, finding the longest matching blocks gets too slow, and the
+// rows to move are instead found with calculate_moves_unique()
+constexpr size_t max_block_matching_size = 1000;
+
+// Find the largest set of rows which kept their relative order, which is the
+// longest increasing subsequence of their previous indices, and report all other
+// rows as moved. Of the sets of equal size, the one with the most unmodified rows
+// is kept. This runs in O(N log N) time, but requires each row to appear only once.
+void calculate_moves_unique(std::vector<RowInfo> const& rows, size_t first_difference,
+                            CollectionChangeSet& changeset)
+{
+    // The rank of each row's previous index among the rows being diffed
+    std::vector<size_t> prev_indices;
+    prev_indices.reserve(rows.size() - first_difference);
+    for (size_t i = first_difference; i < rows.size(); ++i)
+        prev_indices.push_back(rows[i].prev_tv_index);
+    std::sort(begin(prev_indices), end(prev_indices));
+
+    // The best subsequence ending at a row: its length and number of unmodified rows,
+    // and the previous row in it
+    struct Subsequence {
+        size_t length = 0;
+        size_t unmodified = 0;
+        size_t row = IndexSet::npos;
+
+        bool operator<(Subsequence const& other) const
+        {
+            return std::tie(length, unmodified) < std::tie(other.length, other.unmodified);
+        }
+    };
+    // A Fenwick tree over the ranks of the previous indices, holding the best
+    // subsequence ending at a row with a lower previous index
+    std::vector<Subsequence> tree(prev_indices.size() + 1);
+    std::vector<size_t> predecessor(rows.size(), IndexSet::npos);
+    Subsequence best;
+    for (size_t i = first_difference; i < rows.size(); ++i) {
+        size_t rank = std::lower_bound(begin(prev_indices), end(prev_indices), rows[i].prev_tv_index) -
+                      begin(prev_indices);
+
+        Subsequence prefix;
+        for (size_t k = rank; k > 0; k &= k - 1) {
+            if (prefix < tree[k])
+                prefix = tree[k];
+        }
+        predecessor[i] = prefix.row;
+        Subsequence current{prefix.length + 1,
+                            prefix.unmodified + !changeset.modifications.contains(rows[i].tv_index), i};
+        for (size_t k = rank + 1; k < tree.size(); k += k & (0 - k)) {
+            if (tree[k] < current)
+                tree[k] = current;
+        }
+        if (best < current)
+            best = current;
+    }
+
+    std::vector<bool> kept(rows.size());
+    for (size_t i = best.row; i != IndexSet::npos; i = predecessor[i])
+        kept[i] = true;
+    for (size_t i = first_difference; i < rows.size(); ++i) {
+        if (!kept[i]) {
+            changeset.deletions.add(rows[i].prev_tv_index);
+            changeset.insertions.add(rows[i].tv_index);
+        }
+    }
+}
+
+void calculate_moves_sorted(std::vector<RowInfo>& rows, CollectionChangeSet& changeset,
+                            size_t max_move_calculation_size)
 {
     // The RowInfo array contains information about the old and new TV indices of
     // each row, which we need to turn into two sequences of rows, which we'll
@@ -525,6 +592,16 @@ void calculate_moves_sorted(std::vector<RowInfo>& rows, CollectionChangeSet& cha
     if (first_difference == IndexSet::npos)
         return;
 
+    // Too many rows may have moved to be worth finding out which, so report
+    // them all as removed and reinserted
+    if (rows.size() - first_difference > max_move_calculation_size) {
+        for (size_t i = first_difference; i < rows.size(); ++i) {
+            changeset.deletions.add(a[i].tv_index);
+            changeset.insertions.add(rows[i].tv_index);
+        }
+        return;
+    }
+
     // Note that `b` is sorted by key, while `a` is sorted by tv_index
     b.reserve(rows.size());
     for (size_t i = 0; i < rows.size(); ++i)
@@ -533,6 +610,16 @@ void calculate_moves_sorted(std::vector<RowInfo>& rows, CollectionChangeSet& cha
         return std::tie(lft.key, lft.tv_index) < std::tie(rgt.key, rgt.tv_index);
     });
 
+    if (rows.size() - first_difference > max_block_matching_size) {
+        auto duplicate = std::adjacent_find(begin(b), end(b), [](auto lft, auto rgt) {
+            return lft.key == rgt.key;
+        });
+        if (duplicate == end(b)) {
+            calculate_moves_unique(rows, first_difference, changeset);
+            return;
+        }
+    }
+
     // Calculate the LCS of the two sequences
     auto matches =
         LongestCommonSubsequenceCalculator(a, b, first_difference, changeset.modifications).m_longest_matches;
@@ -576,7 +663,7 @@ void verify_changeset(std::vector<T> const& prev_rows, std::vector<T> const& nex
 }
 
 void calculate(CollectionChangeBuilder& ret, std::vector<RowInfo> old_rows, std::vector<RowInfo> new_rows,
-               util::FunctionRef<bool(int64_t)> key_did_change, bool in_table_order)
+               util::FunctionRef<bool(int64_t)> key_did_change, bool in_table_order, size_t max_move_calculation_size)
 {
     // Now that our old and new sets of rows are sorted by key, we can
     // iterate over them and either record old+new TV indices for rows present
@@ -623,7 +710,7 @@ void calculate(CollectionChangeBuilder& ret, std::vector<RowInfo> old_rows, std:
     }
 
     if (!in_table_order)
-        calculate_moves_sorted(new_rows, ret);
+        calculate_moves_sorted(new_rows, ret, max_move_calculation_size);
 }
 
 template <typename T>
@@ -660,7 +747,7 @@ std::vector<RowInfo> build_row_info(const std::vector<T>& rows)
 
 CollectionChangeBuilder CollectionChangeBuilder::calculate(const ObjKeys& prev_objs, const ObjKeys& next_objs,
                                                            util::FunctionRef<bool(ObjKey)> key_did_change,
-                                                           bool in_table_order)
+                                                           bool in_table_order, size_t max_move_calculation_size)
 {
     CollectionChangeBuilder ret;
     ::calculate(
@@ -668,7 +755,7 @@ CollectionChangeBuilder CollectionChangeBuilder::calculate(const ObjKeys& prev_o
         [&key_did_change](int64_t key) {
             return key_did_change(ObjKey(key));
         },
-        in_table_order);
+        in_table_order, max_move_calculation_size);
     ret.verify();
     verify_changeset(prev_objs, next_objs, ret);
     return ret;
@@ -676,7 +763,8 @@ CollectionChangeBuilder CollectionChangeBuilder::calculate(const ObjKeys& prev_o
 
 CollectionChangeBuilder CollectionChangeBuilder::calculate(std::vector<size_t> const& prev_rows,
                                                            std::vector<size_t> const& next_rows,
-                                                           util::FunctionRef<bool(size_t)> ndx_did_change)
+                                                           util::FunctionRef<bool(size_t)> ndx_did_change,
+                                                           size_t max_move_calculation_size)
 {
     CollectionChangeBuilder ret;
     ::calculate(
@@ -684,7 +772,7 @@ CollectionChangeBuilder CollectionChangeBuilder::calculate(std::vector<size_t> c
         [&ndx_did_change](int64_t ndx) {
             return ndx_did_change(size_t(ndx));
         },
-        false);
+        false, max_move_calculation_size);
     ret.verify();
     verify_changeset(prev_rows, next_rows, ret);
     return ret;
@@ -42,14 +42,20 @@ public:
                             std::vector<Move> moves = {}, bool collection_was_cleared = false,
                             bool root_was_deleted = false);
 
+    // When more than this many rows may have moved, all of them are reported as
+    // deleted and reinserted rather than finding the rows which actually moved
+    static constexpr size_t default_max_move_calculation_size = 1'000'000;
+
     // Calculate where objects need to be inserted or deleted from old_objs to turn
     // it into new_objs, and check all matching objects for modifications
     static CollectionChangeBuilder calculate(const ObjKeys& old_objs, const ObjKeys& new_objs,
-                                             util::FunctionRef<bool(ObjKey)> key_did_change, bool in_table_order);
+                                             util::FunctionRef<bool(ObjKey)> key_did_change, bool in_table_order,
+                                             size_t max_move_calculation_size = default_max_move_calculation_size);
     // Calculate where rows need to be inserted or deleted from old_rows to turn
     // it into new_rows, and check all matching rows for modifications
     static CollectionChangeBuilder calculate(std::vector<size_t> const& old_rows, std::vector<size_t> const& new_rows,
-                                             util::FunctionRef<bool(size_t)> ndx_did_change);
+                                             util::FunctionRef<bool(size_t)> ndx_did_change,
+                                             size_t max_move_calculation_size = default_max_move_calculation_size);
 
     // generic operations {
     CollectionChangeSet finalize() &&;
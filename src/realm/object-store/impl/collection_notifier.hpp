@@ -169,6 +169,8 @@ public:
     void add_required_change_info(TransactionChangeInfo& info);
 
     // precondition: RealmCoordinator::m_notifier_mutex is unlocked
+    // Different notifiers may run concurrently, so this must only modify the
+    // notifier's own state and only read from the shared transaction
     virtual void run() = 0;
 
     // precondition: RealmCoordinator::m_notifier_mutex is locked
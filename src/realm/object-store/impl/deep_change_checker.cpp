@@ -41,6 +41,8 @@ void DeepChangeChecker::find_related_tables(std::vector<RelatedTable>& related_t
         std::vector<ColKey> forward_links;
         std::vector<TableKey> forward_tables;
         std::vector<TableKey> backlink_tables;
+        // The backlink columns of incoming links along with the tables they come from.
+        std::vector<std::pair<ColKey, TableKey>> incoming_links;
         bool processed_table = false;
     };
 
@@ -84,6 +86,7 @@ void DeepChangeChecker::find_related_tables(std::vector<RelatedTable>& related_t
             auto& links = get_mapping(origin_table_key);
             links.forward_links.push_back(origin_link_col);
             links.forward_tables.push_back(table_key);
+            get_mapping(table_key).incoming_links.emplace_back(backlink_col_key, origin_table_key);
 
             if (any_of(key_path_array.begin(), key_path_array.end(), [&](const KeyPath& key_path) {
                     return any_of(key_path.begin(), key_path.end(), [&](std::pair<TableKey, ColKey> pair) {
@@ -125,6 +128,15 @@ void DeepChangeChecker::find_related_tables(std::vector<RelatedTable>& related_t
         tables_to_check.insert(tables_to_check.end(), link_info.backlink_tables.begin(),
                                link_info.backlink_tables.end());
     }
+
+    // The incoming links are only followed when they come from a table whose outgoing links are checked.
+    for (auto& related_table : related_tables) {
+        for (auto& [backlink_col_key, origin_table_key] : get_mapping(related_table.table_key).incoming_links) {
+            if (get_mapping(origin_table_key).processed_table) {
+                related_table.backlinks.push_back(backlink_col_key);
+            }
+        }
+    }
 }
 
 DeepChangeChecker::DeepChangeChecker(TransactionChangeInfo const& info, Table const& root_table,
@@ -342,6 +354,73 @@ bool DeepChangeChecker::check_row(Table const& table, ObjKey object_key, const s
     return ret;
 }
 
+std::optional<std::unordered_set<ObjKey>> DeepChangeChecker::find_objects_reaching_changes() const
+{
+    Group& group = *m_root_table.get_parent_group();
+
+    // Start with all modified objects and walk backwards along the links one level at a
+    // time, so that the objects found at each level are exactly those whose shortest path
+    // to a modified object has that length.
+    std::vector<std::pair<const RelatedTable*, ObjKey>> current;
+    for (auto& related_table : m_related_tables) {
+        auto it = m_info.tables.find(related_table.table_key);
+        if (it == m_info.tables.end())
+            continue;
+        for (auto& [obj_key, columns] : it->second.get_modifications()) {
+            if (!obj_key.is_unresolved() && it->second.modifications_contains(obj_key, m_filtered_columns))
+                current.emplace_back(&related_table, obj_key);
+        }
+    }
+
+    auto find_related_table = [&](TableKey table_key) {
+        auto it = std::find_if(begin(m_related_tables), end(m_related_tables), [&](const auto& related_table) {
+            return related_table.table_key == table_key;
+        });
+        REALM_ASSERT(it != m_related_tables.end());
+        return &*it;
+    };
+
+    const size_t max_visited =
+        std::max(current.size() * s_max_backlinks_per_modification, s_min_backlink_search_size);
+    size_t visited_count = 0;
+    std::unordered_map<TableKey, std::unordered_set<ObjKey>> visited;
+    std::vector<std::pair<const RelatedTable*, ObjKey>> next;
+    // An object at depth n of the search in check_row() is n links away from the root object
+    for (size_t depth = 1; depth < m_current_path.size() && !current.empty(); ++depth) {
+        for (auto& [related_table, obj_key] : current) {
+            if (related_table->backlinks.empty())
+                continue;
+            ConstTableRef table = group.get_table(related_table->table_key);
+            const Obj obj = table->try_get_object(obj_key);
+            if (!obj)
+                continue;
+            for (auto backlink_col_key : related_table->backlinks) {
+                ConstTableRef origin_table = table->get_opposite_table(backlink_col_key);
+                ColKey origin_col_key = table->get_opposite_column(backlink_col_key);
+                size_t backlink_count = obj.get_backlink_count(*origin_table, origin_col_key);
+                if (backlink_count == 0)
+                    continue;
+                auto& origins = visited[origin_table->get_key()];
+                const RelatedTable* origin_related_table = nullptr;
+                for (size_t i = 0; i < backlink_count; ++i) {
+                    ObjKey origin_key = obj.get_backlink(*origin_table, origin_col_key, i);
+                    if (!origins.insert(origin_key).second)
+                        continue;
+                    if (++visited_count > max_visited)
+                        return {};
+                    if (!origin_related_table)
+                        origin_related_table = find_related_table(origin_table->get_key());
+                    next.emplace_back(origin_related_table, origin_key);
+                }
+            }
+        }
+        std::swap(current, next);
+        next.clear();
+    }
+
+    return std::move(visited[m_root_table.get_key()]);
+}
+
 bool DeepChangeChecker::operator()(ObjKey key)
 {
     // First check if the root object was modified. We could skip this and do
@@ -358,7 +437,15 @@ bool DeepChangeChecker::operator()(ObjKey key)
     }
 
     // The object itself wasn't modified, so move on to check if any of the
-    // objects it links to were modified.
+    // objects it links to were modified. When there are few modifications
+    // this is answered by looking up the objects that link to them.
+    if (!m_did_search_backlinks) {
+        m_root_objects_reaching_changes = find_objects_reaching_changes();
+        m_did_search_backlinks = true;
+    }
+    if (m_root_objects_reaching_changes) {
+        return m_root_objects_reaching_changes->count(key) > 0;
+    }
     return check_row(m_root_table, key, m_filtered_columns, 0);
 }
 
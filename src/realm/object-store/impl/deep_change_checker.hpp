@@ -24,6 +24,7 @@
 #include <realm/collection_parent.hpp>
 
 #include <array>
+#include <optional>
 
 namespace realm {
 class CollectionBase;
@@ -70,6 +71,8 @@ public:
         TableKey table_key;
         // All outgoing links to the table specified by `table_key`.
         std::vector<ColKey> links;
+        // The backlink columns of the table specified by `table_key` for all incoming links from related tables.
+        std::vector<ColKey> backlinks;
     };
 
     typedef std::vector<RelatedTable> RelatedTables;
@@ -151,6 +154,17 @@ private:
 
     std::unordered_map<TableKey, std::unordered_set<ObjKey>> m_not_modified;
 
+    // The objects in the root table which link to a modified object within the maximum search depth,
+    // found by following the backlinks of the modified objects. This is computed on first use, and
+    // left empty if it would visit too many objects, in which case the outgoing links of each object
+    // are searched instead.
+    std::optional<std::unordered_set<ObjKey>> m_root_objects_reaching_changes;
+    bool m_did_search_backlinks = false;
+
+    // The backlink search is abandoned once it has visited more objects than this per modified object
+    static constexpr size_t s_max_backlinks_per_modification = 16;
+    static constexpr size_t s_min_backlink_search_size = 1000;
+
     struct Path {
         ObjKey obj_key;
         ColKey col_key;
@@ -186,6 +200,14 @@ private:
     bool check_outgoing_links(Table const& table, ObjKey object_key, const std::vector<ColKey>& filtered_columns,
                               size_t depth = 0);
 
+    /**
+     * Find the objects in the root table from which a modified object can be reached, by following the
+     * backlinks of all modified objects in the related tables up to the maximum search depth.
+     *
+     * @return The objects found, or none if the search visits too many objects.
+     */
+    std::optional<std::unordered_set<ObjKey>> find_objects_reaching_changes() const;
+
     bool do_check_for_collection_modifications(const Obj& obj, ColKey col,
                                                const std::vector<ColKey>& filtered_columns, size_t depth);
     template <typename T>
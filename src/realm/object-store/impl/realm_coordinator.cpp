@@ -48,6 +48,7 @@
 #include <realm/sync/config.hpp>
 
 #include <algorithm>
+#include <thread>
 #include <unordered_map>
 
 using namespace realm;
@@ -473,6 +474,7 @@ bool RealmCoordinator::open_db()
         options.durability = m_config.in_memory ? DBOptions::Durability::MemOnly : DBOptions::Durability::Full;
         options.is_immutable = m_config.immutable();
         options.logger = util::Logger::get_default_logger();
+        options.enable_metrics = m_config.enable_db_metrics;
 
         if (!m_config.fifo_files_fallback_path.empty()) {
             options.temp_dir = util::normalize_dir(m_config.fifo_files_fallback_path);
@@ -971,8 +973,7 @@ void RealmCoordinator::run_async_notifiers()
         for (auto& notifier : notifiers)
             notifier->add_required_change_info(info);
         transaction::advance(*m_notifier_transaction, info, skip_version->get_version_of_current_transaction());
-        for (auto& notifier : notifiers)
-            notifier->run();
+        run_notifiers(notifiers);
 
         util::CheckedLockGuard lock(m_notifier_mutex);
         for (auto& notifier : notifiers)
@@ -1011,14 +1012,13 @@ void RealmCoordinator::run_async_notifiers()
     // the main Transaction used for background work rather than the temporary one
     for (auto& notifier : new_notifiers) {
         notifier->attach_to(m_notifier_transaction);
-        notifier->run();
     }
 
     // Change info is now all ready, so the notifiers can now perform their
     // background work
-    for (auto& notifier : notifiers) {
-        notifier->run();
-    }
+    NotifierVector notifiers_to_run = new_notifiers;
+    notifiers_to_run.insert(notifiers_to_run.end(), notifiers.begin(), notifiers.end());
+    run_notifiers(notifiers_to_run);
 
     // Reacquire the lock while updating the fields that are actually read on
     // other threads
@@ -1034,6 +1034,43 @@ void RealmCoordinator::run_async_notifiers()
         m_notifier_handover_transaction = m_db->start_read(version);
 }
 
+void RealmCoordinator::run_notifiers(const NotifierVector& notifiers)
+{
+    // The notifiers only read from the transaction, which is not advanced while they run,
+    // and each of them only updates its own state, so they can run concurrently. Which
+    // thread runs a notifier has no effect on the order the changes are delivered in.
+    size_t num_threads = std::min({size_t(std::thread::hardware_concurrency()), max_notifier_threads,
+                                   notifiers.size() / min_notifiers_per_thread});
+    if (num_threads < 2) {
+        for (auto& notifier : notifiers)
+            notifier->run();
+        return;
+    }
+
+    std::atomic<size_t> next_notifier = 0;
+    std::mutex error_mutex;
+    std::exception_ptr error;
+    auto work = [&] {
+        try {
+            for (size_t i = next_notifier++; i < notifiers.size(); i = next_notifier++)
+                notifiers[i]->run();
+        }
+        catch (...) {
+            std::lock_guard lock(error_mutex);
+            if (!error)
+                error = std::current_exception();
+        }
+    };
+    std::vector<std::thread> threads;
+    for (size_t t = 1; t < num_threads; t++)
+        threads.emplace_back(work);
+    work();
+    for (auto& thread : threads)
+        thread.join();
+    if (error)
+        std::rethrow_exception(error);
+}
+
 void RealmCoordinator::advance_to_ready(Realm& realm)
 {
     // If callbacks close the Realm the last external reference may go away
@@ -117,6 +117,10 @@ public:
     {
         return m_db->get_number_of_versions();
     }
+    DBMetrics get_db_metrics() const
+    {
+        return m_db->get_metrics();
+    }
 
     // To avoid having to re-read and validate the file's schema every time a
     // new read transaction is begun, RealmCoordinator maintains a cache of the
@@ -275,6 +279,11 @@ private:
     void do_get_realm(Realm::Config&& config, std::shared_ptr<Realm>& realm, util::Optional<VersionID> version,
                       util::CheckedUniqueLock& realm_lock, bool first_time_open = false) REQUIRES(m_realm_mutex);
     void run_async_notifiers() REQUIRES(!m_notifier_mutex, m_running_notifiers_mutex);
+    // Run the notifiers concurrently on up to `max_notifier_threads` threads
+    static void run_notifiers(const NotifierVector& notifiers);
+    static constexpr size_t max_notifier_threads = 8;
+    // Starting a thread does not pay off for fewer notifiers
+    static constexpr size_t min_notifiers_per_thread = 4;
     void clean_up_dead_notifiers() REQUIRES(m_notifier_mutex);
 
     NotifierVector notifiers_for_realm(Realm&) REQUIRES(m_notifier_mutex);
@@ -114,7 +114,8 @@ bool ResultsNotifier::do_add_required_change_info(TransactionChangeInfo& info)
         update_related_tables(*m_query->get_table());
     }
 
-    return m_query->get_table() && has_run() && have_callbacks();
+    m_changes_are_tracked = m_query->get_table() && has_run() && have_callbacks();
+    return m_changes_are_tracked;
 }
 
 void ResultsNotifier::calculate_changes()
@@ -166,8 +167,10 @@ void ResultsNotifier::run()
     {
         auto lock = lock_target();
         // Don't run the query if the results aren't actually going to be used
-        if (!get_realm() || (!have_callbacks() && !m_results_were_used))
+        if (!get_realm() || (!have_callbacks() && !m_results_were_used)) {
+            m_previous_objs_are_current = false;
             return;
+        }
     }
 
     auto new_versions = m_query->sync_view_if_needed();
@@ -190,13 +193,32 @@ void ResultsNotifier::run()
     }
 
     m_run_tv = TableView(*m_query, size_t(-1));
-    // Syncing will be done here
-    m_run_tv.apply_descriptor_ordering(m_descriptor_ordering);
+    // Syncing will be done here, by updating the previous results if possible
+    if (!sync_from_changes())
+        m_run_tv.apply_descriptor_ordering(m_descriptor_ordering);
     m_last_seen_version = std::move(new_versions);
+    m_previous_objs_are_current = true;
 
     calculate_changes();
 }
 
+bool ResultsNotifier::sync_from_changes()
+{
+    if (!has_run() || !m_changes_are_tracked || !m_previous_objs_are_current || m_info->schema_changed)
+        return false;
+
+    std::vector<ObjKey> changed;
+    std::vector<ObjKey> deleted;
+    if (auto it = m_info->tables.find(m_query->get_table()->get_key()); it != m_info->tables.end()) {
+        auto& changes = it->second;
+        changed.assign(changes.get_insertions().begin(), changes.get_insertions().end());
+        for (auto& [key, columns] : changes.get_modifications())
+            changed.push_back(key);
+        deleted.assign(changes.get_deletions().begin(), changes.get_deletions().end());
+    }
+    return m_run_tv.sync_from_changes(m_descriptor_ordering, m_previous_objs, changed, deleted);
+}
+
 void ResultsNotifier::do_prepare_handover(Transaction& sg)
 {
     m_handover_tv.reset();
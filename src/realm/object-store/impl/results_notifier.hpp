@@ -74,8 +74,13 @@ private:
 
     TransactionChangeInfo* m_info = nullptr;
     bool m_results_were_used = true;
+    // Set if m_info tracks the changes to the table, and if m_previous_objs are the results at the
+    // version those changes start from, in which case the results can be updated from the changes
+    bool m_changes_are_tracked = false;
+    bool m_previous_objs_are_current = false;
 
     void calculate_changes();
+    bool sync_from_changes();
 
     void run() override;
     void do_prepare_handover(Transaction&) override;
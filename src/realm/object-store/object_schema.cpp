@@ -145,8 +145,10 @@ ObjectSchema::ObjectSchema(Group const& group, StringData name, TableKey key)
         Property property;
         property.name = column_name;
         property.type = ObjectSchema::from_core_type(col_key);
-        property.is_indexed = table->search_index_type(col_key) == IndexType::General;
-        property.is_fulltext_indexed = table->search_index_type(col_key) == IndexType::Fulltext;
+        auto index_type = table->search_index_type(col_key);
+        // The hash index of a primary key replaces its general index
+        property.is_indexed = index_type == IndexType::General || index_type == IndexType::Hash;
+        property.is_fulltext_indexed = index_type == IndexType::Fulltext;
         property.column_key = col_key;
 
         if (property.type == PropertyType::Object) {
@@ -58,6 +58,43 @@ T& at(std::vector<T>& vec, size_t index)
     return vec[index];
 }
 
+// Maps each row of the results after `changes` to the row it had before them. Rows which were
+// inserted or modified are mapped to npos, as their section key may have changed. Returns an
+// empty vector if the changes do not account for the change in size of the results.
+std::vector<size_t> map_unchanged_rows(const CollectionChangeSet& changes, size_t old_size, size_t new_size)
+{
+    if (changes.collection_root_was_deleted || changes.collection_was_cleared)
+        return {};
+    size_t deleted = changes.deletions.count();
+    if (deleted > old_size || old_size - deleted + changes.insertions.count() != new_size)
+        return {};
+
+    std::vector<size_t> rows(new_size, npos);
+    auto insertions = changes.insertions.as_indexes();
+    auto deletions = changes.deletions.as_indexes();
+    auto modifications = changes.modifications_new.as_indexes();
+    auto insertion = insertions.begin();
+    auto deletion = deletions.begin();
+    auto modification = modifications.begin();
+    size_t old_row = 0;
+    for (size_t row = 0; row < new_size; ++row) {
+        if (insertion != insertions.end() && *insertion == row) {
+            ++insertion;
+            continue;
+        }
+        while (deletion != deletions.end() && *deletion == old_row) {
+            ++deletion;
+            ++old_row;
+        }
+        while (modification != modifications.end() && *modification < row)
+            ++modification;
+        if (modification == modifications.end() || *modification != row)
+            rows[row] = old_row;
+        ++old_row;
+    }
+    return rows;
+}
+
 struct IndexSetAdder {
     IndexSet* set;
     IndexSetAdder& operator=(size_t value)
@@ -84,11 +121,12 @@ struct SectionedResultsNotificationHandler {
 public:
     SectionedResultsNotificationHandler(SectionedResults& sectioned_results,
                                         SectionedResultsNotificationCallback&& cb,
-                                        util::Optional<Mixed> section_filter = util::none)
+                                        bool has_key_path_filter, util::Optional<Mixed> section_filter = util::none)
         : m_cb(std::move(cb))
         , m_sectioned_results(sectioned_results)
         , m_prev_row_to_index_path(m_sectioned_results.m_row_to_index_path)
         , m_section_filter(section_filter)
+        , m_has_key_path_filter(has_key_path_filter)
     {
     }
 
@@ -96,7 +134,13 @@ public:
     {
         util::CheckedUniqueLock lock(m_sectioned_results.m_mutex);
 
-        m_sectioned_results.calculate_sections_if_required();
+        // The changes describe what happened since the previous call, so they can be used to
+        // update the sections if those are still from then. With a key path filter the
+        // modifications of some properties are not reported, so they can't.
+        bool use_changes = !m_has_key_path_filter && m_version &&
+                           m_sectioned_results.m_sections_version == m_version;
+        m_sectioned_results.calculate_sections_if_required(use_changes ? &c : nullptr);
+        m_version = m_sectioned_results.m_sections_version;
         section_initial_changes(c);
         m_prev_row_to_index_path = m_sectioned_results.m_row_to_index_path;
 
@@ -187,6 +231,9 @@ private:
     // change indices referring to the supplied section key.
     util::Optional<Mixed> m_section_filter;
     bool m_section_filter_should_deliver_initial_notification = true;
+    bool m_has_key_path_filter;
+    // The version of the sections when the callback was last called
+    util::Optional<VersionID> m_version;
 
     // Group the changes in the changeset by the section
     void section_initial_changes(CollectionChangeSet const& c) REQUIRES(m_sectioned_results.m_mutex)
@@ -388,7 +435,7 @@ SectionedResults::SectionedResults(Results results, Results::SectionedResultsOpe
 {
 }
 
-void SectionedResults::calculate_sections_if_required()
+void SectionedResults::calculate_sections_if_required(const CollectionChangeSet* changes)
 {
     if (m_results.m_update_policy == Results::UpdatePolicy::Never)
         return;
@@ -400,13 +447,16 @@ void SectionedResults::calculate_sections_if_required()
         m_results.ensure_up_to_date();
     }
 
-    calculate_sections();
+    calculate_sections(changes);
 }
 
 // This method will run in the following scenarios:
 // - SectionedResults is performing its initial evaluation.
 // - The underlying Table in the Results collection has changed
-void SectionedResults::calculate_sections()
+// When the changes since the previous run are known, the section keys of the rows
+// which were neither inserted nor modified are taken from the previous sections, and
+// the section key callback only runs for the other rows.
+void SectionedResults::calculate_sections(const CollectionChangeSet* changes)
 {
     m_previous_str_buffers.clear();
     m_previous_str_buffers.swap(m_current_str_buffers);
@@ -418,16 +468,27 @@ void SectionedResults::calculate_sections()
     }
 
     m_sections.clear();
+    auto previous_row_to_index_path = std::move(m_row_to_index_path);
     m_row_to_index_path.clear();
     size_t size = m_results.size();
     m_row_to_index_path.resize(size);
 
+    std::vector<size_t> previous_rows;
+    if (changes && m_has_performed_initial_evaluation)
+        previous_rows = map_unchanged_rows(*changes, previous_row_to_index_path.size(), size);
+
     for (size_t i = 0; i < size; ++i) {
-        Mixed key = m_callback(m_results.get_any(i), m_results.get_realm());
-        // Disallow links as section keys. It would be uncommon to use them to begin with
-        // and if the object acting as the key was deleted bad things would happen.
-        if (key.is_type(type_Link, type_TypedLink)) {
-            throw InvalidArgument("Links are not supported as section keys.");
+        Mixed key;
+        if (!previous_rows.empty() && previous_rows[i] != npos) {
+            key = m_previous_index_to_key[previous_row_to_index_path[previous_rows[i]].first];
+        }
+        else {
+            key = m_callback(m_results.get_any(i), m_results.get_realm());
+            // Disallow links as section keys. It would be uncommon to use them to begin with
+            // and if the object acting as the key was deleted bad things would happen.
+            if (key.is_type(type_Link, type_TypedLink)) {
+                throw InvalidArgument("Links are not supported as section keys.");
+            }
         }
 
         auto it = m_current_key_to_index.find(key);
@@ -453,6 +514,11 @@ void SectionedResults::calculate_sections()
         }
     }
     m_has_performed_initial_evaluation = true;
+    auto& realm = m_results.get_realm();
+    if (realm->is_in_transaction())
+        m_sections_version = util::none;
+    else
+        m_sections_version = realm->current_transaction_version();
 }
 
 size_t SectionedResults::size()
@@ -487,15 +553,19 @@ ResultsSection SectionedResults::operator[](Mixed key)
 NotificationToken SectionedResults::add_notification_callback(SectionedResultsNotificationCallback&& callback,
                                                               std::optional<KeyPathArray> key_path_array) &
 {
-    return m_results.add_notification_callback(SectionedResultsNotificationHandler(*this, std::move(callback)),
-                                               std::move(key_path_array));
+    bool has_key_path_filter = key_path_array.has_value();
+    return m_results.add_notification_callback(
+        SectionedResultsNotificationHandler(*this, std::move(callback), has_key_path_filter),
+        std::move(key_path_array));
 }
 
 NotificationToken SectionedResults::add_notification_callback_for_section(
     Mixed section_key, SectionedResultsNotificationCallback&& callback, std::optional<KeyPathArray> key_path_array)
 {
+    bool has_key_path_filter = key_path_array.has_value();
     return m_results.add_notification_callback(
-        SectionedResultsNotificationHandler(*this, std::move(callback), section_key), std::move(key_path_array));
+        SectionedResultsNotificationHandler(*this, std::move(callback), has_key_path_filter, section_key),
+        std::move(key_path_array));
 }
 
 // Thread-safety analysis doesn't work when creating a different instance of the
@@ -547,6 +617,7 @@ void SectionedResults::reset_section_callback(SectionKeyFunc section_callback)
     util::CheckedUniqueLock lock(m_mutex);
     m_callback = std::move(section_callback);
     m_has_performed_initial_evaluation = false;
+    m_sections_version = util::none;
     m_sections.clear();
     m_previous_index_to_key.clear();
     m_current_key_to_index.clear();
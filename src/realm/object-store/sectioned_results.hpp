@@ -168,9 +168,14 @@ private:
     friend struct SectionedResultsNotificationHandler;
     util::CheckedOptionalMutex m_mutex;
     SectionedResults copy(Results&&) REQUIRES(!m_mutex);
-    void calculate_sections_if_required() REQUIRES(m_mutex);
-    void calculate_sections() REQUIRES(m_mutex);
+    // `changes` may be given when they are known to describe the changes to the
+    // underlying results since the sections were last calculated.
+    void calculate_sections_if_required(const CollectionChangeSet* changes = nullptr) REQUIRES(m_mutex);
+    void calculate_sections(const CollectionChangeSet* changes) REQUIRES(m_mutex);
     bool m_has_performed_initial_evaluation = false;
+    // The version the sections were calculated at, unset if they were calculated
+    // inside a write transaction.
+    util::Optional<VersionID> m_sections_version;
     NotificationToken
     add_notification_callback_for_section(Mixed section_key, SectionedResultsNotificationCallback&& callback,
                                           std::optional<KeyPathArray> key_path_array = std::nullopt);
@@ -703,6 +703,12 @@ uint_fast64_t Realm::get_number_of_versions() const
     return m_coordinator->get_number_of_versions();
 }
 
+DBMetrics Realm::get_db_metrics() const
+{
+    verify_open();
+    return m_coordinator->get_db_metrics();
+}
+
 bool Realm::is_in_transaction() const noexcept
 {
     return !m_config.immutable() && !is_closed() && m_transaction &&
@@ -177,6 +177,10 @@ struct RealmConfig {
     // it instead delete orphans and duplicate objects with multiple incoming links.
     bool automatically_handle_backlinks_in_migrations = false;
 
+    // Collect latency histograms and counters of the transactions and commits
+    // of the file, available through Realm::get_db_metrics().
+    bool enable_db_metrics = false;
+
     // Only for internal testing. Not to be exposed by SDKs.
     //
     // Disable the background worker thread for producing change
@@ -326,6 +330,9 @@ public:
 
     // Returns the number of versions in the Realm file.
     uint_fast64_t get_number_of_versions() const;
+    // Returns the metrics collected for the Realm file, which are all zero
+    // unless Config::enable_db_metrics is set.
+    DBMetrics get_db_metrics() const;
 
     VersionID read_transaction_version() const;
     Group& read_group();
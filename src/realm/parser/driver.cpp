@@ -31,7 +31,10 @@
 #include "realm/parser/generated/query_flex.hpp"
 
 #include <external/mpark/variant.hpp>
+#include <list>
+#include <mutex>
 #include <stdexcept>
+#include <unordered_map>
 
 using namespace realm;
 using namespace std::string_literals;
@@ -1694,6 +1697,8 @@ DescriptorNode::~DescriptorNode() {}
 
 DescriptorOrderingNode::~DescriptorOrderingNode() {}
 
+GroupByNode::~GroupByNode() {}
+
 std::unique_ptr<DescriptorOrdering> DescriptorOrderingNode::visit(ParserDriver* drv)
 {
     auto target = drv->m_base_table;
@@ -1747,6 +1752,57 @@ std::unique_ptr<DescriptorOrdering> DescriptorOrderingNode::visit(ParserDriver*
     return ordering;
 }
 
+GroupBy GroupByNode::visit(ParserDriver* drv)
+{
+    auto target = drv->m_base_table;
+    auto column = [&](const Path& path, const char* clause) {
+        if (path.size() != 1) {
+            throw InvalidQueryError(util::format("Only properties of '%1' can be used in the '%2' clause",
+                                                 target->get_class_name(), clause));
+        }
+        LinkChain link_chain(target);
+        std::string prop_name = drv->translate(link_chain, path[0].get_key());
+        ColKey col_key = target->get_column_key(prop_name);
+        if (!col_key) {
+            throw InvalidQueryError(util::format("No property '%1' found on object type '%2' specified in '%3' clause",
+                                                 prop_name, target->get_class_name(), clause));
+        }
+        return col_key;
+    };
+
+    GroupBy group_by;
+    for (auto& path : columns) {
+        group_by.columns.push_back(column(path, "group by"));
+    }
+    for (auto& [type, path] : aggregates) {
+        GroupByAggregate aggregate;
+        switch (type) {
+            case COUNT:
+                aggregate.type = GroupByAggregate::Type::Count;
+                break;
+            case AggrNode::MAX:
+                aggregate.type = GroupByAggregate::Type::Max;
+                break;
+            case AggrNode::MIN:
+                aggregate.type = GroupByAggregate::Type::Min;
+                break;
+            case AggrNode::SUM:
+                aggregate.type = GroupByAggregate::Type::Sum;
+                break;
+            case AggrNode::AVG:
+                aggregate.type = GroupByAggregate::Type::Average;
+                break;
+        }
+        if (type != COUNT)
+            aggregate.column = column(path, "aggregate");
+        group_by.aggregates.push_back(aggregate);
+    }
+    if (group_by.aggregates.empty()) {
+        group_by.aggregates.push_back({GroupByAggregate::Type::Count});
+    }
+    return group_by;
+}
+
 // If one of the expresions is constant, it should be right
 static void verify_conditions(Subexpr* left, Subexpr* right, util::serializer::SerialisationState& state)
 {
@@ -1771,19 +1827,21 @@ ParserDriver::ParserDriver(TableRef t, Arguments& args, const query_parser::KeyP
     : m_base_table(t)
     , m_args(args)
     , m_mapping(mapping)
+    , m_yyscanner(nullptr)
 {
-    yylex_init(&m_yyscanner);
 }
 
 ParserDriver::~ParserDriver()
 {
-    yylex_destroy(m_yyscanner);
+    if (m_yyscanner)
+        yylex_destroy(m_yyscanner);
 }
 
 PathElement ParserDriver::get_arg_for_index(const std::string& i)
 {
     REALM_ASSERT(i[0] == '$');
     size_t arg_no = size_t(strtol(i.substr(1).c_str(), nullptr, 10));
+    parse_used_args = true;
     if (m_args.is_argument_null(arg_no) || m_args.is_argument_list(arg_no)) {
         throw InvalidQueryError("Invalid index parameter");
     }
@@ -1818,6 +1876,7 @@ double ParserDriver::get_arg_for_coordinate(const std::string& str)
 {
     REALM_ASSERT(str[0] == '$');
     size_t arg_no = size_t(strtol(str.substr(1).c_str(), nullptr, 10));
+    parse_used_args = true;
     if (m_args.is_argument_null(arg_no)) {
         throw InvalidQueryError(util::format("NULL cannot be used in coordinate at argument '%1'", str));
     }
@@ -1910,6 +1969,19 @@ void ParserDriver::backlink(LinkChain& link_chain, std::string_view raw_table_na
     link_chain.backlink(*origin_table, origin_column);
 }
 
+void ParserDriver::check_keyword(const std::string& id, std::string_view keyword)
+{
+    bool equal = id.size() == keyword.size() && std::equal(id.begin(), id.end(), keyword.begin(), [](char a, char b) {
+                     return std::tolower(static_cast<unsigned char>(a)) == b;
+                 });
+    if (!equal) {
+        std::string expected(keyword);
+        std::transform(expected.begin(), expected.end(), expected.begin(), ::toupper);
+        throw yy::parser::syntax_error(
+            util::format("syntax error, unexpected identifier '%1', expecting %2", id, expected));
+    }
+}
+
 std::string ParserDriver::translate(const LinkChain& link_chain, const std::string& identifier)
 {
     return m_mapping.translate(link_chain, identifier);
@@ -1918,6 +1990,8 @@ std::string ParserDriver::translate(const LinkChain& link_chain, const std::stri
 int ParserDriver::parse(const std::string& str)
 {
     // std::cout << str << std::endl;
+    if (!m_yyscanner)
+        yylex_init(&m_yyscanner);
     parse_buffer.append(str);
     parse_buffer.append("\0\0", 2); // Flex requires 2 terminating zeroes
     scan_begin(m_yyscanner, trace_scanning);
@@ -1930,6 +2004,24 @@ int ParserDriver::parse(const std::string& str)
     return res;
 }
 
+std::unique_ptr<ParserDriver::ParseResult> ParserDriver::release_parse_result()
+{
+    if (parse_used_args)
+        return nullptr;
+    auto parsed = std::make_unique<ParseResult>();
+    parsed->nodes = std::move(m_parse_nodes);
+    parsed->result = result;
+    parsed->ordering = ordering;
+    return parsed;
+}
+
+void ParserDriver::use_parse_result(ParseResult& parsed)
+{
+    parsed.nodes.restore_parsed_state();
+    result = parsed.result;
+    ordering = parsed.ordering;
+}
+
 void parse(const std::string& str)
 {
     ParserDriver driver;
@@ -1961,6 +2053,116 @@ std::string check_escapes(const char* str)
     return ret + std::string(str);
 }
 
+namespace {
+
+// Syntax trees of recently used query strings. An entry is taken out of the cache while
+// a query is built from it, as building the query modifies the tree temporarily.
+class QueryCache {
+public:
+    using ParseResult = ParserDriver::ParseResult;
+
+    static QueryCache& get()
+    {
+        static QueryCache cache;
+        return cache;
+    }
+
+    std::unique_ptr<ParseResult> take(const std::string& query_string)
+    {
+        std::lock_guard lock(m_mutex);
+        if (m_capacity == 0)
+            return nullptr;
+        auto it = m_entries.find(query_string);
+        if (it == m_entries.end()) {
+            ++m_stats.misses;
+            return nullptr;
+        }
+        ++m_stats.hits;
+        auto parsed = std::move(it->second.parsed);
+        m_lru.erase(it->second.lru_pos);
+        m_entries.erase(it);
+        return parsed;
+    }
+
+    void put(const std::string& query_string, std::unique_ptr<ParseResult> parsed)
+    {
+        std::vector<std::unique_ptr<ParseResult>> evicted; // destroyed outside the lock
+        std::lock_guard lock(m_mutex);
+        // Another thread may have returned the same query meanwhile
+        if (m_capacity == 0 || m_entries.count(query_string))
+            return;
+        m_lru.push_front(query_string);
+        m_entries.emplace(query_string, Entry{std::move(parsed), m_lru.begin()});
+        evict(evicted);
+    }
+
+    void set_capacity(size_t capacity)
+    {
+        std::vector<std::unique_ptr<ParseResult>> evicted;
+        std::lock_guard lock(m_mutex);
+        m_capacity = capacity;
+        evict(evicted);
+    }
+
+    QueryCacheStats get_stats()
+    {
+        std::lock_guard lock(m_mutex);
+        QueryCacheStats stats = m_stats;
+        stats.size = m_entries.size();
+        stats.capacity = m_capacity;
+        return stats;
+    }
+
+    void clear()
+    {
+        std::lock_guard lock(m_mutex);
+        m_entries.clear();
+        m_lru.clear();
+        m_stats = {};
+    }
+
+private:
+    struct Entry {
+        std::unique_ptr<ParseResult> parsed;
+        std::list<std::string>::iterator lru_pos;
+    };
+
+    std::mutex m_mutex;
+    size_t m_capacity = 256;
+    // Most recently used first
+    std::list<std::string> m_lru;
+    std::unordered_map<std::string, Entry> m_entries;
+    QueryCacheStats m_stats;
+
+    void evict(std::vector<std::unique_ptr<ParseResult>>& evicted)
+    {
+        while (m_entries.size() > m_capacity) {
+            auto it = m_entries.find(m_lru.back());
+            evicted.push_back(std::move(it->second.parsed));
+            m_entries.erase(it);
+            m_lru.pop_back();
+            ++m_stats.evictions;
+        }
+    }
+};
+
+} // namespace
+
+void set_query_cache_capacity(size_t capacity)
+{
+    QueryCache::get().set_capacity(capacity);
+}
+
+QueryCacheStats get_query_cache_stats()
+{
+    return QueryCache::get().get_stats();
+}
+
+void clear_query_cache()
+{
+    QueryCache::get().clear();
+}
+
 } // namespace query_parser
 
 Query Table::query(const std::string& query_string, const std::vector<MixedArguments::Arg>& arguments) const
@@ -1992,10 +2194,26 @@ Query Table::query(const std::string& query_string, const std::vector<MixedArgum
 Query Table::query(const std::string& query_string, query_parser::Arguments& args,
                    const query_parser::KeyPathMapping& mapping) const
 {
+    auto& cache = query_parser::QueryCache::get();
     ParserDriver driver(m_own_ref, args, mapping);
-    driver.parse(query_string);
-    driver.result->canonicalize();
-    return driver.result->visit(&driver).set_ordering(driver.ordering->visit(&driver));
+    auto parsed = cache.take(query_string);
+    if (parsed) {
+        driver.use_parse_result(*parsed);
+    }
+    else {
+        driver.parse(query_string);
+        driver.result->canonicalize();
+        driver.m_parse_nodes.save_parsed_state();
+    }
+    Query q = driver.result->visit(&driver).set_ordering(driver.ordering->visit(&driver));
+    if (driver.ordering->group_by)
+        q.set_group_by(driver.ordering->group_by->visit(&driver));
+    q.set_explain(driver.ordering->explain);
+    if (!parsed)
+        parsed = driver.release_parse_result();
+    if (parsed)
+        cache.put(query_string, std::move(parsed));
+    return q;
 }
 
 std::unique_ptr<Subexpr> LinkChain::column(const std::string& col, bool has_path)
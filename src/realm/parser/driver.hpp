@@ -338,10 +338,29 @@ public:
         }
     }
 
+    // Building a query consumes the elements of the path, so the parsed state
+    // is saved in order to build queries from the same syntax tree again.
+    void save_parsed_state()
+    {
+        m_parsed_elems = path_elems;
+        m_parsed_backlink_str = backlink_str;
+        m_parsed_backlink = backlink;
+    }
+    void restore_parsed_state()
+    {
+        path_elems = m_parsed_elems;
+        backlink_str = m_parsed_backlink_str;
+        backlink = m_parsed_backlink;
+    }
+
 private:
     std::string arg;
     std::string backlink_str;
     int backlink = 0;
+
+    Path m_parsed_elems;
+    std::string m_parsed_backlink_str;
+    int m_parsed_backlink = 0;
 };
 
 class PropertyNode : public ValueNode {
@@ -610,9 +629,34 @@ public:
     }
 };
 
+class GroupByNode : public ParserNode {
+public:
+    // AggrNode::Type, or COUNT
+    static constexpr int COUNT = -1;
+    std::vector<Path> columns;
+    std::vector<std::pair<int, Path>> aggregates;
+
+    ~GroupByNode() override;
+    void add(PathNode* path)
+    {
+        columns.push_back(std::move(path->path_elems));
+    }
+    void add_aggregate(int type, PathNode* path)
+    {
+        aggregates.emplace_back(type, path ? std::move(path->path_elems) : Path{});
+    }
+    void add_aggregates(GroupByNode* other)
+    {
+        std::move(other->aggregates.begin(), other->aggregates.end(), std::back_inserter(aggregates));
+    }
+    GroupBy visit(ParserDriver* drv);
+};
+
 class DescriptorOrderingNode : public ParserNode {
 public:
     std::vector<DescriptorNode*> orderings;
+    GroupByNode* group_by = nullptr;
+    Query::Explain explain = Query::Explain::None;
 
     DescriptorOrderingNode() = default;
     ~DescriptorOrderingNode() override;
@@ -635,11 +679,34 @@ public:
             auto owned = std::make_unique<T>(std::forward<Args>(args)...);
             auto ret = owned.get();
             m_store.push_back(std::move(owned));
+            if constexpr (std::is_same_v<T, PathNode>)
+                m_paths.push_back(ret);
             return ret;
         }
 
+        void save_parsed_state()
+        {
+            for (auto path : m_paths)
+                path->save_parsed_state();
+        }
+        void restore_parsed_state()
+        {
+            for (auto path : m_paths)
+                path->restore_parsed_state();
+        }
+
     private:
         std::vector<std::unique_ptr<ParserNode>> m_store;
+        std::vector<PathNode*> m_paths;
+    };
+
+    // The syntax tree of a query string. Unless arguments were needed for parsing (used as
+    // list indexes or coordinates), it only depends on the text of the query and can be used
+    // to build queries on any table, with any arguments and mapping.
+    struct ParseResult {
+        ParserNodeStore nodes;
+        QueryNode* result = nullptr;
+        DescriptorOrderingNode* ordering = nullptr;
     };
 
     ParserDriver()
@@ -662,6 +729,12 @@ public:
     // Run the parser on file F.  Return 0 on success.
     int parse(const std::string& str);
 
+    // Take the syntax tree built by parse(), canonicalized. Returns null if the
+    // tree depends on the arguments.
+    std::unique_ptr<ParseResult> release_parse_result();
+    // Build the query from a syntax tree taken from another driver instead of parsing
+    void use_parse_result(ParseResult& parsed);
+
     // Handling the scanner.
     void scan_begin(void*, bool trace_scanning);
 
@@ -671,6 +744,9 @@ public:
         parse_error = true;
     }
 
+    // Fail the parse unless the identifier is the keyword, ignoring case
+    void check_keyword(const std::string& id, std::string_view keyword);
+
     PathElement get_arg_for_index(const std::string&);
     std::string get_arg_for_key_path(const std::string& i);
     double get_arg_for_coordinate(const std::string&);
@@ -690,6 +766,7 @@ private:
     std::string error_string;
     void* scan_buffer = nullptr;
     bool parse_error = false;
+    bool parse_used_args = false;
 
     static NoArguments s_default_args;
     static query_parser::KeyPathMapping s_default_mapping;
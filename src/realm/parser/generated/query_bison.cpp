@@ -232,6 +232,12 @@ namespace yy {
         value.YY_MOVE_OR_COPY< GeospatialNode* > (YY_MOVE (that.value));
         break;
 
+      case symbol_kind::SYM_group_by: // group_by
+      case symbol_kind::SYM_group_by_param: // group_by_param
+      case symbol_kind::SYM_group_by_aggregates: // group_by_aggregates
+        value.YY_MOVE_OR_COPY< GroupByNode* > (YY_MOVE (that.value));
+        break;
+
       case symbol_kind::SYM_list: // list
       case symbol_kind::SYM_list_content: // list_content
         value.YY_MOVE_OR_COPY< ListNode* > (YY_MOVE (that.value));
@@ -275,6 +281,7 @@ namespace yy {
         value.YY_MOVE_OR_COPY< double > (YY_MOVE (that.value));
         break;
 
+      case symbol_kind::SYM_explain: // explain
       case symbol_kind::SYM_comp_type: // comp_type
       case symbol_kind::SYM_aggr_op: // aggr_op
         value.YY_MOVE_OR_COPY< int > (YY_MOVE (that.value));
@@ -378,6 +385,12 @@ namespace yy {
         value.move< GeospatialNode* > (YY_MOVE (that.value));
         break;
 
+      case symbol_kind::SYM_group_by: // group_by
+      case symbol_kind::SYM_group_by_param: // group_by_param
+      case symbol_kind::SYM_group_by_aggregates: // group_by_aggregates
+        value.move< GroupByNode* > (YY_MOVE (that.value));
+        break;
+
       case symbol_kind::SYM_list: // list
       case symbol_kind::SYM_list_content: // list_content
         value.move< ListNode* > (YY_MOVE (that.value));
@@ -421,6 +434,7 @@ namespace yy {
         value.move< double > (YY_MOVE (that.value));
         break;
 
+      case symbol_kind::SYM_explain: // explain
       case symbol_kind::SYM_comp_type: // comp_type
       case symbol_kind::SYM_aggr_op: // aggr_op
         value.move< int > (YY_MOVE (that.value));
@@ -524,6 +538,12 @@ namespace yy {
         value.copy< GeospatialNode* > (that.value);
         break;
 
+      case symbol_kind::SYM_group_by: // group_by
+      case symbol_kind::SYM_group_by_param: // group_by_param
+      case symbol_kind::SYM_group_by_aggregates: // group_by_aggregates
+        value.copy< GroupByNode* > (that.value);
+        break;
+
       case symbol_kind::SYM_list: // list
       case symbol_kind::SYM_list_content: // list_content
         value.copy< ListNode* > (that.value);
@@ -567,6 +587,7 @@ namespace yy {
         value.copy< double > (that.value);
         break;
 
+      case symbol_kind::SYM_explain: // explain
       case symbol_kind::SYM_comp_type: // comp_type
       case symbol_kind::SYM_aggr_op: // aggr_op
         value.copy< int > (that.value);
@@ -668,6 +689,12 @@ namespace yy {
         value.move< GeospatialNode* > (that.value);
         break;
 
+      case symbol_kind::SYM_group_by: // group_by
+      case symbol_kind::SYM_group_by_param: // group_by_param
+      case symbol_kind::SYM_group_by_aggregates: // group_by_aggregates
+        value.move< GroupByNode* > (that.value);
+        break;
+
       case symbol_kind::SYM_list: // list
       case symbol_kind::SYM_list_content: // list_content
         value.move< ListNode* > (that.value);
@@ -711,6 +738,7 @@ namespace yy {
         value.move< double > (that.value);
         break;
 
+      case symbol_kind::SYM_explain: // explain
       case symbol_kind::SYM_comp_type: // comp_type
       case symbol_kind::SYM_aggr_op: // aggr_op
         value.move< int > (that.value);
@@ -1178,6 +1206,22 @@ namespace yy {
                  { yyo << yysym.value.template as < DescriptorNode* > (); }
         break;
 
+      case symbol_kind::SYM_group_by: // group_by
+                 { yyo << yysym.value.template as < GroupByNode* > (); }
+        break;
+
+      case symbol_kind::SYM_group_by_param: // group_by_param
+                 { yyo << yysym.value.template as < GroupByNode* > (); }
+        break;
+
+      case symbol_kind::SYM_group_by_aggregates: // group_by_aggregates
+                 { yyo << yysym.value.template as < GroupByNode* > (); }
+        break;
+
+      case symbol_kind::SYM_explain: // explain
+                 { yyo << yysym.value.template as < int > (); }
+        break;
+
       case symbol_kind::SYM_sort: // sort
                  { yyo << yysym.value.template as < DescriptorNode* > (); }
         break;
@@ -1508,6 +1552,12 @@ namespace yy {
         yylhs.value.emplace< GeospatialNode* > ();
         break;
 
+      case symbol_kind::SYM_group_by: // group_by
+      case symbol_kind::SYM_group_by_param: // group_by_param
+      case symbol_kind::SYM_group_by_aggregates: // group_by_aggregates
+        yylhs.value.emplace< GroupByNode* > ();
+        break;
+
       case symbol_kind::SYM_list: // list
       case symbol_kind::SYM_list_content: // list_content
         yylhs.value.emplace< ListNode* > ();
@@ -1551,6 +1601,7 @@ namespace yy {
         yylhs.value.emplace< double > ();
         break;
 
+      case symbol_kind::SYM_explain: // explain
       case symbol_kind::SYM_comp_type: // comp_type
       case symbol_kind::SYM_aggr_op: // aggr_op
         yylhs.value.emplace< int > ();
@@ -1619,35 +1670,52 @@ namespace yy {
                        { drv.result = yystack_[1].value.as < QueryNode* > (); drv.ordering = yystack_[0].value.as < DescriptorOrderingNode* > (); }
     break;
 
-  case 3: // query: compare
+  case 3: // final: query post_query group_by
+                                { drv.result = yystack_[2].value.as < QueryNode* > (); drv.ordering = yystack_[1].value.as < DescriptorOrderingNode* > (); yystack_[1].value.as < DescriptorOrderingNode* > ()->group_by = yystack_[0].value.as < GroupByNode* > (); }
+    break;
+
+  case 4: // final: query post_query explain
+                                { drv.result = yystack_[2].value.as < QueryNode* > (); drv.ordering = yystack_[1].value.as < DescriptorOrderingNode* > (); yystack_[1].value.as < DescriptorOrderingNode* > ()->explain = Query::Explain(yystack_[0].value.as < int > ()); }
+    break;
+
+  case 5: // final: query post_query group_by explain
+                                        {
+                                    drv.result = yystack_[3].value.as < QueryNode* > ();
+                                    drv.ordering = yystack_[2].value.as < DescriptorOrderingNode* > ();
+                                    yystack_[2].value.as < DescriptorOrderingNode* > ()->group_by = yystack_[1].value.as < GroupByNode* > ();
+                                    yystack_[2].value.as < DescriptorOrderingNode* > ()->explain = Query::Explain(yystack_[0].value.as < int > ());
+                                }
+    break;
+
+  case 6: // query: compare
                                 { yylhs.value.as < QueryNode* > () = yystack_[0].value.as < QueryNode* > (); }
     break;
 
-  case 4: // query: query "||" query
+  case 7: // query: query "||" query
                                 { yylhs.value.as < QueryNode* > () = drv.m_parse_nodes.create<OrNode>(yystack_[2].value.as < QueryNode* > (), yystack_[0].value.as < QueryNode* > ()); }
     break;
 
-  case 5: // query: query "&&" query
+  case 8: // query: query "&&" query
                                 { yylhs.value.as < QueryNode* > () = drv.m_parse_nodes.create<AndNode>(yystack_[2].value.as < QueryNode* > (), yystack_[0].value.as < QueryNode* > ()); }
     break;
 
-  case 6: // query: "!" query
+  case 9: // query: "!" query
                                 { yylhs.value.as < QueryNode* > () = drv.m_parse_nodes.create<NotNode>(yystack_[0].value.as < QueryNode* > ()); }
     break;
 
-  case 7: // query: '(' query ')'
+  case 10: // query: '(' query ')'
                                 { yylhs.value.as < QueryNode* > () = yystack_[1].value.as < QueryNode* > (); }
     break;
 
-  case 8: // query: boolexpr
+  case 11: // query: boolexpr
                                 { yylhs.value.as < QueryNode* > () =yystack_[0].value.as < TrueOrFalseNode* > (); }
     break;
 
-  case 9: // compare: expr equality expr
+  case 12: // compare: expr equality expr
                                 { yylhs.value.as < QueryNode* > () = drv.m_parse_nodes.create<EqualityNode>(yystack_[2].value.as < ExpressionNode* > (), yystack_[1].value.as < CompareType > (), yystack_[0].value.as < ExpressionNode* > ()); }
     break;
 
-  case 10: // compare: expr equality "[c]" expr
+  case 13: // compare: expr equality "[c]" expr
                                 {
                                     auto tmp = drv.m_parse_nodes.create<EqualityNode>(yystack_[3].value.as < ExpressionNode* > (), yystack_[2].value.as < CompareType > (), yystack_[0].value.as < ExpressionNode* > ());
                                     tmp->case_sensitive = false;
@@ -1655,19 +1723,19 @@ namespace yy {
                                 }
     break;
 
-  case 11: // compare: expr relational expr
+  case 14: // compare: expr relational expr
                                 { yylhs.value.as < QueryNode* > () = drv.m_parse_nodes.create<RelationalNode>(yystack_[2].value.as < ExpressionNode* > (), yystack_[1].value.as < CompareType > (), yystack_[0].value.as < ExpressionNode* > ()); }
     break;
 
-  case 12: // compare: value stringop value
+  case 15: // compare: value stringop value
                                 { yylhs.value.as < QueryNode* > () = drv.m_parse_nodes.create<StringOpsNode>(yystack_[2].value.as < ValueNode* > (), yystack_[1].value.as < CompareType > (), yystack_[0].value.as < ValueNode* > ()); }
     break;
 
-  case 13: // compare: value "fulltext" value
+  case 16: // compare: value "fulltext" value
                                 { yylhs.value.as < QueryNode* > () = drv.m_parse_nodes.create<StringOpsNode>(yystack_[2].value.as < ValueNode* > (), CompareType::TEXT, yystack_[0].value.as < ValueNode* > ()); }
     break;
 
-  case 14: // compare: value stringop "[c]" value
+  case 17: // compare: value stringop "[c]" value
                                 {
                                     auto tmp = drv.m_parse_nodes.create<StringOpsNode>(yystack_[3].value.as < ValueNode* > (), yystack_[2].value.as < CompareType > (), yystack_[0].value.as < ValueNode* > ());
                                     tmp->case_sensitive = false;
@@ -1675,265 +1743,320 @@ namespace yy {
                                 }
     break;
 
-  case 15: // compare: value "between" list
+  case 18: // compare: value "between" list
                                 { yylhs.value.as < QueryNode* > () = drv.m_parse_nodes.create<BetweenNode>(yystack_[2].value.as < ValueNode* > (), yystack_[0].value.as < ListNode* > ()); }
     break;
 
-  case 16: // compare: prop "geowithin" geospatial
+  case 19: // compare: prop "geowithin" geospatial
                                 { yylhs.value.as < QueryNode* > () = drv.m_parse_nodes.create<GeoWithinNode>(yystack_[2].value.as < PropertyNode* > (), yystack_[0].value.as < GeospatialNode* > ()); }
     break;
 
-  case 17: // compare: prop "geowithin" "argument"
+  case 20: // compare: prop "geowithin" "argument"
                                 { yylhs.value.as < QueryNode* > () = drv.m_parse_nodes.create<GeoWithinNode>(yystack_[2].value.as < PropertyNode* > (), yystack_[0].value.as < std::string > ()); }
     break;
 
-  case 18: // expr: value
+  case 21: // expr: value
                                 { yylhs.value.as < ExpressionNode* > () = yystack_[0].value.as < ValueNode* > (); }
     break;
 
-  case 19: // expr: '(' expr ')'
+  case 22: // expr: '(' expr ')'
                                 { yylhs.value.as < ExpressionNode* > () = yystack_[1].value.as < ExpressionNode* > (); }
     break;
 
-  case 20: // expr: expr '*' expr
+  case 23: // expr: expr '*' expr
                                 { yylhs.value.as < ExpressionNode* > () = drv.m_parse_nodes.create<OperationNode>(yystack_[2].value.as < ExpressionNode* > (), '*', yystack_[0].value.as < ExpressionNode* > ()); }
     break;
 
-  case 21: // expr: expr '/' expr
+  case 24: // expr: expr '/' expr
                                 { yylhs.value.as < ExpressionNode* > () = drv.m_parse_nodes.create<OperationNode>(yystack_[2].value.as < ExpressionNode* > (), '/', yystack_[0].value.as < ExpressionNode* > ()); }
     break;
 
-  case 22: // expr: expr '+' expr
+  case 25: // expr: expr '+' expr
                                 { yylhs.value.as < ExpressionNode* > () = drv.m_parse_nodes.create<OperationNode>(yystack_[2].value.as < ExpressionNode* > (), '+', yystack_[0].value.as < ExpressionNode* > ()); }
     break;
 
-  case 23: // expr: expr '-' expr
+  case 26: // expr: expr '-' expr
                                 { yylhs.value.as < ExpressionNode* > () = drv.m_parse_nodes.create<OperationNode>(yystack_[2].value.as < ExpressionNode* > (), '-', yystack_[0].value.as < ExpressionNode* > ()); }
     break;
 
-  case 24: // value: constant
+  case 27: // value: constant
                                 { yylhs.value.as < ValueNode* > () = yystack_[0].value.as < ConstantNode* > ();}
     break;
 
-  case 25: // value: prop
+  case 28: // value: prop
                                 { yylhs.value.as < ValueNode* > () = yystack_[0].value.as < PropertyNode* > ();}
     break;
 
-  case 26: // value: list
+  case 29: // value: list
                                 { yylhs.value.as < ValueNode* > () = yystack_[0].value.as < ListNode* > ();}
     break;
 
-  case 27: // value: aggregate
+  case 30: // value: aggregate
                                 { yylhs.value.as < ValueNode* > () = yystack_[0].value.as < AggrNode* > ();}
     break;
 
-  case 28: // value: subquery
+  case 31: // value: subquery
                                 { yylhs.value.as < ValueNode* > () = yystack_[0].value.as < SubqueryNode* > ();}
     break;
 
-  case 29: // prop: path post_op
+  case 32: // prop: path post_op
                                 { yylhs.value.as < PropertyNode* > () = drv.m_parse_nodes.create<PropertyNode>(yystack_[1].value.as < PathNode* > ()); yylhs.value.as < PropertyNode* > ()->add_postop(yystack_[0].value.as < PostOpNode* > ()); }
     break;
 
-  case 30: // prop: comp_type path post_op
+  case 33: // prop: comp_type path post_op
                                 { yylhs.value.as < PropertyNode* > () = drv.m_parse_nodes.create<PropertyNode>(yystack_[1].value.as < PathNode* > (), ExpressionComparisonType(yystack_[2].value.as < int > ())); yylhs.value.as < PropertyNode* > ()->add_postop(yystack_[0].value.as < PostOpNode* > ()); }
     break;
 
-  case 31: // aggregate: path aggr_op '.' id
+  case 34: // aggregate: path aggr_op '.' id
                                 {
                                     auto prop = drv.m_parse_nodes.create<PropertyNode>(yystack_[3].value.as < PathNode* > ());
                                     yylhs.value.as < AggrNode* > () = drv.m_parse_nodes.create<LinkAggrNode>(prop, yystack_[2].value.as < int > (), yystack_[0].value.as < std::string > ());
                                 }
     break;
 
-  case 32: // aggregate: path aggr_op
+  case 35: // aggregate: path aggr_op
                                 {
                                     auto prop = drv.m_parse_nodes.create<PropertyNode>(yystack_[1].value.as < PathNode* > ());
                                     yylhs.value.as < AggrNode* > () = drv.m_parse_nodes.create<ListAggrNode>(prop, yystack_[0].value.as < int > ());
                                 }
     break;
 
-  case 33: // simple_prop: path
+  case 36: // simple_prop: path
                                 { yylhs.value.as < PropertyNode* > () = drv.m_parse_nodes.create<PropertyNode>(yystack_[0].value.as < PathNode* > ()); }
     break;
 
-  case 34: // subquery: "subquery" '(' simple_prop ',' id ',' query ')' '.' "@size"
+  case 37: // subquery: "subquery" '(' simple_prop ',' id ',' query ')' '.' "@size"
                                                                { yylhs.value.as < SubqueryNode* > () = drv.m_parse_nodes.create<SubqueryNode>(yystack_[7].value.as < PropertyNode* > (), yystack_[5].value.as < std::string > (), yystack_[3].value.as < QueryNode* > ()); }
     break;
 
-  case 35: // coordinate: "float"
+  case 38: // coordinate: "float"
                     { yylhs.value.as < double > () = strtod(yystack_[0].value.as < std::string > ().c_str(), nullptr); }
     break;
 
-  case 36: // coordinate: "natural0"
+  case 39: // coordinate: "natural0"
                     { yylhs.value.as < double > () = double(strtoll(yystack_[0].value.as < std::string > ().c_str(), nullptr, 0)); }
     break;
 
-  case 37: // coordinate: "argument"
+  case 40: // coordinate: "argument"
                     { yylhs.value.as < double > () = drv.get_arg_for_coordinate(yystack_[0].value.as < std::string > ()); }
     break;
 
-  case 38: // geopoint: '[' coordinate ',' coordinate ']'
+  case 41: // geopoint: '[' coordinate ',' coordinate ']'
                                         { yylhs.value.as < std::optional<GeoPoint> > () = GeoPoint{yystack_[3].value.as < double > (), yystack_[1].value.as < double > ()}; }
     break;
 
-  case 39: // geopoint: '[' coordinate ',' coordinate ',' "float" ']'
+  case 42: // geopoint: '[' coordinate ',' coordinate ',' "float" ']'
                                                   { yylhs.value.as < std::optional<GeoPoint> > () = GeoPoint{yystack_[5].value.as < double > (), yystack_[3].value.as < double > (), strtod(yystack_[1].value.as < std::string > ().c_str(), nullptr)}; }
     break;
 
-  case 40: // geoloop_content: geopoint
+  case 43: // geoloop_content: geopoint
                { yylhs.value.as < GeospatialNode* > () = drv.m_parse_nodes.create<GeospatialNode>(GeospatialNode::Loop{}, *yystack_[0].value.as < std::optional<GeoPoint> > ()); }
     break;
 
-  case 41: // geoloop_content: geoloop_content ',' geopoint
+  case 44: // geoloop_content: geoloop_content ',' geopoint
                                    { yystack_[2].value.as < GeospatialNode* > ()->add_point_to_loop(*yystack_[0].value.as < std::optional<GeoPoint> > ()); yylhs.value.as < GeospatialNode* > () = yystack_[2].value.as < GeospatialNode* > (); }
     break;
 
-  case 42: // geoloop: '{' geoloop_content '}'
+  case 45: // geoloop: '{' geoloop_content '}'
                                   { yylhs.value.as < GeospatialNode* > () = yystack_[1].value.as < GeospatialNode* > (); }
     break;
 
-  case 43: // geopoly_content: geoloop
+  case 46: // geopoly_content: geoloop
               { yylhs.value.as < GeospatialNode* > () = yystack_[0].value.as < GeospatialNode* > (); }
     break;
 
-  case 44: // geopoly_content: geopoly_content ',' geoloop
+  case 47: // geopoly_content: geopoly_content ',' geoloop
                                   { yystack_[2].value.as < GeospatialNode* > ()->add_loop_to_polygon(yystack_[0].value.as < GeospatialNode* > ()); yylhs.value.as < GeospatialNode* > () = yystack_[2].value.as < GeospatialNode* > (); }
     break;
 
-  case 45: // geospatial: "geobox" '(' geopoint ',' geopoint ')'
+  case 48: // geospatial: "geobox" '(' geopoint ',' geopoint ')'
                                             { yylhs.value.as < GeospatialNode* > () = drv.m_parse_nodes.create<GeospatialNode>(GeospatialNode::Box{}, *yystack_[3].value.as < std::optional<GeoPoint> > (), *yystack_[1].value.as < std::optional<GeoPoint> > ()); }
     break;
 
-  case 46: // geospatial: "geocircle" '(' geopoint ',' coordinate ')'
+  case 49: // geospatial: "geocircle" '(' geopoint ',' coordinate ')'
                                                 { yylhs.value.as < GeospatialNode* > () = drv.m_parse_nodes.create<GeospatialNode>(GeospatialNode::Circle{}, *yystack_[3].value.as < std::optional<GeoPoint> > (), yystack_[1].value.as < double > ()); }
     break;
 
-  case 47: // geospatial: "geopolygon" '(' geopoly_content ')'
+  case 50: // geospatial: "geopolygon" '(' geopoly_content ')'
                                             { yylhs.value.as < GeospatialNode* > () = yystack_[1].value.as < GeospatialNode* > (); }
     break;
 
-  case 48: // post_query: %empty
+  case 51: // post_query: %empty
                                 { yylhs.value.as < DescriptorOrderingNode* > () = drv.m_parse_nodes.create<DescriptorOrderingNode>();}
     break;
 
-  case 49: // post_query: post_query sort
+  case 52: // post_query: post_query sort
                                 { yystack_[1].value.as < DescriptorOrderingNode* > ()->add_descriptor(yystack_[0].value.as < DescriptorNode* > ()); yylhs.value.as < DescriptorOrderingNode* > () = yystack_[1].value.as < DescriptorOrderingNode* > (); }
     break;
 
-  case 50: // post_query: post_query distinct
+  case 53: // post_query: post_query distinct
                                 { yystack_[1].value.as < DescriptorOrderingNode* > ()->add_descriptor(yystack_[0].value.as < DescriptorNode* > ()); yylhs.value.as < DescriptorOrderingNode* > () = yystack_[1].value.as < DescriptorOrderingNode* > (); }
     break;
 
-  case 51: // post_query: post_query limit
+  case 54: // post_query: post_query limit
                                 { yystack_[1].value.as < DescriptorOrderingNode* > ()->add_descriptor(yystack_[0].value.as < DescriptorNode* > ()); yylhs.value.as < DescriptorOrderingNode* > () = yystack_[1].value.as < DescriptorOrderingNode* > (); }
     break;
 
-  case 52: // distinct: "distinct" '(' distinct_param ')'
+  case 55: // distinct: "distinct" '(' distinct_param ')'
                                           { yylhs.value.as < DescriptorNode* > () = yystack_[1].value.as < DescriptorNode* > (); }
     break;
 
-  case 53: // distinct_param: path
+  case 56: // distinct_param: path
                                 { yylhs.value.as < DescriptorNode* > () = drv.m_parse_nodes.create<DescriptorNode>(DescriptorNode::DISTINCT); yylhs.value.as < DescriptorNode* > ()->add(yystack_[0].value.as < PathNode* > ());}
     break;
 
-  case 54: // distinct_param: distinct_param ',' path
+  case 57: // distinct_param: distinct_param ',' path
                                 { yystack_[2].value.as < DescriptorNode* > ()->add(yystack_[0].value.as < PathNode* > ()); yylhs.value.as < DescriptorNode* > () = yystack_[2].value.as < DescriptorNode* > (); }
     break;
 
-  case 55: // sort: "sort" '(' sort_param ')'
+  case 58: // group_by: "identifier" "identifier" '(' group_by_param ')'
+                                    {
+                                    drv.check_keyword(yystack_[4].value.as < std::string > (), "group");
+                                    drv.check_keyword(yystack_[3].value.as < std::string > (), "by");
+                                    yylhs.value.as < GroupByNode* > () = yystack_[1].value.as < GroupByNode* > ();
+                                }
+    break;
+
+  case 59: // group_by: group_by "identifier" '(' group_by_aggregates ')'
+                                              {
+                                    drv.check_keyword(yystack_[3].value.as < std::string > (), "aggregate");
+                                    yystack_[4].value.as < GroupByNode* > ()->add_aggregates(yystack_[1].value.as < GroupByNode* > ());
+                                    yylhs.value.as < GroupByNode* > () = yystack_[4].value.as < GroupByNode* > ();
+                                }
+    break;
+
+  case 60: // group_by_param: path
+                                { yylhs.value.as < GroupByNode* > () = drv.m_parse_nodes.create<GroupByNode>(); yylhs.value.as < GroupByNode* > ()->add(yystack_[0].value.as < PathNode* > ()); }
+    break;
+
+  case 61: // group_by_param: group_by_param ',' path
+                                { yystack_[2].value.as < GroupByNode* > ()->add(yystack_[0].value.as < PathNode* > ()); yylhs.value.as < GroupByNode* > () = yystack_[2].value.as < GroupByNode* > (); }
+    break;
+
+  case 62: // group_by_aggregates: "@size"
+                                { yylhs.value.as < GroupByNode* > () = drv.m_parse_nodes.create<GroupByNode>(); yylhs.value.as < GroupByNode* > ()->add_aggregate(GroupByNode::COUNT, nullptr); }
+    break;
+
+  case 63: // group_by_aggregates: path aggr_op
+                                { yylhs.value.as < GroupByNode* > () = drv.m_parse_nodes.create<GroupByNode>(); yylhs.value.as < GroupByNode* > ()->add_aggregate(yystack_[0].value.as < int > (), yystack_[1].value.as < PathNode* > ()); }
+    break;
+
+  case 64: // group_by_aggregates: group_by_aggregates ',' "@size"
+                                            { yystack_[2].value.as < GroupByNode* > ()->add_aggregate(GroupByNode::COUNT, nullptr); yylhs.value.as < GroupByNode* > () = yystack_[2].value.as < GroupByNode* > (); }
+    break;
+
+  case 65: // group_by_aggregates: group_by_aggregates ',' path aggr_op
+                                            { yystack_[3].value.as < GroupByNode* > ()->add_aggregate(yystack_[0].value.as < int > (), yystack_[1].value.as < PathNode* > ()); yylhs.value.as < GroupByNode* > () = yystack_[3].value.as < GroupByNode* > (); }
+    break;
+
+  case 66: // explain: "identifier"
+                                {
+                                    drv.check_keyword(yystack_[0].value.as < std::string > (), "explain");
+                                    yylhs.value.as < int > () = int(Query::Explain::Plan);
+                                }
+    break;
+
+  case 67: // explain: "identifier" "identifier"
+                                {
+                                    drv.check_keyword(yystack_[1].value.as < std::string > (), "explain");
+                                    drv.check_keyword(yystack_[0].value.as < std::string > (), "analyze");
+                                    yylhs.value.as < int > () = int(Query::Explain::Analyze);
+                                }
+    break;
+
+  case 68: // sort: "sort" '(' sort_param ')'
                                 { yylhs.value.as < DescriptorNode* > () = yystack_[1].value.as < DescriptorNode* > (); }
     break;
 
-  case 56: // sort_param: path direction
+  case 69: // sort_param: path direction
                                 { yylhs.value.as < DescriptorNode* > () = drv.m_parse_nodes.create<DescriptorNode>(DescriptorNode::SORT); yylhs.value.as < DescriptorNode* > ()->add(yystack_[1].value.as < PathNode* > (), yystack_[0].value.as < bool > ());}
     break;
 
-  case 57: // sort_param: sort_param ',' path direction
+  case 70: // sort_param: sort_param ',' path direction
                                      { yystack_[3].value.as < DescriptorNode* > ()->add(yystack_[1].value.as < PathNode* > (), yystack_[0].value.as < bool > ()); yylhs.value.as < DescriptorNode* > () = yystack_[3].value.as < DescriptorNode* > (); }
     break;
 
-  case 58: // limit: "limit" '(' "natural0" ')'
+  case 71: // limit: "limit" '(' "natural0" ')'
                                 { yylhs.value.as < DescriptorNode* > () = drv.m_parse_nodes.create<DescriptorNode>(DescriptorNode::LIMIT, yystack_[1].value.as < std::string > ()); }
     break;
 
-  case 59: // direction: "ascending"
+  case 72: // direction: "ascending"
                                 { yylhs.value.as < bool > () = true; }
     break;
 
-  case 60: // direction: "descending"
+  case 73: // direction: "descending"
                                 { yylhs.value.as < bool > () = false; }
     break;
 
-  case 61: // list: '{' list_content '}'
+  case 74: // list: '{' list_content '}'
                                         { yylhs.value.as < ListNode* > () = yystack_[1].value.as < ListNode* > (); }
     break;
 
-  case 62: // list: comp_type '{' list_content '}'
+  case 75: // list: comp_type '{' list_content '}'
                                         { yystack_[1].value.as < ListNode* > ()->set_comp_type(ExpressionComparisonType(yystack_[3].value.as < int > ())); yylhs.value.as < ListNode* > () = yystack_[1].value.as < ListNode* > (); }
     break;
 
-  case 63: // list_content: constant
+  case 76: // list_content: constant
                                 { yylhs.value.as < ListNode* > () = drv.m_parse_nodes.create<ListNode>(yystack_[0].value.as < ConstantNode* > ()); }
     break;
 
-  case 64: // list_content: %empty
+  case 77: // list_content: %empty
                                 { yylhs.value.as < ListNode* > () = drv.m_parse_nodes.create<ListNode>(); }
     break;
 
-  case 65: // list_content: list_content ',' constant
+  case 78: // list_content: list_content ',' constant
                                 { yystack_[2].value.as < ListNode* > ()->add_element(yystack_[0].value.as < ConstantNode* > ()); yylhs.value.as < ListNode* > () = yystack_[2].value.as < ListNode* > (); }
     break;
 
-  case 66: // constant: primary_key
+  case 79: // constant: primary_key
                                 { yylhs.value.as < ConstantNode* > () = yystack_[0].value.as < ConstantNode* > (); }
     break;
 
-  case 67: // constant: "infinity"
+  case 80: // constant: "infinity"
                                 { yylhs.value.as < ConstantNode* > () = drv.m_parse_nodes.create<ConstantNode>(ConstantNode::INFINITY_VAL, yystack_[0].value.as < std::string > ()); }
     break;
 
-  case 68: // constant: "NaN"
+  case 81: // constant: "NaN"
                                 { yylhs.value.as < ConstantNode* > () = drv.m_parse_nodes.create<ConstantNode>(ConstantNode::NAN_VAL, yystack_[0].value.as < std::string > ()); }
     break;
 
-  case 69: // constant: "base64"
+  case 82: // constant: "base64"
                                 { yylhs.value.as < ConstantNode* > () = drv.m_parse_nodes.create<ConstantNode>(ConstantNode::STRING_BASE64, yystack_[0].value.as < std::string > ()); }
     break;
 
-  case 70: // constant: "float"
+  case 83: // constant: "float"
                                 { yylhs.value.as < ConstantNode* > () = drv.m_parse_nodes.create<ConstantNode>(ConstantNode::FLOAT, yystack_[0].value.as < std::string > ()); }
     break;
 
-  case 71: // constant: "date"
+  case 84: // constant: "date"
                                 { yylhs.value.as < ConstantNode* > () = drv.m_parse_nodes.create<ConstantNode>(ConstantNode::TIMESTAMP, yystack_[0].value.as < std::string > ()); }
     break;
 
-  case 72: // constant: "link"
+  case 85: // constant: "link"
                                 { yylhs.value.as < ConstantNode* > () = drv.m_parse_nodes.create<ConstantNode>(ConstantNode::LINK, yystack_[0].value.as < std::string > ()); }
     break;
 
-  case 73: // constant: "typed link"
+  case 86: // constant: "typed link"
                                 { yylhs.value.as < ConstantNode* > () = drv.m_parse_nodes.create<ConstantNode>(ConstantNode::TYPED_LINK, yystack_[0].value.as < std::string > ()); }
     break;
 
-  case 74: // constant: "true"
+  case 87: // constant: "true"
                                 { yylhs.value.as < ConstantNode* > () = drv.m_parse_nodes.create<ConstantNode>(ConstantNode::TRUE, ""); }
     break;
 
-  case 75: // constant: "false"
+  case 88: // constant: "false"
                                 { yylhs.value.as < ConstantNode* > () = drv.m_parse_nodes.create<ConstantNode>(ConstantNode::FALSE, ""); }
     break;
 
-  case 76: // constant: "null"
+  case 89: // constant: "null"
                                 { yylhs.value.as < ConstantNode* > () = drv.m_parse_nodes.create<ConstantNode>(ConstantNode::NULL_VAL, ""); }
     break;
 
-  case 77: // constant: comp_type "argument"
+  case 90: // constant: comp_type "argument"
                                 { yylhs.value.as < ConstantNode* > () = drv.m_parse_nodes.create<ConstantNode>(ExpressionComparisonType(yystack_[1].value.as < int > ()), yystack_[0].value.as < std::string > ()); }
     break;
 
-  case 78: // constant: "obj" '(' "string" ',' primary_key ')'
+  case 91: // constant: "obj" '(' "string" ',' primary_key ')'
                                 { 
                                     auto tmp = yystack_[1].value.as < ConstantNode* > ();
                                     tmp->add_table(yystack_[3].value.as < std::string > ());
@@ -1941,243 +2064,243 @@ namespace yy {
                                 }
     break;
 
-  case 79: // constant: "binary" '(' "string" ')'
+  case 92: // constant: "binary" '(' "string" ')'
                                 { yylhs.value.as < ConstantNode* > () = drv.m_parse_nodes.create<ConstantNode>(ConstantNode::BINARY_STR, yystack_[1].value.as < std::string > ()); }
     break;
 
-  case 80: // constant: "binary" '(' "base64" ')'
+  case 93: // constant: "binary" '(' "base64" ')'
                                 { yylhs.value.as < ConstantNode* > () = drv.m_parse_nodes.create<ConstantNode>(ConstantNode::BINARY_BASE64, yystack_[1].value.as < std::string > ()); }
     break;
 
-  case 81: // primary_key: "natural0"
+  case 94: // primary_key: "natural0"
                                 { yylhs.value.as < ConstantNode* > () = drv.m_parse_nodes.create<ConstantNode>(ConstantNode::NUMBER, yystack_[0].value.as < std::string > ()); }
     break;
 
-  case 82: // primary_key: "number"
+  case 95: // primary_key: "number"
                                 { yylhs.value.as < ConstantNode* > () = drv.m_parse_nodes.create<ConstantNode>(ConstantNode::NUMBER, yystack_[0].value.as < std::string > ()); }
     break;
 
-  case 83: // primary_key: "string"
+  case 96: // primary_key: "string"
                                 { yylhs.value.as < ConstantNode* > () = drv.m_parse_nodes.create<ConstantNode>(ConstantNode::STRING, yystack_[0].value.as < std::string > ()); }
     break;
 
-  case 84: // primary_key: "UUID"
+  case 97: // primary_key: "UUID"
                                 { yylhs.value.as < ConstantNode* > () = drv.m_parse_nodes.create<ConstantNode>(ConstantNode::UUID_T, yystack_[0].value.as < std::string > ()); }
     break;
 
-  case 85: // primary_key: "ObjectId"
+  case 98: // primary_key: "ObjectId"
                                 { yylhs.value.as < ConstantNode* > () = drv.m_parse_nodes.create<ConstantNode>(ConstantNode::OID, yystack_[0].value.as < std::string > ()); }
     break;
 
-  case 86: // primary_key: "argument"
+  case 99: // primary_key: "argument"
                                 { yylhs.value.as < ConstantNode* > () = drv.m_parse_nodes.create<ConstantNode>(ConstantNode::ARG, yystack_[0].value.as < std::string > ()); }
     break;
 
-  case 87: // boolexpr: "truepredicate"
+  case 100: // boolexpr: "truepredicate"
                                 { yylhs.value.as < TrueOrFalseNode* > () = drv.m_parse_nodes.create<TrueOrFalseNode>(true); }
     break;
 
-  case 88: // boolexpr: "falsepredicate"
+  case 101: // boolexpr: "falsepredicate"
                                 { yylhs.value.as < TrueOrFalseNode* > () = drv.m_parse_nodes.create<TrueOrFalseNode>(false); }
     break;
 
-  case 89: // comp_type: "any"
+  case 102: // comp_type: "any"
                                 { yylhs.value.as < int > () = int(ExpressionComparisonType::Any); }
     break;
 
-  case 90: // comp_type: "all"
+  case 103: // comp_type: "all"
                                 { yylhs.value.as < int > () = int(ExpressionComparisonType::All); }
     break;
 
-  case 91: // comp_type: "none"
+  case 104: // comp_type: "none"
                                 { yylhs.value.as < int > () = int(ExpressionComparisonType::None); }
     break;
 
-  case 92: // post_op: %empty
+  case 105: // post_op: %empty
                                 { yylhs.value.as < PostOpNode* > () = nullptr; }
     break;
 
-  case 93: // post_op: '.' "@size"
+  case 106: // post_op: '.' "@size"
                                 { yylhs.value.as < PostOpNode* > () = drv.m_parse_nodes.create<PostOpNode>(yystack_[0].value.as < std::string > (), PostOpNode::SIZE);}
     break;
 
-  case 94: // post_op: '[' "SIZE" ']'
+  case 107: // post_op: '[' "SIZE" ']'
                                 { yylhs.value.as < PostOpNode* > () = drv.m_parse_nodes.create<PostOpNode>(yystack_[1].value.as < std::string > (), PostOpNode::SIZE);}
     break;
 
-  case 95: // post_op: '.' "@type"
+  case 108: // post_op: '.' "@type"
                                 { yylhs.value.as < PostOpNode* > () = drv.m_parse_nodes.create<PostOpNode>(yystack_[0].value.as < std::string > (), PostOpNode::TYPE);}
     break;
 
-  case 96: // aggr_op: '.' "@max"
+  case 109: // aggr_op: '.' "@max"
                                 { yylhs.value.as < int > () = int(AggrNode::MAX);}
     break;
 
-  case 97: // aggr_op: '.' "@min"
+  case 110: // aggr_op: '.' "@min"
                                 { yylhs.value.as < int > () = int(AggrNode::MIN);}
     break;
 
-  case 98: // aggr_op: '.' "@sum"
+  case 111: // aggr_op: '.' "@sum"
                                 { yylhs.value.as < int > () = int(AggrNode::SUM);}
     break;
 
-  case 99: // aggr_op: '.' "@average"
+  case 112: // aggr_op: '.' "@average"
                                 { yylhs.value.as < int > () = int(AggrNode::AVG);}
     break;
 
-  case 100: // equality: "=="
+  case 113: // equality: "=="
                                 { yylhs.value.as < CompareType > () = CompareType::EQUAL; }
     break;
 
-  case 101: // equality: "!="
+  case 114: // equality: "!="
                                 { yylhs.value.as < CompareType > () = CompareType::NOT_EQUAL; }
     break;
 
-  case 102: // equality: "in"
+  case 115: // equality: "in"
                                 { yylhs.value.as < CompareType > () = CompareType::IN; }
     break;
 
-  case 103: // relational: "<"
+  case 116: // relational: "<"
                                 { yylhs.value.as < CompareType > () = CompareType::LESS; }
     break;
 
-  case 104: // relational: "<="
+  case 117: // relational: "<="
                                 { yylhs.value.as < CompareType > () = CompareType::LESS_EQUAL; }
     break;
 
-  case 105: // relational: ">"
+  case 118: // relational: ">"
                                 { yylhs.value.as < CompareType > () = CompareType::GREATER; }
     break;
 
-  case 106: // relational: ">="
+  case 119: // relational: ">="
                                 { yylhs.value.as < CompareType > () = CompareType::GREATER_EQUAL; }
     break;
 
-  case 107: // stringop: "beginswith"
+  case 120: // stringop: "beginswith"
                                 { yylhs.value.as < CompareType > () = CompareType::BEGINSWITH; }
     break;
 
-  case 108: // stringop: "endswith"
+  case 121: // stringop: "endswith"
                                 { yylhs.value.as < CompareType > () = CompareType::ENDSWITH; }
     break;
 
-  case 109: // stringop: "contains"
+  case 122: // stringop: "contains"
                                 { yylhs.value.as < CompareType > () = CompareType::CONTAINS; }
     break;
 
-  case 110: // stringop: "like"
+  case 123: // stringop: "like"
                                 { yylhs.value.as < CompareType > () = CompareType::LIKE; }
     break;
 
-  case 111: // path: id
+  case 124: // path: id
                                 { yylhs.value.as < PathNode* > () = drv.m_parse_nodes.create<PathNode>(yystack_[0].value.as < std::string > ()); }
     break;
 
-  case 112: // path: "keypath"
+  case 125: // path: "keypath"
                                 { yylhs.value.as < PathNode* > () = drv.m_parse_nodes.create<PathNode>(yystack_[0].value.as < std::string > (), PathNode::ArgTag()); }
     break;
 
-  case 113: // path: path '.' id
+  case 126: // path: path '.' id
                                 { yystack_[2].value.as < PathNode* > ()->add_element(yystack_[0].value.as < std::string > ()); yylhs.value.as < PathNode* > () = yystack_[2].value.as < PathNode* > (); }
     break;
 
-  case 114: // path: path '[' "natural0" ']'
+  case 127: // path: path '[' "natural0" ']'
                                 { yystack_[3].value.as < PathNode* > ()->add_element(size_t(strtoll(yystack_[1].value.as < std::string > ().c_str(), nullptr, 0))); yylhs.value.as < PathNode* > () = yystack_[3].value.as < PathNode* > (); }
     break;
 
-  case 115: // path: path '[' "FIRST" ']'
+  case 128: // path: path '[' "FIRST" ']'
                                 { yystack_[3].value.as < PathNode* > ()->add_element(size_t(0)); yylhs.value.as < PathNode* > () = yystack_[3].value.as < PathNode* > (); }
     break;
 
-  case 116: // path: path '[' "LAST" ']'
+  case 129: // path: path '[' "LAST" ']'
                                 { yystack_[3].value.as < PathNode* > ()->add_element(size_t(-1)); yylhs.value.as < PathNode* > () = yystack_[3].value.as < PathNode* > (); }
     break;
 
-  case 117: // path: path '[' '*' ']'
+  case 130: // path: path '[' '*' ']'
                                 { yystack_[3].value.as < PathNode* > ()->add_element(PathElement::AllTag()); yylhs.value.as < PathNode* > () = yystack_[3].value.as < PathNode* > (); }
     break;
 
-  case 118: // path: path '[' "string" ']'
+  case 131: // path: path '[' "string" ']'
                                 { yystack_[3].value.as < PathNode* > ()->add_element(yystack_[1].value.as < std::string > ().substr(1, yystack_[1].value.as < std::string > ().size() - 2)); yylhs.value.as < PathNode* > () = yystack_[3].value.as < PathNode* > (); }
     break;
 
-  case 119: // path: path '[' "argument" ']'
+  case 132: // path: path '[' "argument" ']'
                                 { yystack_[3].value.as < PathNode* > ()->add_element(drv.get_arg_for_index(yystack_[1].value.as < std::string > ())); yylhs.value.as < PathNode* > () = yystack_[3].value.as < PathNode* > (); }
     break;
 
-  case 120: // id: "identifier"
+  case 133: // id: "identifier"
                                 { yylhs.value.as < std::string > () = yystack_[0].value.as < std::string > (); }
     break;
 
-  case 121: // id: "@links"
+  case 134: // id: "@links"
                                 { yylhs.value.as < std::string > () = std::string("@links"); }
     break;
 
-  case 122: // id: "beginswith"
+  case 135: // id: "beginswith"
                                 { yylhs.value.as < std::string > () = yystack_[0].value.as < std::string > (); }
     break;
 
-  case 123: // id: "endswith"
+  case 136: // id: "endswith"
                                 { yylhs.value.as < std::string > () = yystack_[0].value.as < std::string > (); }
     break;
 
-  case 124: // id: "contains"
+  case 137: // id: "contains"
                                 { yylhs.value.as < std::string > () = yystack_[0].value.as < std::string > (); }
     break;
 
-  case 125: // id: "like"
+  case 138: // id: "like"
                                 { yylhs.value.as < std::string > () = yystack_[0].value.as < std::string > (); }
     break;
 
-  case 126: // id: "between"
+  case 139: // id: "between"
                                 { yylhs.value.as < std::string > () = yystack_[0].value.as < std::string > (); }
     break;
 
-  case 127: // id: "key or value"
+  case 140: // id: "key or value"
                                 { yylhs.value.as < std::string > () = yystack_[0].value.as < std::string > (); }
     break;
 
-  case 128: // id: "sort"
+  case 141: // id: "sort"
                                 { yylhs.value.as < std::string > () = yystack_[0].value.as < std::string > (); }
     break;
 
-  case 129: // id: "distinct"
+  case 142: // id: "distinct"
                                 { yylhs.value.as < std::string > () = yystack_[0].value.as < std::string > (); }
     break;
 
-  case 130: // id: "limit"
+  case 143: // id: "limit"
                                 { yylhs.value.as < std::string > () = yystack_[0].value.as < std::string > (); }
     break;
 
-  case 131: // id: "ascending"
+  case 144: // id: "ascending"
                                 { yylhs.value.as < std::string > () = yystack_[0].value.as < std::string > (); }
     break;
 
-  case 132: // id: "descending"
+  case 145: // id: "descending"
                                 { yylhs.value.as < std::string > () = yystack_[0].value.as < std::string > (); }
     break;
 
-  case 133: // id: "in"
+  case 146: // id: "in"
                                 { yylhs.value.as < std::string > () = yystack_[0].value.as < std::string > (); }
     break;
 
-  case 134: // id: "fulltext"
+  case 147: // id: "fulltext"
                                 { yylhs.value.as < std::string > () = yystack_[0].value.as < std::string > (); }
     break;
 
-  case 135: // id: "binary"
+  case 148: // id: "binary"
                                 { yylhs.value.as < std::string > () = yystack_[0].value.as < std::string > (); }
     break;
 
-  case 136: // id: "FIRST"
+  case 149: // id: "FIRST"
                                 { yylhs.value.as < std::string > () = yystack_[0].value.as < std::string > (); }
     break;
 
-  case 137: // id: "LAST"
+  case 150: // id: "LAST"
                                 { yylhs.value.as < std::string > () = yystack_[0].value.as < std::string > (); }
     break;
 
-  case 138: // id: "SIZE"
+  case 151: // id: "SIZE"
                                 { yylhs.value.as < std::string > () = yystack_[0].value.as < std::string > (); }
     break;
 
@@ -2529,124 +2652,136 @@ namespace yy {
   }
 
 
-  const short parser::yypact_ninf_ = -160;
+  const short parser::yypact_ninf_ = -217;
 
   const signed char parser::yytable_ninf_ = -1;
 
   const short
   parser::yypact_[] =
   {
-     123,  -160,  -160,   -62,  -160,  -160,  -160,  -160,  -160,  -160,
-     123,  -160,  -160,  -160,  -160,  -160,  -160,  -160,  -160,  -160,
-    -160,  -160,  -160,  -160,  -160,  -160,  -160,  -160,  -160,  -160,
-    -160,  -160,  -160,   -38,  -160,  -160,  -160,    37,  -160,  -160,
-    -160,  -160,  -160,  -160,  -160,   123,   438,    87,    26,  -160,
-      17,   164,    45,  -160,  -160,  -160,  -160,  -160,  -160,   453,
-     -58,  -160,   546,  -160,    88,    29,    -5,    11,    37,   -66,
-    -160,    81,  -160,   123,   123,    79,  -160,  -160,  -160,  -160,
-    -160,  -160,  -160,   250,   250,   250,   250,   189,   250,  -160,
-    -160,  -160,   377,  -160,    22,   316,    73,  -160,  -160,   438,
-      -3,   501,    83,  -160,    52,    64,    47,   101,    75,   114,
-    -160,  -160,   438,  -160,  -160,   163,   121,   132,   170,  -160,
-    -160,  -160,   250,    34,  -160,  -160,    34,  -160,  -160,   250,
-     148,   148,  -160,  -160,   175,   377,  -160,   182,   190,   191,
-    -160,  -160,   -40,   523,  -160,  -160,  -160,  -160,  -160,  -160,
-    -160,  -160,   187,   188,   198,   200,   201,   202,   226,   568,
-     568,   568,   -25,   497,  -160,  -160,  -160,   546,   546,   230,
-     203,   148,  -160,   204,   236,   204,  -160,  -160,  -160,  -160,
-    -160,  -160,  -160,  -160,  -160,   240,   245,    65,    36,    76,
-      47,   246,    80,   252,   204,  -160,   119,   254,   123,  -160,
-    -160,   546,  -160,  -160,  -160,  -160,   546,  -160,  -160,  -160,
-    -160,   255,   204,  -160,   -29,  -160,   236,    80,    18,    36,
-      47,    80,   247,   204,  -160,  -160,   248,   257,  -160,   128,
-    -160,  -160,  -160,   268,   299,  -160,  -160,   261,  -160
+     183,  -217,  -217,    -7,  -217,  -217,  -217,  -217,  -217,  -217,
+     183,  -217,  -217,  -217,  -217,  -217,  -217,  -217,  -217,  -217,
+    -217,  -217,  -217,  -217,  -217,  -217,  -217,  -217,  -217,  -217,
+    -217,  -217,  -217,     1,  -217,  -217,  -217,    14,  -217,  -217,
+    -217,  -217,  -217,  -217,  -217,   183,   498,    94,   150,  -217,
+      19,   148,    51,  -217,  -217,  -217,  -217,  -217,  -217,    75,
+     -26,  -217,   660,  -217,    97,    83,    11,    30,    14,   -59,
+    -217,    39,  -217,   183,   183,    54,  -217,  -217,  -217,  -217,
+    -217,  -217,  -217,   310,   310,   310,   310,   249,   310,  -217,
+    -217,  -217,   437,  -217,     3,   376,    84,  -217,  -217,   498,
+     -12,   522,   111,  -217,    70,    76,    17,    82,    89,    92,
+    -217,  -217,   498,  -217,  -217,   146,   151,   107,   115,   136,
+    -217,   205,  -217,  -217,  -217,   310,   142,  -217,  -217,   142,
+    -217,  -217,   310,    99,    99,  -217,  -217,   169,   437,  -217,
+     176,   180,   182,  -217,  -217,   -51,   591,  -217,  -217,  -217,
+    -217,  -217,  -217,  -217,  -217,   185,   186,   187,   188,   197,
+     199,   200,   682,   682,   682,   116,   518,  -217,  -217,  -217,
+     206,   660,   660,   224,   -21,  -217,   202,    99,  -217,   203,
+     235,   203,  -217,  -217,  -217,  -217,  -217,  -217,  -217,  -217,
+    -217,   227,   241,   660,    32,    90,    81,    17,   250,  -217,
+     614,   -25,   247,   203,  -217,    86,   251,   183,  -217,   110,
+      17,  -217,   660,  -217,  -217,  -217,  -217,   660,  -217,  -217,
+     131,   177,  -217,  -217,  -217,   256,   203,  -217,   -50,  -217,
+     235,   -25,    35,  -217,   660,    90,    17,  -217,   637,   569,
+    -217,   -25,   252,   203,  -217,  -217,   259,   260,    17,  -217,
+    -217,   177,   130,  -217,  -217,  -217,   269,  -217,   286,  -217,
+    -217,   258,  -217
   };
 
   const unsigned char
   parser::yydefact_[] =
   {
-       0,    87,    88,     0,    74,    75,    76,    89,    90,    91,
-       0,   120,    83,    69,    67,    68,    81,    82,    70,    71,
-      84,    85,    72,    73,    86,   112,   122,   123,   124,   134,
-     125,   126,   133,     0,   128,   129,   130,   135,   131,   132,
-     136,   137,   138,   127,   121,     0,    64,     0,    48,     3,
-       0,    18,    25,    27,    28,    26,    24,    66,     8,     0,
-      92,   111,     0,     6,     0,     0,     0,     0,     0,     0,
-      63,     0,     1,     0,     0,     2,   100,   101,   103,   105,
-     106,   104,   102,     0,     0,     0,     0,     0,     0,   107,
-     108,   109,     0,   110,     0,     0,     0,    77,   135,    64,
-      92,     0,     0,    29,    32,     0,    33,     0,     0,     0,
-       7,    19,     0,    61,     5,     4,     0,     0,     0,    50,
-      49,    51,     0,    22,    18,    25,    23,    20,    21,     0,
-       9,    11,    13,    15,     0,     0,    12,     0,     0,     0,
-      17,    16,     0,     0,    30,    96,    97,    98,    99,    93,
-      95,   113,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,    79,    80,    65,     0,     0,     0,
-       0,    10,    14,     0,     0,     0,    62,   118,   114,   119,
-     115,   116,    94,   117,    31,     0,     0,     0,     0,     0,
-      53,     0,     0,     0,     0,    43,     0,     0,     0,    78,
-      55,     0,    59,    60,    56,    52,     0,    58,    36,    35,
-      37,     0,     0,    40,     0,    47,     0,     0,     0,     0,
-      54,     0,     0,     0,    42,    44,     0,     0,    57,     0,
-      45,    41,    46,     0,     0,    38,    34,     0,    39
+       0,   100,   101,     0,    87,    88,    89,   102,   103,   104,
+       0,   133,    96,    82,    80,    81,    94,    95,    83,    84,
+      97,    98,    85,    86,    99,   125,   135,   136,   137,   147,
+     138,   139,   146,     0,   141,   142,   143,   148,   144,   145,
+     149,   150,   151,   140,   134,     0,    77,     0,    51,     6,
+       0,    21,    28,    30,    31,    29,    27,    79,    11,     0,
+     105,   124,     0,     9,     0,     0,     0,     0,     0,     0,
+      76,     0,     1,     0,     0,     2,   113,   114,   116,   118,
+     119,   117,   115,     0,     0,     0,     0,     0,     0,   120,
+     121,   122,     0,   123,     0,     0,     0,    90,   148,    77,
+     105,     0,     0,    32,    35,     0,    36,     0,     0,     0,
+      10,    22,     0,    74,     8,     7,    66,     0,     0,     0,
+      53,     3,     4,    52,    54,     0,    25,    21,    28,    26,
+      23,    24,     0,    12,    14,    16,    18,     0,     0,    15,
+       0,     0,     0,    20,    19,     0,     0,    33,   109,   110,
+     111,   112,   106,   108,   126,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,    92,    93,    78,
+      67,     0,     0,     0,    66,     5,     0,    13,    17,     0,
+       0,     0,    75,   131,   127,   132,   128,   129,   107,   130,
+      34,     0,     0,     0,     0,     0,     0,    56,     0,    67,
+       0,     0,     0,     0,    46,     0,     0,     0,    91,     0,
+      60,    68,     0,    72,    73,    69,    55,     0,    71,    62,
+       0,     0,    39,    38,    40,     0,     0,    43,     0,    50,
+       0,     0,     0,    58,     0,     0,    57,    59,     0,     0,
+      63,     0,     0,     0,    45,    47,     0,     0,    61,    70,
+      64,     0,     0,    48,    44,    49,     0,    65,     0,    41,
+      37,     0,    42
   };
 
   const short
   parser::yypgoto_[] =
   {
-    -160,  -160,    -9,  -160,   -32,     0,     2,  -160,  -160,  -160,
-    -159,  -103,  -160,   122,  -160,  -160,  -160,  -160,  -160,  -160,
-    -160,  -160,   118,   249,   241,   -42,   176,  -160,   -31,   242,
-    -160,  -160,  -160,  -160,   -56,   -55
+    -217,  -217,    -9,  -217,   -32,     0,     2,  -217,  -217,  -217,
+    -216,  -165,  -217,   104,  -217,  -217,  -217,  -217,  -217,  -217,
+    -217,  -217,   214,  -217,  -217,  -217,   101,   243,   239,   -42,
+     195,  -217,   -22,   272,  -214,  -217,  -217,  -217,   -56,   -96
   };
 
   const unsigned char
   parser::yydefgoto_[] =
   {
-       0,    47,    48,    49,    50,   124,   125,    53,   105,    54,
-     211,   193,   214,   195,   196,   141,    75,   119,   189,   120,
-     187,   121,   204,    55,    69,    56,    57,    58,    59,   103,
-     104,    87,    88,    95,    60,    61
+       0,    47,    48,    49,    50,   127,   128,    53,   105,    54,
+     225,   202,   228,   204,   205,   144,    75,   120,   196,   121,
+     209,   220,   122,   123,   194,   124,   215,    55,    69,    56,
+      57,    58,    59,   103,   104,    87,    88,    95,    60,    61
   };
 
-  const unsigned char
+  const short
   parser::yytable_[] =
   {
-      51,    63,    52,   100,    70,   152,   106,   112,    62,   153,
-      51,   113,    52,    67,   101,    71,   102,   154,    73,    74,
-      76,    77,    78,    79,    80,    81,    76,    77,    78,    79,
-      80,    81,    64,   112,   155,   156,    66,   176,     7,     8,
-       9,    73,    74,   158,   223,    51,   151,    52,   224,    73,
-      74,   123,   126,   127,   128,   130,   131,    70,   226,   108,
-     109,    82,   229,   134,   114,   115,   110,    82,    71,   143,
-     166,   102,   197,    51,    51,    52,    52,    83,    84,    85,
-      86,    71,   111,    83,    84,    85,    86,    72,   151,   227,
-     170,   213,   132,   202,   203,   136,    96,   171,    46,   137,
-     138,   139,    85,    86,   184,   185,   151,    65,   161,   222,
-     162,   188,   190,   152,   208,   140,   209,   153,   107,   161,
-     231,   162,   210,    97,   159,   154,     1,     2,     3,     4,
-       5,     6,   116,   117,   118,   172,   200,   160,   201,     7,
-       8,     9,   155,   156,   157,   219,   164,   205,    10,   206,
-     220,   158,    11,    12,    13,    14,    15,    16,    17,    18,
+      51,    63,    52,   100,    70,   154,   106,   240,   199,   222,
+      51,   223,    52,    67,   112,   246,   206,   224,   113,     7,
+       8,     9,   112,   243,    71,   252,   182,   244,    76,    77,
+      78,    79,    80,    81,    73,    74,    66,   257,   227,    76,
+      77,    78,    79,    80,    81,    51,   101,    52,   102,   200,
+     154,   126,   129,   130,   131,   133,   134,    70,    73,    74,
+     146,   242,   102,    62,   114,   115,   190,   191,   154,    82,
+     169,    64,   137,    51,    51,    52,    52,    71,   254,    46,
+      82,    97,   110,   116,    65,    83,    84,    85,    86,   164,
+      71,   165,   135,   176,    72,   139,    83,    84,    85,    86,
+     177,   111,    96,   211,    11,   212,   247,   117,   118,   119,
+     140,   141,   142,   108,   109,   195,   197,    97,    25,    26,
+      27,    28,    29,    30,    31,    32,   143,   107,    34,    35,
+      36,    98,    38,    39,    40,    41,    42,   210,   178,    43,
+      44,   155,   162,   154,   221,   156,   155,   213,   214,   163,
+     156,    99,   216,   157,   217,   166,   235,   229,   157,   230,
+     167,   236,   164,   168,   165,    83,    84,    85,    86,    73,
+     158,   159,   160,    73,    74,   158,   159,   171,   248,   161,
+     170,   233,   251,   234,   161,   172,     1,     2,     3,     4,
+       5,     6,    89,    90,    91,    92,    93,    94,   232,     7,
+       8,     9,   237,   258,   238,   259,   173,    51,    10,    52,
+      85,    86,    11,    12,    13,    14,    15,    16,    17,    18,
       19,    20,    21,    22,    23,    24,    25,    26,    27,    28,
-      29,    30,    31,    32,   163,    33,    34,    35,    36,    37,
-      38,    39,    40,    41,    42,   165,    73,    43,    44,   218,
-     215,   167,   216,    45,     3,     4,     5,     6,    51,    46,
-      52,   234,   168,   235,   129,     7,     8,     9,    89,    90,
-      91,    92,    93,    94,    83,    84,    85,    86,    11,    12,
+      29,    30,    31,    32,   174,    33,    34,    35,    36,    37,
+      38,    39,    40,    41,    42,    99,   179,    43,    44,   239,
+     180,   165,   181,    45,     3,     4,     5,     6,   198,    46,
+     183,   184,   185,   186,   132,     7,     8,     9,    83,    84,
+      85,    86,   187,   111,   188,   189,   193,   201,    11,    12,
       13,    14,    15,    16,    17,    18,    19,    20,    21,    22,
       23,    24,    25,    26,    27,    28,    29,    30,    31,    32,
-     169,    33,    34,    35,    36,    37,    38,    39,    40,    41,
-      42,    99,   173,    43,    44,     3,     4,     5,     6,   122,
-     174,   175,   177,   178,   191,    46,     7,     8,     9,    83,
-      84,    85,    86,   179,   111,   180,   181,   182,   192,    11,
+     207,    33,    34,    35,    36,    37,    38,    39,    40,    41,
+      42,   203,   208,    43,    44,     3,     4,     5,     6,   125,
+     226,   218,   261,   253,   231,    46,     7,     8,     9,   241,
+     255,   260,   256,   262,   245,   175,   249,   136,   145,    11,
       12,    13,    14,    15,    16,    17,    18,    19,    20,    21,
       22,    23,    24,    25,    26,    27,    28,    29,    30,    31,
-      32,   183,    33,    34,    35,    36,    37,    38,    39,    40,
-      41,    42,   194,   198,    43,    44,   199,   207,   230,   232,
-     122,     3,     4,     5,     6,   212,    46,   217,   221,   233,
-     236,   135,     7,     8,     9,   237,   238,   228,   225,   186,
-     142,     0,   144,   133,     0,    11,    12,    13,    14,    15,
+      32,   192,    33,    34,    35,    36,    37,    38,    39,    40,
+      41,    42,   147,     0,    43,    44,     0,     0,     0,     0,
+     125,     3,     4,     5,     6,     0,    46,     0,     0,     0,
+       0,   138,     7,     8,     9,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,    11,    12,    13,    14,    15,
       16,    17,    18,    19,    20,    21,    22,    23,    24,    25,
       26,    27,    28,    29,    30,    31,    32,     0,    33,    34,
       35,    36,    37,    38,    39,    40,    41,    42,     0,     0,
@@ -2660,62 +2795,73 @@ namespace yy {
        0,     0,     0,    46,     7,     8,     9,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,    12,    13,
       14,    15,    16,    17,    18,    19,    20,    21,    22,    23,
-      24,     0,    11,     0,     0,     0,     0,     0,     0,     0,
-      33,     0,     0,     0,    68,    97,    25,    26,    27,    28,
-      29,    30,    31,    32,     0,     0,    34,    35,    36,    98,
-      38,    39,    40,    41,    42,     0,     0,    43,    44,     0,
-     145,   146,   147,   148,     0,     0,     0,    12,     0,    99,
-      11,    16,    17,     0,     0,    20,    21,     0,     0,    24,
-       0,     0,     0,     0,     0,    26,    27,    28,    29,    30,
-      31,    32,    11,     0,    34,    35,    36,    98,    38,    39,
-      40,    41,    42,   149,   150,    43,    44,    26,    27,    28,
-      29,    30,    31,    32,     0,    11,    34,    35,    36,    98,
-      38,    39,    40,    41,    42,   149,   150,    43,    44,    25,
-      26,    27,    28,    29,    30,    31,    32,    11,     0,    34,
-      35,    36,    98,    38,    39,    40,    41,    42,     0,     0,
-      43,    44,    26,    27,    28,    29,    30,    31,    32,     0,
-       0,    34,    35,    36,    98,    38,    39,    40,    41,    42,
-       0,     0,    43,    44
+      24,   148,   149,   150,   151,     0,     0,     0,    12,     0,
+      33,    11,    16,    17,    68,     0,    20,    21,     0,     0,
+      24,     0,     0,     0,     0,     0,    26,    27,    28,    29,
+      30,    31,    32,     0,     0,    34,    35,    36,    98,    38,
+      39,    40,    41,    42,   152,   153,    43,    44,   148,   149,
+     150,   151,     0,     0,     0,     0,     0,     0,    11,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,    26,    27,    28,    29,    30,    31,    32,
+      11,     0,    34,    35,    36,    98,    38,    39,    40,    41,
+      42,     0,     0,    43,    44,    26,    27,    28,    29,    30,
+      31,    32,     0,    11,    34,    35,    36,    98,    38,    39,
+      40,    41,    42,   152,   153,    43,    44,    25,    26,    27,
+      28,    29,    30,    31,    32,     0,    11,    34,    35,    36,
+      98,    38,    39,    40,    41,    42,   219,     0,    43,    44,
+      25,    26,    27,    28,    29,    30,    31,    32,     0,    11,
+      34,    35,    36,    98,    38,    39,    40,    41,    42,   250,
+       0,    43,    44,    25,    26,    27,    28,    29,    30,    31,
+      32,    11,     0,    34,    35,    36,    98,    38,    39,    40,
+      41,    42,     0,     0,    43,    44,    26,    27,    28,    29,
+      30,    31,    32,     0,     0,    34,    35,    36,    98,    38,
+      39,    40,    41,    42,     0,     0,    43,    44
   };
 
   const short
   parser::yycheck_[] =
   {
-       0,    10,     0,    59,    46,    30,    62,    73,    70,    34,
-      10,    77,    10,    45,    72,    46,    74,    42,    23,    24,
-       9,    10,    11,    12,    13,    14,     9,    10,    11,    12,
-      13,    14,    70,    73,    59,    60,    45,    77,    16,    17,
-      18,    23,    24,    68,    73,    45,   101,    45,    77,    23,
-      24,    83,    84,    85,    86,    87,    88,    99,   217,    30,
-      31,    50,   221,    94,    73,    74,    71,    50,    99,    72,
-     112,    74,   175,    73,    74,    73,    74,    66,    67,    68,
-      69,   112,    71,    66,    67,    68,    69,     0,   143,    71,
-     122,   194,    92,    57,    58,    95,    51,   129,    76,    26,
-      27,    28,    68,    69,   159,   160,   161,    70,    72,   212,
-      74,   167,   168,    30,    34,    42,    36,    34,    30,    72,
-     223,    74,    42,    42,    72,    42,     3,     4,     5,     6,
-       7,     8,    53,    54,    55,   135,    71,    73,    73,    16,
-      17,    18,    59,    60,    61,   201,    71,    71,    25,    73,
-     206,    68,    29,    30,    31,    32,    33,    34,    35,    36,
+       0,    10,     0,    59,    46,   101,    62,   221,    29,    34,
+      10,    36,    10,    45,    73,   231,   181,    42,    77,    16,
+      17,    18,    73,    73,    46,   241,    77,    77,     9,    10,
+      11,    12,    13,    14,    23,    24,    45,   251,   203,     9,
+      10,    11,    12,    13,    14,    45,    72,    45,    74,    70,
+     146,    83,    84,    85,    86,    87,    88,    99,    23,    24,
+      72,   226,    74,    70,    73,    74,   162,   163,   164,    50,
+     112,    70,    94,    73,    74,    73,    74,    99,   243,    76,
+      50,    42,    71,    29,    70,    66,    67,    68,    69,    72,
+     112,    74,    92,   125,     0,    95,    66,    67,    68,    69,
+     132,    71,    51,    71,    29,    73,    71,    53,    54,    55,
+      26,    27,    28,    30,    31,   171,   172,    42,    43,    44,
+      45,    46,    47,    48,    49,    50,    42,    30,    53,    54,
+      55,    56,    57,    58,    59,    60,    61,   193,   138,    64,
+      65,    30,    72,   239,   200,    34,    30,    57,    58,    73,
+      34,    76,    71,    42,    73,    73,   212,    71,    42,    73,
+      71,   217,    72,    71,    74,    66,    67,    68,    69,    23,
+      59,    60,    61,    23,    24,    59,    60,    70,   234,    68,
+      29,    71,   238,    73,    68,    70,     3,     4,     5,     6,
+       7,     8,    44,    45,    46,    47,    48,    49,   207,    16,
+      17,    18,    71,    73,    73,    75,    70,   207,    25,   207,
+      68,    69,    29,    30,    31,    32,    33,    34,    35,    36,
       37,    38,    39,    40,    41,    42,    43,    44,    45,    46,
-      47,    48,    49,    50,    73,    52,    53,    54,    55,    56,
-      57,    58,    59,    60,    61,    71,    23,    64,    65,   198,
-      71,    70,    73,    70,     5,     6,     7,     8,   198,    76,
-     198,    73,    70,    75,    15,    16,    17,    18,    44,    45,
-      46,    47,    48,    49,    66,    67,    68,    69,    29,    30,
+      47,    48,    49,    50,    29,    52,    53,    54,    55,    56,
+      57,    58,    59,    60,    61,    76,    70,    64,    65,    72,
+      70,    74,    70,    70,     5,     6,     7,     8,    34,    76,
+      75,    75,    75,    75,    15,    16,    17,    18,    66,    67,
+      68,    69,    75,    71,    75,    75,    70,    74,    29,    30,
       31,    32,    33,    34,    35,    36,    37,    38,    39,    40,
       41,    42,    43,    44,    45,    46,    47,    48,    49,    50,
-      70,    52,    53,    54,    55,    56,    57,    58,    59,    60,
-      61,    76,    70,    64,    65,     5,     6,     7,     8,    70,
-      70,    70,    75,    75,    34,    76,    16,    17,    18,    66,
-      67,    68,    69,    75,    71,    75,    75,    75,    74,    29,
+      73,    52,    53,    54,    55,    56,    57,    58,    59,    60,
+      61,    76,    71,    64,    65,     5,     6,     7,     8,    70,
+      73,    71,    36,    71,    73,    76,    16,    17,    18,    73,
+      71,    62,    72,    75,   230,   121,   235,    94,    99,    29,
       30,    31,    32,    33,    34,    35,    36,    37,    38,    39,
       40,    41,    42,    43,    44,    45,    46,    47,    48,    49,
-      50,    75,    52,    53,    54,    55,    56,    57,    58,    59,
-      60,    61,    76,    73,    64,    65,    71,    71,    71,    71,
-      70,     5,     6,     7,     8,    73,    76,    73,    73,    72,
-      62,    15,    16,    17,    18,    36,    75,   219,   216,   163,
-      99,    -1,   100,    94,    -1,    29,    30,    31,    32,    33,
+      50,   166,    52,    53,    54,    55,    56,    57,    58,    59,
+      60,    61,   100,    -1,    64,    65,    -1,    -1,    -1,    -1,
+      70,     5,     6,     7,     8,    -1,    76,    -1,    -1,    -1,
+      -1,    15,    16,    17,    18,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    29,    30,    31,    32,    33,
       34,    35,    36,    37,    38,    39,    40,    41,    42,    43,
       44,    45,    46,    47,    48,    49,    50,    -1,    52,    53,
       54,    55,    56,    57,    58,    59,    60,    61,    -1,    -1,
@@ -2729,22 +2875,27 @@ namespace yy {
       -1,    -1,    -1,    76,    16,    17,    18,    -1,    -1,    -1,
       -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    30,    31,
       32,    33,    34,    35,    36,    37,    38,    39,    40,    41,
-      42,    -1,    29,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      52,    -1,    -1,    -1,    56,    42,    43,    44,    45,    46,
-      47,    48,    49,    50,    -1,    -1,    53,    54,    55,    56,
-      57,    58,    59,    60,    61,    -1,    -1,    64,    65,    -1,
-      19,    20,    21,    22,    -1,    -1,    -1,    30,    -1,    76,
-      29,    34,    35,    -1,    -1,    38,    39,    -1,    -1,    42,
-      -1,    -1,    -1,    -1,    -1,    44,    45,    46,    47,    48,
-      49,    50,    29,    -1,    53,    54,    55,    56,    57,    58,
-      59,    60,    61,    62,    63,    64,    65,    44,    45,    46,
-      47,    48,    49,    50,    -1,    29,    53,    54,    55,    56,
-      57,    58,    59,    60,    61,    62,    63,    64,    65,    43,
-      44,    45,    46,    47,    48,    49,    50,    29,    -1,    53,
-      54,    55,    56,    57,    58,    59,    60,    61,    -1,    -1,
-      64,    65,    44,    45,    46,    47,    48,    49,    50,    -1,
-      -1,    53,    54,    55,    56,    57,    58,    59,    60,    61,
-      -1,    -1,    64,    65
+      42,    19,    20,    21,    22,    -1,    -1,    -1,    30,    -1,
+      52,    29,    34,    35,    56,    -1,    38,    39,    -1,    -1,
+      42,    -1,    -1,    -1,    -1,    -1,    44,    45,    46,    47,
+      48,    49,    50,    -1,    -1,    53,    54,    55,    56,    57,
+      58,    59,    60,    61,    62,    63,    64,    65,    19,    20,
+      21,    22,    -1,    -1,    -1,    -1,    -1,    -1,    29,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    44,    45,    46,    47,    48,    49,    50,
+      29,    -1,    53,    54,    55,    56,    57,    58,    59,    60,
+      61,    -1,    -1,    64,    65,    44,    45,    46,    47,    48,
+      49,    50,    -1,    29,    53,    54,    55,    56,    57,    58,
+      59,    60,    61,    62,    63,    64,    65,    43,    44,    45,
+      46,    47,    48,    49,    50,    -1,    29,    53,    54,    55,
+      56,    57,    58,    59,    60,    61,    62,    -1,    64,    65,
+      43,    44,    45,    46,    47,    48,    49,    50,    -1,    29,
+      53,    54,    55,    56,    57,    58,    59,    60,    61,    62,
+      -1,    64,    65,    43,    44,    45,    46,    47,    48,    49,
+      50,    29,    -1,    53,    54,    55,    56,    57,    58,    59,
+      60,    61,    -1,    -1,    64,    65,    44,    45,    46,    47,
+      48,    49,    50,    -1,    -1,    53,    54,    55,    56,    57,
+      58,    59,    60,    61,    -1,    -1,    64,    65
   };
 
   const signed char
@@ -2755,63 +2906,70 @@ namespace yy {
       38,    39,    40,    41,    42,    43,    44,    45,    46,    47,
       48,    49,    50,    52,    53,    54,    55,    56,    57,    58,
       59,    60,    61,    64,    65,    70,    76,    79,    80,    81,
-      82,    83,    84,    85,    87,   101,   103,   104,   105,   106,
-     112,   113,    70,    80,    70,    70,    80,    82,    56,   102,
-     103,   106,     0,    23,    24,    94,     9,    10,    11,    12,
-      13,    14,    50,    66,    67,    68,    69,   109,   110,    44,
-      45,    46,    47,    48,    49,   111,    51,    42,    56,    76,
-     112,    72,    74,   107,   108,    86,   112,    30,    30,    31,
-      71,    71,    73,    77,    80,    80,    53,    54,    55,    95,
-      97,    99,    70,    82,    83,    84,    82,    82,    82,    15,
-      82,    82,    83,   101,   106,    15,    83,    26,    27,    28,
-      42,    93,   102,    72,   107,    19,    20,    21,    22,    62,
-      63,   113,    30,    34,    42,    59,    60,    61,    68,    72,
-      73,    72,    74,    73,    71,    71,   103,    70,    70,    70,
-      82,    82,    83,    70,    70,    70,    77,    75,    75,    75,
-      75,    75,    75,    75,   113,   113,   104,    98,   112,    96,
-     112,    34,    74,    89,    76,    91,    92,    89,    73,    71,
-      71,    73,    57,    58,   100,    71,    73,    71,    34,    36,
-      42,    88,    73,    89,    90,    71,    73,    73,    80,   112,
-     112,    73,    89,    73,    77,    91,    88,    71,   100,    88,
-      71,    89,    71,    72,    73,    75,    62,    36,    75
+      82,    83,    84,    85,    87,   105,   107,   108,   109,   110,
+     116,   117,    70,    80,    70,    70,    80,    82,    56,   106,
+     107,   110,     0,    23,    24,    94,     9,    10,    11,    12,
+      13,    14,    50,    66,    67,    68,    69,   113,   114,    44,
+      45,    46,    47,    48,    49,   115,    51,    42,    56,    76,
+     116,    72,    74,   111,   112,    86,   116,    30,    30,    31,
+      71,    71,    73,    77,    80,    80,    29,    53,    54,    55,
+      95,    97,   100,   101,   103,    70,    82,    83,    84,    82,
+      82,    82,    15,    82,    82,    83,   105,   110,    15,    83,
+      26,    27,    28,    42,    93,   106,    72,   111,    19,    20,
+      21,    22,    62,    63,   117,    30,    34,    42,    59,    60,
+      61,    68,    72,    73,    72,    74,    73,    71,    71,   107,
+      29,    70,    70,    70,    29,   100,    82,    82,    83,    70,
+      70,    70,    77,    75,    75,    75,    75,    75,    75,    75,
+     117,   117,   108,    70,   102,   116,    96,   116,    34,    29,
+      70,    74,    89,    76,    91,    92,    89,    73,    71,    98,
+     116,    71,    73,    57,    58,   104,    71,    73,    71,    62,
+      99,   116,    34,    36,    42,    88,    73,    89,    90,    71,
+      73,    73,    80,    71,    73,   116,   116,    71,    73,    72,
+     112,    73,    89,    73,    77,    91,    88,    71,   116,   104,
+      62,   116,    88,    71,    89,    71,    72,   112,    73,    75,
+      62,    36,    75
   };
 
   const signed char
   parser::yyr1_[] =
   {
-       0,    78,    79,    80,    80,    80,    80,    80,    80,    81,
-      81,    81,    81,    81,    81,    81,    81,    81,    82,    82,
-      82,    82,    82,    82,    83,    83,    83,    83,    83,    84,
-      84,    85,    85,    86,    87,    88,    88,    88,    89,    89,
-      90,    90,    91,    92,    92,    93,    93,    93,    94,    94,
-      94,    94,    95,    96,    96,    97,    98,    98,    99,   100,
-     100,   101,   101,   102,   102,   102,   103,   103,   103,   103,
-     103,   103,   103,   103,   103,   103,   103,   103,   103,   103,
-     103,   104,   104,   104,   104,   104,   104,   105,   105,   106,
-     106,   106,   107,   107,   107,   107,   108,   108,   108,   108,
-     109,   109,   109,   110,   110,   110,   110,   111,   111,   111,
-     111,   112,   112,   112,   112,   112,   112,   112,   112,   112,
-     113,   113,   113,   113,   113,   113,   113,   113,   113,   113,
-     113,   113,   113,   113,   113,   113,   113,   113,   113
+       0,    78,    79,    79,    79,    79,    80,    80,    80,    80,
+      80,    80,    81,    81,    81,    81,    81,    81,    81,    81,
+      81,    82,    82,    82,    82,    82,    82,    83,    83,    83,
+      83,    83,    84,    84,    85,    85,    86,    87,    88,    88,
+      88,    89,    89,    90,    90,    91,    92,    92,    93,    93,
+      93,    94,    94,    94,    94,    95,    96,    96,    97,    97,
+      98,    98,    99,    99,    99,    99,   100,   100,   101,   102,
+     102,   103,   104,   104,   105,   105,   106,   106,   106,   107,
+     107,   107,   107,   107,   107,   107,   107,   107,   107,   107,
+     107,   107,   107,   107,   108,   108,   108,   108,   108,   108,
+     109,   109,   110,   110,   110,   111,   111,   111,   111,   112,
+     112,   112,   112,   113,   113,   113,   114,   114,   114,   114,
+     115,   115,   115,   115,   116,   116,   116,   116,   116,   116,
+     116,   116,   116,   117,   117,   117,   117,   117,   117,   117,
+     117,   117,   117,   117,   117,   117,   117,   117,   117,   117,
+     117,   117
   };
 
   const signed char
   parser::yyr2_[] =
   {
-       0,     2,     2,     1,     3,     3,     2,     3,     1,     3,
-       4,     3,     3,     3,     4,     3,     3,     3,     1,     3,
-       3,     3,     3,     3,     1,     1,     1,     1,     1,     2,
-       3,     4,     2,     1,    10,     1,     1,     1,     5,     7,
-       1,     3,     3,     1,     3,     6,     6,     4,     0,     2,
-       2,     2,     4,     1,     3,     4,     2,     4,     4,     1,
-       1,     3,     4,     1,     0,     3,     1,     1,     1,     1,
-       1,     1,     1,     1,     1,     1,     1,     2,     6,     4,
-       4,     1,     1,     1,     1,     1,     1,     1,     1,     1,
-       1,     1,     0,     2,     3,     2,     2,     2,     2,     2,
+       0,     2,     2,     3,     3,     4,     1,     3,     3,     2,
+       3,     1,     3,     4,     3,     3,     3,     4,     3,     3,
+       3,     1,     3,     3,     3,     3,     3,     1,     1,     1,
+       1,     1,     2,     3,     4,     2,     1,    10,     1,     1,
+       1,     5,     7,     1,     3,     3,     1,     3,     6,     6,
+       4,     0,     2,     2,     2,     4,     1,     3,     5,     5,
+       1,     3,     1,     2,     3,     4,     1,     2,     4,     2,
+       4,     4,     1,     1,     3,     4,     1,     0,     3,     1,
        1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
-       1,     1,     1,     3,     4,     4,     4,     4,     4,     4,
+       2,     6,     4,     4,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     0,     2,     3,     2,     2,
+       2,     2,     2,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     3,     4,     4,     4,
+       4,     4,     4,     1,     1,     1,     1,     1,     1,     1,
        1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
-       1,     1,     1,     1,     1,     1,     1,     1,     1
+       1,     1
   };
 
 
@@ -2839,7 +2997,8 @@ namespace yy {
   "final", "query", "compare", "expr", "value", "prop", "aggregate",
   "simple_prop", "subquery", "coordinate", "geopoint", "geoloop_content",
   "geoloop", "geopoly_content", "geospatial", "post_query", "distinct",
-  "distinct_param", "sort", "sort_param", "limit", "direction", "list",
+  "distinct_param", "group_by", "group_by_param", "group_by_aggregates",
+  "explain", "sort", "sort_param", "limit", "direction", "list",
   "list_content", "constant", "primary_key", "boolexpr", "comp_type",
   "post_op", "aggr_op", "equality", "relational", "stringop", "path", "id", YY_NULLPTR
   };
@@ -2850,20 +3009,22 @@ namespace yy {
   const short
   parser::yyrline_[] =
   {
-       0,   183,   183,   186,   187,   188,   189,   190,   191,   194,
-     195,   200,   201,   202,   203,   208,   209,   210,   213,   214,
-     215,   216,   217,   218,   221,   222,   223,   224,   225,   228,
-     229,   232,   236,   242,   245,   248,   249,   250,   253,   254,
-     257,   258,   260,   263,   264,   267,   268,   269,   272,   273,
-     274,   275,   277,   280,   281,   283,   286,   287,   289,   292,
-     293,   295,   296,   299,   300,   301,   304,   305,   306,   307,
-     308,   309,   310,   311,   312,   313,   314,   315,   316,   322,
-     323,   326,   327,   328,   329,   330,   331,   334,   335,   338,
-     339,   340,   343,   344,   345,   346,   349,   350,   351,   352,
-     355,   356,   357,   360,   361,   362,   363,   366,   367,   368,
-     369,   372,   373,   374,   375,   376,   377,   378,   379,   380,
-     383,   384,   385,   386,   387,   388,   389,   390,   391,   392,
-     393,   394,   395,   396,   397,   398,   399,   400,   401
+       0,   185,   185,   186,   187,   188,   196,   197,   198,   199,
+     200,   201,   204,   205,   210,   211,   212,   213,   218,   219,
+     220,   223,   224,   225,   226,   227,   228,   231,   232,   233,
+     234,   235,   238,   239,   242,   246,   252,   255,   258,   259,
+     260,   263,   264,   267,   268,   270,   273,   274,   277,   278,
+     279,   282,   283,   284,   285,   287,   290,   291,   295,   300,
+     307,   308,   311,   312,   313,   314,   318,   322,   328,   331,
+     332,   334,   337,   338,   340,   341,   344,   345,   346,   349,
+     350,   351,   352,   353,   354,   355,   356,   357,   358,   359,
+     360,   361,   367,   368,   371,   372,   373,   374,   375,   376,
+     379,   380,   383,   384,   385,   388,   389,   390,   391,   394,
+     395,   396,   397,   400,   401,   402,   405,   406,   407,   408,
+     411,   412,   413,   414,   417,   418,   419,   420,   421,   422,
+     423,   424,   425,   428,   429,   430,   431,   432,   433,   434,
+     435,   436,   437,   438,   439,   440,   441,   442,   443,   444,
+     445,   446
   };
 
   void
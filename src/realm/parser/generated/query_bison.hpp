@@ -70,6 +70,7 @@
     class PathNode;
     class DescriptorOrderingNode;
     class DescriptorNode;
+    class GroupByNode;
     class PropertyNode;
     class SubqueryNode;
 
@@ -466,45 +467,51 @@ namespace yy {
       // geospatial
       char dummy7[sizeof (GeospatialNode*)];
 
+      // group_by
+      // group_by_param
+      // group_by_aggregates
+      char dummy8[sizeof (GroupByNode*)];
+
       // list
       // list_content
-      char dummy8[sizeof (ListNode*)];
+      char dummy9[sizeof (ListNode*)];
 
       // path
-      char dummy9[sizeof (PathNode*)];
+      char dummy10[sizeof (PathNode*)];
 
       // post_op
-      char dummy10[sizeof (PostOpNode*)];
+      char dummy11[sizeof (PostOpNode*)];
 
       // prop
       // simple_prop
-      char dummy11[sizeof (PropertyNode*)];
+      char dummy12[sizeof (PropertyNode*)];
 
       // query
       // compare
-      char dummy12[sizeof (QueryNode*)];
+      char dummy13[sizeof (QueryNode*)];
 
       // subquery
-      char dummy13[sizeof (SubqueryNode*)];
+      char dummy14[sizeof (SubqueryNode*)];
 
       // boolexpr
-      char dummy14[sizeof (TrueOrFalseNode*)];
+      char dummy15[sizeof (TrueOrFalseNode*)];
 
       // value
-      char dummy15[sizeof (ValueNode*)];
+      char dummy16[sizeof (ValueNode*)];
 
       // direction
-      char dummy16[sizeof (bool)];
+      char dummy17[sizeof (bool)];
 
       // coordinate
-      char dummy17[sizeof (double)];
+      char dummy18[sizeof (double)];
 
+      // explain
       // comp_type
       // aggr_op
-      char dummy18[sizeof (int)];
+      char dummy19[sizeof (int)];
 
       // geopoint
-      char dummy19[sizeof (std::optional<GeoPoint>)];
+      char dummy20[sizeof (std::optional<GeoPoint>)];
 
       // "identifier"
       // "string"
@@ -544,7 +551,7 @@ namespace yy {
       // "key or value"
       // "@links"
       // id
-      char dummy20[sizeof (std::string)];
+      char dummy21[sizeof (std::string)];
     };
 
     /// The size of the largest semantic type.
@@ -769,23 +776,27 @@ namespace yy {
         SYM_post_query = 94,                     // post_query
         SYM_distinct = 95,                       // distinct
         SYM_distinct_param = 96,                 // distinct_param
-        SYM_sort = 97,                           // sort
-        SYM_sort_param = 98,                     // sort_param
-        SYM_limit = 99,                          // limit
-        SYM_direction = 100,                     // direction
-        SYM_list = 101,                          // list
-        SYM_list_content = 102,                  // list_content
-        SYM_constant = 103,                      // constant
-        SYM_primary_key = 104,                   // primary_key
-        SYM_boolexpr = 105,                      // boolexpr
-        SYM_comp_type = 106,                     // comp_type
-        SYM_post_op = 107,                       // post_op
-        SYM_aggr_op = 108,                       // aggr_op
-        SYM_equality = 109,                      // equality
-        SYM_relational = 110,                    // relational
-        SYM_stringop = 111,                      // stringop
-        SYM_path = 112,                          // path
-        SYM_id = 113                             // id
+        SYM_group_by = 97,                       // group_by
+        SYM_group_by_param = 98,                 // group_by_param
+        SYM_group_by_aggregates = 99,            // group_by_aggregates
+        SYM_explain = 100,                       // explain
+        SYM_sort = 101,                          // sort
+        SYM_sort_param = 102,                    // sort_param
+        SYM_limit = 103,                         // limit
+        SYM_direction = 104,                     // direction
+        SYM_list = 105,                          // list
+        SYM_list_content = 106,                  // list_content
+        SYM_constant = 107,                      // constant
+        SYM_primary_key = 108,                   // primary_key
+        SYM_boolexpr = 109,                      // boolexpr
+        SYM_comp_type = 110,                     // comp_type
+        SYM_post_op = 111,                       // post_op
+        SYM_aggr_op = 112,                       // aggr_op
+        SYM_equality = 113,                      // equality
+        SYM_relational = 114,                    // relational
+        SYM_stringop = 115,                      // stringop
+        SYM_path = 116,                          // path
+        SYM_id = 117                             // id
       };
     };
 
@@ -858,6 +869,12 @@ namespace yy {
         value.move< GeospatialNode* > (std::move (that.value));
         break;
 
+      case symbol_kind::SYM_group_by: // group_by
+      case symbol_kind::SYM_group_by_param: // group_by_param
+      case symbol_kind::SYM_group_by_aggregates: // group_by_aggregates
+        value.move< GroupByNode* > (std::move (that.value));
+        break;
+
       case symbol_kind::SYM_list: // list
       case symbol_kind::SYM_list_content: // list_content
         value.move< ListNode* > (std::move (that.value));
@@ -901,6 +918,7 @@ namespace yy {
         value.move< double > (std::move (that.value));
         break;
 
+      case symbol_kind::SYM_explain: // explain
       case symbol_kind::SYM_comp_type: // comp_type
       case symbol_kind::SYM_aggr_op: // aggr_op
         value.move< int > (std::move (that.value));
@@ -1056,6 +1074,18 @@ namespace yy {
       {}
 #endif
 
+#if 201103L <= YY_CPLUSPLUS
+      basic_symbol (typename Base::kind_type t, GroupByNode*&& v)
+        : Base (t)
+        , value (std::move (v))
+      {}
+#else
+      basic_symbol (typename Base::kind_type t, const GroupByNode*& v)
+        : Base (t)
+        , value (v)
+      {}
+#endif
+
 #if 201103L <= YY_CPLUSPLUS
       basic_symbol (typename Base::kind_type t, ListNode*&& v)
         : Base (t)
@@ -1229,6 +1259,10 @@ namespace yy {
         (void) yysym;
         switch (yykind)
         {
+      case symbol_kind::SYM_explain: // explain
+                    { }
+        break;
+
       case symbol_kind::SYM_comp_type: // comp_type
                     { }
         break;
@@ -1282,6 +1316,12 @@ switch (yykind)
         value.template destroy< GeospatialNode* > ();
         break;
 
+      case symbol_kind::SYM_group_by: // group_by
+      case symbol_kind::SYM_group_by_param: // group_by_param
+      case symbol_kind::SYM_group_by_aggregates: // group_by_aggregates
+        value.template destroy< GroupByNode* > ();
+        break;
+
       case symbol_kind::SYM_list: // list
       case symbol_kind::SYM_list_content: // list_content
         value.template destroy< ListNode* > ();
@@ -1325,6 +1365,7 @@ switch (yykind)
         value.template destroy< double > ();
         break;
 
+      case symbol_kind::SYM_explain: // explain
       case symbol_kind::SYM_comp_type: // comp_type
       case symbol_kind::SYM_aggr_op: // aggr_op
         value.template destroy< int > ();
@@ -2561,7 +2602,7 @@ switch (yykind)
 
 
     /// Stored state numbers (used for stacks).
-    typedef unsigned char state_type;
+    typedef short state_type;
 
     /// The arguments of the error message.
     int yy_syntax_error_arguments_ (const context& yyctx,
@@ -2617,7 +2658,7 @@ switch (yykind)
     // YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
     // positive, shift that token.  If negative, reduce the rule whose
     // number is the opposite.  If YYTABLE_NINF, syntax error.
-    static const unsigned char yytable_[];
+    static const short yytable_[];
 
     static const short yycheck_[];
 
@@ -2861,8 +2902,8 @@ switch (yykind)
     /// Constants.
     enum
     {
-      yylast_ = 633,     ///< Last index in yytable_.
-      yynnts_ = 36,  ///< Number of nonterminal symbols.
+      yylast_ = 747,     ///< Last index in yytable_.
+      yynnts_ = 40,  ///< Number of nonterminal symbols.
       yyfinal_ = 72 ///< Termination state number.
     };
 
@@ -2974,6 +3015,12 @@ switch (yykind)
         value.copy< GeospatialNode* > (YY_MOVE (that.value));
         break;
 
+      case symbol_kind::SYM_group_by: // group_by
+      case symbol_kind::SYM_group_by_param: // group_by_param
+      case symbol_kind::SYM_group_by_aggregates: // group_by_aggregates
+        value.copy< GroupByNode* > (YY_MOVE (that.value));
+        break;
+
       case symbol_kind::SYM_list: // list
       case symbol_kind::SYM_list_content: // list_content
         value.copy< ListNode* > (YY_MOVE (that.value));
@@ -3017,6 +3064,7 @@ switch (yykind)
         value.copy< double > (YY_MOVE (that.value));
         break;
 
+      case symbol_kind::SYM_explain: // explain
       case symbol_kind::SYM_comp_type: // comp_type
       case symbol_kind::SYM_aggr_op: // aggr_op
         value.copy< int > (YY_MOVE (that.value));
@@ -3136,6 +3184,12 @@ switch (yykind)
         value.move< GeospatialNode* > (YY_MOVE (s.value));
         break;
 
+      case symbol_kind::SYM_group_by: // group_by
+      case symbol_kind::SYM_group_by_param: // group_by_param
+      case symbol_kind::SYM_group_by_aggregates: // group_by_aggregates
+        value.move< GroupByNode* > (YY_MOVE (s.value));
+        break;
+
       case symbol_kind::SYM_list: // list
       case symbol_kind::SYM_list_content: // list_content
         value.move< ListNode* > (YY_MOVE (s.value));
@@ -3179,6 +3233,7 @@ switch (yykind)
         value.move< double > (YY_MOVE (s.value));
         break;
 
+      case symbol_kind::SYM_explain: // explain
       case symbol_kind::SYM_comp_type: // comp_type
       case symbol_kind::SYM_aggr_op: // aggr_op
         value.move< int > (YY_MOVE (s.value));
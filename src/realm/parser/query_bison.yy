@@ -32,6 +32,7 @@
     class PathNode;
     class DescriptorOrderingNode;
     class DescriptorNode;
+    class GroupByNode;
     class PropertyNode;
     class SubqueryNode;
 
@@ -133,7 +134,7 @@ using namespace realm::query_parser;
 %token <std::string> BACKLINK "@links"
 %type  <bool> direction
 %type  <CompareType> equality relational stringop
-%type  <int> aggr_op
+%type  <int> aggr_op explain
 %type  <double> coordinate
 %type  <ConstantNode*> constant primary_key
 %type  <GeospatialNode*> geospatial geoloop geoloop_content geopoly_content
@@ -153,6 +154,7 @@ using namespace realm::query_parser;
 %type  <PathNode*> path
 %type  <DescriptorOrderingNode*> post_query
 %type  <DescriptorNode*> sort sort_param distinct distinct_param limit
+%type  <GroupByNode*> group_by group_by_param group_by_aggregates
 %type  <std::string> id
 %type  <PropertyNode*> simple_prop
 
@@ -180,7 +182,15 @@ using namespace realm::query_parser;
 %right NOT;
 
 final
-    : query post_query { drv.result = $1; drv.ordering = $2; };
+    : query post_query { drv.result = $1; drv.ordering = $2; }
+    | query post_query group_by { drv.result = $1; drv.ordering = $2; $2->group_by = $3; }
+    | query post_query explain  { drv.result = $1; drv.ordering = $2; $2->explain = Query::Explain($3); }
+    | query post_query group_by explain {
+                                    drv.result = $1;
+                                    drv.ordering = $2;
+                                    $2->group_by = $3;
+                                    $2->explain = Query::Explain($4);
+                                };
 
 query
     : compare                   { $$ = $1; }
@@ -280,6 +290,41 @@ distinct_param
     : path                      { $$ = drv.m_parse_nodes.create<DescriptorNode>(DescriptorNode::DISTINCT); $$->add($1);}
     | distinct_param ',' path   { $1->add($3); $$ = $1; }
 
+// GROUP, BY and AGGREGATE are not reserved words, so they are read as identifiers
+group_by
+    : ID ID '(' group_by_param ')'  {
+                                    drv.check_keyword($1, "group");
+                                    drv.check_keyword($2, "by");
+                                    $$ = $4;
+                                }
+    | group_by ID '(' group_by_aggregates ')' {
+                                    drv.check_keyword($2, "aggregate");
+                                    $1->add_aggregates($4);
+                                    $$ = $1;
+                                }
+
+group_by_param
+    : path                      { $$ = drv.m_parse_nodes.create<GroupByNode>(); $$->add($1); }
+    | group_by_param ',' path   { $1->add($3); $$ = $1; }
+
+group_by_aggregates
+    : SIZE                      { $$ = drv.m_parse_nodes.create<GroupByNode>(); $$->add_aggregate(GroupByNode::COUNT, nullptr); }
+    | path aggr_op              { $$ = drv.m_parse_nodes.create<GroupByNode>(); $$->add_aggregate($2, $1); }
+    | group_by_aggregates ',' SIZE          { $1->add_aggregate(GroupByNode::COUNT, nullptr); $$ = $1; }
+    | group_by_aggregates ',' path aggr_op  { $1->add_aggregate($4, $3); $$ = $1; }
+
+// EXPLAIN and ANALYZE are not reserved words either
+explain
+    : ID                        {
+                                    drv.check_keyword($1, "explain");
+                                    $$ = int(Query::Explain::Plan);
+                                }
+    | ID ID                     {
+                                    drv.check_keyword($1, "explain");
+                                    drv.check_keyword($2, "analyze");
+                                    $$ = int(Query::Explain::Analyze);
+                                }
+
 sort: SORT '(' sort_param ')'   { $$ = $3; }
 
 sort_param
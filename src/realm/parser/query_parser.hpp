@@ -341,6 +341,23 @@ public:
 
 void parse(const std::string&);
 
+// The syntax trees of the query strings passed to Table::query() are kept in a cache shared by
+// all tables, so running a query again, also with other arguments or on another table, skips
+// parsing it. Queries using arguments as list indexes or coordinates are not cached.
+struct QueryCacheStats {
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t evictions = 0;
+    size_t size = 0;
+    size_t capacity = 0;
+};
+
+// Set the maximum number of cached queries (256 by default). 0 disables the cache.
+void set_query_cache_capacity(size_t capacity);
+QueryCacheStats get_query_cache_stats();
+// Remove all cached queries and reset the statistics
+void clear_query_cache();
+
 } // namespace realm::query_parser
 
 
@@ -29,6 +29,8 @@
 #include <realm/set.hpp>
 
 #include <algorithm>
+#include <numeric>
+#include <thread>
 
 using namespace realm;
 
@@ -87,6 +89,9 @@ Query::Query(const Query& source)
     , m_groups(source.m_groups)
     , m_table(source.m_table)
     , m_ordering(source.m_ordering)
+    , m_group_by(source.m_group_by)
+    , m_explain(source.m_explain)
+    , m_threads(source.m_threads)
 {
     if (source.m_owned_source_table_view) {
         m_owned_source_table_view = source.m_owned_source_table_view->clone();
@@ -132,7 +137,13 @@ Query& Query::operator=(const Query& source)
         else if (m_source_collection) {
             m_view = m_source_collection.get();
         }
+        else {
+            m_view = nullptr;
+        }
         m_ordering = source.m_ordering;
+        m_group_by = source.m_group_by;
+        m_explain = source.m_explain;
+        m_threads = source.m_threads;
     }
     return *this;
 }
@@ -158,6 +169,9 @@ Query::Query(const Query* source, Transaction* tr, PayloadPolicy policy)
         REALM_ASSERT_DEBUG(m_view);
     }
     m_groups = source->m_groups;
+    m_group_by = source->m_group_by;
+    m_explain = source->m_explain;
+    m_threads = source->m_threads;
     if (source->m_table)
         set_table(tr->import_copy_of(source->m_table));
     // otherwise: empty query.
@@ -940,8 +954,7 @@ Query& Query::like(ColKey column_key, StringData value, bool case_sensitive)
 
 Query& Query::fulltext(ColKey column_key, StringData value)
 {
-    auto index = m_table->get_string_index(column_key);
-    if (!(index && index->is_fulltext_index())) {
+    if (m_table->search_index_type(column_key) != IndexType::Fulltext) {
         throw IllegalOperation{"Column has no fulltext index"};
     }
 
@@ -952,8 +965,7 @@ Query& Query::fulltext(ColKey column_key, StringData value)
 
 Query& Query::fulltext(ColKey column_key, StringData value, const LinkMap& link_map)
 {
-    auto index = link_map.get_target_table()->get_string_index(column_key);
-    if (!(index && index->is_fulltext_index())) {
+    if (link_map.get_target_table()->search_index_type(column_key) != IndexType::Fulltext) {
         throw IllegalOperation{"Column has no fulltext index"};
     }
 
@@ -1033,6 +1045,9 @@ void Query::aggregate(QueryStateBase& st, ColKey column_key) const
                     }
                 }
             }
+            else if (use_threads()) {
+                do_find_on_threads(st, column_key);
+            }
             else {
                 // no index, traverse cluster tree
                 node = pn;
@@ -1145,6 +1160,297 @@ std::optional<Mixed> Query::max(ColKey col_key, ObjKey* return_ndx) const
     return AggregateHelper<Query>::max(*m_table, *this, col_key, return_ndx);
 }
 
+namespace {
+
+// The results of one aggregate for each group
+class GroupAggregator {
+public:
+    virtual ~GroupAggregator() = default;
+    virtual void add_group() = 0;
+    virtual void accumulate(size_t group, Mixed value) = 0;
+    virtual Mixed result(size_t group) const = 0;
+};
+
+template <class T, template <class> class Operator>
+class GroupAggregatorImpl : public GroupAggregator {
+public:
+    void add_group() override
+    {
+        m_states.emplace_back();
+    }
+    void accumulate(size_t group, Mixed value) override
+    {
+        m_states[group].accumulate(value);
+    }
+    Mixed result(size_t group) const override
+    {
+        auto& state = m_states[group];
+        return state.is_null() ? Mixed() : Mixed(state.result());
+    }
+
+private:
+    std::vector<Operator<T>> m_states;
+};
+
+template <template <class> class Operator>
+std::unique_ptr<GroupAggregator> make_group_aggregator(DataType type)
+{
+    constexpr bool is_min_max = std::is_same_v<Operator<int64_t>, aggregate_operations::Minimum<int64_t>> ||
+                                std::is_same_v<Operator<int64_t>, aggregate_operations::Maximum<int64_t>>;
+    switch (type) {
+        case type_Int:
+            return std::make_unique<GroupAggregatorImpl<int64_t, Operator>>();
+        case type_Float:
+            return std::make_unique<GroupAggregatorImpl<float, Operator>>();
+        case type_Double:
+            return std::make_unique<GroupAggregatorImpl<double, Operator>>();
+        case type_Decimal:
+            return std::make_unique<GroupAggregatorImpl<Decimal128, Operator>>();
+        case type_Mixed:
+            return std::make_unique<GroupAggregatorImpl<Mixed, Operator>>();
+        case type_Timestamp:
+            if constexpr (is_min_max) {
+                return std::make_unique<GroupAggregatorImpl<Timestamp, Operator>>();
+            }
+            break;
+        default:
+            break;
+    }
+    return nullptr;
+}
+
+// Finds the group of each matching object and accumulates the aggregates of the group.
+// In a cluster traversal the values are read from the leaves of the current cluster.
+class GroupByState : public QueryStateBase {
+public:
+    GroupByState(const Table& table, const std::vector<ColKey>& columns,
+                 const std::vector<GroupByAggregate>& aggregates)
+        : m_columns(columns)
+    {
+        if (columns.empty())
+            throw InvalidArgument("Grouping requires at least one column");
+        for (auto col : columns) {
+            table.check_column(col);
+            if (col.is_collection() || col.get_type() == col_type_BackLink || col.get_type() == col_type_TypedLink)
+                throw IllegalOperation(util::format("Cannot group by '%1'", table.get_column_name(col)));
+        }
+        for (auto& aggregate : aggregates) {
+            std::unique_ptr<GroupAggregator> aggregator;
+            if (aggregate.type != GroupByAggregate::Type::Count) {
+                table.check_column(aggregate.column);
+                if (aggregate.column.is_collection())
+                    throw IllegalOperation(
+                        util::format("Cannot aggregate '%1'", table.get_column_name(aggregate.column)));
+                DataType type = table.get_column_type(aggregate.column);
+                switch (aggregate.type) {
+                    case GroupByAggregate::Type::Sum:
+                        if (type != type_Timestamp)
+                            aggregator = make_group_aggregator<aggregate_operations::Sum>(type);
+                        break;
+                    case GroupByAggregate::Type::Average:
+                        if (type != type_Timestamp)
+                            aggregator = make_group_aggregator<aggregate_operations::Average>(type);
+                        break;
+                    case GroupByAggregate::Type::Min:
+                        aggregator = make_group_aggregator<aggregate_operations::Minimum>(type);
+                        break;
+                    case GroupByAggregate::Type::Max:
+                        aggregator = make_group_aggregator<aggregate_operations::Maximum>(type);
+                        break;
+                    case GroupByAggregate::Type::Count:
+                        break;
+                }
+                if (!aggregator)
+                    throw IllegalOperation(util::format("Cannot aggregate '%1' of type '%2'",
+                                                        table.get_column_name(aggregate.column), type));
+            }
+            m_aggregate_columns.push_back(aggregate.column);
+            m_aggregators.push_back(std::move(aggregator));
+        }
+        Allocator& alloc = table.get_alloc();
+        for (auto col : m_columns) {
+            m_column_leaves.push_back(TwoColumnsNodeBase::update_cached_leaf_pointers_for_column(alloc, col));
+        }
+        for (size_t i = 0; i < m_aggregators.size(); ++i) {
+            std::unique_ptr<ArrayPayload> leaf;
+            if (m_aggregators[i])
+                leaf = TwoColumnsNodeBase::update_cached_leaf_pointers_for_column(alloc, m_aggregate_columns[i]);
+            m_aggregate_leaves.push_back(std::move(leaf));
+        }
+        m_key.resize(m_columns.size());
+    }
+
+    void set_cluster(const Cluster* cluster)
+    {
+        for (size_t i = 0; i < m_columns.size(); ++i)
+            cluster->init_leaf(m_columns[i], m_column_leaves[i].get());
+        for (size_t i = 0; i < m_aggregators.size(); ++i) {
+            if (m_aggregators[i])
+                cluster->init_leaf(m_aggregate_columns[i], m_aggregate_leaves[i].get());
+        }
+    }
+
+    bool match(size_t index, Mixed) noexcept final
+    {
+        return match(index);
+    }
+    bool match(size_t index) noexcept final
+    {
+        for (size_t i = 0; i < m_columns.size(); ++i)
+            m_key[i] = m_column_leaves[i]->get_any(index);
+        size_t group = find_group();
+        for (size_t i = 0; i < m_aggregators.size(); ++i) {
+            if (m_aggregators[i])
+                m_aggregators[i]->accumulate(group, m_aggregate_leaves[i]->get_any(index));
+        }
+        ++m_match_count;
+        return true;
+    }
+
+    void add(const Obj& obj)
+    {
+        for (size_t i = 0; i < m_columns.size(); ++i)
+            m_key[i] = obj.get_any(m_columns[i]);
+        size_t group = find_group();
+        for (size_t i = 0; i < m_aggregators.size(); ++i) {
+            if (m_aggregators[i])
+                m_aggregators[i]->accumulate(group, obj.get_any(m_aggregate_columns[i]));
+        }
+        ++m_match_count;
+    }
+
+    void get_result(std::vector<Mixed>& keys, std::vector<Mixed>& values) const
+    {
+        keys = m_keys;
+        size_t num_groups = m_counts.size();
+        values.reserve(num_groups * m_aggregators.size());
+        for (size_t group = 0; group < num_groups; ++group) {
+            for (auto& aggregator : m_aggregators) {
+                values.push_back(aggregator ? aggregator->result(group) : Mixed(int64_t(m_counts[group])));
+            }
+        }
+    }
+
+private:
+    std::vector<ColKey> m_columns;
+    std::vector<ColKey> m_aggregate_columns;
+    std::vector<std::unique_ptr<GroupAggregator>> m_aggregators;
+    std::vector<std::unique_ptr<ArrayPayload>> m_column_leaves;
+    std::vector<std::unique_ptr<ArrayPayload>> m_aggregate_leaves;
+
+    // The key of the current object
+    std::vector<Mixed> m_key;
+    // The keys of the groups, one after the other
+    std::vector<Mixed> m_keys;
+    std::vector<size_t> m_counts;
+    // The groups by the hash of their keys
+    std::unordered_multimap<size_t, size_t> m_groups;
+
+    size_t find_group()
+    {
+        size_t hash = 0;
+        for (auto& value : m_key)
+            hash = hash * 31 + value.compare_hash();
+        auto [begin, end] = m_groups.equal_range(hash);
+        for (auto it = begin; it != end; ++it) {
+            size_t group = it->second;
+            auto keys = m_keys.begin() + group * m_key.size();
+            if (std::equal(m_key.begin(), m_key.end(), keys, [](const Mixed& a, const Mixed& b) {
+                    return a.compare(b) == 0;
+                })) {
+                ++m_counts[group];
+                return group;
+            }
+        }
+        size_t group = m_counts.size();
+        m_keys.insert(m_keys.end(), m_key.begin(), m_key.end());
+        m_counts.push_back(1);
+        for (auto& aggregator : m_aggregators) {
+            if (aggregator)
+                aggregator->add_group();
+        }
+        m_groups.emplace(hash, group);
+        return group;
+    }
+};
+
+} // anonymous namespace
+
+GroupByResult Query::group_by(const std::vector<ColKey>& columns,
+                              const std::vector<GroupByAggregate>& aggregates) const
+{
+    GroupByState st(*m_table, columns, aggregates);
+
+    if (m_view) {
+        init();
+        m_view->for_each([&](const Obj& obj) {
+            if (eval_object(obj))
+                st.add(obj);
+            return IteratorControl::AdvanceToNext;
+        });
+    }
+    else if (!has_conditions()) {
+        m_table->traverse_clusters([&](const Cluster* cluster) {
+            st.set_cluster(cluster);
+            size_t sz = cluster->node_size();
+            for (size_t i = 0; i < sz; i++)
+                st.match(i);
+            return IteratorControl::AdvanceToNext;
+        });
+    }
+    else {
+        init();
+        auto pn = root_node();
+        auto best = find_best_node(pn);
+        auto node = pn->m_children[best];
+        if (node->has_search_index()) {
+            auto keys = node->index_based_keys();
+            REALM_ASSERT(keys);
+            // The node having the search index can be removed from the query as we know that
+            // all the objects will match this condition
+            pn->m_children[best] = pn->m_children.back();
+            pn->m_children.pop_back();
+            const size_t num_keys = keys->size();
+            for (size_t i = 0; i < num_keys; ++i) {
+                auto obj = m_table->get_object(keys->get(i));
+                if (pn->m_children.empty() || eval_object(obj))
+                    st.add(obj);
+            }
+        }
+        else {
+            node = pn;
+            m_table->traverse_clusters([&](const Cluster* cluster) {
+                size_t e = cluster->node_size();
+                node->set_cluster(cluster);
+                st.set_cluster(cluster);
+                st.m_key_offset = cluster->get_offset();
+                st.m_key_values = cluster->get_key_array();
+                aggregate_internal(node, &st, 0, e, nullptr);
+                return IteratorControl::AdvanceToNext;
+            });
+        }
+    }
+
+    GroupByResult result;
+    result.m_num_columns = columns.size();
+    result.m_num_aggregates = aggregates.size();
+    st.get_result(result.m_keys, result.m_values);
+    return result;
+}
+
+GroupByResult Query::group_by() const
+{
+    if (!m_group_by)
+        throw IllegalOperation("The query has no grouping");
+    return group_by(m_group_by->columns, m_group_by->aggregates);
+}
+
+Query& Query::set_group_by(GroupBy group_by)
+{
+    m_group_by = std::move(group_by);
+    return *this;
+}
+
 // Grouping
 Query& Query::group()
 {
@@ -1289,7 +1595,7 @@ ObjKey Query::find() const
     return ret;
 }
 
-void Query::do_find_all(QueryStateBase& st) const
+void Query::do_find_all(QueryStateBase& st, ColKey payload_col) const
 {
     auto logger = m_table->get_logger();
     std::chrono::steady_clock::time_point t1;
@@ -1314,23 +1620,35 @@ void Query::do_find_all(QueryStateBase& st) const
 
     bool has_cond = has_conditions();
 
+    // The value of the payload column is read from the current leaf where there is one
+    std::unique_ptr<ArrayPayload> leaf;
+    if (payload_col)
+        leaf = TwoColumnsNodeBase::update_cached_leaf_pointers_for_column(m_table->get_alloc(), payload_col);
+    auto get_payload = [&](const Obj& obj) {
+        return payload_col ? obj.get_any(payload_col) : Mixed();
+    };
+
     if (m_view) {
         size_t sz = m_view->size();
         for (size_t t = 0; t < sz; t++) {
             const Obj obj = m_view->get_object(t);
             if (eval_object(obj)) {
                 st.m_key_offset = obj.get_key().value;
-                if (!st.match(0, Mixed()))
+                if (!st.match(0, get_payload(obj)))
                     break;
             }
         }
     }
     else {
         if (!has_cond) {
-            auto f = [&st](const Cluster* cluster) {
+            auto f = [&st, &leaf, payload_col](const Cluster* cluster) {
                 size_t sz = cluster->node_size();
                 st.m_key_offset = cluster->get_offset();
                 st.m_key_values = cluster->get_key_array();
+                if (leaf) {
+                    cluster->init_leaf(payload_col, leaf.get());
+                    st.set_payload_column(leaf.get());
+                }
                 for (size_t i = 0; i < sz; i++) {
                     if (!st.match(i, Mixed()))
                         return IteratorControl::Stop;
@@ -1359,28 +1677,33 @@ void Query::do_find_all(QueryStateBase& st) const
                     st.m_key_offset = key.value;
                     if (pn->m_children.empty()) {
                         // No more conditions - just add key
-                        if (!st.match(0, Mixed()))
+                        if (!st.match(0, payload_col ? m_table->get_object(key).get_any(payload_col) : Mixed()))
                             break;
                     }
                     else {
                         auto obj = m_table->get_object(key);
                         if (eval_object(obj)) {
-                            if (!st.match(0, Mixed()))
+                            if (!st.match(0, get_payload(obj)))
                                 break;
                         }
                     }
                 }
             }
+            else if (st.limit() == size_t(-1) && use_threads()) {
+                do_find_on_threads(st, payload_col);
+            }
             else {
                 // no index on best node (and likely no index at all), descend B+-tree
                 node = pn;
 
-                auto f = [&node, &st, this](const Cluster* cluster) {
+                auto f = [&node, &st, &leaf, payload_col, this](const Cluster* cluster) {
                     size_t e = cluster->node_size();
                     node->set_cluster(cluster);
+                    if (leaf)
+                        cluster->init_leaf(payload_col, leaf.get());
                     st.m_key_offset = cluster->get_offset();
                     st.m_key_values = cluster->get_key_array();
-                    aggregate_internal(node, &st, 0, e, nullptr);
+                    aggregate_internal(node, &st, 0, e, leaf.get());
                     // Stop if limit is reached
                     return st.match_count() == st.limit() ? IteratorControl::Stop : IteratorControl::AdvanceToNext;
                 };
@@ -1487,6 +1810,9 @@ size_t Query::do_count(size_t limit) const
                 cnt = std::min(limit, sz);
             }
         }
+        else if (limit == size_t(-1) && use_threads()) {
+            cnt = do_count_on_threads();
+        }
         else {
             // no index, descend down the B+-tree instead
             node = pn;
@@ -1586,135 +1912,172 @@ size_t Query::remove() const
     return rows;
 }
 
-#if REALM_MULTITHREAD_QUERY
-TableView Query::find_all_multi(size_t start, size_t end)
+void Query::set_threads(unsigned int threadcount)
 {
-    static_cast<void>(start);
-    static_cast<void>(end);
-
-    // Initialization
-    init();
-    ts.next_job = start;
-    ts.end_job = end;
-    ts.done_job = 0;
-    ts.count = 0;
-    ts.table = &table;
-    ts.node = first[0];
-
-    // Signal all threads to start
-    pthread_mutex_unlock(&ts.jobs_mutex);
-    pthread_cond_broadcast(&ts.jobs_cond);
-
-    // Wait until all threads have completed
-    pthread_mutex_lock(&ts.completed_mutex);
-    while (ts.done_job < ts.end_job)
-        pthread_cond_wait(&ts.completed_cond, &ts.completed_mutex);
-    pthread_mutex_lock(&ts.jobs_mutex);
-    pthread_mutex_unlock(&ts.completed_mutex);
-
-    TableView tv(*m_table);
-
-    // Sort search results because user expects ascending order
-    sort(ts.chunks.begin(), ts.chunks.end(), &Query::comp);
-    for (size_t i = 0; i < ts.chunks.size(); ++i) {
-        const size_t from = ts.chunks[i].m_root_node;
-        const size_t upto = (i == ts.chunks.size() - 1) ? size_t(-1) : ts.chunks[i + 1].m_root_node;
-        size_t first = ts.chunks[i].second;
-
-        while (first < ts.results.size() && ts.results[first] < upto && ts.results[first] >= from) {
-            tv.get_ref_column().add(ts.results[first]);
-            ++first;
-        }
-    }
-
-    return move(tv);
+    m_threads = threadcount;
 }
 
-int Query::set_threads(unsigned int threadcount)
+TableView Query::find_all_multi() const
 {
-#if defined(_WIN32) || defined(__WIN32__) || defined(_WIN64)
-    pthread_win32_process_attach_np();
-#endif
-    pthread_mutex_init(&ts.result_mutex, nullptr);
-    pthread_cond_init(&ts.completed_cond, nullptr);
-    pthread_mutex_init(&ts.jobs_mutex, nullptr);
-    pthread_mutex_init(&ts.completed_mutex, nullptr);
-    pthread_cond_init(&ts.jobs_cond, nullptr);
-
-    pthread_mutex_lock(&ts.jobs_mutex);
-
-    for (size_t i = 0; i < m_threadcount; ++i)
-        pthread_detach(threads[i]);
-
-    for (size_t i = 0; i < threadcount; ++i) {
-        int r = pthread_create(&threads[i], nullptr, query_thread, (void*)&ts);
-        if (r != 0)
-            REALM_ASSERT(false); // todo
-    }
-    m_threadcount = threadcount;
-    return 0;
+    Query q(*this);
+    if (q.m_threads <= 1)
+        q.m_threads = std::max(std::thread::hardware_concurrency(), 1u);
+    return q.find_all();
 }
 
-
-void* Query::query_thread(void* arg)
+bool Query::use_threads() const
 {
-    static_cast<void>(arg);
-    thread_state* ts = static_cast<thread_state*>(arg);
-
-    std::vector<size_t> res;
-    std::vector<pair<size_t, size_t>> chunks;
+    // Starting threads does not pay off for small tables
+    return m_threads > 1 && m_table->size() >= min_size_for_threads;
+}
 
-    for (;;) {
-        // Main waiting loop that waits for a query to start
-        pthread_mutex_lock(&ts->jobs_mutex);
-        while (ts->next_job == ts->end_job)
-            pthread_cond_wait(&ts->jobs_cond, &ts->jobs_mutex);
-        pthread_mutex_unlock(&ts->jobs_mutex);
+namespace {
 
-        for (;;) {
-            // Pick a job
-            pthread_mutex_lock(&ts->jobs_mutex);
-            if (ts->next_job == ts->end_job)
-                break;
-            const size_t chunk = min(ts->end_job - ts->next_job, thread_chunk_size);
-            const size_t mine = ts->next_job;
-            ts->next_job += chunk;
-            size_t r = mine - 1;
-            const size_t end = mine + chunk;
+// Collects the matching rows of a leaf when a query runs on several threads
+class QueryStateCollect : public QueryStateBase {
+public:
+    std::vector<size_t> m_matches;
 
-            pthread_mutex_unlock(&ts->jobs_mutex);
+    bool match(size_t index, Mixed) noexcept final
+    {
+        return match(index);
+    }
+    bool match(size_t index) noexcept final
+    {
+        ++m_match_count;
+        m_matches.push_back(index);
+        return true;
+    }
+};
 
-            // Execute job
-            for (;;) {
-                r = ts->node->find_first(r + 1, end);
-                if (r == end)
-                    break;
-                res.push_back(r);
-            }
+} // anonymous namespace
 
-            // Append result in common queue shared by all threads.
-            pthread_mutex_lock(&ts->result_mutex);
-            ts->done_job += chunk;
-            if (res.size() > 0) {
-                ts->chunks.push_back(std::pair<size_t, size_t>(mine, ts->results.size()));
-                ts->count += res.size();
-                for (size_t i = 0; i < res.size(); i++) {
-                    ts->results.push_back(res[i]);
-                }
-                res.clear();
-            }
-            pthread_mutex_unlock(&ts->result_mutex);
+std::vector<std::unique_ptr<Query>> Query::clone_for_threads() const
+{
+    // Every thread needs its own copy of the condition nodes, as they hold the
+    // current leaf, the accessors of linked tables and the match statistics.
+    // The first thread, which is the calling one, uses this query.
+    std::vector<std::unique_ptr<Query>> queries;
+    for (unsigned int t = 1; t < m_threads; t++) {
+        queries.push_back(std::make_unique<Query>(*this));
+        queries.back()->init();
+    }
+
+    // The table accessors are shared by the threads. Create those of the
+    // linked tables now rather than having the threads race to create them.
+    std::vector<TableKey> tables;
+    root_node()->get_link_dependencies(tables);
+    if (Group* g = m_table.unchecked_ptr()->get_parent_group()) {
+        for (auto key : tables)
+            g->get_table(key);
+    }
+    return queries;
+}
+
+// Evaluate the conditions on several threads. If `payload_col` is given, its
+// value is passed along with every match.
+void Query::do_find_on_threads(QueryStateBase& st, ColKey payload_col) const
+{
+    auto queries = clone_for_threads();
+
+    // Every thread needs its own leaf of the payload column
+    Allocator& alloc = m_table.unchecked_ptr()->get_alloc();
+    std::vector<std::unique_ptr<ArrayPayload>> leaves(m_threads);
+    if (payload_col) {
+        for (auto& leaf : leaves)
+            leaf = TwoColumnsNodeBase::update_cached_leaf_pointers_for_column(alloc, payload_col);
+    }
+
+    // Aggregates are computed by every thread on its own and combined at the end
+    std::vector<std::unique_ptr<QueryStateBase>> partials;
+    for (unsigned int t = 0; t < m_threads; t++) {
+        if (auto partial = st.make_partial())
+            partials.push_back(std::move(partial));
+    }
+    if (!partials.empty()) {
+        m_table->traverse_clusters_parallel(m_threads, [&](size_t t, size_t, const Cluster* cluster) {
+            const Query& q = t == 0 ? *this : *queries[t - 1];
+            ParentNode* node = q.root_node();
+            QueryStateBase& partial = *partials[t];
+            node->set_cluster(cluster);
+            if (payload_col)
+                cluster->init_leaf(payload_col, leaves[t].get());
+            partial.m_key_offset = cluster->get_offset();
+            partial.m_key_values = cluster->get_key_array();
+            q.aggregate_internal(node, &partial, 0, cluster->node_size(), leaves[t].get());
+        });
+        for (auto& partial : partials)
+            st.merge_partial(*partial);
+        return;
+    }
 
-            // Signal main thread that we might have compleeted
-            pthread_mutex_lock(&ts->completed_mutex);
-            pthread_cond_signal(&ts->completed_cond);
-            pthread_mutex_unlock(&ts->completed_mutex);
+    // Otherwise the matches are collected per leaf and passed to `st` in key order
+    struct LeafMatches {
+        size_t leaf_ndx;
+        std::vector<ObjKey> keys;
+        std::vector<Mixed> values;
+    };
+    std::vector<std::vector<LeafMatches>> results(m_threads);
+
+    m_table->traverse_clusters_parallel(m_threads, [&](size_t t, size_t leaf_ndx, const Cluster* cluster) {
+        const Query& q = t == 0 ? *this : *queries[t - 1];
+        ParentNode* node = q.root_node();
+        QueryStateCollect collect;
+        node->set_cluster(cluster);
+        q.aggregate_internal(node, &collect, 0, cluster->node_size(), nullptr);
+        if (collect.m_matches.empty())
+            return;
+
+        LeafMatches& m = results[t].emplace_back();
+        m.leaf_ndx = leaf_ndx;
+        m.keys.reserve(collect.m_matches.size());
+        for (auto i : collect.m_matches)
+            m.keys.push_back(cluster->get_real_key(i));
+        if (payload_col) {
+            cluster->init_leaf(payload_col, leaves[t].get());
+            m.values.reserve(collect.m_matches.size());
+            for (auto i : collect.m_matches)
+                m.values.push_back(leaves[t]->get_any(i));
+        }
+    });
+
+    std::vector<const LeafMatches*> merged;
+    for (auto& thread_results : results) {
+        for (auto& m : thread_results)
+            merged.push_back(&m);
+    }
+    std::sort(merged.begin(), merged.end(), [](const LeafMatches* a, const LeafMatches* b) {
+        return a->leaf_ndx < b->leaf_ndx;
+    });
+
+    st.m_key_values = nullptr;
+    st.set_payload_column(nullptr);
+    for (auto m : merged) {
+        for (size_t i = 0; i < m->keys.size(); i++) {
+            st.m_key_offset = m->keys[i].value;
+            if (!st.match(0, m->values.empty() ? Mixed() : m->values[i]))
+                return;
         }
     }
-    return 0;
 }
 
-#endif // REALM_MULTITHREADQUERY
+size_t Query::do_count_on_threads() const
+{
+    auto queries = clone_for_threads();
+
+    // The matches need neither be ordered nor kept, so every thread just
+    // counts those it finds
+    std::vector<size_t> counts(m_threads);
+    m_table->traverse_clusters_parallel(m_threads, [&](size_t t, size_t, const Cluster* cluster) {
+        const Query& q = t == 0 ? *this : *queries[t - 1];
+        ParentNode* node = q.root_node();
+        QueryStateCount st;
+        node->set_cluster(cluster);
+        q.aggregate_internal(node, &st, 0, cluster->node_size(), nullptr);
+        counts[t] += st.get_count();
+    });
+    return std::accumulate(counts.begin(), counts.end(), size_t(0));
+}
 
 std::string Query::validate() const
 {
@@ -1747,6 +2110,51 @@ std::string Query::get_description(util::serializer::SerialisationState& state)
     if (m_ordering) {
         description += " " + m_ordering->get_description(m_table);
     }
+    if (m_group_by) {
+        description += " GROUP BY(";
+        for (size_t i = 0; i < m_group_by->columns.size(); ++i) {
+            description += m_table->get_column_name(m_group_by->columns[i]);
+            if (i < m_group_by->columns.size() - 1)
+                description += ", ";
+        }
+        description += ")";
+        if (!m_group_by->aggregates.empty()) {
+            description += " AGGREGATE(";
+            for (size_t i = 0; i < m_group_by->aggregates.size(); ++i) {
+                auto& aggregate = m_group_by->aggregates[i];
+                if (aggregate.type != GroupByAggregate::Type::Count) {
+                    description += m_table->get_column_name(aggregate.column);
+                    description += ".";
+                }
+                switch (aggregate.type) {
+                    case GroupByAggregate::Type::Count:
+                        description += "@count";
+                        break;
+                    case GroupByAggregate::Type::Sum:
+                        description += "@sum";
+                        break;
+                    case GroupByAggregate::Type::Min:
+                        description += "@min";
+                        break;
+                    case GroupByAggregate::Type::Max:
+                        description += "@max";
+                        break;
+                    case GroupByAggregate::Type::Average:
+                        description += "@avg";
+                        break;
+                }
+                if (i < m_group_by->aggregates.size() - 1)
+                    description += ", ";
+            }
+            description += ")";
+        }
+    }
+    if (m_explain == Explain::Plan) {
+        description += " EXPLAIN";
+    }
+    else if (m_explain == Explain::Analyze) {
+        description += " EXPLAIN ANALYZE";
+    }
     return description;
 }
 
@@ -1781,6 +2189,104 @@ std::string Query::get_description_safe() const noexcept
     return "Unknown Query";
 }
 
+QueryProfile Query::explain() const
+{
+    if (!m_table)
+        return {};
+    init();
+    return make_profile(false);
+}
+
+QueryProfile Query::profile() const
+{
+    if (!m_table)
+        return {};
+    Query query(*this);
+    query.m_threads = 0;
+    if (ParentNode* root = query.root_node())
+        root->set_profiling(true);
+    auto start = std::chrono::steady_clock::now();
+    TableView tv = m_ordering ? query.find_all(*m_ordering) : query.find_all();
+    auto time = std::chrono::steady_clock::now() - start;
+
+    // The view runs its own copy of the query, which holds the statistics
+    QueryProfile profile = tv.get_query()->make_profile(true);
+    profile.matches = tv.size();
+    profile.time = std::chrono::duration_cast<std::chrono::nanoseconds>(time);
+    return profile;
+}
+
+QueryProfile Query::explain_requested() const
+{
+    switch (m_explain) {
+        case Explain::Plan:
+            return explain();
+        case Explain::Analyze:
+            return profile();
+        case Explain::None:
+            break;
+    }
+    throw IllegalOperation("The query has no EXPLAIN");
+}
+
+QueryProfile Query::make_profile(bool has_run) const
+{
+    QueryProfile profile;
+    if (!has_conditions())
+        return profile;
+
+    // Same order as the children of the root node
+    ParentNode* root = root_node();
+    std::vector<ParentNode*> nodes;
+    for (ParentNode* node = root; node; node = node->m_child.get())
+        nodes.push_back(node);
+    if (root->m_composite_index_node)
+        nodes.push_back(root->m_composite_index_node.get());
+    if (!m_view) {
+        // The search is driven by the node chosen by find_best_node()
+        auto best = std::min_element(nodes.begin(), nodes.end(), [](const ParentNode* a, const ParentNode* b) {
+            return a->cost() < b->cost();
+        });
+        std::rotate(nodes.begin(), best, best + 1);
+        profile.uses_index = nodes.front()->has_search_index();
+    }
+
+    util::serializer::SerialisationState state(m_table->get_parent_group());
+    for (ParentNode* node : nodes) {
+        QueryProfile::Condition condition;
+        condition.description = node->describe(state);
+        condition.uses_index = node->has_search_index();
+        condition.cost = node->cost();
+        condition.probes = node->m_probes;
+        condition.matches = node->m_matches;
+        condition.clusters_visited = node->m_clusters_visited;
+        condition.clusters_skipped = node->m_clusters_skipped;
+        if (has_run && condition.uses_index && condition.probes == 0) {
+            // The matches were looked up in the index when the query was initialized
+            if (auto keys = node->index_based_keys()) {
+                condition.probes = 1;
+                condition.matches = keys->size();
+            }
+        }
+        profile.conditions.push_back(std::move(condition));
+    }
+    return profile;
+}
+
+std::string QueryProfile::to_string() const
+{
+    std::string result = uses_index ? "Search driven by an index\n" : "";
+    for (size_t i = 0; i < conditions.size(); ++i) {
+        auto& condition = conditions[i];
+        result += util::format("%1. %2%3 (cost %4): %5 probes, %6 matches, %7 clusters visited, %8 skipped\n",
+                               i + 1, condition.description, condition.uses_index ? " [index]" : "",
+                               condition.cost, condition.probes, condition.matches, condition.clusters_visited,
+                               condition.clusters_skipped);
+    }
+    result += util::format("%1 matches in %2 us", matches, double(time.count()) / 1000);
+    return result;
+}
+
 void Query::init() const
 {
     m_table.check();
@@ -1788,6 +2294,10 @@ void Query::init() const
         root->init(m_view == nullptr);
         std::vector<ParentNode*> vec;
         root->gather_children(vec);
+        if (!m_view)
+            root->init_composite_index();
+        // The objects of a view are few enough to evaluate the conditions on each of them
+        root->init_semi_joins(m_view == nullptr);
     }
 }
 
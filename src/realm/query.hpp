@@ -23,17 +23,10 @@
 #include <cstdio>
 #include <climits>
 #include <algorithm>
+#include <chrono>
 #include <string>
 #include <vector>
 
-#define REALM_MULTITHREAD_QUERY 0
-
-#if REALM_MULTITHREAD_QUERY
-// FIXME: Use our C++ thread abstraction API since it provides a much
-// higher level of encapsulation and safety.
-#include <pthread.h>
-#endif
-
 #include <realm/aggregate_ops.hpp>
 #include <realm/binary_data.hpp>
 #include <realm/column_type_traits.hpp>
@@ -78,6 +71,85 @@ struct QueryGroup {
     State m_state = State::Default;
 };
 
+// How a query is evaluated, as reported by Query::explain() and Query::profile()
+struct QueryProfile {
+    struct Condition {
+        // The condition in the syntax of the query language
+        std::string description;
+        // The objects matching the condition are found through a search index
+        bool uses_index = false;
+        // Estimated cost of finding the next match, used to choose the condition driving the search
+        double cost = 0;
+        // Statistics collected by profile(). A probe is a search for the first match in a range of objects.
+        size_t probes = 0;
+        size_t matches = 0;
+        size_t clusters_visited = 0;
+        // Clusters where the values were not read as none of them can match
+        size_t clusters_skipped = 0;
+    };
+
+    // The conditions ANDed at the top level of the query, in the order they are tested. The first
+    // condition drives the search, the others are tested on its matches.
+    std::vector<Condition> conditions;
+    bool uses_index = false;
+
+    // Set by profile()
+    size_t matches = 0;
+    std::chrono::nanoseconds time{0};
+
+    std::string to_string() const;
+};
+
+// An aggregate computed for each group by Query::group_by()
+struct GroupByAggregate {
+    enum class Type { Count, Sum, Min, Max, Average };
+    Type type;
+    // The column aggregated. Not used by Count, which counts the objects of the group.
+    ColKey column = {};
+};
+
+// The grouping computed by Query::group_by(). In the query language it is given after
+// the other clauses, as in `GROUP BY(category, region) AGGREGATE(@count, price.@sum)`.
+struct GroupBy {
+    std::vector<ColKey> columns;
+    std::vector<GroupByAggregate> aggregates;
+};
+
+// The groups found by Query::group_by(), in the order their first object was found.
+// String and binary values refer to the database like the results of Query::min(),
+// so they are only valid until the transaction is advanced or modified. The result
+// is complete when group_by() returns, as any object may belong to any group, so no
+// group is final before the last object has been read. It takes memory per group,
+// not per object.
+class GroupByResult {
+public:
+    size_t size() const noexcept
+    {
+        return m_num_columns ? m_keys.size() / m_num_columns : 0;
+    }
+    // The value of the grouping column `column_ndx` shared by the objects of the group
+    Mixed get_key(size_t group, size_t column_ndx) const
+    {
+        REALM_ASSERT(group < size() && column_ndx < m_num_columns);
+        return m_keys[group * m_num_columns + column_ndx];
+    }
+    // The result of the aggregate `aggregate_ndx` for the group: the number of objects
+    // for Count, else what sum(), min(), max() or avg() give for the objects of the group
+    Mixed get_value(size_t group, size_t aggregate_ndx) const
+    {
+        REALM_ASSERT(group < size() && aggregate_ndx < m_num_aggregates);
+        return m_values[group * m_num_aggregates + aggregate_ndx];
+    }
+
+private:
+    friend class Query;
+
+    size_t m_num_columns = 0;
+    size_t m_num_aggregates = 0;
+    std::vector<Mixed> m_keys;
+    std::vector<Mixed> m_values;
+};
+
 class Query final {
 public:
     Query(ConstTableRef table, TableView* tv = nullptr);
@@ -272,15 +344,38 @@ public:
     std::optional<Mixed> max(ColKey col_key, ObjKey* = nullptr) const;
     std::optional<Mixed> avg(ColKey col_key, size_t* value_count = nullptr) const;
 
+    // Group the matching objects by the values of `columns` and compute the
+    // aggregates of each group, in a single pass over the objects. Sum and
+    // Average accept the columns accepted by sum() and avg(), Min and Max those
+    // accepted by min() and max(). Any ordering of the query is ignored.
+    GroupByResult group_by(const std::vector<ColKey>& columns,
+                           const std::vector<GroupByAggregate>& aggregates) const;
+    // Use the grouping set by set_group_by() or given in the query language
+    GroupByResult group_by() const;
+    Query& set_group_by(GroupBy group_by);
+    const std::optional<GroupBy>& get_group_by() const noexcept
+    {
+        return m_group_by;
+    }
+
     // Deletion
     size_t remove() const;
 
-#if REALM_MULTITHREAD_QUERY
     // Multi-threading
-    TableView find_all_multi(size_t start = 0, size_t end = size_t(-1));
-    TableView find_all_multi(size_t start = 0, size_t end = size_t(-1)) const;
-    int set_threads(unsigned int threadcount);
-#endif
+
+    /// Evaluate the conditions of this query on up to `threadcount` threads
+    /// when searching a large table without a usable search index. This
+    /// applies to find_all() and count() without a limit, and to sum(),
+    /// min(), max() and avg(). The results are the same as when running on a
+    /// single thread, except that sums and averages of floating point values
+    /// may differ in the last digits, as every thread adds up its own part of
+    /// the values. The threads are taken from a pool kept by the process,
+    /// which grows to the largest number of threads asked for. A value of 0 or
+    /// 1 disables multi-threading.
+    void set_threads(unsigned int threadcount);
+    /// Same as find_all(), using the number of threads given to
+    /// set_threads(), or one thread per CPU core if no number has been set.
+    TableView find_all_multi() const;
 
     const ConstTableRef& get_table() const noexcept
     {
@@ -318,6 +413,29 @@ public:
 
     std::string validate() const;
 
+    // Profiling
+
+    /// Describe how the query will be evaluated without running it.
+    QueryProfile explain() const;
+    /// Run the query as find_all() does, applying its ordering if any, and
+    /// report the statistics collected for each condition and the time spent.
+    /// The query is run on a single thread regardless of set_threads().
+    QueryProfile profile() const;
+
+    // Report requested by EXPLAIN (explain()) or EXPLAIN ANALYZE (profile()) at the end of a
+    // query in the query language
+    enum class Explain { None, Plan, Analyze };
+    QueryProfile explain_requested() const;
+    Query& set_explain(Explain explain) noexcept
+    {
+        m_explain = explain;
+        return *this;
+    }
+    Explain get_explain() const noexcept
+    {
+        return m_explain;
+    }
+
     std::string get_description() const;
     std::string get_description_safe() const noexcept;
 
@@ -331,6 +449,7 @@ private:
     void create();
 
     void init() const;
+    QueryProfile make_profile(bool has_run) const;
     size_t find_internal(size_t start = 0, size_t end = size_t(-1)) const;
     void handle_pending_not();
     void set_table(TableRef tr);
@@ -364,8 +483,12 @@ private:
     void aggregate_internal(ParentNode* pn, QueryStateBase* st, size_t start, size_t end,
                             ArrayPayload* source_column) const;
 
-    void do_find_all(QueryStateBase& st) const;
+    void do_find_all(QueryStateBase& st, ColKey payload_col = {}) const;
     size_t do_count(size_t limit = size_t(-1)) const;
+    bool use_threads() const;
+    std::vector<std::unique_ptr<Query>> clone_for_threads() const;
+    void do_find_on_threads(QueryStateBase& st, ColKey payload_col = {}) const;
+    size_t do_count_on_threads() const;
     void delete_nodes() noexcept;
 
     ParentNode* root_node() const
@@ -404,6 +527,11 @@ private:
     TableView* m_source_table_view = nullptr;      // table views are not refcounted, and not owned by the query.
     std::unique_ptr<TableView> m_owned_source_table_view; // <--- except when indicated here
     util::bind_ptr<DescriptorOrdering> m_ordering;
+    std::optional<GroupBy> m_group_by;
+    Explain m_explain = Explain::None;
+    unsigned int m_threads = 0;
+    // Tables smaller than this are always searched on a single thread
+    static constexpr size_t min_size_for_threads = 10000;
 };
 
 // Implementation:
@@ -35,10 +35,10 @@ public:
     using QueryStateBase::QueryStateBase;
     bool match(size_t index, Mixed value) noexcept final
     {
-        if (m_source_column) {
-            REALM_ASSERT_DEBUG(value.is_null());
+        // The value passed by the finder belongs to the condition column, which
+        // is not necessarily the column being aggregated
+        if (m_source_column)
             value = m_source_column->get_any(index);
-        }
         if (!value.is_null()) {
             auto v = value.get<T>();
             if (!m_state.accumulate(v))
@@ -59,6 +59,16 @@ public:
         }
         return (m_limit > m_match_count);
     }
+    std::unique_ptr<QueryStateBase> make_partial() const final
+    {
+        return std::make_unique<QueryStateSum>();
+    }
+    void merge_partial(QueryStateBase& other) final
+    {
+        auto& partial = static_cast<QueryStateSum&>(other);
+        m_state.merge(partial.m_state);
+        m_match_count += partial.m_match_count;
+    }
     ResultType result_sum() const
     {
         return m_state.result();
@@ -78,10 +88,10 @@ public:
     using QueryStateBase::QueryStateBase;
     bool match(size_t index, Mixed value) noexcept final
     {
-        if (m_source_column) {
-            REALM_ASSERT_DEBUG(value.is_null());
+        // The value passed by the finder belongs to the condition column, which
+        // is not necessarily the column being aggregated
+        if (m_source_column)
             value = m_source_column->get_any(index);
-        }
         if (!value.is_null()) {
             auto v = value.get<R>();
             if (!m_state.accumulate(v)) {
@@ -106,6 +116,24 @@ public:
         }
         return m_limit > m_match_count;
     }
+    std::unique_ptr<QueryStateBase> make_partial() const final
+    {
+        return std::make_unique<QueryStateMinMax>();
+    }
+    void merge_partial(QueryStateBase& other) final
+    {
+        auto& partial = static_cast<QueryStateMinMax&>(other);
+        if (partial.m_state.is_null())
+            return;
+        auto value = partial.m_state.result();
+        // Of several objects with the same value, the one with the lowest key is
+        // reported, as it is the one found first when running on a single thread
+        if (m_state.accumulate(value) ||
+            (partial.m_minmax_key < m_minmax_key && Mixed(value) == Mixed(m_state.result()))) {
+            m_minmax_key = partial.m_minmax_key;
+        }
+        m_match_count += partial.m_match_count;
+    }
     Mixed get_result() const
     {
         return m_state.is_null() ? Mixed() : m_state.result();
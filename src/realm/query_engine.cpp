@@ -19,6 +19,8 @@
 #include <realm/query_engine.hpp>
 
 #include <realm/query_expression.hpp>
+#include <realm/index_composite.hpp>
+#include <realm/index_fulltext.hpp>
 #include <realm/index_string.hpp>
 #include <realm/db.hpp>
 #include <realm/utilities.hpp>
@@ -32,19 +34,141 @@ ParentNode::ParentNode(const ParentNode& from)
     , m_dT(from.m_dT)
     , m_probes(from.m_probes)
     , m_matches(from.m_matches)
+    , m_profiling(from.m_profiling)
     , m_table(from.m_table)
 {
 }
 
+void ParentNode::init_semi_joins(bool allowed)
+{
+    ParentNode* driver = nullptr;
+    for (auto child : m_children) {
+        if (child->has_pending_semi_join()) {
+            if (!driver)
+                driver = child;
+        }
+        else if (child->m_dT == 0) {
+            allowed = false;
+        }
+    }
+    for (auto child : m_children) {
+        if (child->has_pending_semi_join())
+            child->finish_semi_join(allowed && child == driver);
+    }
+}
+
+void ParentNode::init_composite_index()
+{
+    using Type = IndexCondition::Type;
+    using Bound = CompositeIndex::Bound;
+
+    m_composite_index_node.reset();
+    const Table* table = m_table.unchecked_ptr();
+    if (table->m_composite_indexes.empty())
+        return;
+
+    std::vector<std::pair<IndexCondition, const ParentNode*>> conditions;
+    for (auto child : m_children) {
+        IndexCondition cond;
+        if (child->get_index_condition(cond))
+            conditions.emplace_back(cond, child);
+    }
+    if (conditions.empty())
+        return;
+
+    // Find the index covering the most conditions: a prefix of its columns compared for
+    // equality, optionally followed by a column with a range condition.
+    const CompositeIndex* best_index = nullptr;
+    size_t best_score = 0;
+    std::vector<Mixed> best_prefix;
+    std::optional<Bound> best_lower;
+    std::optional<Bound> best_upper;
+    for (auto& index : table->m_composite_indexes) {
+        std::vector<Mixed> prefix;
+        std::optional<Bound> lower;
+        std::optional<Bound> upper;
+        const ParentNode* first_node = nullptr;
+        for (auto col_key : index->get_column_keys()) {
+            auto equal = std::find_if(conditions.begin(), conditions.end(), [&](auto& c) {
+                return c.first.col_key == col_key && c.first.type == Type::Equal;
+            });
+            if (equal != conditions.end()) {
+                prefix.push_back(equal->first.value);
+                if (!first_node)
+                    first_node = equal->second;
+                continue;
+            }
+            for (auto& [cond, node] : conditions) {
+                // Null is not greater or less than any value
+                if (cond.col_key != col_key || cond.value.is_null())
+                    continue;
+                bool inclusive = cond.type == Type::GreaterEqual || cond.type == Type::LessEqual;
+                if (cond.type == Type::Greater || cond.type == Type::GreaterEqual) {
+                    int cmp = lower ? cond.value.compare(lower->value) : 1;
+                    if (cmp > 0 || (cmp == 0 && !inclusive))
+                        lower = Bound{cond.value, inclusive};
+                }
+                else {
+                    int cmp = upper ? cond.value.compare(upper->value) : -1;
+                    if (cmp < 0 || (cmp == 0 && !inclusive))
+                        upper = Bound{cond.value, inclusive};
+                }
+                if (!first_node)
+                    first_node = node;
+            }
+            break;
+        }
+
+        size_t score = prefix.size() + ((lower || upper) ? 1 : 0);
+        // A single condition is better served by its own index, if any
+        if (score == 0 || (score == 1 && first_node->has_search_index()))
+            continue;
+        if (score > best_score) {
+            best_index = index.get();
+            best_score = score;
+            best_prefix = std::move(prefix);
+            best_lower = std::move(lower);
+            best_upper = std::move(upper);
+        }
+    }
+    if (!best_index)
+        return;
+
+    std::vector<ObjKey> keys;
+    best_index->find(best_prefix, best_lower, best_upper, keys);
+    // Visiting the objects in key order is slower than a linear scan if many of them match
+    constexpr size_t max_selectivity = 8;
+    if (keys.size() * max_selectivity > table->size())
+        return;
+
+    std::sort(keys.begin(), keys.end());
+    m_composite_index_node = std::make_unique<CompositeIndexNode>(std::move(keys), best_index->get_column_keys());
+    m_composite_index_node->set_table(m_table);
+    m_composite_index_node->m_profiling = m_profiling;
+    m_children.push_back(m_composite_index_node.get());
+}
+
 
 size_t ParentNode::find_first(size_t start, size_t end)
+{
+    return m_profiling ? do_find_first<true>(start, end) : do_find_first<false>(start, end);
+}
+
+template <bool profiling>
+size_t ParentNode::do_find_first(size_t start, size_t end)
 {
     size_t sz = m_children.size();
     size_t current_cond = 0;
     size_t nb_cond_to_test = sz;
 
     while (REALM_LIKELY(start < end)) {
-        size_t m = m_children[current_cond]->find_first_local(start, end);
+        ParentNode* child = m_children[current_cond];
+        size_t m = child->find_first_local(start, end);
+        if constexpr (profiling) {
+            ++child->m_probes;
+            if (m != not_found)
+                ++child->m_matches;
+        }
 
         if (m != start) {
             // Pointer advanced - we will have to check all other conditions
@@ -87,6 +211,14 @@ bool ParentNode::match(const Obj& obj)
 
 size_t ParentNode::aggregate_local(QueryStateBase* st, size_t start, size_t end, size_t local_limit,
                                    ArrayPayload* source_column)
+{
+    return m_profiling ? do_aggregate_local<true>(st, start, end, local_limit, source_column)
+                       : do_aggregate_local<false>(st, start, end, local_limit, source_column);
+}
+
+template <bool profiling>
+size_t ParentNode::do_aggregate_local(QueryStateBase* st, size_t start, size_t end, size_t local_limit,
+                                      ArrayPayload* source_column)
 {
     // aggregate called on non-integer column type. Speed of this function is not as critical as speed of the
     // integer version, because find_first_local() is relatively slower here (because it's non-integers).
@@ -101,6 +233,13 @@ size_t ParentNode::aggregate_local(QueryStateBase* st, size_t start, size_t end,
     size_t local_matches = 0;
 
     if (m_children.size() == 1) {
+        if constexpr (profiling) {
+            size_t matches_before = st->match_count();
+            size_t ret = find_all_local(start, end);
+            ++m_probes;
+            m_matches += st->match_count() - matches_before;
+            return ret;
+        }
         return find_all_local(start, end);
     }
 
@@ -114,21 +253,30 @@ size_t ParentNode::aggregate_local(QueryStateBase* st, size_t start, size_t end,
         // Find first match in this condition node
         auto pos = r + 1;
         r = find_first_local(pos, end);
+        if constexpr (profiling)
+            ++m_probes;
         if (r == not_found) {
             m_dD = double(pos - start) / (local_matches + 1.1);
             return end;
         }
 
         local_matches++;
+        if constexpr (profiling)
+            ++m_matches;
 
         // Find first match in remaining condition nodes
         size_t m = r;
 
         for (size_t c = 1; c < m_children.size(); c++) {
-            m = m_children[c]->find_first_local(r, r + 1);
+            ParentNode* child = m_children[c];
+            m = child->find_first_local(r, r + 1);
+            if constexpr (profiling)
+                ++child->m_probes;
             if (m != r) {
                 break;
             }
+            if constexpr (profiling)
+                ++child->m_matches;
         }
 
         // If index of first match in this node equals index of first match in all remaining nodes, we have a final
@@ -413,6 +561,13 @@ bool StringNode<Equal>::do_consume_condition(ParentNode& node)
 size_t StringNode<Equal>::_find_first_local(size_t start, size_t end)
 {
     if (m_needles.empty()) {
+        if (m_leaf->is_enum()) {
+            if (!m_enum_key)
+                m_enum_key = m_leaf->find_key(m_string_value);
+            if (*m_enum_key == not_found)
+                return not_found;
+            return m_leaf->find_first_key(*m_enum_key, start, end);
+        }
         return m_leaf->find_first(m_string_value, start, end);
     }
     else {
@@ -486,10 +641,16 @@ StringNodeFulltext::StringNodeFulltext(const StringNodeFulltext& other)
 
 void StringNodeFulltext::_search_index_init()
 {
-    StringIndex* index = m_link_map->get_target_table()->get_string_index(ParentNode::m_condition_column_key);
-    REALM_ASSERT(index && index->is_fulltext_index());
+    SearchIndex* index = m_link_map->get_target_table()->get_search_index(ParentNode::m_condition_column_key);
     m_index_matches.clear();
-    index->find_all_fulltext(m_index_matches, StringNodeBase::m_string_value);
+    if (auto fulltext_index = dynamic_cast<FulltextIndex*>(index)) {
+        fulltext_index->find_all_fulltext(m_index_matches, StringNodeBase::m_string_value);
+    }
+    else {
+        auto string_index = dynamic_cast<StringIndex*>(index);
+        REALM_ASSERT(string_index && string_index->is_fulltext_index());
+        string_index->find_all_fulltext(m_index_matches, StringNodeBase::m_string_value);
+    }
 
     // If links exists, use backlinks to find the original objects
     if (m_link_map->links_exist()) {
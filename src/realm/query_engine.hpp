@@ -85,6 +85,7 @@ TConditionValue:    Type of values in condition column. That is, int64_t, float,
 #include <realm/array_timestamp.hpp>
 #include <realm/column_integer.hpp>
 #include <realm/column_type_traits.hpp>
+#include <realm/index_ordered.hpp>
 #include <realm/index_string.hpp>
 #include <realm/query_conditions.hpp>
 #include <realm/query_expression.hpp>
@@ -104,6 +105,35 @@ namespace realm {
 
 class IndexEvaluator;
 
+// A comparison of a column with a constant value. Nodes describe their condition this way
+// so that conditions on several columns can be answered by a composite index.
+struct IndexCondition {
+    enum class Type { Equal, Greater, GreaterEqual, Less, LessEqual };
+
+    ColKey col_key;
+    Type type;
+    Mixed value;
+};
+
+template <class Cond>
+bool make_index_condition(ColKey col_key, Mixed value, IndexCondition& cond)
+{
+    using Type = IndexCondition::Type;
+    if constexpr (std::is_same_v<Cond, Equal>)
+        cond = {col_key, Type::Equal, value};
+    else if constexpr (std::is_same_v<Cond, Greater>)
+        cond = {col_key, Type::Greater, value};
+    else if constexpr (std::is_same_v<Cond, GreaterEqual>)
+        cond = {col_key, Type::GreaterEqual, value};
+    else if constexpr (std::is_same_v<Cond, Less>)
+        cond = {col_key, Type::Less, value};
+    else if constexpr (std::is_same_v<Cond, LessEqual>)
+        cond = {col_key, Type::LessEqual, value};
+    else
+        return false;
+    return true;
+}
+
 class ParentNode {
     typedef ParentNode ThisType;
 
@@ -115,10 +145,23 @@ public:
     {
         return false;
     }
+    // A condition which can find its matches up front by searching another table, see
+    // init_semi_joins()
+    virtual bool has_pending_semi_join() const
+    {
+        return false;
+    }
+    virtual void finish_semi_join(bool) {}
+
     virtual const IndexEvaluator* index_based_keys()
     {
         return nullptr;
     }
+    // Describe the condition of this node as a comparison with a constant, if possible
+    virtual bool get_index_condition(IndexCondition&) const
+    {
+        return false;
+    }
 
     void gather_children(std::vector<ParentNode*>& v)
     {
@@ -148,6 +191,10 @@ public:
     virtual void init(bool will_query_ranges)
     {
         m_dD = 100.0;
+        m_probes = 0;
+        m_matches = 0;
+        m_clusters_visited = 0;
+        m_clusters_skipped = 0;
 
         if (m_child)
             m_child->init(will_query_ranges);
@@ -174,8 +221,11 @@ public:
     void set_cluster(const Cluster* cluster)
     {
         m_cluster = cluster;
+        ++m_clusters_visited;
         if (m_child)
             m_child->set_cluster(cluster);
+        if (m_composite_index_node)
+            m_composite_index_node->set_cluster(cluster);
         cluster_changed();
     }
 
@@ -189,11 +239,31 @@ public:
     virtual size_t aggregate_local(QueryStateBase* st, size_t start, size_t end, size_t local_limit,
                                    ArrayPayload* source_column);
 
+    // Set on every node of the query by Query::profile()
+    void set_profiling(bool profiling)
+    {
+        m_profiling = profiling;
+        if (m_child)
+            m_child->set_profiling(profiling);
+        if (m_composite_index_node)
+            m_composite_index_node->set_profiling(profiling);
+    }
+
     virtual std::string validate()
     {
         return m_child ? m_child->validate() : "";
     }
 
+    // Decide which of the conditions in m_children search another table up front to find their
+    // matches. This only pays off for the condition driving the search, so it is done for the
+    // first of them, and only if no other condition is answered by a search index.
+    void init_semi_joins(bool allowed);
+
+    // If a composite index of the table covers some of the conditions in m_children, look up the
+    // matching objects and add a node yielding them to m_children. The conditions are kept, so the
+    // index only has to narrow down the candidates. Must be called after gather_children().
+    void init_composite_index();
+
     ParentNode(const ParentNode& from);
 
     void add_child(std::unique_ptr<ParentNode> child)
@@ -253,14 +323,30 @@ public:
 
     std::unique_ptr<ParentNode> m_child;
     std::vector<ParentNode*> m_children;
+    // Candidates found through a composite index, owned by the root node. See init_composite_index().
+    std::unique_ptr<ParentNode> m_composite_index_node;
     mutable ColKey m_condition_column_key = ColKey(); // Column of search criteria
 
     double m_dD;       // Average row distance between each local match at current position
     double m_dT = 1.0; // Time overhead of testing index i + 1 if we have just tested index i. > 1 for linear scans, 0
     // for index/tableview
 
+    // Statistics of the current run, reported by Query::profile(). A probe is a search for
+    // the first match of the condition in a range of objects.
     size_t m_probes = 0;
     size_t m_matches = 0;
+    // Only count probes and matches when profiling, to keep the search loops tight
+    bool m_profiling = false;
+    size_t m_clusters_visited = 0;
+    // Clusters passed over without reading the values, as none of them can match
+    size_t m_clusters_skipped = 0;
+
+private:
+    template <bool profiling>
+    size_t do_find_first(size_t start, size_t end);
+    template <bool profiling>
+    size_t do_aggregate_local(QueryStateBase* st, size_t start, size_t end, size_t local_limit,
+                              ArrayPayload* source_column);
 
 protected:
     ConstTableRef m_table = ConstTableRef();
@@ -272,6 +358,45 @@ protected:
         return m_table.unchecked_ptr()->get_real_column_type(key);
     }
 
+    // Check if the current cluster may hold a value of the condition column
+    // matching the range condition `Cond` with `value`, according to the
+    // smallest and largest value of the column in the cluster. This allows
+    // whole clusters to be skipped. Other conditions are not checked.
+    template <class Cond>
+    bool leaf_may_match(Mixed value) const
+    {
+        constexpr bool is_range_condition = std::is_same_v<Cond, Greater> || std::is_same_v<Cond, GreaterEqual> ||
+                                            std::is_same_v<Cond, Less> || std::is_same_v<Cond, LessEqual>;
+        if constexpr (is_range_condition) {
+            Mixed min, max;
+            if (value.is_null() || !m_cluster->get_value_range(m_condition_column_key, min, max))
+                return true;
+            if (value.is_type(type_Float, type_Double)) {
+                double v = value.is_type(type_Float) ? double(value.get_float()) : value.get_double();
+                if (std::isnan(v))
+                    return true;
+                value = v;
+            }
+            else if (value.is_type(type_Timestamp)) {
+                // Only the seconds are ranged, so values with the same seconds may match
+                value = value.get_timestamp().get_seconds();
+                if constexpr (std::is_same_v<Cond, Greater> || std::is_same_v<Cond, GreaterEqual>)
+                    return max >= value;
+                else
+                    return min <= value;
+            }
+            if constexpr (std::is_same_v<Cond, Greater>)
+                return max > value;
+            else if constexpr (std::is_same_v<Cond, GreaterEqual>)
+                return max >= value;
+            else if constexpr (std::is_same_v<Cond, Less>)
+                return min < value;
+            else
+                return min <= value;
+        }
+        return true;
+    }
+
 private:
     virtual void table_changed()
     {
@@ -346,6 +471,104 @@ private:
     std::vector<ObjKey>* m_matching_keys = nullptr;
 };
 
+// Collect the keys of the objects satisfying a range condition using an ordered index. The keys are
+// sorted as required by IndexEvaluator. Returns false if the condition is expected to match so large a
+// part of the table that a linear scan will be faster than visiting the objects in key order.
+template <class Cond>
+bool find_range_in_ordered_index(const OrderedIndex& index, Mixed value, std::vector<ObjKey>& keys)
+{
+    static_assert(realm::is_any_v<Cond, Greater, GreaterEqual, Less, LessEqual>);
+
+    // Null is ordered first and is not greater or less than any other value
+    size_t nulls_end = index.upper_bound(Mixed());
+    size_t begin = nulls_end;
+    size_t end = nulls_end;
+    if (value.is_null()) {
+        if constexpr (realm::is_any_v<Cond, GreaterEqual, LessEqual>)
+            begin = 0;
+    }
+    else if constexpr (std::is_same_v<Cond, Greater>) {
+        begin = index.upper_bound(value);
+        end = index.size();
+    }
+    else if constexpr (std::is_same_v<Cond, GreaterEqual>) {
+        begin = index.lower_bound(value);
+        end = index.size();
+    }
+    else if constexpr (std::is_same_v<Cond, Less>) {
+        end = index.lower_bound(value);
+    }
+    else {
+        end = index.upper_bound(value);
+    }
+
+    constexpr size_t max_selectivity = 8; // use the index when at most 1/8 of the objects match
+    if ((end - begin) * max_selectivity > index.size())
+        return false;
+
+    keys.clear();
+    index.get_keys(begin, end, keys);
+    std::sort(keys.begin(), keys.end());
+    return true;
+}
+
+// Yields the objects found through a composite index. Created by ParentNode::init_composite_index()
+// and only used as the search index node of a query, so it never matches on its own.
+class CompositeIndexNode : public ParentNode {
+public:
+    CompositeIndexNode(std::vector<ObjKey>&& keys, const std::vector<ColKey>& col_keys)
+        : m_keys(std::move(keys))
+        , m_col_keys(col_keys)
+    {
+        m_index_evaluator.init(&m_keys);
+        // Rank above nodes using a single-column index, as the keys satisfy several conditions
+        m_dD = 1000.0;
+        m_dT = 0;
+    }
+
+    CompositeIndexNode(const CompositeIndexNode& from)
+        : ParentNode(from)
+        , m_keys(from.m_keys)
+        , m_col_keys(from.m_col_keys)
+    {
+        m_index_evaluator.init(&m_keys);
+    }
+
+    bool has_search_index() const override
+    {
+        return true;
+    }
+
+    const IndexEvaluator* index_based_keys() override
+    {
+        return &m_index_evaluator;
+    }
+
+    size_t find_first_local(size_t start, size_t end) override
+    {
+        return m_index_evaluator.do_search_index(m_cluster, start, end);
+    }
+
+    std::string describe(util::serializer::SerialisationState& state) const override
+    {
+        std::string columns;
+        for (auto col_key : m_col_keys) {
+            columns += (columns.empty() ? "" : ", ") + state.describe_column(m_table, col_key);
+        }
+        return "composite index (" + columns + ")";
+    }
+
+    std::unique_ptr<ParentNode> clone() const override
+    {
+        return std::unique_ptr<ParentNode>(new CompositeIndexNode(*this));
+    }
+
+private:
+    std::vector<ObjKey> m_keys;
+    std::vector<ColKey> m_col_keys;
+    IndexEvaluator m_index_evaluator;
+};
+
 template <class LeafType>
 class IntegerNodeBase : public ColumnNodeBase {
 public:
@@ -415,13 +638,61 @@ public:
     {
     }
 
+    void init(bool will_query_ranges) override
+    {
+        BaseType::init(will_query_ranges);
+
+        m_index_evaluator.reset();
+        if constexpr (realm::is_any_v<TConditionFunction, Greater, GreaterEqual, Less, LessEqual>) {
+            ColKey col_key = this->m_condition_column_key;
+            // Evaluating single objects through the index would be slower than reading the values
+            if (will_query_ranges && this->m_table->search_index_type(col_key) == IndexType::Ordered) {
+                auto index = static_cast<const OrderedIndex*>(this->m_table->get_search_index(col_key));
+                if (find_range_in_ordered_index<TConditionFunction>(*index, this->m_value, m_index_matches)) {
+                    m_index_evaluator = IndexEvaluator();
+                    m_index_evaluator->init(&m_index_matches);
+                    this->m_dT = 0;
+                }
+            }
+        }
+    }
+
+    bool has_search_index() const override
+    {
+        return bool(m_index_evaluator);
+    }
+
+    const IndexEvaluator* index_based_keys() override
+    {
+        return m_index_evaluator ? &(*m_index_evaluator) : nullptr;
+    }
+
+    bool get_index_condition(IndexCondition& cond) const override
+    {
+        return make_index_condition<TConditionFunction>(this->m_condition_column_key, Mixed(this->m_value), cond);
+    }
+
+    void cluster_changed() override
+    {
+        BaseType::cluster_changed();
+        m_leaf_may_match = this->template leaf_may_match<TConditionFunction>(this->m_value);
+        if (!m_leaf_may_match)
+            ++this->m_clusters_skipped;
+    }
+
     size_t find_first_local(size_t start, size_t end) override
     {
+        if (m_index_evaluator)
+            return m_index_evaluator->do_search_index(this->m_cluster, start, end);
+        if (!m_leaf_may_match)
+            return not_found;
         return this->m_leaf->template find_first<TConditionFunction>(this->m_value, start, end);
     }
 
     size_t find_all_local(size_t start, size_t end) override
     {
+        if (!m_leaf_may_match)
+            return end;
         return BaseType::template find_all_local<TConditionFunction>(start, end);
     }
 
@@ -434,6 +705,11 @@ public:
     {
         return std::unique_ptr<ParentNode>(new ThisType(*this));
     }
+
+private:
+    bool m_leaf_may_match = true;
+    std::optional<IndexEvaluator> m_index_evaluator;
+    std::vector<ObjKey> m_index_matches;
 };
 
 template <size_t linear_search_threshold, class LeafType, class NeedleContainer>
@@ -497,8 +773,8 @@ public:
 
     bool has_search_index() const override
     {
-        return this->m_table->search_index_type(IntegerNodeBase<LeafType>::m_condition_column_key) ==
-               IndexType::General;
+        auto index_type = this->m_table->search_index_type(IntegerNodeBase<LeafType>::m_condition_column_key);
+        return index_type == IndexType::General || index_type == IndexType::Ordered || index_type == IndexType::Hash;
     }
 
     const IndexEvaluator* index_based_keys() override
@@ -506,6 +782,13 @@ public:
         return m_index_evaluator ? &(*m_index_evaluator) : nullptr;
     }
 
+    bool get_index_condition(IndexCondition& cond) const override
+    {
+        if (!m_needles.empty())
+            return false;
+        return make_index_condition<Equal>(this->m_condition_column_key, Mixed(this->m_value), cond);
+    }
+
     size_t find_first_local(size_t start, size_t end) override
     {
         REALM_ASSERT(this->m_table);
@@ -599,10 +882,16 @@ public:
     {
         m_leaf.emplace(m_table.unchecked_ptr()->get_alloc());
         m_cluster->init_leaf(this->m_condition_column_key, &*m_leaf);
+        m_leaf_may_match = leaf_may_match<TConditionFunction>(m_value);
+        if (!m_leaf_may_match)
+            ++m_clusters_skipped;
     }
 
     size_t find_first_local(size_t start, size_t end) override
     {
+        if (!m_leaf_may_match)
+            return not_found;
+
         TConditionFunction cond;
 
         auto find = [&](bool nullability) {
@@ -648,6 +937,7 @@ public:
 protected:
     TConditionValue m_value;
     std::optional<LeafType> m_leaf;
+    bool m_leaf_may_match = true;
 };
 
 template <class T, class TConditionFunction>
@@ -868,6 +1158,11 @@ public:
         return bool(m_index_evaluator);
     }
 
+    bool get_index_condition(IndexCondition& cond) const override
+    {
+        return make_index_condition<TConditionFunction>(m_condition_column_key, Mixed(m_value), cond);
+    }
+
     void cluster_changed() override
     {
         m_leaf.emplace(m_table.unchecked_ptr()->get_alloc());
@@ -948,6 +1243,19 @@ class TimestampNode : public TimestampNodeBase {
 public:
     using TimestampNodeBase::TimestampNodeBase;
 
+    TimestampNode(const TimestampNode& from)
+        : TimestampNodeBase(from)
+        , m_index_evaluator(from.m_index_evaluator)
+        , m_index_matches(from.m_index_matches)
+        , m_leaf_may_match(from.m_leaf_may_match)
+    {
+        // Range lookups refer to the matches owned by the node
+        if constexpr (!std::is_same_v<TConditionFunction, Equal>) {
+            if (m_index_evaluator)
+                m_index_evaluator->init(&m_index_matches);
+        }
+    }
+
     void init(bool will_query_ranges) override
     {
         TimestampNodeBase::init(will_query_ranges);
@@ -960,13 +1268,24 @@ public:
                 this->m_dT = 0;
             }
         }
+        else if constexpr (realm::is_any_v<TConditionFunction, Greater, GreaterEqual, Less, LessEqual>) {
+            m_index_evaluator.reset();
+            if (will_query_ranges && m_table->search_index_type(m_condition_column_key) == IndexType::Ordered) {
+                auto index = static_cast<const OrderedIndex*>(m_table->get_search_index(m_condition_column_key));
+                if (find_range_in_ordered_index<TConditionFunction>(*index, m_value, m_index_matches)) {
+                    m_index_evaluator = IndexEvaluator();
+                    m_index_evaluator->init(&m_index_matches);
+                    this->m_dT = 0;
+                }
+            }
+        }
     }
 
     void table_changed() override
     {
         if constexpr (std::is_same_v<TConditionFunction, Equal>) {
-            const bool has_index =
-                this->m_table->search_index_type(TimestampNodeBase::m_condition_column_key) == IndexType::General;
+            auto index_type = this->m_table->search_index_type(TimestampNodeBase::m_condition_column_key);
+            const bool has_index = index_type == IndexType::General || index_type == IndexType::Ordered;
             m_index_evaluator = has_index ? std::make_optional(IndexEvaluator{}) : std::nullopt;
         }
     }
@@ -981,13 +1300,26 @@ public:
         return bool(m_index_evaluator);
     }
 
+    bool get_index_condition(IndexCondition& cond) const override
+    {
+        return make_index_condition<TConditionFunction>(m_condition_column_key, Mixed(m_value), cond);
+    }
+
+    void cluster_changed() override
+    {
+        TimestampNodeBase::cluster_changed();
+        m_leaf_may_match = leaf_may_match<TConditionFunction>(m_value);
+        if (!m_leaf_may_match)
+            ++m_clusters_skipped;
+    }
+
     size_t find_first_local(size_t start, size_t end) override
     {
-        if constexpr (std::is_same_v<TConditionFunction, Equal>) {
-            if (m_index_evaluator) {
-                return m_index_evaluator->do_search_index(this->m_cluster, start, end);
-            }
+        if (m_index_evaluator) {
+            return m_index_evaluator->do_search_index(this->m_cluster, start, end);
         }
+        if (!m_leaf_may_match)
+            return not_found;
         return m_leaf->find_first<TConditionFunction>(m_value, start, end);
     }
 
@@ -1005,6 +1337,8 @@ public:
 
 protected:
     std::optional<IndexEvaluator> m_index_evaluator;
+    std::vector<ObjKey> m_index_matches;
+    bool m_leaf_may_match = true;
 };
 
 class DecimalNodeBase : public ParentNode {
@@ -1181,8 +1515,8 @@ public:
 
     void table_changed() override
     {
-        const bool has_index =
-            this->m_table->search_index_type(BaseType::m_condition_column_key) == IndexType::General;
+        auto index_type = this->m_table->search_index_type(BaseType::m_condition_column_key);
+        const bool has_index = index_type == IndexType::General || index_type == IndexType::Hash;
         m_index_evaluator = has_index ? std::make_optional(IndexEvaluator{}) : std::nullopt;
     }
 
@@ -1196,6 +1530,12 @@ public:
         return bool(m_index_evaluator);
     }
 
+    bool get_index_condition(IndexCondition& cond) const override
+    {
+        Mixed value = this->m_value_is_null ? Mixed() : Mixed(this->m_value);
+        return make_index_condition<Equal>(this->m_condition_column_key, value, cond);
+    }
+
     size_t find_first_local(size_t start, size_t end) override
     {
         REALM_ASSERT(this->m_table);
@@ -1834,8 +2174,31 @@ public:
 
     void _search_index_init() override;
 
+    void table_changed() override
+    {
+        StringNodeEqualBase::table_changed();
+        // The hash index of a primary key can only answer exact matches, so unlike the
+        // general index it is not used for EqualIns
+        if (m_table.unchecked_ptr()->search_index_type(m_condition_column_key) == IndexType::Hash)
+            m_index_evaluator = IndexEvaluator{};
+    }
+
+    void init(bool will_query_ranges) override
+    {
+        StringNodeEqualBase::init(will_query_ranges);
+        // New values may have been added to the keys since the last run
+        m_enum_key.reset();
+    }
+
     bool do_consume_condition(ParentNode& other) override;
 
+    bool get_index_condition(IndexCondition& cond) const override
+    {
+        if (!m_needles.empty())
+            return false;
+        return make_index_condition<Equal>(m_condition_column_key, Mixed(m_string_value), cond);
+    }
+
     std::unique_ptr<ParentNode> clone() const override
     {
         return std::unique_ptr<ParentNode>(new StringNode<Equal>(*this));
@@ -1862,6 +2225,9 @@ private:
     size_t _find_first_local(size_t start, size_t end) override;
     std::unordered_set<StringData> m_needles;
     std::vector<std::unique_ptr<char[]>> m_needle_storage;
+    // Index of the search value in the keys of an enumerated column. The keys
+    // are shared by all leaves, so the lookup is only done once per run.
+    std::optional<size_t> m_enum_key;
 };
 
 
@@ -2311,6 +2677,16 @@ public:
     void init(bool) override;
     size_t find_first_local(size_t start, size_t end) override;
 
+    bool has_pending_semi_join() const override
+    {
+        return m_expression->has_pending_semi_join();
+    }
+    void finish_semi_join(bool use) override
+    {
+        if (m_expression->finish_semi_join(use))
+            m_dT = 0;
+    }
+
     void table_changed() override;
     void cluster_changed() override;
     void collect_dependencies(std::vector<TableKey>&) const override;
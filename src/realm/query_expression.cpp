@@ -19,6 +19,10 @@
 #include <realm/query_expression.hpp>
 #include <realm/group.hpp>
 #include <realm/dictionary.hpp>
+#include <realm/table_view.hpp>
+#if REALM_ENABLE_GEOSPATIAL
+#include <realm/index_geospatial.hpp>
+#endif
 
 namespace realm {
 
@@ -58,6 +62,20 @@ void LinkMap::collect_dependencies(std::vector<TableKey>& tables) const
     }
 }
 
+void LinkMap::collect_origin_dependencies(std::vector<TableKey>& tables) const
+{
+    if (m_tables.empty())
+        return;
+    ConstTableRef target = m_tables.back();
+    target->for_each_backlink_column([&](ColKey col_key) {
+        TableKey k = target->get_opposite_table_key(col_key);
+        if (find(tables.begin(), tables.end(), k) == tables.end()) {
+            tables.push_back(k);
+        }
+        return IteratorControl::AdvanceToNext;
+    });
+}
+
 std::string LinkMap::description(util::serializer::SerialisationState& state) const
 {
     std::string s;
@@ -231,6 +249,8 @@ std::vector<ObjKey> LinkMap::get_origin_objkeys(ObjKey key, size_t column) const
     auto origin_col = m_link_column_keys[column];
     auto origin = m_tables[column];
     auto link_type = m_link_types[column];
+    // The links can't be followed backwards if the column has been removed
+    origin->check_column(origin_col);
     if (link_type == col_type_BackLink) {
         auto link_table = origin->get_opposite_table(origin_col);
         ColKey link_col_key = origin->get_opposite_column(origin_col);
@@ -263,6 +283,676 @@ std::vector<ObjKey> LinkMap::get_origin_objkeys(ObjKey key, size_t column) const
     return ret;
 }
 
+#if REALM_ENABLE_GEOSPATIAL
+double GeoWithinCompare::init()
+{
+    m_has_index = false;
+    m_has_matches = false;
+    m_within.clear();
+    m_matches.clear();
+
+    auto target = m_link_map.get_target_table();
+    if (target->search_index_type(m_coords_col) != IndexType::Geospatial) {
+        return Expression::init();
+    }
+
+    // The index gives the objects in the cells covering the region, of which only
+    // those actually within the region are kept
+    auto index = static_cast<const GeospatialIndex*>(target->get_search_index(m_coords_col));
+    std::vector<ObjKey> candidates;
+    index->find_candidates(m_region, candidates);
+    for (auto key : candidates) {
+        if (m_region.contains(Geospatial::point_from_obj(target->get_object(key), m_type_col, m_coords_col))) {
+            m_within.push_back(key);
+        }
+    }
+    m_has_index = true;
+
+    if (m_comp_type.value_or(ExpressionComparisonType::Any) != ExpressionComparisonType::Any) {
+        // All links of an object must be checked, but each check is now a lookup
+        return 10.0;
+    }
+
+    for (auto key : m_within) {
+        auto origin_keys = m_link_map.get_origin_objkeys(key);
+        m_matches.insert(m_matches.end(), origin_keys.begin(), origin_keys.end());
+    }
+    std::sort(m_matches.begin(), m_matches.end());
+    m_matches.erase(std::unique(m_matches.begin(), m_matches.end()), m_matches.end());
+    m_has_matches = true;
+    return 0;
+}
+#endif
+
+namespace {
+
+// Whether the values of the column are equal to one of the constant values exactly when
+// they are found in a hash set of the constant values
+bool can_hash_in_list(DataType column_type, const ValueBase& values)
+{
+    switch (column_type) {
+        case type_Int:
+        case type_Bool:
+        case type_String:
+        case type_Binary:
+        case type_Timestamp:
+        case type_ObjectId:
+        case type_UUID:
+        case type_Mixed:
+            break;
+        default:
+            return false;
+    }
+    for (auto& value : values) {
+        if (value.is_null())
+            continue;
+        switch (value.get_type()) {
+            case type_Bool:
+            case type_String:
+            case type_Binary:
+            case type_Timestamp:
+            case type_ObjectId:
+            case type_UUID:
+                break;
+            case type_Int:
+                // A Mixed column may hold an equal value of another numeric type
+                if (column_type != type_Int)
+                    return false;
+                break;
+            default:
+                return false;
+        }
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+std::optional<double> CompareBase::init_in_list()
+{
+    m_has_needles = false;
+    m_needles.clear();
+
+    ValueBase* values;
+    Subexpr* list;
+    Subexpr* column;
+    if (m_right_const_values) {
+        values = m_right_const_values;
+        list = m_right.get();
+        column = m_left.get();
+    }
+    else if (m_left_const_values) {
+        values = m_left_const_values;
+        list = m_left.get();
+        column = m_right.get();
+    }
+    else {
+        return {};
+    }
+    if (!values->m_from_list || values->size() < 2 ||
+        list->get_comparison_type().value_or(ExpressionComparisonType::Any) != ExpressionComparisonType::Any ||
+        column->get_comparison_type().value_or(ExpressionComparisonType::Any) != ExpressionComparisonType::Any) {
+        return {};
+    }
+
+    DataType column_type = column->get_type();
+    bool same_types = std::all_of(values->begin(), values->end(), [&](const QueryValue& value) {
+        return !value.is_null() && value.get_type() == column_type;
+    });
+    if (same_types && column->has_search_index() && !column->has_indexes_in_link_map()) {
+        // Look up the distinct values in order, which visits the index from left to right
+        std::vector<Mixed> distinct(values->begin(), values->end());
+        std::sort(distinct.begin(), distinct.end());
+        distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+        m_matches.clear();
+        for (auto& value : distinct) {
+            auto keys = column->find_all(value);
+            m_matches.insert(m_matches.end(), keys.begin(), keys.end());
+        }
+        std::sort(m_matches.begin(), m_matches.end());
+        m_matches.erase(std::unique(m_matches.begin(), m_matches.end()), m_matches.end());
+
+        m_has_matches = true;
+        m_index_get = 0;
+        m_index_end = m_matches.size();
+        return 0.0;
+    }
+
+    if (values->size() < s_in_list_hash_threshold || !can_hash_in_list(column_type, *values))
+        return {};
+    for (auto& value : *values) {
+        m_needles.insert(value);
+    }
+    m_needle_column = column;
+    m_has_needles = true;
+    return 10.0;
+}
+
+size_t CompareBase::find_first_with_needles(size_t start, size_t end) const
+{
+    ValueBase values;
+    while (start < end) {
+        size_t rows = 1;
+        Subexpr::Index index(start);
+        do {
+            m_needle_column->evaluate(index, values);
+            if (values.m_from_list) {
+                // All the values belong to the object at `start`
+                for (auto& value : values) {
+                    if (m_needles.count(value))
+                        return start;
+                }
+            }
+            else {
+                // One value for each of the following objects
+                rows = std::max(values.size(), size_t(1));
+                for (size_t i = 0; i < values.size() && start + i < end; ++i) {
+                    if (m_needles.count(values[i]))
+                        return start + i;
+                }
+            }
+        } while (index.more());
+        start += rows;
+    }
+    return not_found;
+}
+
+bool CompareBase::init_semi_join(MakeCompare make_compare)
+{
+    bool left_is_const = m_left->has_single_value();
+    if (!left_is_const && !m_right->has_single_value())
+        return false;
+    const Subexpr& value = left_is_const ? *m_left : *m_right;
+    const Subexpr& column = left_is_const ? *m_right : *m_left;
+    auto prop = dynamic_cast<const ObjPropertyBase*>(&column);
+    if (!prop || !prop->links_exist() || prop->has_path() || prop->column_key().is_collection() ||
+        column.has_indexes_in_link_map() || value.get_comparison_type() || value.get_mixed().is_null() ||
+        column.get_comparison_type().value_or(ExpressionComparisonType::Any) != ExpressionComparisonType::Any) {
+        return false;
+    }
+
+    const LinkMap& link_map = prop->get_link_map();
+    ConstTableRef target = link_map.get_target_table();
+    if (target->size() > link_map.get_base_table()->size() * s_semi_join_max_target_ratio)
+        return false;
+
+    auto target_column = column.clone();
+    dynamic_cast<ObjPropertyBase&>(*target_column).drop_links();
+    m_semi_join_condition = left_is_const ? make_compare(value.clone(), std::move(target_column))
+                                          : make_compare(std::move(target_column), value.clone());
+    m_semi_join_column = prop;
+    return true;
+}
+
+bool CompareBase::finish_semi_join(bool use)
+{
+    REALM_ASSERT(m_semi_join_condition);
+    std::unique_ptr<Expression> condition = std::move(m_semi_join_condition);
+    if (!use)
+        return false;
+
+    // Searching the target table may in turn use an index on the property
+    const LinkMap& link_map = m_semi_join_column->get_link_map();
+    TableView target_matches = Query(std::move(condition)).find_all();
+
+    m_matches.clear();
+    for (size_t i = 0; i < target_matches.size(); ++i) {
+        auto origins = link_map.get_origin_objkeys(target_matches.get_key(i));
+        m_matches.insert(m_matches.end(), origins.begin(), origins.end());
+    }
+    std::sort(m_matches.begin(), m_matches.end());
+    m_matches.erase(std::unique(m_matches.begin(), m_matches.end()), m_matches.end());
+
+    m_has_matches = true;
+    m_index_get = 0;
+    m_index_end = m_matches.size();
+    m_batch.reset();
+    return true;
+}
+
+namespace {
+
+// The values of a numeric expression for a batch of consecutive objects of a cluster
+template <class T>
+class BatchExpr {
+public:
+    virtual ~BatchExpr() = default;
+    virtual void set_cluster(const Cluster*) {}
+    // Compute the values of the objects [start, start + count) of the cluster
+    virtual void evaluate(size_t start, size_t count) = 0;
+
+    T m_values[BatchComparison::s_batch_size];
+    // Only valid if m_has_nulls is set
+    bool m_nulls[BatchComparison::s_batch_size];
+    bool m_has_nulls = false;
+};
+
+class BatchIntColumn : public BatchExpr<int64_t> {
+public:
+    BatchIntColumn(ColKey col_key, Allocator& alloc)
+        : m_col_key(col_key)
+        , m_leaf(alloc)
+    {
+    }
+    void set_cluster(const Cluster* cluster) override
+    {
+        cluster->init_leaf(m_col_key, &m_leaf);
+    }
+    void evaluate(size_t start, size_t count) override
+    {
+        // The batch size is a multiple of 8, so there is room for the whole last chunk
+        for (size_t i = 0; i < count; i += 8)
+            m_leaf.get_chunk(start + i, m_values + i);
+    }
+
+private:
+    ColKey m_col_key;
+    ArrayInteger m_leaf;
+};
+
+class BatchNullableIntColumn : public BatchExpr<int64_t> {
+public:
+    BatchNullableIntColumn(ColKey col_key, Allocator& alloc)
+        : m_col_key(col_key)
+        , m_leaf(alloc)
+    {
+    }
+    void set_cluster(const Cluster* cluster) override
+    {
+        cluster->init_leaf(m_col_key, &m_leaf);
+    }
+    void evaluate(size_t start, size_t count) override
+    {
+        // The values follow the null value stored first in the leaf
+        for (size_t i = 0; i < count; i += 8)
+            m_leaf.Array::get_chunk(start + 1 + i, m_values + i);
+        int64_t null_value = m_leaf.null_value();
+        bool has_nulls = false;
+        for (size_t i = 0; i < count; ++i) {
+            m_nulls[i] = m_values[i] == null_value;
+            has_nulls |= m_nulls[i];
+        }
+        m_has_nulls = has_nulls;
+    }
+
+private:
+    ColKey m_col_key;
+    ArrayIntNull m_leaf;
+};
+
+class BatchDoubleColumn : public BatchExpr<double> {
+public:
+    BatchDoubleColumn(ColKey col_key, Allocator& alloc)
+        : m_col_key(col_key)
+        , m_leaf(alloc)
+    {
+    }
+    void set_cluster(const Cluster* cluster) override
+    {
+        cluster->init_leaf(m_col_key, &m_leaf);
+    }
+    void evaluate(size_t start, size_t count) override
+    {
+        bool has_nulls = false;
+        for (size_t i = 0; i < count; ++i) {
+            m_values[i] = m_leaf.ArrayDouble::get(start + i);
+            m_nulls[i] = null::is_null_float(m_values[i]);
+            has_nulls |= m_nulls[i];
+        }
+        m_has_nulls = has_nulls;
+    }
+
+private:
+    ColKey m_col_key;
+    ArrayDoubleNull m_leaf;
+};
+
+template <class T>
+class BatchConstant : public BatchExpr<T> {
+public:
+    BatchConstant(T value)
+    {
+        std::fill(std::begin(this->m_values), std::end(this->m_values), value);
+    }
+    void evaluate(size_t, size_t) override {}
+};
+
+// An int expression used where Mixed arithmetic converts it to double
+class BatchIntToDouble : public BatchExpr<double> {
+public:
+    BatchIntToDouble(std::unique_ptr<BatchExpr<int64_t>> arg)
+        : m_arg(std::move(arg))
+    {
+    }
+    void set_cluster(const Cluster* cluster) override
+    {
+        m_arg->set_cluster(cluster);
+    }
+    void evaluate(size_t start, size_t count) override
+    {
+        m_arg->evaluate(start, count);
+        for (size_t i = 0; i < count; ++i)
+            m_values[i] = double(m_arg->m_values[i]);
+        m_has_nulls = m_arg->m_has_nulls;
+        if (m_has_nulls)
+            std::copy_n(m_arg->m_nulls, count, m_nulls);
+    }
+
+private:
+    std::unique_ptr<BatchExpr<int64_t>> m_arg;
+};
+
+// The arithmetic of Mixed on unboxed values. Integer overflow wraps around, and integer division by
+// zero gives the largest value of the sign of the dividend.
+struct BatchPlus {
+    static int64_t apply(int64_t a, int64_t b)
+    {
+        return int64_t(uint64_t(a) + uint64_t(b));
+    }
+    static double apply(double a, double b)
+    {
+        return a + b;
+    }
+};
+
+struct BatchMinus {
+    static int64_t apply(int64_t a, int64_t b)
+    {
+        return int64_t(uint64_t(a) - uint64_t(b));
+    }
+    static double apply(double a, double b)
+    {
+        return a - b;
+    }
+};
+
+struct BatchMul {
+    static int64_t apply(int64_t a, int64_t b)
+    {
+        return int64_t(uint64_t(a) * uint64_t(b));
+    }
+    static double apply(double a, double b)
+    {
+        return a * b;
+    }
+};
+
+struct BatchDiv {
+    static int64_t apply(int64_t a, int64_t b)
+    {
+        if (b == 0)
+            return a < 0 ? std::numeric_limits<int64_t>::min() : std::numeric_limits<int64_t>::max();
+        if (b == -1)
+            return int64_t(0 - uint64_t(a));
+        return a / b;
+    }
+    static double apply(double a, double b)
+    {
+        return a / b;
+    }
+};
+
+template <class T, class Op>
+class BatchOperator : public BatchExpr<T> {
+public:
+    BatchOperator(std::unique_ptr<BatchExpr<T>> left, std::unique_ptr<BatchExpr<T>> right)
+        : m_left(std::move(left))
+        , m_right(std::move(right))
+    {
+    }
+    void set_cluster(const Cluster* cluster) override
+    {
+        m_left->set_cluster(cluster);
+        m_right->set_cluster(cluster);
+    }
+    void evaluate(size_t start, size_t count) override
+    {
+        m_left->evaluate(start, count);
+        m_right->evaluate(start, count);
+        const T* left = m_left->m_values;
+        const T* right = m_right->m_values;
+        for (size_t i = 0; i < count; ++i)
+            this->m_values[i] = Op::apply(left[i], right[i]);
+
+        // The result is null if one of the operands is
+        this->m_has_nulls = m_left->m_has_nulls || m_right->m_has_nulls;
+        if (m_left->m_has_nulls && m_right->m_has_nulls) {
+            for (size_t i = 0; i < count; ++i)
+                this->m_nulls[i] = m_left->m_nulls[i] | m_right->m_nulls[i];
+        }
+        else if (m_left->m_has_nulls) {
+            std::copy_n(m_left->m_nulls, count, this->m_nulls);
+        }
+        else if (m_right->m_has_nulls) {
+            std::copy_n(m_right->m_nulls, count, this->m_nulls);
+        }
+    }
+
+private:
+    std::unique_ptr<BatchExpr<T>> m_left;
+    std::unique_ptr<BatchExpr<T>> m_right;
+};
+
+// Calls `fn` with a pointer to the Operator if the expression is an arithmetic operator
+template <class F>
+bool visit_operator(const Subexpr& expr, F fn)
+{
+    if (auto op = dynamic_cast<const Operator<Plus>*>(&expr)) {
+        fn(op, BatchPlus());
+        return true;
+    }
+    if (auto op = dynamic_cast<const Operator<Minus>*>(&expr)) {
+        fn(op, BatchMinus());
+        return true;
+    }
+    if (auto op = dynamic_cast<const Operator<Mul>*>(&expr)) {
+        fn(op, BatchMul());
+        return true;
+    }
+    if (auto op = dynamic_cast<const Operator<Div>*>(&expr)) {
+        fn(op, BatchDiv());
+        return true;
+    }
+    return false;
+}
+
+bool is_batch_constant(const Subexpr& expr)
+{
+    return expr.has_single_value() && !expr.has_multiple_values();
+}
+
+template <class T>
+bool is_batch_column(const Subexpr& expr, ColumnType type)
+{
+    auto column = dynamic_cast<const Columns<T>*>(&expr);
+    return column && !column->links_exist() && column->column_key().get_type() == type &&
+           !column->column_key().is_collection();
+}
+
+// The type of the values of the expression if it can be evaluated in batches: type_Int or type_Double
+std::optional<DataType> get_batch_type(const Subexpr& expr)
+{
+    if (expr.get_comparison_type())
+        return {};
+    if (is_batch_column<Int>(expr, col_type_Int))
+        return type_Int;
+    if (is_batch_column<double>(expr, col_type_Double))
+        return type_Double;
+    if (is_batch_constant(expr)) {
+        Mixed value = expr.get_mixed();
+        if (value.is_type(type_Int, type_Double))
+            return value.get_type();
+        return {};
+    }
+    std::optional<DataType> type;
+    visit_operator(expr, [&](auto op, auto) {
+        auto left = get_batch_type(op->get_left());
+        auto right = get_batch_type(op->get_right());
+        // Mixed arithmetic on an int and a double is done on doubles
+        if (left && right)
+            type = *left == type_Int && *right == type_Int ? type_Int : type_Double;
+    });
+    return type;
+}
+
+// The expression must have a batch type, which is type_Int if T is int64_t
+template <class T>
+std::unique_ptr<BatchExpr<T>> make_batch_expr(const Subexpr& expr, Allocator& alloc)
+{
+    if (is_batch_constant(expr)) {
+        return std::make_unique<BatchConstant<T>>(expr.get_mixed().export_to_type<T>());
+    }
+    if constexpr (std::is_same_v<T, double>) {
+        if (*get_batch_type(expr) == type_Int)
+            return std::make_unique<BatchIntToDouble>(make_batch_expr<int64_t>(expr, alloc));
+    }
+    if (auto column = dynamic_cast<const Columns<T>*>(&expr)) {
+        if constexpr (std::is_same_v<T, double>) {
+            return std::make_unique<BatchDoubleColumn>(column->column_key(), alloc);
+        }
+        else {
+            if (column->is_nullable())
+                return std::make_unique<BatchNullableIntColumn>(column->column_key(), alloc);
+            return std::make_unique<BatchIntColumn>(column->column_key(), alloc);
+        }
+    }
+    std::unique_ptr<BatchExpr<T>> result;
+    visit_operator(expr, [&](auto op, auto oper) {
+        result = std::make_unique<BatchOperator<T, decltype(oper)>>(make_batch_expr<T>(op->get_left(), alloc),
+                                                                    make_batch_expr<T>(op->get_right(), alloc));
+    });
+    REALM_ASSERT(result);
+    return result;
+}
+
+template <class TCond, class T>
+class BatchComparisonImpl : public BatchComparison {
+public:
+    BatchComparisonImpl(std::unique_ptr<BatchExpr<T>> left, std::unique_ptr<BatchExpr<T>> right)
+        : m_left(std::move(left))
+        , m_right(std::move(right))
+    {
+    }
+
+    void set_cluster(const Cluster* cluster) override
+    {
+        m_left->set_cluster(cluster);
+        m_right->set_cluster(cluster);
+        m_begin = m_end = 0;
+    }
+
+    size_t find_first(size_t start, size_t end) override
+    {
+        while (start < end) {
+            if (start < m_begin || start >= m_end)
+                evaluate(start, std::min(end - start, s_batch_size));
+            size_t stop = std::min(end, m_end);
+            size_t ndx = start - m_begin;
+            while (ndx < stop - m_begin) {
+                size_t bits = m_matches[ndx / s_word_bits] >> (ndx % s_word_bits);
+                if (bits) {
+                    ndx += ctz(bits);
+                    break;
+                }
+                ndx = (ndx / s_word_bits + 1) * s_word_bits;
+            }
+            if (ndx < stop - m_begin)
+                return m_begin + ndx;
+            start = stop;
+        }
+        return not_found;
+    }
+
+private:
+    std::unique_ptr<BatchExpr<T>> m_left;
+    std::unique_ptr<BatchExpr<T>> m_right;
+    static constexpr size_t s_word_bits = sizeof(size_t) * 8;
+    // The objects of the current batch, and a bit for each of them telling if it matches
+    size_t m_begin = 0;
+    size_t m_end = 0;
+    size_t m_matches[s_batch_size / s_word_bits];
+
+    static bool match(T a, T b, bool a_null, bool b_null)
+    {
+        if constexpr (std::is_same_v<T, double>) {
+            // NaN is less than all numbers and equal to itself in Mixed comparisons
+            if (REALM_UNLIKELY(std::isnan(a) || std::isnan(b)) && !a_null && !b_null)
+                return TCond()(QueryValue(a), QueryValue(b));
+        }
+        return TCond()(a, b, a_null, b_null);
+    }
+
+    void evaluate(size_t start, size_t count)
+    {
+        m_left->evaluate(start, count);
+        m_right->evaluate(start, count);
+        const T* left = m_left->m_values;
+        const T* right = m_right->m_values;
+        const bool* left_nulls = m_left->m_has_nulls ? m_left->m_nulls : nullptr;
+        const bool* right_nulls = m_right->m_has_nulls ? m_right->m_nulls : nullptr;
+        for (size_t word = 0; word * s_word_bits < count; ++word) {
+            size_t first = word * s_word_bits;
+            size_t n = std::min(s_word_bits, count - first);
+            size_t bits = 0;
+            if (!left_nulls && !right_nulls) {
+                for (size_t i = 0; i < n; ++i)
+                    bits |= size_t(match(left[first + i], right[first + i], false, false)) << i;
+            }
+            else {
+                for (size_t i = 0; i < n; ++i) {
+                    bool left_null = left_nulls && left_nulls[first + i];
+                    bool right_null = right_nulls && right_nulls[first + i];
+                    bits |= size_t(match(left[first + i], right[first + i], left_null, right_null)) << i;
+                }
+            }
+            m_matches[word] = bits;
+        }
+        m_begin = start;
+        m_end = start + count;
+    }
+};
+
+} // anonymous namespace
+
+template <class TCond>
+std::unique_ptr<BatchComparison> BatchComparison::create(const Subexpr& left, const Subexpr& right)
+{
+    auto left_type = get_batch_type(left);
+    auto right_type = get_batch_type(right);
+    if (!left_type || !right_type || (is_batch_constant(left) && is_batch_constant(right)))
+        return nullptr;
+    if (*left_type != *right_type) {
+        // Comparing an int with a double is only exact as doubles for ints of at most 53 bits,
+        // which can only be checked up front for constants
+        auto fits_double = [](const Subexpr& expr) {
+            if (!is_batch_constant(expr))
+                return false;
+            int64_t value = expr.get_mixed().get_int();
+            return value >= -(int64_t(1) << 53) && value <= (int64_t(1) << 53);
+        };
+        if (!(*left_type == type_Int ? fits_double(left) : fits_double(right)))
+            return nullptr;
+        left_type = right_type = type_Double;
+    }
+    auto table = left.get_base_table() ? left.get_base_table() : right.get_base_table();
+    if (!table)
+        return nullptr;
+    Allocator& alloc = table->get_alloc();
+    if (*left_type == type_Int) {
+        return std::make_unique<BatchComparisonImpl<TCond, int64_t>>(make_batch_expr<int64_t>(left, alloc),
+                                                                     make_batch_expr<int64_t>(right, alloc));
+    }
+    return std::make_unique<BatchComparisonImpl<TCond, double>>(make_batch_expr<double>(left, alloc),
+                                                                make_batch_expr<double>(right, alloc));
+}
+
+template std::unique_ptr<BatchComparison> BatchComparison::create<Equal>(const Subexpr&, const Subexpr&);
+template std::unique_ptr<BatchComparison> BatchComparison::create<NotEqual>(const Subexpr&, const Subexpr&);
+template std::unique_ptr<BatchComparison> BatchComparison::create<Greater>(const Subexpr&, const Subexpr&);
+template std::unique_ptr<BatchComparison> BatchComparison::create<Less>(const Subexpr&, const Subexpr&);
+template std::unique_ptr<BatchComparison> BatchComparison::create<GreaterEqual>(const Subexpr&, const Subexpr&);
+template std::unique_ptr<BatchComparison> BatchComparison::create<LessEqual>(const Subexpr&, const Subexpr&);
+
 ColumnDictionaryKeys Columns<Dictionary>::keys()
 {
     return ColumnDictionaryKeys(*this);
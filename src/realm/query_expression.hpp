@@ -88,6 +88,10 @@ Value<T> containing 8 values representing table rows i...i + 7.
 So Value<T> contains 8 concecutive values and all operations are based on these chunks. This is
 to save overhead by virtual calls needed for evaluating a query that has been dynamically constructed at runtime.
 
+Comparisons of numeric expressions made only of int and double properties of the table (no links), constants and
+the arithmetic operators are instead evaluated by a BatchComparison. It reads up to 256 values of each property from
+the leaf into a typed buffer, applies the operators to whole buffers, and compares them into a bitmap of matches.
+
 
 Memory allocation:
 -----------------------------------------------------------------------------------------------------------------------
@@ -155,6 +159,7 @@ The Columns class encapsulates all this into a simple class that, for any type T
 
 #include <numeric>
 #include <algorithm>
+#include <unordered_set>
 
 // Normally, if a next-generation-syntax condition is supported by the old query_engine.hpp, a query_engine node is
 // created because it's faster (by a factor of 5 - 10). Because many of our existing next-generation-syntax unit
@@ -660,6 +665,19 @@ public:
     virtual std::string description(util::serializer::SerialisationState& state) const = 0;
 
     virtual std::unique_ptr<Expression> clone() const = 0;
+
+    // A condition which could search another table up front to find its matches is only
+    // prepared by init(), as this only pays off if the condition drives the search.
+    virtual bool has_pending_semi_join() const
+    {
+        return false;
+    }
+    // Search the other table if `use` is set, otherwise evaluate the condition on each object.
+    // Returns true if the matches were found up front.
+    virtual bool finish_semi_join(bool)
+    {
+        return false;
+    }
 };
 
 template <typename T, typename... Args>
@@ -1601,6 +1619,9 @@ public:
     }
 
     void collect_dependencies(std::vector<TableKey>& tables) const;
+    // Add the tables linking to the target table, as changes to their links change the backlinks
+    // of the target objects
+    void collect_origin_dependencies(std::vector<TableKey>& tables) const;
 
     std::string description(util::serializer::SerialisationState& state) const;
 
@@ -1624,6 +1645,16 @@ public:
 
     std::vector<ObjKey> get_origin_objkeys(ObjKey key, size_t column = 0) const;
 
+    // Remove the links, so the map applies to the objects of the target table directly
+    void drop_links()
+    {
+        ConstTableRef target = get_target_table();
+        m_link_column_keys.clear();
+        m_link_types.clear();
+        m_tables = {target};
+        m_only_unary_links = true;
+    }
+
     size_t count_links(size_t row) const
     {
         size_t count = 0;
@@ -1770,6 +1801,12 @@ public:
         return false;
     }
 
+    // Evaluate the property on the objects of the target table rather than through the links
+    void drop_links()
+    {
+        m_link_map.drop_links();
+    }
+
 protected:
     LinkMap m_link_map;
     // Column index of payload column of m_table
@@ -1803,8 +1840,8 @@ public:
 
     bool has_search_index() const final
     {
-        auto target_table = m_link_map.get_target_table();
-        return target_table->search_index_type(m_column_key) == IndexType::General;
+        auto index_type = m_link_map.get_target_table()->search_index_type(m_column_key);
+        return index_type == IndexType::General || index_type == IndexType::Ordered || index_type == IndexType::Hash;
     }
 
     bool has_indexes_in_link_map() const final
@@ -2416,6 +2453,7 @@ public:
     void collect_dependencies(std::vector<TableKey>& tables) const override
     {
         m_link_map.collect_dependencies(tables);
+        m_link_map.collect_origin_dependencies(tables);
     }
 
     void evaluate(Subexpr::Index& index, ValueBase& destination) override
@@ -2467,10 +2505,15 @@ public:
         : m_link_map(other.m_link_map)
         , m_bounds(other.m_bounds)
         , m_region(m_bounds)
+        , m_type_col(other.m_type_col)
+        , m_coords_col(other.m_coords_col)
         , m_comp_type(other.m_comp_type)
     {
     }
 
+    // If the points have a geospatial index, the objects within the region are found up front
+    double init() override;
+
     void set_base_table(ConstTableRef table) override
     {
         m_link_map.set_base_table(table);
@@ -2492,6 +2535,7 @@ public:
 
     void set_cluster(const Cluster* cluster) override
     {
+        m_cluster = cluster;
         m_link_map.set_cluster(cluster);
     }
 
@@ -2509,15 +2553,24 @@ public:
 
     size_t find_first(size_t start, size_t end) const override
     {
+        if (m_has_matches) {
+            return find_first_with_matches(start, end);
+        }
+
         auto table = m_link_map.get_target_table();
+        auto within = [&](ObjKey key) {
+            if (m_has_index) {
+                return std::binary_search(m_within.begin(), m_within.end(), key);
+            }
+            return m_region.contains(Geospatial::point_from_obj(table->get_object(key), m_type_col, m_coords_col));
+        };
 
         while (start < end) {
             bool found = false;
             switch (m_comp_type.value_or(ExpressionComparisonType::Any)) {
                 case ExpressionComparisonType::Any: {
                     m_link_map.map_links(start, [&](ObjKey key) {
-                        found = m_region.contains(
-                            Geospatial::point_from_obj(table->get_object(key), m_type_col, m_coords_col));
+                        found = within(key);
                         return !found; // keep searching if not found, stop searching on first match
                     });
                     if (found)
@@ -2526,8 +2579,7 @@ public:
                 }
                 case ExpressionComparisonType::All: {
                     m_link_map.map_links(start, [&](ObjKey key) {
-                        found = m_region.contains(
-                            Geospatial::point_from_obj(table->get_object(key), m_type_col, m_coords_col));
+                        found = within(key);
                         return found; // keep searching until one the first non-match
                     });
                     if (found) // all matched
@@ -2536,8 +2588,7 @@ public:
                 }
                 case ExpressionComparisonType::None: {
                     m_link_map.map_links(start, [&](ObjKey key) {
-                        found = m_region.contains(
-                            Geospatial::point_from_obj(table->get_object(key), m_type_col, m_coords_col));
+                        found = within(key);
                         return !found; // keep searching until the first match
                     });
                     if (!found) // none matched
@@ -2569,6 +2620,24 @@ private:
     ColKey m_type_col;
     ColKey m_coords_col;
     util::Optional<ExpressionComparisonType> m_comp_type;
+    const Cluster* m_cluster = nullptr;
+    // Keys of the linked objects within the region, sorted, when found through the index
+    bool m_has_index = false;
+    std::vector<ObjKey> m_within;
+    // Keys of the matching objects of the base table, sorted, for the "any" comparison
+    bool m_has_matches = false;
+    std::vector<ObjKey> m_matches;
+
+    size_t find_first_with_matches(size_t start, size_t end) const
+    {
+        if (start >= end)
+            return not_found;
+        ObjKey first_key = m_cluster->get_real_key(start);
+        auto it = std::lower_bound(m_matches.begin(), m_matches.end(), first_key);
+        if (it == m_matches.end() || *it > m_cluster->get_real_key(end - 1))
+            return not_found;
+        return m_cluster->lower_bound_key(ObjKey(it->value - m_cluster->get_offset()));
+    }
 };
 #endif
 
@@ -4417,6 +4486,15 @@ public:
         return make_subexpr<Operator>(*this);
     }
 
+    const Subexpr& get_left() const
+    {
+        return *m_left;
+    }
+    const Subexpr& get_right() const
+    {
+        return *m_right;
+    }
+
 private:
     std::unique_ptr<Subexpr> m_left;
     std::unique_ptr<Subexpr> m_right;
@@ -4425,6 +4503,22 @@ private:
     Mixed m_const_value;
 };
 
+// A comparison of numeric expressions evaluated for batches of consecutive objects of a cluster.
+// The matches of the last batch are kept, so finding the next match within it is cheap.
+class BatchComparison {
+public:
+    static constexpr size_t s_batch_size = 256;
+
+    virtual ~BatchComparison() = default;
+    virtual void set_cluster(const Cluster* cluster) = 0;
+    virtual size_t find_first(size_t start, size_t end) = 0;
+
+    // Returns null unless both sides are made of non-link int or double properties, numeric constants and
+    // arithmetic operators, and both sides have the same type.
+    template <class TCond>
+    static std::unique_ptr<BatchComparison> create(const Subexpr& left, const Subexpr& right);
+};
+
 class CompareBase : public Expression {
 public:
     CompareBase(std::unique_ptr<Subexpr> left, std::unique_ptr<Subexpr> right)
@@ -4452,6 +4546,9 @@ public:
         if (m_has_matches) {
             m_cluster = cluster;
         }
+        else if (m_batch) {
+            m_batch->set_cluster(cluster);
+        }
         else {
             m_left->set_cluster(cluster);
             m_right->set_cluster(cluster);
@@ -4517,6 +4614,33 @@ public:
         return m_cluster->lower_bound_key(ObjKey(actual_key.value - m_cluster->get_offset()));
     }
 
+    // Set up the evaluation of `column IN {values}` with a list of constant values: the matches are
+    // found up front by looking up each distinct value in the search index of the column, or the
+    // values are put in a hash set probed for each object. Returns the cost of the condition if one
+    // of them applies.
+    std::optional<double> init_in_list();
+    size_t find_first_with_needles(size_t start, size_t end) const;
+
+    // Lists with fewer values are compared one by one
+    static constexpr size_t s_in_list_hash_threshold = 8;
+
+    // Prepare the evaluation of a condition comparing a property reached through links with a constant
+    // as a semi-join: the condition is evaluated once on the target table, and the matches are the
+    // objects linking to the target objects found. `make_compare` creates the condition for the given
+    // operands. Returns false if the condition can't be evaluated this way. The target table is only
+    // searched by finish_semi_join(), once the query knows that this condition drives the search.
+    using MakeCompare =
+        util::FunctionRef<std::unique_ptr<Expression>(std::unique_ptr<Subexpr>, std::unique_ptr<Subexpr>)>;
+    bool init_semi_join(MakeCompare make_compare);
+    bool has_pending_semi_join() const override
+    {
+        return bool(m_semi_join_condition);
+    }
+    bool finish_semi_join(bool use) override;
+
+    // The whole target table is searched, which doesn't pay off if it is much larger than the base table
+    static constexpr size_t s_semi_join_max_target_ratio = 4;
+
 protected:
     CompareBase(const CompareBase& other)
         : m_left(other.m_left->clone())
@@ -4539,6 +4663,22 @@ protected:
     std::vector<ObjKey> m_matches;
     mutable size_t m_index_get = 0;
     size_t m_index_end = 0;
+    // The condition on the target table prepared by init_semi_join()
+    std::unique_ptr<Expression> m_semi_join_condition;
+    const ObjPropertyBase* m_semi_join_column = nullptr;
+
+    // Same semantics as Equal. The hash set is only used for values whose types make this
+    // agree with Mixed::hash(), e.g. not for an integer compared with a double.
+    struct NeedleEqual {
+        bool operator()(const Mixed& a, const Mixed& b) const
+        {
+            return (a.is_null() && b.is_null()) || (Mixed::types_are_comparable(a, b) && a == b);
+        }
+    };
+    bool m_has_needles = false;
+    Subexpr* m_needle_column = nullptr;
+    std::unordered_set<Mixed, std::hash<Mixed>, NeedleEqual> m_needles;
+    std::unique_ptr<BatchComparison> m_batch;
 };
 
 template <class TCond>
@@ -4549,6 +4689,12 @@ public:
     double init() override
     {
         double dT = 50.0;
+        m_has_matches = false;
+        m_semi_join_condition.reset();
+        if constexpr (std::is_same_v<TCond, Equal>) {
+            if (auto in_list_dT = init_in_list())
+                return *in_list_dT;
+        }
         if ((m_left->has_single_value()) || (m_right->has_single_value())) {
             dT = 10.0;
             if constexpr (std::is_same_v<TCond, Equal>) {
@@ -4604,6 +4750,23 @@ public:
             }
         }
 
+        // A null value across links also matches objects with a null link, and so can only be found through
+        // the links. These conditions never match a null value when comparing with a value which isn't null.
+        if constexpr (realm::is_any_v<TCond, Equal, EqualIns, Greater, Less, GreaterEqual, LessEqual, BeginsWith,
+                                      BeginsWithIns, EndsWith, EndsWithIns, Contains, ContainsIns, Like, LikeIns>) {
+            if (!m_has_matches) {
+                init_semi_join([](std::unique_ptr<Subexpr> left, std::unique_ptr<Subexpr> right) {
+                    return std::unique_ptr<Expression>(new Compare(std::move(left), std::move(right)));
+                });
+            }
+        }
+
+        m_batch.reset();
+        if constexpr (realm::is_any_v<TCond, Equal, NotEqual, Greater, Less, GreaterEqual, LessEqual>) {
+            if (!m_has_matches)
+                m_batch = BatchComparison::create<TCond>(*m_left, *m_right);
+        }
+
         return dT;
     }
 
@@ -4612,6 +4775,12 @@ public:
         if (m_has_matches) {
             return find_first_with_matches(start, end);
         }
+        if (m_has_needles) {
+            return find_first_with_needles(start, end);
+        }
+        if (m_batch) {
+            return m_batch->find_first(start, end);
+        }
 
         size_t match;
         ValueBase left_buf;
@@ -21,6 +21,7 @@
 
 #include <cstdlib> // size_t
 #include <cstdint> // unint8_t etc
+#include <memory>
 
 #include <realm/node.hpp>
 
@@ -60,6 +61,16 @@ public:
         return false;
     }
 
+    // When a query runs on several threads, every thread passes its matches to
+    // a state made by make_partial(), and the results are added to this state
+    // with merge_partial() at the end. States which need to see the matches in
+    // key order return nullptr.
+    virtual std::unique_ptr<QueryStateBase> make_partial() const
+    {
+        return nullptr;
+    }
+    virtual void merge_partial(QueryStateBase&) {}
+
     inline size_t match_count() const noexcept
     {
         return m_match_count;
@@ -69,6 +69,7 @@ public:
     }
     Mixed get_value(ObjKey key) const;
     Lst<String> get_list(ObjKey key) const;
+    Obj get_object(ObjKey key) const;
     std::vector<ObjKey> get_all_keys() const;
 
 private:
@@ -88,6 +89,12 @@ public:
     }
     virtual ~SearchIndex() = default;
 
+    // A value of the indexed column and the object holding it
+    struct Entry {
+        ObjKey key;
+        Mixed value;
+    };
+
     // Search Index API:
     virtual void insert(ObjKey value, const Mixed& key) = 0;
     virtual void set(ObjKey value, const Mixed& key) = 0;
@@ -103,6 +110,9 @@ public:
                              ArrayPayload& values) = 0;
     virtual void insert_bulk_list(const ArrayUnsigned* keys, uint64_t key_offset, size_t num_values,
                                   ArrayInteger& ref_array) = 0;
+    // Fill an empty index with all the entries at once. This is much faster than
+    // inserting the entries one by one for large tables. The entries are reordered.
+    virtual void insert_all(std::vector<Entry>& entries) = 0;
     virtual void verify() const = 0;
 
 #ifdef REALM_DEBUG
@@ -135,6 +145,10 @@ public:
 protected:
     ClusterColumn m_target_column;
     Array* m_root_array;
+
+    // Sort the entries by value, and entries with equal values by key. Large
+    // vectors are sorted on several threads.
+    static void sort_entries(std::vector<Entry>& entries);
 };
 
 
@@ -285,22 +285,46 @@ void DistinctDescriptor::execute(IndexPairs& v, const Sorter& predicate, const B
         v.erase(nulls, v.end());
     }
 
-    // Sort by the columns to distinct on
-    std::sort(v.begin(), v.end(), std::ref(predicate));
+    // Keep the entry with the lowest index_in_view of each set of equal entries. The
+    // positions of the kept entries are found through a hash set, which saves sorting
+    // all entries by the columns to distinct on.
+    std::vector<size_t> hashes;
+    hashes.reserve(v.size());
+    for (auto& index : v) {
+        hashes.push_back(predicate.hash(index));
+    }
+    auto hash = [&](size_t pos) {
+        return hashes[pos];
+    };
+    auto equal = [&](size_t a, size_t b) {
+        return hashes[a] == hashes[b] && !predicate(v[a], v[b], false) && !predicate(v[b], v[a], false);
+    };
+    std::unordered_set<size_t, decltype(hash), decltype(equal)> kept(v.size(), hash, equal);
+    std::vector<bool> keep(v.size());
+    for (size_t pos = 0; pos < v.size(); ++pos) {
+        auto [it, inserted] = kept.insert(pos);
+        if (inserted) {
+            keep[pos] = true;
+        }
+        else if (v[pos].index_in_view < v[*it].index_in_view) {
+            keep[*it] = false;
+            keep[pos] = true;
+            kept.erase(it);
+            kept.insert(pos);
+        }
+    }
+    size_t kept_count = 0;
+    for (size_t pos = 0; pos < v.size(); ++pos) {
+        if (keep[pos])
+            v[kept_count++] = std::move(v[pos]);
+    }
+    v.erase(v.begin() + kept_count, v.end());
 
-    // Move duplicates to the back - "not less than" is "equal" since they're sorted
-    auto duplicates = std::unique(v.begin(), v.end(), [&](const IP& a, const IP& b) {
-        return !predicate(a, b, false);
-    });
-    // Erase the duplicates
-    v.erase(duplicates, v.end());
+    // Keep the original order, this is either the original tableview order or the
+    // order of the previous sort
     bool will_be_sorted_next = next && next->get_type() == DescriptorType::Sort;
-    if (!will_be_sorted_next) {
-        // Restore the original order, this is either the original
-        // tableview order or the order of the previous sort
-        std::sort(v.begin(), v.end(), [](const IP& a, const IP& b) {
-            return a.index_in_view < b.index_in_view;
-        });
+    if (!will_be_sorted_next && !std::is_sorted(v.begin(), v.end())) {
+        std::sort(v.begin(), v.end());
     }
 }
 
@@ -316,21 +340,13 @@ void SortDescriptor::execute(IndexPairs& v, const Sorter& predicate, const BaseD
     if (next && next->get_type() == DescriptorType::Limit) {
         limit = static_cast<const LimitDescriptor*>(next)->get_limit();
     }
-    // Measurements shows that if limit is smaller than size / 16, then
-    // it is quicker to make a sorted insert into a smaller vector
-    if (limit < (v.size() >> 4)) {
-        IndexPairs buffer;
-        buffer.reserve(limit + 1);
-        for (auto& elem : v) {
-            auto it = std::lower_bound(buffer.begin(), buffer.end(), elem, std::ref(predicate));
-            buffer.insert(it, elem);
-            if (buffer.size() > limit) {
-                buffer.pop_back();
-            }
-        }
+    // If only a minor part of the elements is kept, it is quicker to keep the
+    // best elements in a heap of size `limit` while scanning the rest than to
+    // sort everything
+    if (limit < (v.size() >> 2)) {
+        std::partial_sort(v.begin(), v.begin() + limit, v.end(), std::ref(predicate));
         v.m_removed_by_limit += v.size() - limit;
         v.erase(v.begin() + limit, v.end());
-        std::move(buffer.begin(), buffer.end(), v.begin());
     }
     else {
         std::sort(v.begin(), v.end(), std::ref(predicate));
@@ -482,6 +498,24 @@ void BaseDescriptor::Sorter::cache_first_column(IndexPairs& v)
     }
 }
 
+size_t BaseDescriptor::Sorter::hash(IndexPair i) const
+{
+    size_t h = 0;
+    for (size_t t = 0; t < m_columns.size(); t++) {
+        Mixed value = i.cached_value;
+        if (t > 0) {
+            auto& col = m_columns[t];
+            ObjKey key = col.translated_keys.empty() ? i.key_for_object : col.translated_keys[i.index_in_view];
+            if (key)
+                value = col.col_key.get_value(col.table->get_object(key));
+            else
+                value = Mixed();
+        }
+        h = h * 31 + value.compare_hash();
+    }
+    return h;
+}
+
 DescriptorOrdering::DescriptorOrdering(const DescriptorOrdering& other)
     : AtomicRefCountBase()
 {
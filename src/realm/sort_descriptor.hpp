@@ -97,6 +97,9 @@ public:
             });
         }
         void cache_first_column(IndexPairs& v);
+        // Hash of the values of the columns, equal for entries which compare equal.
+        // The first column must have been cached.
+        size_t hash(IndexPair i) const;
 
     private:
         struct SortColumn {
@@ -165,6 +168,11 @@ public:
     }
     void collect_dependencies(const Table* table, std::vector<TableKey>& table_keys) const override;
 
+    const std::vector<std::vector<ExtendedColumnKey>>& get_column_keys() const noexcept
+    {
+        return m_column_keys;
+    }
+
 protected:
     std::vector<std::vector<ExtendedColumnKey>> m_column_keys;
 };
@@ -29,7 +29,14 @@
 #include <realm/dictionary.hpp>
 #include <realm/exceptions.hpp>
 #include <realm/impl/destroy_guard.hpp>
+#include <realm/index_composite.hpp>
+#include <realm/index_fulltext.hpp>
+#include <realm/index_hash.hpp>
+#include <realm/index_ordered.hpp>
 #include <realm/index_string.hpp>
+#if REALM_ENABLE_GEOSPATIAL
+#include <realm/index_geospatial.hpp>
+#endif
 #include <realm/query_conditions_tpl.hpp>
 #include <realm/replication.hpp>
 #include <realm/table_view.hpp>
@@ -356,6 +363,7 @@ Table::Table(Allocator& alloc)
     , m_index_refs(m_alloc)
     , m_opposite_table(m_alloc)
     , m_opposite_column(m_alloc)
+    , m_composite_index_refs(m_alloc)
     , m_repl(&g_dummy_replication)
     , m_own_ref(this, alloc.get_instance_version())
 {
@@ -363,6 +371,7 @@ Table::Table(Allocator& alloc)
     m_index_refs.set_parent(&m_top, top_position_for_search_indexes);
     m_opposite_table.set_parent(&m_top, top_position_for_opposite_table);
     m_opposite_column.set_parent(&m_top, top_position_for_opposite_column);
+    m_composite_index_refs.set_parent(&m_top, top_position_for_composite_indexes);
 
     ref_type ref = create_empty_table(m_alloc); // Throws
     ArrayParent* parent = nullptr;
@@ -378,6 +387,7 @@ Table::Table(Replication* const* repl, Allocator& alloc)
     , m_index_refs(m_alloc)
     , m_opposite_table(m_alloc)
     , m_opposite_column(m_alloc)
+    , m_composite_index_refs(m_alloc)
     , m_repl(repl)
     , m_own_ref(this, alloc.get_instance_version())
 {
@@ -385,6 +395,7 @@ Table::Table(Replication* const* repl, Allocator& alloc)
     m_index_refs.set_parent(&m_top, top_position_for_search_indexes);
     m_opposite_table.set_parent(&m_top, top_position_for_opposite_table);
     m_opposite_column.set_parent(&m_top, top_position_for_opposite_column);
+    m_composite_index_refs.set_parent(&m_top, top_position_for_composite_indexes);
     m_cookie = cookie_created;
 }
 
@@ -676,13 +687,24 @@ static void do_bulk_insert_index(Table* table, SearchIndex* index, ColKey col_ke
     using LeafType = typename ColumnTypeTraits<Type>::cluster_leaf_type;
     LeafType leaf(alloc);
 
-    auto f = [&col_key, &index, &leaf](const Cluster* cluster) {
+    // Gather all the values so that the index can be built in one go. The values
+    // may refer to the memory of the leaves, which is not changed while building.
+    std::vector<SearchIndex::Entry> entries;
+    entries.reserve(table->size());
+    auto f = [&col_key, &entries, &leaf](const Cluster* cluster) {
         cluster->init_leaf(col_key, &leaf);
-        index->insert_bulk(cluster->get_key_array(), cluster->get_offset(), cluster->node_size(), leaf);
+        const ArrayUnsigned* keys = cluster->get_key_array();
+        const int64_t key_offset = cluster->get_offset();
+        const size_t num_values = cluster->node_size();
+        for (size_t i = 0; i < num_values; ++i) {
+            ObjKey key(keys ? int64_t(keys->get(i)) + key_offset : int64_t(i) + key_offset);
+            entries.push_back({key, leaf.get_any(i)});
+        }
         return IteratorControl::AdvanceToNext;
     };
 
     table->traverse_clusters(f);
+    index->insert_all(entries);
 }
 
 
@@ -721,6 +743,9 @@ void Table::populate_search_index(ColKey col_key)
             do_bulk_insert_index<bool>(this, index, col_key, get_alloc());
         }
     }
+    else if (type == type_Double && col_key.is_list()) {
+        do_bulk_insert_index_list(this, index, col_key, get_alloc());
+    }
     else if (type == type_String) {
         if (col_key.is_list()) {
             do_bulk_insert_index_list(this, index, col_key, get_alloc());
@@ -765,6 +790,12 @@ void Table::erase_from_search_indexes(ObjKey key)
                 index->erase(key);
             }
         }
+        if (!m_composite_indexes.empty()) {
+            const Obj obj = m_clusters.get(key);
+            for (auto& index : m_composite_indexes) {
+                index->erase(key, get_composite_index_values(*index, obj));
+            }
+        }
     }
 }
 
@@ -852,6 +883,13 @@ void Table::update_indexes(ObjKey key, const FieldValues& values)
             }
         }
     }
+
+    if (!m_composite_indexes.empty()) {
+        const Obj obj = m_clusters.get(key);
+        for (auto& index : m_composite_indexes) {
+            index->insert(key, get_composite_index_values(*index, obj));
+        }
+    }
 }
 
 void Table::clear_indexes()
@@ -861,6 +899,147 @@ void Table::clear_indexes()
             index->clear();
         }
     }
+    for (auto& index : m_composite_indexes) {
+        index->clear();
+    }
+}
+
+std::vector<Mixed> Table::get_composite_index_values(const CompositeIndex& index, const Obj& obj) const
+{
+    std::vector<Mixed> values;
+    values.reserve(index.get_column_keys().size());
+    for (auto col_key : index.get_column_keys()) {
+        values.push_back(obj.get_any(col_key));
+    }
+    return values;
+}
+
+void Table::do_update_composite_indexes(ObjKey key, ColKey col_key, Mixed new_value)
+{
+    // Tombstones do not use index
+    if (key.is_unresolved())
+        return;
+
+    std::optional<Obj> obj;
+    for (auto& index : m_composite_indexes) {
+        auto& col_keys = index->get_column_keys();
+        auto it = std::find(col_keys.begin(), col_keys.end(), col_key);
+        if (it == col_keys.end())
+            continue;
+        if (!obj)
+            obj = m_clusters.get(key);
+        auto values = get_composite_index_values(*index, *obj);
+        index->erase(key, values);
+        values[it - col_keys.begin()] = new_value;
+        index->insert(key, values);
+    }
+}
+
+void Table::populate_composite_index(CompositeIndex& index)
+{
+    for (auto& obj : *this) {
+        index.insert(obj.get_key(), get_composite_index_values(index, obj));
+    }
+}
+
+void Table::refresh_composite_index_accessors()
+{
+    m_composite_indexes.clear();
+    if (m_top.size() <= top_position_for_composite_indexes || !m_top.get_as_ref(top_position_for_composite_indexes)) {
+        m_composite_index_refs.detach();
+        return;
+    }
+
+    m_composite_index_refs.init_from_parent();
+    for (size_t ndx = 0; ndx < m_composite_index_refs.size(); ++ndx) {
+        auto index = std::make_unique<CompositeIndex>(m_alloc);
+        index->init_from_ref(m_composite_index_refs.get_as_ref(ndx));
+        index->set_parent(&m_composite_index_refs, ndx);
+        m_composite_indexes.push_back(std::move(index));
+    }
+}
+
+void Table::add_search_index(const std::vector<ColKey>& col_keys)
+{
+    if (col_keys.size() < CompositeIndex::min_columns || col_keys.size() > CompositeIndex::max_columns) {
+        throw InvalidArgument(util::format("A composite index must cover %1 to %2 properties",
+                                           CompositeIndex::min_columns, CompositeIndex::max_columns));
+    }
+    for (auto col_key : col_keys) {
+        check_column(col_key);
+        if (!CompositeIndex::type_supported(col_key)) {
+            throw IllegalOperation(
+                util::format("Composite index not supported for this property: %1", get_column_name(col_key)));
+        }
+        if (std::count(col_keys.begin(), col_keys.end(), col_key) > 1) {
+            throw InvalidArgument(
+                util::format("Property used more than once in composite index: %1", get_column_name(col_key)));
+        }
+    }
+
+    // Early-out if already indexed
+    for (auto& index : m_composite_indexes) {
+        if (index->get_column_keys() == col_keys)
+            return;
+    }
+
+    if (!m_composite_index_refs.is_attached()) {
+        while (m_top.size() <= top_position_for_composite_indexes) {
+            m_top.add(0); // Throws
+        }
+        m_composite_index_refs.create(Array::type_HasRefs); // Throws
+        m_composite_index_refs.update_parent();              // Throws
+    }
+
+    auto index = std::make_unique<CompositeIndex>(m_alloc);
+    index->create(col_keys); // Throws
+    size_t ndx = m_composite_index_refs.size();
+    try {
+        m_composite_index_refs.add(from_ref(index->get_ref())); // Throws
+    }
+    catch (...) {
+        index->destroy();
+        throw;
+    }
+    index->set_parent(&m_composite_index_refs, ndx);
+    m_composite_indexes.push_back(std::move(index));
+
+    populate_composite_index(*m_composite_indexes.back());
+}
+
+void Table::remove_search_index(const std::vector<ColKey>& col_keys)
+{
+    for (size_t ndx = 0; ndx < m_composite_indexes.size(); ++ndx) {
+        if (m_composite_indexes[ndx]->get_column_keys() == col_keys) {
+            m_composite_indexes[ndx]->destroy();
+            m_composite_indexes.erase(m_composite_indexes.begin() + ndx);
+            m_composite_index_refs.erase(ndx);
+            for (; ndx < m_composite_indexes.size(); ++ndx) {
+                m_composite_indexes[ndx]->set_parent(&m_composite_index_refs, ndx);
+            }
+            return;
+        }
+    }
+}
+
+void Table::remove_composite_indexes_for_column(ColKey col_key)
+{
+    for (size_t ndx = m_composite_indexes.size(); ndx > 0; --ndx) {
+        auto& index = m_composite_indexes[ndx - 1];
+        if (index->covers(col_key)) {
+            auto col_keys = index->get_column_keys();
+            remove_search_index(col_keys);
+        }
+    }
+}
+
+std::vector<std::vector<ColKey>> Table::get_composite_indexes() const
+{
+    std::vector<std::vector<ColKey>> result;
+    for (auto& index : m_composite_indexes) {
+        result.push_back(index->get_column_keys());
+    }
+    return result;
 }
 
 void Table::do_add_search_index(ColKey col_key, IndexType type)
@@ -871,7 +1050,24 @@ void Table::do_add_search_index(ColKey col_key, IndexType type)
     if (m_index_accessors[column_ndx] != nullptr)
         return;
 
-    if (!StringIndex::type_supported(DataType(col_key.get_type())) ||
+    if (type == IndexType::Ordered) {
+        if (!OrderedIndex::type_supported(col_key))
+            throw IllegalOperation(
+                util::format("Ordered index not supported for this property: %1", get_column_name(col_key)));
+    }
+    else if (type == IndexType::Hash) {
+        if (!HashIndex::type_supported(col_key))
+            throw IllegalOperation(
+                util::format("Hash index not supported for this property: %1", get_column_name(col_key)));
+    }
+    else if (type == IndexType::Geospatial) {
+#if REALM_ENABLE_GEOSPATIAL
+        if (!GeospatialIndex::type_supported(col_key))
+#endif
+            throw IllegalOperation(
+                util::format("Geospatial index not supported for this property: %1", get_column_name(col_key)));
+    }
+    else if (!StringIndex::type_supported(DataType(col_key.get_type())) ||
         (col_key.is_collection() && !(col_key.is_list() && col_key.get_type() == col_type_String)) ||
         (type == IndexType::Fulltext && col_key.get_type() != col_type_String)) {
         // Not ideal, but this is what we used to throw, so keep throwing that for compatibility reasons, even though
@@ -885,8 +1081,24 @@ void Table::do_add_search_index(ColKey col_key, IndexType type)
     REALM_ASSERT(m_index_accessors[column_ndx] == nullptr);
 
     // Create the index
-    m_index_accessors[column_ndx] =
-        std::make_unique<StringIndex>(ClusterColumn(&m_clusters, col_key, type), get_alloc()); // Throws
+    ClusterColumn target_column(&m_clusters, col_key, type);
+    if (type == IndexType::Ordered) {
+        m_index_accessors[column_ndx] = std::make_unique<OrderedIndex>(target_column, get_alloc()); // Throws
+    }
+    else if (type == IndexType::Hash) {
+        m_index_accessors[column_ndx] = std::make_unique<HashIndex>(target_column, get_alloc()); // Throws
+    }
+#if REALM_ENABLE_GEOSPATIAL
+    else if (type == IndexType::Geospatial) {
+        m_index_accessors[column_ndx] = std::make_unique<GeospatialIndex>(target_column, get_alloc()); // Throws
+    }
+#endif
+    else if (type == IndexType::Fulltext && FulltextIndex::type_supported(col_key)) {
+        m_index_accessors[column_ndx] = std::make_unique<FulltextIndex>(target_column, get_alloc()); // Throws
+    }
+    else {
+        m_index_accessors[column_ndx] = std::make_unique<StringIndex>(target_column, get_alloc()); // Throws
+    }
     SearchIndex* index = m_index_accessors[column_ndx].get();
     // Insert ref to index
     index->set_parent(&m_index_refs, column_ndx);
@@ -906,6 +1118,12 @@ void Table::add_search_index(ColKey col_key, IndexType type)
 
     if (col_key == m_primary_key_col && type == IndexType::Fulltext)
         throw InvalidColumnKey("primary key cannot have a full text index");
+    if (col_key == m_primary_key_col && type == IndexType::Ordered)
+        throw InvalidColumnKey("primary key cannot have an ordered index");
+    if (col_key != m_primary_key_col && type == IndexType::Hash)
+        throw InvalidColumnKey("hash index only supported for the primary key");
+    if (col_key == m_primary_key_col && type == IndexType::Geospatial)
+        throw InvalidColumnKey("primary key cannot have a geospatial index");
 
     switch (type) {
         case IndexType::None:
@@ -917,7 +1135,8 @@ void Table::add_search_index(ColKey col_key, IndexType type)
                 REALM_ASSERT(search_index_type(col_key) == IndexType::Fulltext);
                 return;
             }
-            if (attr.test(col_attr_Indexed)) {
+            if (attr.test(col_attr_Indexed) || attr.test(col_attr_Ordered_Indexed) ||
+                attr.test(col_attr_Geo_Indexed)) {
                 this->remove_search_index(col_key);
             }
             break;
@@ -926,16 +1145,61 @@ void Table::add_search_index(ColKey col_key, IndexType type)
                 REALM_ASSERT(search_index_type(col_key) == IndexType::General);
                 return;
             }
-            if (attr.test(col_attr_FullText_Indexed)) {
+            if (attr.test(col_attr_FullText_Indexed) || attr.test(col_attr_Ordered_Indexed) ||
+                attr.test(col_attr_Hash_Indexed) || attr.test(col_attr_Geo_Indexed)) {
                 this->remove_search_index(col_key);
             }
             break;
+        case IndexType::Ordered:
+            if (attr.test(col_attr_Ordered_Indexed)) {
+                REALM_ASSERT(search_index_type(col_key) == IndexType::Ordered);
+                return;
+            }
+            if (attr.test(col_attr_Indexed) || attr.test(col_attr_FullText_Indexed) ||
+                attr.test(col_attr_Geo_Indexed)) {
+                this->remove_search_index(col_key);
+            }
+            break;
+        case IndexType::Hash:
+            if (attr.test(col_attr_Hash_Indexed)) {
+                REALM_ASSERT(search_index_type(col_key) == IndexType::Hash);
+                return;
+            }
+            // Replaces the general index that every primary key has
+            this->remove_search_index(col_key);
+            break;
+        case IndexType::Geospatial:
+            if (attr.test(col_attr_Geo_Indexed)) {
+                REALM_ASSERT(search_index_type(col_key) == IndexType::Geospatial);
+                return;
+            }
+            break;
     }
 
     do_add_search_index(col_key, type);
 
     // Update spec
-    attr.set(type == IndexType::Fulltext ? col_attr_FullText_Indexed : col_attr_Indexed);
+    attr = m_spec.get_column_attr(spec_ndx);
+    switch (type) {
+        case IndexType::Fulltext:
+            attr.set(col_attr_FullText_Indexed);
+            // The posting list layout is part of file format 25, which older versions refuse to open
+            if (FulltextIndex::type_supported(col_key))
+                attr.set(col_attr_FullText_Postings);
+            break;
+        case IndexType::Ordered:
+            attr.set(col_attr_Ordered_Indexed);
+            break;
+        case IndexType::Hash:
+            attr.set(col_attr_Hash_Indexed);
+            break;
+        case IndexType::Geospatial:
+            attr.set(col_attr_Geo_Indexed);
+            break;
+        default:
+            attr.set(col_attr_Indexed);
+            break;
+    }
     m_spec.set_column_attr(spec_ndx, attr); // Throws
 }
 
@@ -961,6 +1225,10 @@ void Table::remove_search_index(ColKey col_key)
     auto attr = m_spec.get_column_attr(spec_ndx);
     attr.reset(col_attr_Indexed);
     attr.reset(col_attr_FullText_Indexed);
+    attr.reset(col_attr_FullText_Postings);
+    attr.reset(col_attr_Ordered_Indexed);
+    attr.reset(col_attr_Hash_Indexed);
+    attr.reset(col_attr_Geo_Indexed);
     m_spec.set_column_attr(spec_ndx, attr); // Throws
 }
 
@@ -993,6 +1261,28 @@ size_t Table::get_num_unique_values(ColKey col_key) const
     return col.size();
 }
 
+void Table::enumerate_low_cardinality_string_columns()
+{
+    // Scanning a column is linear in the size of the table, so the columns
+    // are only checked again once the table has doubled in size.
+    size_t sz = size();
+    if (sz < min_size_for_enumeration || sz < 2 * m_size_at_enumeration_check)
+        return;
+    m_size_at_enumeration_check = sz;
+
+    // Converting a column pays off when every distinct value is used by a
+    // number of objects. The number of keys is also bounded, as they are
+    // searched linearly when new values are added.
+    size_t limit = std::min(max_enumerated_values, sz / 8);
+    for_each_public_column([&](ColKey col_key) {
+        if (col_key.get_type() == col_type_String && !col_key.is_collection() && col_key != m_primary_key_col &&
+            !is_enumerated(col_key) && m_clusters.count_distinct_strings(col_key, limit) <= limit) {
+            m_clusters.enumerate_string_column(col_key);
+        }
+        return IteratorControl::AdvanceToNext;
+    });
+}
+
 
 void Table::erase_root_column(ColKey col_key)
 {
@@ -1056,6 +1346,7 @@ ColKey Table::do_insert_root_column(ColKey col_key, ColumnType type, StringData
 void Table::do_erase_root_column(ColKey col_key)
 {
     size_t col_ndx = col_key.get_index().val;
+    remove_composite_indexes_for_column(col_key);
     // If the column had a source index we have to remove and destroy that as well
     ref_type index_ref = m_index_refs.get_as_ref(col_ndx);
     if (index_ref) {
@@ -1264,6 +1555,12 @@ IndexType Table::search_index_type(ColKey col_key) const noexcept
 {
     if (m_index_accessors[col_key.get_index().val].get()) {
         auto attr = m_spec.get_column_attr(m_leaf_ndx2spec_ndx[col_key.get_index().val]);
+        if (attr.test(col_attr_Ordered_Indexed))
+            return IndexType::Ordered;
+        if (attr.test(col_attr_Hash_Indexed))
+            return IndexType::Hash;
+        if (attr.test(col_attr_Geo_Indexed))
+            return IndexType::Geospatial;
         bool fulltext = attr.test(col_attr_FullText_Indexed);
         return fulltext ? IndexType::Fulltext : IndexType::General;
     }
@@ -1346,6 +1643,11 @@ void Table::migrate_col_keys()
     }
 }
 
+void Table::migrate_value_ranges()
+{
+    m_clusters.update_value_ranges(true);
+}
+
 StringData Table::get_name() const noexcept
 {
     const Array& real_top = m_top;
@@ -1919,6 +2221,24 @@ TableView Table::find_all_fulltext(ColKey col_key, StringData terms) const
     return where().fulltext(col_key, terms).find_all();
 }
 
+std::vector<ObjKey> Table::find_top_fulltext(ColKey col_key, StringData terms, size_t limit) const
+{
+    check_column(col_key);
+    std::vector<ObjKey> result;
+    if (search_index_type(col_key) != IndexType::Fulltext)
+        throw IllegalOperation{"Column has no fulltext index"};
+    if (auto index = dynamic_cast<FulltextIndex*>(get_search_index(col_key))) {
+        index->find_all_fulltext(result, terms, limit);
+    }
+    else {
+        // Indexes without posting lists cannot rank the matches
+        get_string_index(col_key)->find_all_fulltext(result, terms);
+        if (result.size() > limit)
+            result.resize(limit);
+    }
+    return result;
+}
+
 TableView Table::get_sorted_view(ColKey col_key, bool ascending)
 {
     TableView tv = where().find_all();
@@ -2030,6 +2350,15 @@ void Table::schema_to_json(std::ostream& out) const
         if (index_type == IndexType::Fulltext) {
             out << ",\"isFulltextIndexed\":true";
         }
+        if (index_type == IndexType::Ordered) {
+            out << ",\"isOrderedIndexed\":true";
+        }
+        if (index_type == IndexType::Hash) {
+            out << ",\"isHashIndexed\":true";
+        }
+        if (index_type == IndexType::Geospatial) {
+            out << ",\"isGeospatialIndexed\":true";
+        }
         out << "}";
         if (i < sz - 1) {
             out << ",";
@@ -2073,10 +2402,15 @@ bool Table::operator==(const Table& t) const
 }
 
 
-void Table::flush_for_commit()
+void Table::flush_for_commit(const CommitEncodings& encodings)
 {
     if (m_top.is_attached() && m_top.size() >= top_position_for_version) {
         if (!m_top.is_read_only()) {
+            if (encodings.enumerate_string_columns)
+                enumerate_low_cardinality_string_columns();
+            if (encodings.encode_integer_leaves)
+                m_clusters.encode_integer_leaves();
+            m_clusters.update_value_ranges();
             ++m_in_file_version_at_transaction_boundary;
             auto rot_version = RefOrTagged::make_tagged(m_in_file_version_at_transaction_boundary);
             m_top.set(top_position_for_version, rot_version);
@@ -2163,18 +2497,58 @@ void Table::refresh_index_accessors()
         else {
             auto attr = m_spec.get_column_attr(m_leaf_ndx2spec_ndx[col_ndx]);
             bool fulltext = attr.test(col_attr_FullText_Indexed);
+            bool ordered = attr.test(col_attr_Ordered_Indexed);
+            bool hashed = attr.test(col_attr_Hash_Indexed);
+            bool geo = attr.test(col_attr_Geo_Indexed);
+            bool postings = attr.test(col_attr_FullText_Postings);
             auto col_key = m_leaf_ndx2colkey[col_ndx];
-            ClusterColumn virtual_col(&m_clusters, col_key, fulltext ? IndexType::Fulltext : IndexType::General);
+            ClusterColumn virtual_col(&m_clusters, col_key,
+                                      ordered    ? IndexType::Ordered
+                                      : hashed   ? IndexType::Hash
+                                      : geo      ? IndexType::Geospatial
+                                      : fulltext ? IndexType::Fulltext
+                                                 : IndexType::General);
+
+            // The kind of index on a column may have changed since the accessor was created
+            auto& accessor = m_index_accessors[col_ndx];
+            if (accessor && (ordered != bool(dynamic_cast<OrderedIndex*>(accessor.get())) ||
+                             hashed != bool(dynamic_cast<HashIndex*>(accessor.get())) ||
+                             postings != bool(dynamic_cast<FulltextIndex*>(accessor.get())))) {
+                accessor.reset();
+            }
+#if REALM_ENABLE_GEOSPATIAL
+            if (accessor && geo != bool(dynamic_cast<GeospatialIndex*>(accessor.get()))) {
+                accessor.reset();
+            }
+#endif
 
-            if (m_index_accessors[col_ndx]) { // still there, refresh:
-                m_index_accessors[col_ndx]->refresh_accessor_tree(virtual_col);
+            if (accessor) { // still there, refresh:
+                accessor->refresh_accessor_tree(virtual_col);
+            }
+            else if (ordered) { // new index!
+                accessor = std::make_unique<OrderedIndex>(ref, &m_index_refs, col_ndx, virtual_col, get_alloc());
+            }
+            else if (hashed) {
+                accessor = std::make_unique<HashIndex>(ref, &m_index_refs, col_ndx, virtual_col, get_alloc());
             }
-            else { // new index!
-                m_index_accessors[col_ndx] =
-                    std::make_unique<StringIndex>(ref, &m_index_refs, col_ndx, virtual_col, get_alloc());
+            else if (postings) {
+                accessor = std::make_unique<FulltextIndex>(ref, &m_index_refs, col_ndx, virtual_col, get_alloc());
+            }
+            else if (geo) {
+#if REALM_ENABLE_GEOSPATIAL
+                accessor = std::make_unique<GeospatialIndex>(ref, &m_index_refs, col_ndx, virtual_col, get_alloc());
+#else
+                throw IllegalOperation(util::format("Geospatial index on '%1' requires geospatial support",
+                                                    get_column_name(col_key)));
+#endif
+            }
+            else {
+                accessor = std::make_unique<StringIndex>(ref, &m_index_refs, col_ndx, virtual_col, get_alloc());
             }
         }
     }
+
+    refresh_composite_index_accessors();
 }
 
 bool Table::is_cross_table_link_target() const noexcept
@@ -2200,6 +2574,10 @@ void Table::verify() const
     m_clusters.verify();
     if (nb_unresolved())
         m_tombstones->verify();
+    for (auto& index : m_composite_indexes) {
+        index->verify();
+        REALM_ASSERT_3(index->size(), ==, size());
+    }
 #endif
 }
 
@@ -2916,6 +3294,9 @@ void Table::do_set_primary_key_column(ColKey col_key)
         if (attr.test(col_attr_FullText_Indexed)) {
             throw InvalidColumnKey("primary key cannot have a full text index");
         }
+        if (attr.test(col_attr_Ordered_Indexed)) {
+            throw InvalidColumnKey("primary key cannot have an ordered index");
+        }
     }
 
     if (m_primary_key_col) {
@@ -2940,7 +3321,8 @@ void Table::do_set_primary_key_column(ColKey col_key)
 
 bool Table::contains_unique_values(ColKey col) const
 {
-    if (search_index_type(col) == IndexType::General) {
+    auto index_type = search_index_type(col);
+    if (index_type == IndexType::General || index_type == IndexType::Hash) {
         auto search_index = get_search_index(col);
         return !search_index->has_duplicate_values();
     }
@@ -3213,6 +3595,11 @@ ColKey Table::set_nullability(ColKey col_key, bool nullable, bool throw_on_null)
     check_column(col_key);
 
     auto index_type = search_index_type(col_key);
+    std::vector<std::vector<ColKey>> composite_indexes;
+    for (auto& index : m_composite_indexes) {
+        if (index->covers(col_key))
+            composite_indexes.push_back(index->get_column_keys());
+    }
     std::string column_name(get_column_name(col_key));
     auto type = col_key.get_type();
     auto attr = col_key.get_attrs();
@@ -3246,8 +3633,31 @@ ColKey Table::set_nullability(ColKey col_key, bool nullable, bool throw_on_null)
     erase_root_column(col_key);
     m_spec.rename_column(colkey2spec_ndx(new_col), column_name);
 
-    if (index_type != IndexType::None)
+    if (index_type == IndexType::Hash) {
+        // The hash index only exists on the primary key, and replaces its general index
+        if (new_col == m_primary_key_col)
+            add_search_index(new_col, IndexType::Hash);
+    }
+    else if (index_type != IndexType::None)
         do_add_search_index(new_col, index_type);
+    if (index_type == IndexType::Ordered || index_type == IndexType::Geospatial ||
+        (index_type == IndexType::Fulltext && FulltextIndex::type_supported(new_col))) {
+        // The kind of index is recorded in the spec and must follow the column
+        auto spec_ndx = colkey2spec_ndx(new_col);
+        auto attr = m_spec.get_column_attr(spec_ndx);
+        if (index_type == IndexType::Fulltext) {
+            attr.set(col_attr_FullText_Indexed);
+            attr.set(col_attr_FullText_Postings);
+        }
+        else {
+            attr.set(index_type == IndexType::Ordered ? col_attr_Ordered_Indexed : col_attr_Geo_Indexed);
+        }
+        m_spec.set_column_attr(spec_ndx, attr);
+    }
+    for (auto& col_keys : composite_indexes) {
+        std::replace(col_keys.begin(), col_keys.end(), col_key, new_col);
+        add_search_index(col_keys);
+    }
 
     return new_col;
 }
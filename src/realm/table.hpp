@@ -51,6 +51,7 @@ class BacklinkCount;
 class ColKeys;
 template <class>
 class Columns;
+class CompositeIndex;
 class DictionaryLinkValues;
 struct GlobalKey;
 class Group;
@@ -67,6 +68,13 @@ struct Link {
 };
 typedef Link BackLink;
 
+/// Compact encodings applied to the data modified by a write transaction
+/// when it is committed. See the members of the same name in DBOptions.
+struct CommitEncodings {
+    bool encode_integer_leaves = false;
+    bool enumerate_string_columns = false;
+};
+
 
 namespace _impl {
 class TableFriend;
@@ -248,6 +256,16 @@ public:
     }
     void remove_search_index(ColKey col_key);
 
+    /// add_search_index() with several columns adds a composite index covering
+    /// 2 to 4 columns of type Int, Bool, String, Timestamp, ObjectId or UUID, in
+    /// the given order. Queries combining equality conditions on the leading
+    /// columns, optionally followed by a range condition on the next one, find
+    /// the matching objects in the index. Adding an index which already exists
+    /// has no effect. A composite index is removed along with any of its columns.
+    void add_search_index(const std::vector<ColKey>& col_keys);
+    void remove_search_index(const std::vector<ColKey>& col_keys);
+    std::vector<std::vector<ColKey>> get_composite_indexes() const;
+
     void enumerate_string_column(ColKey col_key);
     bool is_enumerated(ColKey col_key) const noexcept;
     bool contains_unique_values(ColKey col_key) const;
@@ -358,6 +376,10 @@ public:
     {
         return m_clusters.traverse(func);
     }
+    size_t traverse_clusters_parallel(size_t num_threads, ClusterTree::ParallelTraverseFunction func) const
+    {
+        return m_clusters.traverse_parallel(num_threads, func);
+    }
 
     /// remove_object() removes the specified object from the table.
     /// Any links from the specified object into objects residing in an embedded
@@ -475,6 +497,8 @@ public:
     TableView find_all_null(ColKey col_key) const;
 
     TableView find_all_fulltext(ColKey col_key, StringData value) const;
+    // Up to `limit` objects matching the search terms, the most relevant first
+    std::vector<ObjKey> find_top_fulltext(ColKey col_key, StringData terms, size_t limit) const;
 
     TableView get_sorted_view(ColKey col_key, bool ascending = true);
     TableView get_sorted_view(ColKey col_key, bool ascending = true) const;
@@ -735,6 +759,8 @@ private:
     Array m_opposite_table;                         // 7th slot in m_top
     Array m_opposite_column;                        // 8th slot in m_top
     std::vector<std::unique_ptr<SearchIndex>> m_index_accessors;
+    Array m_composite_index_refs; // 15th slot in m_top
+    std::vector<std::unique_ptr<CompositeIndex>> m_composite_indexes;
     ColKey m_primary_key_col;
     Replication* const* m_repl;
     static Replication* g_dummy_replication;
@@ -749,6 +775,17 @@ private:
     void erase_from_search_indexes(ObjKey key);
     void update_indexes(ObjKey key, const FieldValues& values);
     void clear_indexes();
+    // Must be called before the value of the column is changed to `new_value`
+    void update_composite_indexes(ObjKey key, ColKey col_key, Mixed new_value)
+    {
+        if (!m_composite_indexes.empty())
+            do_update_composite_indexes(key, col_key, new_value);
+    }
+    void do_update_composite_indexes(ObjKey key, ColKey col_key, Mixed new_value);
+    void populate_composite_index(CompositeIndex& index);
+    std::vector<Mixed> get_composite_index_values(const CompositeIndex& index, const Obj& obj) const;
+    void refresh_composite_index_accessors();
+    void remove_composite_indexes_for_column(ColKey col_key);
     template <typename T>
     void do_populate_index(StringIndex* index, ColKey::Idx col_ndx);
 
@@ -756,6 +793,7 @@ private:
     void migrate_sets_and_dictionaries();
     void migrate_set_orderings();
     void migrate_col_keys();
+    void migrate_value_ranges();
 
     /// Disable copying assignment.
     ///
@@ -848,7 +886,8 @@ private:
     void refresh_accessor_tree();
     void refresh_index_accessors();
     void refresh_content_version();
-    void flush_for_commit();
+    void flush_for_commit(const CommitEncodings& encodings = {});
+    void enumerate_low_cardinality_string_columns();
 
     bool is_cross_table_link_target() const noexcept;
 
@@ -860,8 +899,14 @@ private:
     std::vector<size_t> m_leaf_ndx2spec_ndx;
     Type m_table_type = Type::TopLevel;
     uint64_t m_in_file_version_at_transaction_boundary = 0;
+    // Number of objects when the string columns were last checked for enumeration
+    size_t m_size_at_enumeration_check = 0;
     AtomicLifeCycleCookie m_cookie;
 
+    // Thresholds used by enumerate_low_cardinality_string_columns()
+    static constexpr size_t min_size_for_enumeration = 1000;
+    static constexpr size_t max_enumerated_values = 256;
+
     static constexpr int top_position_for_spec = 0;
     static constexpr int top_position_for_columns = 1;
     static constexpr int top_position_for_cluster_tree = 2;
@@ -878,6 +923,9 @@ private:
     // flags contents: bit 0-1 - table type
     static constexpr int top_position_for_tombstones = 13;
     static constexpr int top_array_size = 14;
+    // Added on demand when the first composite index is created. Part of file format 25, so
+    // versions that would not maintain the composite indexes cannot open files that have them.
+    static constexpr int top_position_for_composite_indexes = 14;
 
     enum { s_collision_map_lo = 0, s_collision_map_hi = 1, s_collision_map_local_id = 2, s_collision_map_num_slots };
 
@@ -19,12 +19,130 @@
 #include <realm/table_view.hpp>
 #include <realm/column_integer.hpp>
 #include <realm/index_string.hpp>
+#include <realm/query_engine.hpp>
 #include <realm/transaction.hpp>
 
+#include <algorithm>
 #include <unordered_set>
 
 using namespace realm;
 
+namespace {
+
+// Used when the result of a query is sorted and then limited to the first `limit`
+// objects. A match is dropped as soon as `limit` other matches have a better
+// value in the sort column, as it can then never be part of the result. The
+// remaining candidates are kept in key order, so sorting and limiting them gives
+// the same result as sorting all matches. The value of the sort column is passed
+// along with every match by the query.
+class QueryStateTopK : public QueryStateBase {
+public:
+    QueryStateTopK(KeyValues& keys, bool ascending, size_t limit)
+        : m_keys(keys)
+        , m_ascending(ascending)
+        , m_limit_results(limit)
+        , m_compact_size(2 * limit + 16)
+    {
+    }
+    bool match(size_t index, Mixed value) noexcept final
+    {
+        if (m_source_column)
+            value = m_source_column->get_any(index);
+        // Sorting reads unresolved links as null
+        if (value.is_unresolved_link())
+            value = Mixed();
+        ++m_match_count;
+        add(ObjKey((m_key_values ? m_key_values->get(index) : index) + m_key_offset), value);
+        return true;
+    }
+    bool match(size_t index) noexcept final
+    {
+        REALM_ASSERT(m_source_column);
+        return match(index, Mixed());
+    }
+    std::unique_ptr<QueryStateBase> make_partial() const final
+    {
+        return std::make_unique<QueryStateTopK>(m_keys, m_ascending, m_limit_results);
+    }
+    void merge_partial(QueryStateBase& other) final
+    {
+        auto& partial = static_cast<QueryStateTopK&>(other);
+        for (auto& c : partial.m_candidates)
+            add(c.key, c.value);
+        m_match_count += partial.m_match_count;
+        // The candidates of every thread are in key order on their own
+        m_merged = true;
+    }
+    // Move the remaining candidates into the result
+    void finish()
+    {
+        compact();
+        if (m_merged) {
+            std::sort(m_candidates.begin(), m_candidates.end(), [](const Candidate& a, const Candidate& b) {
+                return a.key < b.key;
+            });
+        }
+        for (auto& c : m_candidates)
+            m_keys.push_back(c.key);
+    }
+
+private:
+    struct Candidate {
+        ObjKey key;
+        Mixed value;
+    };
+    KeyValues& m_keys;
+    bool m_ascending;
+    size_t m_limit_results;
+    size_t m_compact_size;
+    bool m_merged = false;
+    std::vector<Candidate> m_candidates;
+    // The best `m_limit_results` values seen so far with the worst one on top
+    std::vector<Mixed> m_best;
+
+    bool better(const Mixed& a, const Mixed& b) const noexcept
+    {
+        int c = a.compare(b);
+        return m_ascending ? c < 0 : c > 0;
+    }
+    void add(ObjKey key, Mixed value) noexcept
+    {
+        auto comparator = [this](const Mixed& a, const Mixed& b) {
+            return better(a, b);
+        };
+        if (m_best.size() < m_limit_results) {
+            m_best.push_back(value);
+            std::push_heap(m_best.begin(), m_best.end(), comparator);
+        }
+        else if (better(value, m_best.front())) {
+            std::pop_heap(m_best.begin(), m_best.end(), comparator);
+            m_best.back() = value;
+            std::push_heap(m_best.begin(), m_best.end(), comparator);
+        }
+        else if (better(m_best.front(), value)) {
+            return;
+        }
+        m_candidates.push_back({key, value});
+        if (m_candidates.size() >= m_compact_size)
+            compact();
+    }
+    void compact() noexcept
+    {
+        if (m_best.size() == m_limit_results) {
+            const Mixed& worst = m_best.front();
+            auto it = std::remove_if(m_candidates.begin(), m_candidates.end(), [&](const Candidate& c) {
+                return better(worst, c.value);
+            });
+            m_candidates.erase(it, m_candidates.end());
+        }
+        // Many values equal to the worst value may survive. Don't compact again
+        // before the number of candidates has doubled.
+        m_compact_size = std::max(m_compact_size, 2 * m_candidates.size());
+    }
+};
+
+} // anonymous namespace
+
 TableView::TableView(TableView& src, Transaction* tr, PayloadPolicy policy_mode)
     : m_source_column_key(src.m_source_column_key)
 {
@@ -405,6 +523,125 @@ void TableView::apply_descriptor_ordering(const DescriptorOrdering& new_ordering
     do_sync();
 }
 
+bool TableView::sync_from_changes(const DescriptorOrdering& new_ordering, const std::vector<ObjKey>& previous_keys,
+                                  const std::vector<ObjKey>& changed, const std::vector<ObjKey>& deleted)
+{
+    if (!m_query || m_query->m_view || m_limit != size_t(-1))
+        return false;
+    if (changed.size() + deleted.size() > m_table->size() / s_sync_from_changes_ratio)
+        return false;
+
+    // The sort columns must be properties of the table, as changes to other tables are not known
+    const SortDescriptor* sort = nullptr;
+    if (!new_ordering.is_empty()) {
+        if (new_ordering.size() != 1 || new_ordering.get_type(0) != DescriptorType::Sort)
+            return false;
+        sort = static_cast<const SortDescriptor*>(new_ordering[0]);
+        for (auto& columns : sort->get_column_keys()) {
+            if (columns.size() != 1 || columns[0].is_collection() || !m_table->valid_column(columns[0]))
+                return false;
+        }
+    }
+    // Only conditions on the properties of the objects themselves qualify. A change to another
+    // object, even of the same table, may change the values read through links or backlinks,
+    // such as `@links.@count`, while the object reading them isn't reported as changed.
+    std::vector<TableKey> link_dependencies;
+    if (ParentNode* root = m_query->root_node())
+        root->get_link_dependencies(link_dependencies);
+    if (!link_dependencies.empty())
+        return false;
+
+    util::CriticalSection cs(m_race_detector);
+    m_descriptor_ordering = new_ordering;
+    m_descriptor_ordering.collect_dependencies(m_table.unchecked_ptr());
+
+    // The objects which are still matches, in the order of the results
+    std::unordered_set<ObjKey> touched(changed.begin(), changed.end());
+    touched.insert(deleted.begin(), deleted.end());
+    std::vector<ObjKey> kept;
+    kept.reserve(previous_keys.size());
+    for (auto key : previous_keys) {
+        if (!touched.count(key))
+            kept.push_back(key);
+    }
+
+    // The sort places the objects by the values of the sort columns, and then by key, which is the
+    // order of the results of the query
+    auto sort_values = [&](ObjKey key) {
+        std::vector<Mixed> values;
+        if (sort) {
+            const Obj obj = m_table->get_object(key);
+            for (auto& columns : sort->get_column_keys())
+                values.push_back(columns[0].get_value(obj));
+        }
+        return values;
+    };
+    auto less = [&](const std::vector<Mixed>& values_a, ObjKey a, const std::vector<Mixed>& values_b, ObjKey b) {
+        for (size_t i = 0; i < values_a.size(); ++i) {
+            if (int c = values_a[i].compare(values_b[i]))
+                return *sort->is_ascending(i) ? c < 0 : c > 0;
+        }
+        return a < b;
+    };
+
+    // Evaluate the changed objects, and find where the matches go among the kept ones. The sort
+    // values of each object are read once.
+    struct Insert {
+        size_t pos;
+        ObjKey key;
+        std::vector<Mixed> values;
+    };
+    std::vector<Insert> inserts;
+    std::unordered_set<ObjKey> evaluated;
+    if (!changed.empty())
+        m_query->init();
+    for (auto key : changed) {
+        if (!evaluated.insert(key).second)
+            continue;
+        if (!m_table->is_valid(key) || !m_query->eval_object(m_table->get_object(key)))
+            continue;
+        inserts.push_back({0, key, sort_values(key)});
+    }
+    if (sort && !inserts.empty()) {
+        std::vector<std::vector<Mixed>> kept_values;
+        kept_values.reserve(kept.size());
+        for (auto key : kept)
+            kept_values.push_back(sort_values(key));
+        for (auto& insert : inserts) {
+            insert.pos = std::partition_point(kept_values.begin(), kept_values.end(),
+                                              [&](const std::vector<Mixed>& values) {
+                                                  size_t ndx = &values - kept_values.data();
+                                                  return less(values, kept[ndx], insert.values, insert.key);
+                                              }) -
+                         kept_values.begin();
+        }
+    }
+    else {
+        for (auto& insert : inserts) {
+            insert.pos = std::lower_bound(kept.begin(), kept.end(), insert.key) - kept.begin();
+        }
+    }
+    std::sort(inserts.begin(), inserts.end(), [&](const Insert& a, const Insert& b) {
+        return a.pos < b.pos || (a.pos == b.pos && less(a.values, a.key, b.values, b.key));
+    });
+
+    if (!m_key_values.is_attached())
+        m_key_values.create();
+    m_key_values.clear();
+    m_key_values.reserve(kept.size() + inserts.size());
+    auto insert = inserts.begin();
+    for (size_t pos = 0; pos <= kept.size(); ++pos) {
+        for (; insert != inserts.end() && insert->pos == pos; ++insert)
+            m_key_values.add(insert->key);
+        if (pos < kept.size())
+            m_key_values.add(kept[pos]);
+    }
+
+    m_last_seen_versions.clear();
+    get_dependencies(m_last_seen_versions);
+    return true;
+}
+
 std::string TableView::get_descriptor_ordering_description() const
 {
     return m_descriptor_ordering.get_description(m_table);
@@ -479,8 +716,19 @@ void TableView::do_sync()
                     limit = l;
             }
         }
-        QueryStateFindAll<std::vector<ObjKey>> st(m_key_values, limit);
-        m_query->do_find_all(st);
+        if (auto sort = get_top_k_sort(limit)) {
+            auto& col = sort->get_column_keys()[0][0];
+            size_t top_k = static_cast<const LimitDescriptor*>(m_descriptor_ordering[1])->get_limit();
+            if (!find_top_k_using_index(*sort, top_k)) {
+                QueryStateTopK st(m_key_values, *sort->is_ascending(0), top_k);
+                m_query->do_find_all(st, col);
+                st.finish();
+            }
+        }
+        else {
+            QueryStateFindAll<std::vector<ObjKey>> st(m_key_values, limit);
+            m_query->do_find_all(st);
+        }
     }
 
     apply_descriptors(m_descriptor_ordering);
@@ -488,6 +736,69 @@ void TableView::do_sync()
     get_dependencies(m_last_seen_versions);
 }
 
+const SortDescriptor* TableView::get_top_k_sort(size_t limit) const
+{
+    // The matches can be reduced to the candidates for the first N objects
+    // while running the query if the results are sorted and then limited
+    if (limit != size_t(-1) || m_descriptor_ordering.size() < 2 ||
+        m_descriptor_ordering.get_type(0) != DescriptorType::Sort ||
+        m_descriptor_ordering.get_type(1) != DescriptorType::Limit ||
+        static_cast<const LimitDescriptor*>(m_descriptor_ordering[1])->get_limit() == 0)
+        return nullptr;
+
+    auto sort = static_cast<const SortDescriptor*>(m_descriptor_ordering[0]);
+    auto& columns = sort->get_column_keys()[0];
+    // Sorting over links or on invalid columns is left to the regular code path
+    if (columns.size() != 1 || columns[0].is_collection() || !m_table->valid_column(columns[0]))
+        return nullptr;
+    return sort;
+}
+
+bool TableView::find_top_k_using_index(const SortDescriptor& sort, size_t top_k)
+{
+    // Objects are visited in sort order, so only the leading part of the index has to be
+    // checked. Queries restricted to a view are left to the regular code path.
+    if (sort.get_column_keys().size() != 1 || m_query->m_view)
+        return false;
+    ColKey col = sort.get_column_keys()[0][0];
+    if (m_table->search_index_type(col) != IndexType::Ordered)
+        return false;
+    auto index = static_cast<const OrderedIndex*>(m_table->get_search_index(col));
+
+    const bool has_conditions = m_query->has_conditions();
+    if (has_conditions) {
+        // The objects are evaluated one at a time, as when the query is restricted to a view
+        ParentNode* root = m_query->root_node();
+        root->init(false);
+        std::vector<ParentNode*> children;
+        root->gather_children(children);
+    }
+
+    // If few objects match, scanning the table and keeping the best candidates is cheaper
+    // than visiting the objects one by one through the index
+    const size_t max_visits = std::max(top_k * 4, index->size() / 16);
+    size_t visits = 0;
+    bool exhausted = false;
+    index->for_each_in_order(*sort.is_ascending(0), [&](ObjKey key) {
+        if (has_conditions) {
+            if (++visits > max_visits) {
+                exhausted = true;
+                return IteratorControl::Stop;
+            }
+            if (!m_query->eval_object(m_table->get_object(key)))
+                return IteratorControl::AdvanceToNext;
+        }
+        m_key_values.add(key);
+        return m_key_values.size() < top_k ? IteratorControl::AdvanceToNext : IteratorControl::Stop;
+    });
+
+    if (exhausted) {
+        m_key_values.clear();
+        return false;
+    }
+    return true;
+}
+
 void TableView::apply_descriptors(const DescriptorOrdering& ordering)
 {
     if (ordering.is_empty())
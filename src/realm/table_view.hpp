@@ -375,6 +375,19 @@ public:
     // calling sort and distinct. This is a convenience method for bindings.
     void apply_descriptor_ordering(const DescriptorOrdering& new_ordering);
 
+    // Alternative to apply_descriptor_ordering() for a view which was in sync at an earlier version,
+    // when its contents were `previous_keys`: the view is brought in sync by evaluating only the
+    // objects inserted or modified since then, `changed`, and dropping those deleted, `deleted`,
+    // instead of running the query. Returns false, leaving the view out of sync, if the results may
+    // depend on other tables, if the ordering isn't a single sort on properties of the table, or if
+    // so many objects changed that running the query is cheaper.
+    bool sync_from_changes(const DescriptorOrdering& new_ordering, const std::vector<ObjKey>& previous_keys,
+                           const std::vector<ObjKey>& changed, const std::vector<ObjKey>& deleted);
+
+    // Running the query is cheaper than evaluating the changed objects one at a time once more than
+    // this fraction of the table changed
+    static constexpr size_t s_sync_from_changes_ratio = 16;
+
     // Gets a readable and parsable string which completely describes the sort and
     // distinct operations applied to this view.
     std::string get_descriptor_ordering_description() const;
@@ -401,6 +414,12 @@ protected:
 
     void do_sync();
     void apply_descriptors(const DescriptorOrdering&);
+    // Returns the sort descriptor if the ordering starts with a sort followed by
+    // a limit, and the query can keep only the candidates for the limited result.
+    const SortDescriptor* get_top_k_sort(size_t limit) const;
+    // Finds the first `top_k` matches of the query by walking an ordered index on the
+    // sort column. Returns false if the index cannot be used or the query is too selective.
+    bool find_top_k_using_index(const SortDescriptor& sort, size_t top_k);
 
     mutable ConstTableRef m_table;
     // The source column index that this view contain backlinks for.
@@ -19,6 +19,8 @@
 #include <realm/tokenizer.hpp>
 #include <realm/exceptions.hpp>
 
+#include <algorithm>
+
 namespace realm {
 
 Tokenizer::~Tokenizer() {}
@@ -136,6 +138,26 @@ TokenInfoMap Tokenizer::get_token_info()
     return info;
 }
 
+TokenFrequencies Tokenizer::get_token_frequencies()
+{
+    std::vector<std::string> tokens;
+    while (next()) {
+        tokens.emplace_back(get_token());
+    }
+    std::sort(tokens.begin(), tokens.end());
+
+    TokenFrequencies frequencies;
+    for (auto& token : tokens) {
+        if (!frequencies.empty() && frequencies.back().first == token) {
+            frequencies.back().second++;
+        }
+        else {
+            frequencies.emplace_back(std::move(token), 1);
+        }
+    }
+    return frequencies;
+}
+
 class DefaultTokenizer : public Tokenizer {
 public:
     bool next() override;
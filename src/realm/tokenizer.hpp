@@ -47,6 +47,8 @@ struct TokenInfo {
 };
 
 using TokenInfoMap = std::map<std::string, TokenInfo>;
+// The distinct tokens of a text sorted, each with the number of times it occurs
+using TokenFrequencies = std::vector<std::pair<std::string, unsigned>>;
 
 class Tokenizer {
 public:
@@ -62,6 +64,7 @@ public:
     std::set<std::string> get_all_tokens();
     std::pair<std::set<std::string>, std::set<std::string>> get_search_tokens();
     TokenInfoMap get_token_info();
+    TokenFrequencies get_token_frequencies();
 
     static std::unique_ptr<Tokenizer> get_instance();
 
@@ -207,7 +207,7 @@ DB::version_type Transaction::commit()
     REALM_ASSERT(is_attached());
 
     // before committing, allow any accessors at group level or below to sync
-    flush_accessors_for_commit();
+    flush_accessors_for_commit(db->m_commit_encodings);
 
     DB::version_type new_version = db->do_commit(*this); // Throws
 
@@ -259,7 +259,7 @@ VersionID Transaction::commit_and_continue_as_read(bool commit_to_disk)
     if (m_transact_stage != DB::transact_Writing)
         throw WrongTransactionState("Not a write transaction");
 
-    flush_accessors_for_commit();
+    flush_accessors_for_commit(db->m_commit_encodings);
 
     DB::version_type version = db->do_commit(*this, commit_to_disk); // Throws
 
@@ -269,7 +269,7 @@ VersionID Transaction::commit_and_continue_as_read(bool commit_to_disk)
     // completed commit.
 
     try {
-        // Grabbing the new lock before releasing the old one prevents m_transaction_count
+        // Grabbing the new lock before releasing the old one prevents the read lock count
         // from going shortly to zero
         DB::ReadLockInfo new_read_lock = db->grab_read_lock(DB::ReadLockInfo::Live, VersionID()); // Throws
 
@@ -340,7 +340,7 @@ VersionID Transaction::commit_and_continue_writing()
         throw WrongTransactionState("Not a write transaction");
 
     // before committing, allow any accessors at group level or below to sync
-    flush_accessors_for_commit();
+    flush_accessors_for_commit(db->m_commit_encodings);
 
     DB::version_type version = db->do_commit(*this); // Throws
 
@@ -526,7 +526,7 @@ void Transaction::upgrade_file_format(int target_file_format_version)
     // Be sure to revisit the following upgrade logic when a new file format
     // version is introduced. The following assert attempt to help you not
     // forget it.
-    REALM_ASSERT_EX(target_file_format_version == 24, target_file_format_version);
+    REALM_ASSERT_EX(target_file_format_version == 25, target_file_format_version);
 
     // DB::do_open() must ensure that only supported version are allowed.
     // It does that by asking backup if the current file format version is
@@ -577,6 +577,13 @@ void Transaction::upgrade_file_format(int target_file_format_version)
             t->migrate_col_keys();
         }
     }
+    if (current_file_format_version < 25) {
+        // Let range queries skip the clusters written by older versions too
+        for (auto k : table_keys) {
+            auto t = get_table(k);
+            t->migrate_value_ranges();
+        }
+    }
     // NOTE: Additional future upgrade steps go here.
 }
 
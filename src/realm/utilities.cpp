@@ -38,30 +38,32 @@
 #ifdef REALM_COMPILER_SSE
 #ifdef _MSC_VER
 #include <intrin.h>
+#else
+#include <cpuid.h>
 #endif
 #endif
 
 namespace {
 
-#ifdef REALM_COMPILER_SSE
-#if !defined __clang__ && ((defined(_MSC_FULL_VER) && _MSC_FULL_VER >= 160040219) || defined __GNUC__)
-#if defined REALM_COMPILER_AVX && defined __GNUC__
-#define _XCR_XFEATURE_ENABLED_MASK 0
+// The _xgetbv() intrinsic is available from Visual Studio 2010 SP1. Other
+// compilers, including clang (which defines __GNUC__ as 4.2, so that a check
+// for a GCC version does not apply to it), use the instruction directly.
+#if defined REALM_COMPILER_AVX && (!defined _MSC_VER || _MSC_FULL_VER >= 160040219)
+#define REALM_HAVE_XGETBV
 
-inline unsigned long long _xgetbv(unsigned index)
+// The mask of the register states which the OS saves on context switches
+// (XCR0)
+inline unsigned long long xcr_feature_enabled_mask()
 {
-#if REALM_HAVE_AT_LEAST_GCC(4, 4)
+#ifdef _MSC_VER
+    return _xgetbv(0);
+#else
     unsigned int eax, edx;
-    __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(index));
+    __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
     return (static_cast<unsigned long long>(edx) << 32) | eax;
-#else
-    static_cast<void>(index);
-    return 0;
 #endif
 }
 
-#endif
-#endif
 #endif
 
 } // anonymous namespace
@@ -104,27 +106,41 @@ void cpuid_init()
 
     bool avxSupported = false;
 
-// seems like in jenkins builds, __GNUC__ is defined for clang?! todo fixme
-#if !defined __clang__ && ((defined(_MSC_FULL_VER) && _MSC_FULL_VER >= 160040219) || defined __GNUC__)
+#ifdef REALM_HAVE_XGETBV
     bool osUsesXSAVE_XRSTORE = cret & (1 << 27) || false;
     bool cpuAVXSuport = cret & (1 << 28) || false;
 
     if (osUsesXSAVE_XRSTORE && cpuAVXSuport) {
-        // Check if the OS will save the YMM registers
-        unsigned long long xcrFeatureMask = _xgetbv(_XCR_XFEATURE_ENABLED_MASK);
-        avxSupported = (xcrFeatureMask & 0x6) || false;
+        // Check if the OS will save both the XMM and the YMM registers
+        unsigned long long xcrFeatureMask = xcr_feature_enabled_mask();
+        avxSupported = (xcrFeatureMask & 0x6) == 0x6;
     }
 #endif
 
     if (avxSupported) {
         avx_support = 0; // AVX1 supported
+
+        // AVX2 is reported in bit 5 of EBX of the extended features leaf (eax = 7, ecx = 0). The YMM state check
+        // above also covers AVX2, so no additional OS support test is needed.
+        int ebx7 = 0;
+#ifdef _MSC_VER
+        __cpuid(CPUInfo, 0);
+        if (CPUInfo[0] >= 7) {
+            __cpuidex(CPUInfo, 7, 0);
+            ebx7 = CPUInfo[1];
+        }
+#else
+        unsigned int eax7, ebx, ecx7, edx7;
+        if (__get_cpuid_count(7, 0, &eax7, &ebx, &ecx7, &edx7))
+            ebx7 = int(ebx);
+#endif
+        if (ebx7 & (1 << 5))
+            avx_support = 1; // AVX2 supported
     }
     else {
         avx_support = -1; // No AVX supported
     }
 
-    // 1 is reserved for AVX2
-
 #endif
 }
 } // namespace realm
@@ -741,6 +741,55 @@ struct BenchmarkInsertPKToIndexForType : public BenchmarkWithType<Type> {
     std::set<underlying_type> m_unique_randoms;
 };
 
+template <typename Type, IndexType index_type>
+struct BenchmarkFindPrimaryKeyForType : public BenchmarkWithType<Type> {
+    using Base = BenchmarkWithType<Type>;
+    using underlying_type = typename Type::underlying_type;
+    BenchmarkFindPrimaryKeyForType<Type, index_type>()
+        : BenchmarkWithType<Type>()
+    {
+        Base::benchmark_name = util::format("FindPrimaryKey<%1><%2>", get_data_type_name(Type::data_type),
+                                            index_type == IndexType::Hash ? "HashIndex" : "SearchIndex");
+    }
+    void before_all(DBRef group) override
+    {
+        WriteTransaction tr(group);
+        TableRef t =
+            tr.get_group().add_table_with_primary_key(Base::name(), Type::data_type, "pk", Type::is_nullable);
+        Base::m_col = t->get_primary_key_column();
+        t->add_search_index(Base::m_col, index_type);
+        while (m_unique_randoms.size() < BASE_SIZE) {
+            int64_t random_int = m_random.draw_int<int64_t>();
+            m_unique_randoms.insert(m_test_value_generator.convert_for_test<underlying_type>(random_int));
+        }
+        for (auto& value : m_unique_randoms) {
+            t->create_object_with_primary_key(value);
+        }
+        tr.commit();
+        // Look the keys up in random order, so that the general index gets no help from
+        // lookups of neighbouring values
+        m_needles.assign(m_unique_randoms.begin(), m_unique_randoms.end());
+        m_random.shuffle(m_needles.begin(), m_needles.end());
+    }
+    void operator()(DBRef) override
+    {
+        for (auto& needle : m_needles) {
+            ObjKey key = Base::m_table->find_primary_key(needle);
+            static_cast<void>(key);
+        }
+    }
+    TestValueGenerator m_test_value_generator;
+    Random m_random;
+    std::set<underlying_type> m_unique_randoms;
+    std::vector<underlying_type> m_needles;
+};
+
+// BENCH() does not accept template arguments containing commas
+template <typename Type>
+using BenchmarkFindPrimaryKeyWithSearchIndex = BenchmarkFindPrimaryKeyForType<Type, IndexType::General>;
+template <typename Type>
+using BenchmarkFindPrimaryKeyWithHashIndex = BenchmarkFindPrimaryKeyForType<Type, IndexType::Hash>;
+
 template <typename Type>
 struct BenchmarkEraseObjectForType : public BenchmarkWithType<Type> {
     using Base = BenchmarkWithType<Type>;
@@ -2641,6 +2690,15 @@ int benchmark_common_tasks_main()
     BENCH(BenchmarkInsertPKToIndexForType<NullableIndexed<String>>);
     BENCH(BenchmarkInsertPKToIndexForType<NullableIndexed<Int>>);
 
+    BENCH(BenchmarkFindPrimaryKeyWithSearchIndex<Prop<Int>>);
+    BENCH(BenchmarkFindPrimaryKeyWithHashIndex<Prop<Int>>);
+    BENCH(BenchmarkFindPrimaryKeyWithSearchIndex<Prop<String>>);
+    BENCH(BenchmarkFindPrimaryKeyWithHashIndex<Prop<String>>);
+    BENCH(BenchmarkFindPrimaryKeyWithSearchIndex<Prop<ObjectId>>);
+    BENCH(BenchmarkFindPrimaryKeyWithHashIndex<Prop<ObjectId>>);
+    BENCH(BenchmarkFindPrimaryKeyWithSearchIndex<Prop<UUID>>);
+    BENCH(BenchmarkFindPrimaryKeyWithHashIndex<Prop<UUID>>);
+
     BENCH(BenchmarkEraseObjectForType<Prop<String>>);
     BENCH(BenchmarkEraseObjectForType<Prop<Int>>);
     BENCH(BenchmarkEraseObjectForType<Prop<Timestamp>>);
@@ -0,0 +1,125 @@
+/*************************************************************************
+ *
+ * Copyright 2024 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+// Measures the throughput of beginning and ending read transactions on the
+// latest version from an increasing number of threads, with and without a
+// concurrent writer.
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <realm.hpp>
+#include <realm/disable_sync_to_disk.hpp>
+
+#include "../util/timer.hpp"
+#include "../util/benchmark_results.hpp"
+#include "../util/test_path.hpp"
+
+using namespace realm;
+using namespace realm::test_util;
+
+namespace {
+
+const size_t reads_per_thread = 200000;
+const size_t max_threads = 64;
+
+// Run `num_threads` threads each beginning and ending `reads_per_thread` read
+// transactions, and return the elapsed time in seconds
+double run_readers(DBRef db, size_t num_threads, bool with_writer)
+{
+    std::atomic<size_t> ready{0};
+    std::atomic<bool> go{false};
+    std::atomic<size_t> done{0};
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < num_threads; ++i) {
+        threads.emplace_back([&] {
+            ++ready;
+            while (!go)
+                std::this_thread::yield();
+            int64_t sum = 0;
+            for (size_t j = 0; j < reads_per_thread; ++j) {
+                auto rt = db->start_read();
+                sum += rt->get_version();
+            }
+            if (sum == 0)
+                std::abort();
+            ++done;
+        });
+    }
+
+    std::thread writer;
+    if (with_writer) {
+        writer = std::thread([&] {
+            int64_t value = 0;
+            while (done < num_threads) {
+                auto wt = db->start_write();
+                wt->get_table("table")->begin()->set("value", ++value);
+                wt->commit();
+            }
+        });
+    }
+
+    while (ready < num_threads)
+        std::this_thread::yield();
+    Timer timer(Timer::type_RealTime);
+    go = true;
+    for (auto& t : threads)
+        t.join();
+    double seconds = timer.get_elapsed_time();
+    if (writer.joinable())
+        writer.join();
+    return seconds;
+}
+
+} // anonymous namespace
+
+int main(int argc, const char** argv)
+{
+    if (!initialize_test_path(argc, argv))
+        return 1;
+    disable_sync_to_disk();
+
+    TestPathGuard path(get_test_path_prefix() + "benchmark-read-scaling.realm");
+    DBRef db = DB::create(make_in_realm_history(), path);
+    {
+        auto wt = db->start_write();
+        auto table = wt->add_table("table");
+        table->add_column(type_Int, "value");
+        table->create_object();
+        wt->commit();
+    }
+
+    std::string results_file_stem = get_test_path_prefix() + "results";
+    BenchmarkResults results(40, "benchmark-read-scaling", results_file_stem.c_str());
+
+    for (bool with_writer : {false, true}) {
+        for (size_t num_threads = 1; num_threads <= max_threads; num_threads *= 2) {
+            double seconds = run_readers(db, num_threads, with_writer);
+            double per_second = double(num_threads * reads_per_thread) / seconds;
+            std::string ident = util::format("read_%1_threads%2", num_threads, with_writer ? "_writer" : "");
+            std::string lead_text =
+                util::format("Begin/end read, %1 threads%2", num_threads, with_writer ? ", writer" : "");
+            results.submit_single(ident.c_str(), lead_text.c_str(), "runtime_secs", seconds);
+            std::cout << "  " << size_t(per_second) << " transactions per second" << std::endl;
+        }
+    }
+    return 0;
+}
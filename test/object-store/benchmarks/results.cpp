@@ -29,8 +29,12 @@
 #include <realm/object-store/results.hpp>
 #include <realm/object-store/schema.hpp>
 #include <realm/object-store/sectioned_results.hpp>
+#include <realm/object-store/impl/collection_notifier.hpp>
 #include <realm/object-store/impl/realm_coordinator.hpp>
 
+#include <numeric>
+#include <random>
+
 using namespace realm;
 
 TEST_CASE("Benchmark results", "[benchmark][results]") {
@@ -335,6 +339,81 @@ TEST_CASE("Benchmark results notifier", "[benchmark][results]") {
     }
 }
 
+TEST_CASE("Benchmark sorted results changes", "[benchmark][results]") {
+    // A leaderboard: the results are sorted by score, and updating scores moves
+    // players around in the results
+    InMemoryTestFile config;
+    config.automatic_change_notifications = false;
+    config.schema = Schema{{"player", {{"score", PropertyType::Int}}}};
+
+    auto realm = Realm::get_shared_realm(config);
+    auto& coordinator = *_impl::RealmCoordinator::get_coordinator(config.path);
+    auto table = realm->read_group().get_table("class_player");
+    auto col = table->get_column_key("score");
+
+    constexpr size_t player_count = 100'000;
+    realm->begin_transaction();
+    ObjKeys keys;
+    table->create_objects(player_count, keys);
+    for (size_t i = 0; i < player_count; ++i) {
+        table->get_object(keys[i]).set(col, int64_t(i));
+    }
+    realm->commit_transaction();
+
+    std::mt19937_64 rng(0);
+    auto update_scores = [&](size_t count) {
+        realm->begin_transaction();
+        for (size_t i = 0; i < count; ++i) {
+            auto obj = table->get_object(keys[rng() % player_count]);
+            obj.set(col, obj.get<int64_t>(col) + int64_t(rng() % 10'000));
+        }
+        realm->commit_transaction();
+        coordinator.on_change();
+        realm->notify();
+    };
+
+    auto results = Results(realm, table).sort({{"score", false}});
+    auto token = results.add_notification_callback([](CollectionChangeSet) {});
+    coordinator.on_change();
+    realm->notify();
+
+    BENCHMARK("update 10 scores") {
+        update_scores(10);
+    };
+    BENCHMARK("update 1000 scores") {
+        update_scores(1000);
+    };
+    BENCHMARK("update 10000 scores") {
+        update_scores(10'000);
+    };
+
+    std::vector<size_t> prev(player_count);
+    std::iota(prev.begin(), prev.end(), 0);
+    auto none_modified = [](size_t) {
+        return false;
+    };
+
+    BENCHMARK_ADVANCED("calculate 1000 moved rows")(Catch::Benchmark::Chronometer meter)
+    {
+        auto next = prev;
+        for (size_t i = 0; i < 1000; ++i) {
+            std::swap(next[rng() % player_count], next[rng() % player_count]);
+        }
+        meter.measure([&] {
+            return _impl::CollectionChangeBuilder::calculate(prev, next, none_modified);
+        });
+    };
+
+    BENCHMARK_ADVANCED("calculate shuffled rows")(Catch::Benchmark::Chronometer meter)
+    {
+        auto next = prev;
+        std::shuffle(next.begin(), next.end(), rng);
+        meter.measure([&] {
+            return _impl::CollectionChangeBuilder::calculate(prev, next, none_modified);
+        });
+    };
+}
+
 TEST_CASE("aggregates", "[benchmark][aggregate]") {
     InMemoryTestFile config;
     config.schema = Schema{
@@ -1454,6 +1454,31 @@ TEST_CASE("C API - realm", "[c_api]") {
         REQUIRE(realm_equals(realm3.get(), realm2.get()));
     }
 
+    SECTION("db metrics") {
+        realm_db_metrics_t metrics;
+        CHECK(checked(realm_get_db_metrics(realm, &metrics)));
+        CHECK(metrics.write_group.count == 0);
+
+        TestFile test_file2;
+        auto config2 = make_config(test_file2.path.c_str(), true);
+        CHECK(!realm_config_get_db_metrics_enabled(config2.get()));
+        realm_config_set_db_metrics_enabled(config2.get(), true);
+        CHECK(realm_config_get_db_metrics_enabled(config2.get()));
+        auto realm2 = cptr_checked(realm_open(config2.get()));
+        CHECK(checked(realm_begin_write(realm2.get())));
+        CHECK(checked(realm_commit(realm2.get())));
+
+        CHECK(checked(realm_get_db_metrics(realm2.get(), &metrics)));
+        CHECK(metrics.write_lock_wait.count > 0);
+        CHECK(metrics.write_group.count > 0);
+        CHECK(metrics.sync.count > 0);
+        CHECK(metrics.write_group.total_ns >= metrics.write_group.max_ns);
+        CHECK(metrics.bytes_written > 0);
+        uint64_t live_versions;
+        CHECK(checked(realm_get_num_versions(realm2.get(), &live_versions)));
+        CHECK(metrics.live_versions == live_versions);
+    }
+
     SECTION("native ptr conversion") {
         realm::SharedRealm native;
         _realm_get_native_ptr(realm, &native, sizeof(native));
@@ -4563,6 +4588,39 @@ TEST_CASE("C API - queries", "[c_api]") {
             }
         }
 
+        SECTION("realm_query_group_by()") {
+            auto all = cptr_checked(realm_query_parse(realm, class_foo.key, "TRUEPREDICATE", 0, nullptr));
+            realm_group_by_aggregate_t aggregates[2] = {{RLM_GROUP_BY_COUNT, 0}, {RLM_GROUP_BY_MAX, foo_int_key}};
+            auto result = cptr_checked(realm_query_group_by(all.get(), &foo_int_key, 1, aggregates, 2));
+            size_t count;
+            CHECK(checked(realm_group_by_result_count(result.get(), &count)));
+            CHECK(count == 2);
+            realm_value_t key;
+            realm_value_t values[2];
+            CHECK(checked(realm_group_by_result_get(result.get(), 0, &key, values)));
+            CHECK(rlm_val_eq(key, int_val1));
+            CHECK(values[0].type == RLM_TYPE_INT);
+            CHECK(values[0].integer == 2);
+            CHECK(rlm_val_eq(values[1], int_val1));
+            CHECK(checked(realm_group_by_result_get(result.get(), 1, &key, nullptr)));
+            CHECK(rlm_val_eq(key, int_val2));
+            CHECK(!realm_group_by_result_get(result.get(), 2, &key, values));
+            CHECK_ERR(RLM_ERR_INDEX_OUT_OF_BOUNDS);
+
+            // The clauses of the query string
+            auto grouped = cptr_checked(realm_query_parse(realm, class_foo.key,
+                                                          "int > 200 GROUP BY(string) AGGREGATE(@count)", 0, nullptr));
+            result = cptr_checked(realm_query_group_by(grouped.get(), nullptr, 0, nullptr, 0));
+            CHECK(checked(realm_group_by_result_count(result.get(), &count)));
+            CHECK(count == 1);
+            CHECK(checked(realm_group_by_result_get(result.get(), 0, &key, values)));
+            CHECK(rlm_val_eq(key, rlm_str_val("")));
+            CHECK(values[0].integer == 1);
+
+            CHECK(!realm_query_group_by(all.get(), nullptr, 0, nullptr, 0));
+            CHECK_ERR(RLM_ERR_INVALID_ARGUMENT);
+        }
+
         SECTION("realm_query_parse() errors") {
             // Invalid class key
             CHECK(!realm_query_parse(realm, 123123123, "string == $0", num_args, arg_list));
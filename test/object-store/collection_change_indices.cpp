@@ -22,7 +22,9 @@
 
 #include "util/index_helpers.hpp"
 
+#include <algorithm>
 #include <limits>
+#include <numeric>
 
 using namespace realm;
 
@@ -649,6 +651,47 @@ TEST_CASE("collection_change: calculate() sorted", "[collection change]") {
         REQUIRE_INDICES(c.insertions, 0, 3, 7, 10);
     }
 
+    SECTION("reports the fewest moves for large reorderings") {
+        std::vector<size_t> prev(5000);
+        std::iota(prev.begin(), prev.end(), 0);
+        auto next = prev;
+        // Move the rows 100, 200, ... 4900 to the front, leaving everything else in order
+        std::stable_partition(next.begin(), next.end(), [](size_t row) {
+            return row % 100 == 0 && row > 0;
+        });
+        c = _impl::CollectionChangeBuilder::calculate(prev, next, none_modified);
+        REQUIRE(c.deletions.count() == 49);
+        REQUIRE(c.insertions.count() == 49);
+        REQUIRE(c.insertions.count(0, 49) == 49);
+        REQUIRE(c.deletions.contains(100));
+        REQUIRE(c.deletions.contains(4900));
+
+        // Swapping two rows can be done by moving either of them
+        next = prev;
+        std::swap(next[1000], next[1001]);
+        auto modified = [](size_t row) {
+            return row == 1001;
+        };
+        c = _impl::CollectionChangeBuilder::calculate(prev, next, modified);
+        REQUIRE_INDICES(c.deletions, 1001);
+        REQUIRE_INDICES(c.insertions, 1000);
+    }
+
+    SECTION("reports all rows as moved above the move calculation limit") {
+        std::vector<size_t> prev(100);
+        std::iota(prev.begin(), prev.end(), 0);
+        auto next = prev;
+        std::swap(next[10], next[11]);
+        c = _impl::CollectionChangeBuilder::calculate(prev, next, none_modified, 50);
+        REQUIRE(c.deletions.count() == 90);
+        REQUIRE(c.deletions.count(10, 100) == 90);
+        REQUIRE(c.insertions.count() == 90);
+        REQUIRE(c.insertions.count(10, 100) == 90);
+        c = _impl::CollectionChangeBuilder::calculate(prev, next, none_modified, 90);
+        REQUIRE_INDICES(c.deletions, 11);
+        REQUIRE_INDICES(c.insertions, 10);
+    }
+
     SECTION("produces diffs which let merge collapse insert -> move -> delete to no-op") {
         auto four_modified = [](auto ndx) {
             return ndx == 4;
@@ -3347,6 +3347,208 @@ TEST_CASE("results: notifier with no callbacks", "[notifications][results]") {
     }
 }
 
+TEST_CASE("results: notifier updates results from changes", "[notifications][results]") {
+    _impl::RealmCoordinator::assert_no_open_realms();
+    InMemoryTestFile config;
+    config.automatic_change_notifications = false;
+
+    auto r = Realm::get_shared_realm(config);
+    r->update_schema({
+        {"object",
+         {
+             {"value", PropertyType::Int},
+             {"name", PropertyType::String},
+         }},
+    });
+
+    auto table = r->read_group().get_table("class_object");
+    auto col_value = table->get_column_key("value");
+    auto col_name = table->get_column_key("name");
+    r->begin_transaction();
+    for (int i = 0; i < 200; ++i)
+        table->create_object().set(col_value, i).set(col_name, util::format("name %1", i % 7));
+    r->commit_transaction();
+
+    auto write = [&](auto&& f) {
+        r->begin_transaction();
+        f();
+        r->commit_transaction();
+        advance_and_notify(*r);
+    };
+    auto query = table->where().greater(col_value, 50);
+    DescriptorOrdering ordering;
+    ordering.append_sort(SortDescriptor({{col_name}, {col_value}}, {true, false}));
+    Results results(r, query, ordering);
+
+    CollectionChangeSet change;
+    auto token = results.add_notification_callback([&](CollectionChangeSet c) {
+        change = c;
+    });
+    advance_and_notify(*r);
+
+    auto require_in_sync = [&] {
+        auto expected = query.find_all(ordering);
+        REQUIRE(results.size() == expected.size());
+        for (size_t i = 0; i < expected.size(); ++i)
+            REQUIRE(results.get(i).get_key() == expected.get_key(i));
+    };
+    require_in_sync();
+
+    SECTION("modifying an object moves it") {
+        write([&] {
+            table->get_object(100).set(col_name, "a");
+        });
+        require_in_sync();
+        REQUIRE(results.get(0).get_key() == ObjKey(100));
+        REQUIRE_INDICES(change.insertions, 0);
+        REQUIRE(change.deletions.count() == 1);
+    }
+
+    SECTION("objects starting and stopping to match") {
+        write([&] {
+            table->get_object(10).set(col_value, 300);
+            table->get_object(150).set(col_value, 0);
+        });
+        require_in_sync();
+        REQUIRE(change.insertions.count() == 1);
+        REQUIRE(change.deletions.count() == 1);
+    }
+
+    SECTION("insertions and deletions") {
+        write([&] {
+            table->create_object().set(col_value, 60).set(col_name, "name 3");
+            table->create_object().set(col_value, 10).set(col_name, "name 3");
+            table->remove_object(ObjKey(120));
+        });
+        require_in_sync();
+        REQUIRE(change.insertions.count() == 1);
+        REQUIRE(change.deletions.count() == 1);
+    }
+
+    SECTION("many small commits") {
+        for (int i = 0; i < 10; ++i) {
+            write([&] {
+                table->get_object(i * 17).set(col_value, 200 - i * 17);
+            });
+            require_in_sync();
+        }
+    }
+}
+
+TEST_CASE("results: notifier follows changes to backlinks", "[notifications][results]") {
+    _impl::RealmCoordinator::assert_no_open_realms();
+    InMemoryTestFile config;
+    config.automatic_change_notifications = false;
+
+    auto r = Realm::get_shared_realm(config);
+    r->update_schema({
+        {"object",
+         {
+             {"value", PropertyType::Int},
+         }},
+        {"linking object", {{"link", PropertyType::Object | PropertyType::Nullable, "object"}}},
+    });
+
+    auto table = r->read_group().get_table("class_object");
+    auto origin = r->read_group().get_table("class_linking object");
+    auto col_value = table->get_column_key("value");
+    auto col_link = origin->get_column_key("link");
+    r->begin_transaction();
+    for (int i = 0; i < 100; ++i)
+        table->create_object().set(col_value, i);
+    origin->create_object().set(col_link, ObjKey(10));
+    r->commit_transaction();
+
+    // Adding or removing a link only reports the linking object as modified
+    auto query = table->query("@links.@count > 0");
+    Results results(r, query);
+    CollectionChangeSet change;
+    auto token = results.add_notification_callback([&](CollectionChangeSet c) {
+        change = c;
+    });
+    advance_and_notify(*r);
+    REQUIRE(results.size() == 1);
+
+    r->begin_transaction();
+    origin->create_object().set(col_link, ObjKey(20));
+    r->commit_transaction();
+    advance_and_notify(*r);
+    REQUIRE(results.size() == 2);
+    REQUIRE(results.get(1).get_key() == ObjKey(20));
+    REQUIRE_INDICES(change.insertions, 1);
+
+    r->begin_transaction();
+    origin->begin()->set_null(col_link);
+    r->commit_transaction();
+    advance_and_notify(*r);
+    REQUIRE(results.size() == 1);
+    REQUIRE(results.get(0).get_key() == ObjKey(20));
+    REQUIRE_INDICES(change.deletions, 0);
+}
+
+TEST_CASE("notifications: many notifiers", "[notifications][results]") {
+    _impl::RealmCoordinator::assert_no_open_realms();
+    InMemoryTestFile config;
+    config.automatic_change_notifications = false;
+
+    auto r = Realm::get_shared_realm(config);
+    r->update_schema({
+        {"object",
+         {
+             {"value", PropertyType::Int},
+         }},
+    });
+
+    auto table = r->read_group().get_table("class_object");
+    auto col_value = table->get_column_key("value");
+    r->begin_transaction();
+    for (int i = 0; i < 100; ++i)
+        table->create_object().set(col_value, i);
+    r->commit_transaction();
+
+    // Enough notifiers to be run on several threads
+    constexpr int num_notifiers = 64;
+    std::vector<Results> results;
+    std::vector<NotificationToken> tokens;
+    std::vector<CollectionChangeSet> changes(num_notifiers);
+    std::vector<int> delivery_order;
+    // The notifiers refer to their Results, so these must not be moved
+    results.reserve(num_notifiers);
+    for (int i = 0; i < num_notifiers; ++i) {
+        results.emplace_back(r, table->where().greater_equal(col_value, i));
+        tokens.push_back(results.back().add_notification_callback([&, i](CollectionChangeSet c) {
+            changes[i] = c;
+            delivery_order.push_back(i);
+        }));
+    }
+    advance_and_notify(*r);
+    delivery_order.clear();
+
+    r->begin_transaction();
+    table->get_object(ObjKey(10)).set(col_value, 1000);
+    table->remove_object(ObjKey(50));
+    r->commit_transaction();
+    advance_and_notify(*r);
+
+    REQUIRE(delivery_order.size() == num_notifiers);
+    REQUIRE(std::is_sorted(delivery_order.begin(), delivery_order.end()));
+    for (int i = 0; i < num_notifiers; ++i) {
+        // Object 10 now matches every query, and object 50 is gone
+        REQUIRE(results[i].size() == size_t(100 - i + (i > 10) - (i <= 50)));
+        if (i <= 10) {
+            REQUIRE_INDICES(changes[i].modifications, 10 - i);
+            REQUIRE(changes[i].insertions.empty());
+        }
+        else {
+            REQUIRE_INDICES(changes[i].insertions, 0);
+        }
+        if (i <= 50)
+            REQUIRE_INDICES(changes[i].deletions, 50 - i);
+        else
+            REQUIRE(changes[i].deletions.empty());
+    }
+}
+
 TEST_CASE("results: snapshots", "[results]") {
     InMemoryTestFile config;
     config.automatic_change_notifications = false;
@@ -2190,3 +2190,122 @@ TEST_CASE("DeepChangeChecker singular links", "[notifications]") {
         }
     }
 }
+
+TEST_CASE("DeepChangeChecker across tables", "[notifications]") {
+    InMemoryTestFile config;
+    config.automatic_change_notifications = false;
+    auto r = Realm::get_shared_realm(config);
+    r->update_schema({
+        {"a", {{"value", PropertyType::Int}, {"link", PropertyType::Object | PropertyType::Nullable, "b"}}},
+        {"b", {{"value", PropertyType::Int}, {"list", PropertyType::Object | PropertyType::Array, "c"}}},
+        {"c", {{"value", PropertyType::Int}, {"link", PropertyType::Object | PropertyType::Nullable, "d"}}},
+        {"d", {{"value", PropertyType::Int}, {"link", PropertyType::Object | PropertyType::Nullable, "e"}}},
+        {"e", {{"value", PropertyType::Int}}},
+    });
+    auto& group = r->read_group();
+    auto a = group.get_table("class_a");
+    auto b = group.get_table("class_b");
+    auto c = group.get_table("class_c");
+    auto d = group.get_table("class_d");
+    auto e = group.get_table("class_e");
+    auto a_link = a->get_column_key("link");
+    auto b_list = b->get_column_key("list");
+    auto c_link = c->get_column_key("link");
+    auto d_link = d->get_column_key("link");
+    auto value = [](ConstTableRef table) {
+        return table->get_column_key("value");
+    };
+
+    // Every object in `a` is three links away from an object in `d`, and four from one in `e`
+    r->begin_transaction();
+    std::vector<ObjKey> b_keys, c_keys, d_keys, e_keys;
+    for (int i = 0; i < 100; ++i) {
+        e_keys.push_back(e->create_object().get_key());
+        d_keys.push_back(d->create_object().set(d_link, e_keys[i]).get_key());
+    }
+    for (int i = 0; i < 100; ++i)
+        c_keys.push_back(c->create_object().set(c_link, d_keys[i / 3]).get_key());
+    for (int i = 0; i < 100; ++i) {
+        auto obj = b->create_object();
+        auto list = obj.get_linklist(b_list);
+        list.add(c_keys[i]);
+        list.add(c_keys[(i + 1) % 100]);
+        b_keys.push_back(obj.get_key());
+    }
+    for (int i = 0; i < 2000; ++i)
+        a->create_object().set(a_link, b_keys[i % 100]);
+    r->commit_transaction();
+
+    std::vector<_impl::DeepChangeChecker::RelatedTable> related_tables;
+    _impl::DeepChangeChecker::find_related_tables(related_tables, *a, {});
+    REQUIRE(related_tables.size() == 5);
+
+    auto track_changes = [&](auto&& f) {
+        auto tr = r->duplicate();
+
+        r->begin_transaction();
+        f();
+        r->commit_transaction();
+
+        _impl::TransactionChangeInfo info{};
+        for (auto key : tr->get_table_keys())
+            info.tables[key];
+        _impl::transaction::advance(*tr, info);
+        return info;
+    };
+
+    auto modify = [&](TableRef table, ObjKey key) {
+        table->get_object(key).set(value(table), 1);
+    };
+    auto is_modified = [&](ConstTableRef table, ObjKey key) {
+        return table->get_object(key).get<Int>(value(table)) == 1;
+    };
+    auto reaches_change = [&](const Obj& obj) {
+        if (is_modified(a, obj.get_key()))
+            return true;
+        ObjKey b_key = obj.get<ObjKey>(a_link);
+        if (is_modified(b, b_key))
+            return true;
+        auto list = b->get_object(b_key).get_linklist(b_list);
+        for (size_t i = 0; i < list.size(); ++i) {
+            if (is_modified(c, list.get(i)) || is_modified(d, c->get_object(list.get(i)).get<ObjKey>(c_link)))
+                return true;
+        }
+        return false;
+    };
+    auto verify = [&](const _impl::TransactionChangeInfo& info) {
+        _impl::DeepChangeChecker checker(info, *a, related_tables, {}, false);
+        size_t changed = 0;
+        for (auto& obj : *a) {
+            bool expected = reaches_change(obj);
+            REQUIRE(checker(obj.get_key()) == expected);
+            changed += expected;
+        }
+        return changed;
+    };
+
+    SECTION("few modifications") {
+        auto info = track_changes([&] {
+            modify(d, d_keys[5]);
+            modify(c, c_keys[40]);
+            modify(e, e_keys[0]);
+        });
+        REQUIRE(verify(info) == 120);
+    }
+
+    SECTION("modifications reached from many objects") {
+        auto info = track_changes([&] {
+            for (size_t i = 0; i < 34; ++i)
+                modify(d, d_keys[i]);
+        });
+        REQUIRE(verify(info) == 2000);
+    }
+
+    SECTION("modifications of the root table") {
+        auto info = track_changes([&] {
+            modify(a, a->begin()->get_key());
+            modify(b, b_keys[99]);
+        });
+        REQUIRE(verify(info) == 21);
+    }
+}
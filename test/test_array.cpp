@@ -24,6 +24,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <numeric>
 
 #include <realm/array_with_find.hpp>
 #include <realm/array_unsigned.hpp>
@@ -1014,6 +1015,54 @@ TEST(Array_find_sse)
 }
 
 
+// Exercises the vectorized (SSE/AVX2) find paths for all byte-sized widths and the four basic conditions, with
+// unaligned start and end positions, by comparing against a plain scan.
+TEST(Array_find_simd_conditions)
+{
+    Random random(random_int<unsigned long>()); // Seed from slow global generator
+    const int64_t ubounds[] = {100, 30000, 2000000000LL, 8000000000LL};
+
+    Array a(Allocator::get_default());
+    a.create(Array::type_Normal);
+
+    for (int64_t ubound : ubounds) {
+        a.clear();
+        std::vector<int64_t> values;
+        for (size_t i = 0; i < 300; ++i) {
+            // Pick from a small set of values so that there are plenty of matches for each condition
+            int64_t v = ubound - random.draw_int_mod(5);
+            if (random.draw_bool())
+                v = -v;
+            values.push_back(v);
+            a.add(v);
+        }
+
+        auto check = [&](auto cond, int64_t needle, size_t start, size_t end) {
+            using Cond = decltype(cond);
+            std::vector<ObjKey> found;
+            QueryStateFindAll<std::vector<ObjKey>> state(found);
+            ArrayWithFind(a).find<Cond>(needle, start, end, 0, &state);
+            std::vector<ObjKey> expected;
+            for (size_t i = start; i < end; ++i) {
+                if (cond(values[i], needle))
+                    expected.push_back(ObjKey(i));
+            }
+            CHECK(found == expected);
+        };
+
+        for (size_t start : {0, 1, 7, 33}) {
+            for (size_t end : {size_t(300), size_t(299), size_t(250), size_t(64) + start}) {
+                int64_t needle = values[start + 3];
+                check(Equal(), needle, start, end);
+                check(NotEqual(), needle, start, end);
+                check(Greater(), needle, start, end);
+                check(Less(), needle, start, end);
+            }
+        }
+    }
+    a.destroy();
+}
+
 TEST(Array_Greater)
 {
     Array a(Allocator::get_default());
@@ -1494,6 +1543,127 @@ TEST(Array_get_sum)
     c.destroy();
 }
 
+TEST(Array_EncodeOffsets)
+{
+    Array c(Allocator::get_default());
+    c.create(Array::type_Normal);
+
+    // Millisecond timestamps need 64 bits, but fit in 16 bits relative to the first one
+    const int64_t base = 1700000000000LL;
+    std::vector<int64_t> values;
+    for (int64_t i = 0; i < 300; ++i) {
+        values.push_back(base + (i * 131) % 20000);
+        c.add(values.back());
+    }
+    CHECK_EQUAL(c.get_width(), 64);
+    size_t plain_size = c.get_byte_size();
+    CHECK(c.encode_offsets());
+    CHECK(c.has_base());
+    CHECK_EQUAL(c.get_width(), 16);
+    CHECK_LESS(c.get_byte_size(), plain_size);
+    CHECK_EQUAL(c.get_byte_size(), Array::get_byte_size_from_header(c.get_header()));
+
+    // Reading
+    int64_t sum = 0;
+    for (size_t i = 0; i < values.size(); ++i) {
+        CHECK_EQUAL(c.get(i), values[i]);
+        CHECK_EQUAL(Array::get(c.get_header(), i), values[i]);
+        sum += values[i];
+    }
+    CHECK_EQUAL(c.get_sum(), sum);
+    CHECK_EQUAL(c.get_sum(10, 20), std::accumulate(values.begin() + 10, values.begin() + 20, int64_t(0)));
+    int64_t chunk[8];
+    c.get_chunk(296, chunk);
+    for (size_t i = 0; i < 4; ++i)
+        CHECK_EQUAL(chunk[i], values[296 + i]);
+    auto two = Array::get_two(c.get_header(), 7);
+    CHECK_EQUAL(two.first, values[7]);
+    CHECK_EQUAL(two.second, values[8]);
+
+    // Searching
+    CHECK_EQUAL(c.find_first(values[123]), 123);
+    CHECK_EQUAL(c.find_first(base - 1), not_found);
+    CHECK_EQUAL(c.find_first(std::numeric_limits<int64_t>::min()), not_found);
+    CHECK_EQUAL(c.find_first(std::numeric_limits<int64_t>::max()), not_found);
+    CHECK_EQUAL(c.find_first<Greater>(base + 19900), 152);
+    CHECK_EQUAL(c.find_first<Greater>(base + 19990), not_found);
+    CHECK_EQUAL(c.find_first<Less>(base), not_found);
+    CHECK_EQUAL(c.find_first<Less>(base + 1), 0);
+    CHECK_EQUAL(c.find_first<NotEqual>(base), 1);
+    CHECK_EQUAL(c.find_first<Greater>(std::numeric_limits<int64_t>::min()), 0);
+
+    IntegerColumn results(Allocator::get_default());
+    results.create();
+    ArrayWithFind(c).find_all(&results, values[5]);
+    CHECK_EQUAL(results.size(), size_t(std::count(values.begin(), values.end(), values[5])));
+    CHECK_EQUAL(results.get(0), 5);
+    results.destroy();
+
+    // Modifying expands the array back to the regular representation
+    c.set(3, -5);
+    values[3] = -5;
+    CHECK(!c.has_base());
+    for (size_t i = 0; i < values.size(); ++i)
+        CHECK_EQUAL(c.get(i), values[i]);
+
+    // The range is now too large to benefit from the encoding
+    CHECK(!c.encode_offsets());
+    c.set(3, base);
+    values[3] = base;
+    CHECK(c.encode_offsets());
+    c.insert(0, base + 1);
+    values.insert(values.begin(), base + 1);
+    CHECK(!c.has_base());
+    CHECK(c.encode_offsets());
+    c.erase(10);
+    values.erase(values.begin() + 10);
+    CHECK(c.encode_offsets());
+    c.truncate(100);
+    values.resize(100);
+    CHECK_EQUAL(c.size(), values.size());
+    for (size_t i = 0; i < values.size(); ++i)
+        CHECK_EQUAL(c.get(i), values[i]);
+
+    // Moving elements into an encoded array
+    Array d(Allocator::get_default());
+    d.create(Array::type_Normal);
+    for (int i = 0; i < 100; ++i)
+        d.add(-1000000000000LL - i);
+    CHECK(d.encode_offsets());
+    CHECK(c.encode_offsets());
+    c.move(d, 50);
+    CHECK(!d.has_base());
+    CHECK_EQUAL(d.size(), 150);
+    for (size_t i = 0; i < 50; ++i) {
+        CHECK_EQUAL(d.get(i + 100), values[i + 50]);
+        CHECK_EQUAL(d.get(i), -1000000000000LL - int64_t(i));
+    }
+
+    // Small values or a wide spread do not benefit
+    Array e(Allocator::get_default());
+    e.create(Array::type_Normal);
+    for (int i = 0; i < 100; ++i)
+        e.add(i);
+    CHECK(!e.encode_offsets());
+    e.add(std::numeric_limits<int64_t>::min());
+    e.add(std::numeric_limits<int64_t>::max());
+    CHECK(!e.encode_offsets());
+    e.clear();
+
+    // Values at the top of the range can be encoded too
+    for (int i = 0; i < 100; ++i)
+        e.add(std::numeric_limits<int64_t>::max() - i);
+    CHECK(e.encode_offsets());
+    CHECK_EQUAL(e.get(0), std::numeric_limits<int64_t>::max());
+    CHECK_EQUAL(e.get(99), std::numeric_limits<int64_t>::max() - 99);
+    CHECK_EQUAL(e.find_first(std::numeric_limits<int64_t>::max()), 0);
+    CHECK_EQUAL(e.find_first<Less>(std::numeric_limits<int64_t>::max() - 98), 99);
+
+    c.destroy();
+    d.destroy();
+    e.destroy();
+}
+
 // NONCONCURRENT because if run in parallel with other tests which request large amounts of
 // memory, there may be a std::bad_alloc on low memory machines
 NONCONCURRENT_TEST(Array_count)
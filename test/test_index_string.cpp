@@ -20,10 +20,14 @@
 #ifdef TEST_INDEX_STRING
 
 #include <realm.hpp>
+#include <realm/index_hash.hpp>
+#include <realm/index_ordered.hpp>
 #include <realm/index_string.hpp>
 #include <realm/query_expression.hpp>
 #include <realm/tokenizer.hpp>
 #include <realm/util/to_string.hpp>
+#include <deque>
+#include <numeric>
 #include <set>
 #include "test.hpp"
 #include "util/misc.hpp"
@@ -2051,4 +2055,727 @@ TEST_TYPES(StringIndex_ListOfStrings, std::true_type, std::false_type)
     }
 }
 
+
+TEST(StringIndex_BulkBuild)
+{
+    // An index added to a populated table is built from the sorted values. It must
+    // give the same results as an index maintained while the objects are created.
+    Random random(random_int<unsigned long>()); // Seed from slow global generator
+    Group g;
+    auto bulk = g.add_table("bulk");
+    auto incremental = g.add_table("incremental");
+    for (auto& t : {bulk, incremental}) {
+        t->add_column(type_String, "str", true);
+        t->add_column(type_Int, "int", true);
+        t->add_column(type_Mixed, "mixed");
+        t->add_column(type_Timestamp, "ts");
+    }
+    for (auto& name : {"str", "int", "mixed"}) {
+        incremental->add_search_index(incremental->get_column_key(name));
+    }
+    incremental->add_search_index(incremental->get_column_key("ts"), IndexType::Ordered);
+
+    const std::string long_prefix(StringIndex::s_max_offset + 50, 'x');
+    auto random_string_value = [&](size_t i) -> std::optional<std::string> {
+        switch (random.draw_int_mod(5)) {
+            case 0:
+                return {};
+            case 1:
+                return std::string(i % 3 ? "" : "\xff\xfe");
+            case 2:
+                // Values sharing a prefix longer than the index can tell apart
+                return long_prefix + std::to_string(random.draw_int_mod(10));
+            default:
+                return random_string(random.draw_int_mod(12));
+        }
+    };
+    auto random_mixed_value = [&]() -> Mixed {
+        switch (random.draw_int_mod(4)) {
+            case 0:
+                return random.draw_int<int64_t>(-2, 2);
+            case 1:
+                return bool(random.draw_int_mod(2));
+            case 2:
+                return double(random.draw_int_mod(3));
+        }
+        return {};
+    };
+
+    const size_t num_objects = 5000;
+    for (size_t i = 0; i < num_objects; ++i) {
+        auto str = random_string_value(i);
+        Mixed integer = random.draw_int_mod(10) == 0 ? Mixed() : Mixed(random.draw_int<int64_t>(-5000, 5000));
+        Mixed mixed = random_mixed_value();
+        Timestamp ts(random.draw_int_mod(1000), 0);
+        for (auto& t : {bulk, incremental}) {
+            t->create_object()
+                .set_any(t->get_column_key("str"), str ? Mixed(StringData(*str)) : Mixed())
+                .set_any(t->get_column_key("int"), integer)
+                .set_any(t->get_column_key("mixed"), mixed)
+                .set(t->get_column_key("ts"), ts);
+        }
+    }
+    for (auto& name : {"str", "int", "mixed"}) {
+        bulk->add_search_index(bulk->get_column_key(name));
+    }
+    bulk->add_search_index(bulk->get_column_key("ts"), IndexType::Ordered);
+    bulk->verify();
+    incremental->verify();
+
+    for (auto& name : {"str", "int", "mixed", "ts"}) {
+        auto col_bulk = bulk->get_column_key(name);
+        auto col_incremental = incremental->get_column_key(name);
+        auto index_bulk = bulk->get_search_index(col_bulk);
+        auto index_incremental = incremental->get_search_index(col_incremental);
+        CHECK_EQUAL(index_bulk->has_duplicate_values(), index_incremental->has_duplicate_values());
+        std::set<Mixed> checked;
+        for (size_t i = 0; i < num_objects; i += 97) {
+            Mixed value = bulk->get_object(i).get_any(col_bulk);
+            if (!checked.insert(value).second)
+                continue;
+            std::vector<ObjKey> found_bulk, found_incremental;
+            index_bulk->find_all(found_bulk, value);
+            index_incremental->find_all(found_incremental, value);
+            CHECK(found_bulk == found_incremental);
+            CHECK_EQUAL(index_bulk->count(value), found_bulk.size());
+            CHECK_EQUAL(index_bulk->find_first(value), index_incremental->find_first(value));
+        }
+    }
+
+    // The index is maintained as usual after being built
+    auto col_str = bulk->get_column_key("str");
+    bulk->get_object(7).set(col_str, "after build");
+    bulk->create_object().set(col_str, "after build");
+    bulk->remove_object(bulk->get_object(8).get_key());
+    CHECK_EQUAL(bulk->where().equal(col_str, "after build").count(), 2);
+    bulk->verify();
+}
+
+TEST(StringIndex_BulkBuildLarge)
+{
+    // Large enough to be sorted on several threads
+    Group g;
+    auto t = g.add_table("table");
+    auto col = t->add_column(type_Int, "int");
+    const int64_t num_objects = 110000;
+    const int64_t num_values = 1000;
+    for (int64_t i = 0; i < num_objects; ++i) {
+        t->create_object().set(col, (i * 7919) % num_values - num_values / 2);
+    }
+    t->add_search_index(col);
+    t->verify();
+
+    auto index = t->get_search_index(col);
+    for (int64_t value = -num_values / 2; value < num_values / 2; value += 37) {
+        std::vector<ObjKey> found;
+        index->find_all(found, value);
+        CHECK_EQUAL(found.size(), num_objects / num_values);
+        CHECK(std::is_sorted(found.begin(), found.end()));
+        CHECK_EQUAL(t->get_object(found.front()).get<Int>(col), value);
+    }
+}
+
+TEST(OrderedIndex_Modifications)
+{
+    Table table;
+    auto col_int = table.add_column(type_Int, "int", true);
+    auto col_str = table.add_column(type_String, "str");
+    Random random(random_int<unsigned long>());
+
+    std::vector<ObjKey> keys;
+    for (int i = 0; i < 300; i++) {
+        auto obj = table.create_object();
+        if (i % 7)
+            obj.set(col_int, random.draw_int<int64_t>(-20, 20));
+        keys.push_back(obj.get_key());
+    }
+
+    table.add_search_index(col_int, IndexType::Ordered);
+    CHECK_EQUAL(table.search_index_type(col_int), IndexType::Ordered);
+    CHECK_NOT(table.has_search_index(col_int));
+    auto index = dynamic_cast<const OrderedIndex*>(table.get_search_index(col_int));
+    CHECK(index);
+    CHECK_EQUAL(index->size(), table.size());
+
+    // Only integer and timestamp columns are supported
+    CHECK_THROW(table.add_search_index(col_str, IndexType::Ordered), IllegalOperation);
+
+    auto check_consistency = [&] {
+        index->verify();
+        CHECK_EQUAL(index->size(), table.size());
+        for (int64_t v = -21; v <= 21; v++) {
+            size_t expected = 0;
+            for (auto& obj : table) {
+                if (obj.get<util::Optional<int64_t>>(col_int) == v)
+                    expected++;
+            }
+            CHECK_EQUAL(index->count(v), expected);
+            CHECK_EQUAL(table.count_int(col_int, v), expected);
+        }
+        size_t nulls = table.where().equal(col_int, null()).count();
+        CHECK_EQUAL(index->count(Mixed()), nulls);
+    };
+    check_consistency();
+
+    for (int i = 0; i < 200; i++) {
+        ObjKey key = keys[random.draw_int_mod(keys.size())];
+        if (!table.is_valid(key))
+            continue;
+        auto obj = table.get_object(key);
+        switch (random.draw_int_mod(4)) {
+            case 0:
+                obj.set_null(col_int);
+                break;
+            case 1:
+                obj.remove();
+                break;
+            case 2:
+                if (!obj.is_null(col_int))
+                    obj.add_int(col_int, 1);
+                break;
+            default:
+                obj.set(col_int, random.draw_int<int64_t>(-20, 20));
+                break;
+        }
+    }
+    for (int i = 0; i < 50; i++) {
+        keys.push_back(table.create_object().set(col_int, random.draw_int<int64_t>(-20, 20)).get_key());
+    }
+    check_consistency();
+
+    // Switching to a general index and back rebuilds the index
+    table.add_search_index(col_int, IndexType::General);
+    CHECK_EQUAL(table.search_index_type(col_int), IndexType::General);
+    CHECK(table.has_search_index(col_int));
+    table.add_search_index(col_int, IndexType::Ordered);
+    index = dynamic_cast<const OrderedIndex*>(table.get_search_index(col_int));
+    CHECK(index);
+    check_consistency();
+
+    table.remove_search_index(col_int);
+    CHECK_EQUAL(table.search_index_type(col_int), IndexType::None);
+    CHECK_NOT(table.get_search_index(col_int));
+}
+
+TEST(OrderedIndex_ManyLeaves)
+{
+    // Enough entries to spread the index over several B+tree leaves, with runs of equal
+    // values crossing leaf boundaries
+    Table table;
+    auto col_int = table.add_column(type_Int, "int");
+    const int64_t num_values = 37;
+    const size_t num_objects = 5 * REALM_MAX_BPNODE_SIZE + 17;
+    for (size_t i = 0; i < num_objects; i++) {
+        table.create_object().set(col_int, int64_t(i * 7919) % num_values);
+    }
+    table.add_search_index(col_int, IndexType::Ordered);
+    auto index = dynamic_cast<const OrderedIndex*>(table.get_search_index(col_int));
+    CHECK(index);
+
+    auto check_index = [&] {
+        index->verify();
+        size_t begin = 0;
+        for (int64_t v = -1; v <= num_values; v++) {
+            size_t expected = table.where().equal(col_int, v).count();
+            CHECK_EQUAL(index->lower_bound(v), begin);
+            CHECK_EQUAL(index->upper_bound(v), begin + expected);
+            CHECK_EQUAL(index->count(v), expected);
+            ObjKey first = index->find_first(v);
+            if (expected) {
+                CHECK_EQUAL(table.get_object(first).get<int64_t>(col_int), v);
+            }
+            else {
+                CHECK_NOT(first);
+            }
+            begin += expected;
+        }
+        CHECK_EQUAL(begin, table.size());
+
+        int64_t last = num_values;
+        size_t visited = 0;
+        index->for_each_in_order(false, [&](ObjKey key) {
+            int64_t v = table.get_object(key).get<int64_t>(col_int);
+            CHECK_LESS_EQUAL(v, last);
+            last = v;
+            visited++;
+            return IteratorControl::AdvanceToNext;
+        });
+        CHECK_EQUAL(visited, table.size());
+    };
+    check_index();
+
+    // Erase and reinsert entries in the middle of runs spanning several leaves
+    std::vector<ObjKey> keys;
+    index->find_all(keys, Mixed(5));
+    for (size_t i = 0; i < keys.size(); i += 3) {
+        table.get_object(keys[i]).set(col_int, int64_t(11));
+    }
+    keys.clear();
+    index->find_all(keys, Mixed(11));
+    for (size_t i = 0; i < keys.size(); i += 2) {
+        table.remove_object(keys[i]);
+    }
+    check_index();
+}
+
+TEST(OrderedIndex_RangeQueries)
+{
+    Table table;
+    auto col_int = table.add_column(type_Int, "int");
+    auto col_opt = table.add_column(type_Int, "opt", true);
+    auto col_date = table.add_column(type_Timestamp, "date", true);
+    Random random(random_int<unsigned long>());
+
+    for (int i = 0; i < 3000; i++) {
+        auto obj = table.create_object();
+        obj.set(col_int, random.draw_int<int64_t>(0, 999));
+        if (i % 5)
+            obj.set(col_opt, random.draw_int<int64_t>(0, 99));
+        if (i % 3)
+            obj.set(col_date, Timestamp(random.draw_int<int64_t>(0, 999), 0));
+    }
+
+    // Collect the expected results before the indexes are added
+    auto run = [&](ColKey col, Mixed value) {
+        std::vector<std::vector<ObjKey>> results;
+        auto collect = [&](Query q) {
+            auto tv = q.find_all();
+            std::vector<ObjKey> keys;
+            for (size_t i = 0; i < tv.size(); i++)
+                keys.push_back(tv.get_key(i));
+            results.push_back(keys);
+            CHECK_EQUAL(q.count(), keys.size());
+        };
+        if (col == col_date) {
+            Timestamp ts = value.is_null() ? Timestamp() : value.get_timestamp();
+            collect(table.where().greater(col, ts));
+            collect(table.where().greater_equal(col, ts));
+            collect(table.where().less(col, ts));
+            collect(table.where().less_equal(col, ts));
+            collect(table.where().equal(col, ts));
+            collect(table.where().greater(col, ts).less(col_int, 500));
+        }
+        else {
+            int64_t v = value.get_int();
+            collect(table.where().greater(col, v));
+            collect(table.where().greater_equal(col, v));
+            collect(table.where().less(col, v));
+            collect(table.where().less_equal(col, v));
+            collect(table.where().equal(col, v));
+            collect(table.where().greater(col, v).less(col_int, 500));
+        }
+        return results;
+    };
+
+    std::vector<std::pair<ColKey, Mixed>> conditions;
+    for (int64_t v : {-1, 0, 5, 50, 98, 99, 500, 990, 1000}) {
+        conditions.emplace_back(col_int, v);
+        conditions.emplace_back(col_opt, v);
+        conditions.emplace_back(col_date, Timestamp(v, 0));
+    }
+    conditions.emplace_back(col_date, Mixed());
+
+    std::vector<std::vector<std::vector<ObjKey>>> expected;
+    for (auto& [col, value] : conditions)
+        expected.push_back(run(col, value));
+
+    table.add_search_index(col_int, IndexType::Ordered);
+    table.add_search_index(col_opt, IndexType::Ordered);
+    table.add_search_index(col_date, IndexType::Ordered);
+
+    for (size_t i = 0; i < conditions.size(); i++)
+        CHECK(run(conditions[i].first, conditions[i].second) == expected[i]);
+
+    // Sorting and limiting on the indexed column visits the objects in index order
+    auto check_sorted = [&](Query q, SortDescriptor sort, size_t limit) {
+        auto all = q.find_all();
+        all.sort(sort);
+
+        DescriptorOrdering ordering;
+        ordering.append_sort(sort);
+        ordering.append_limit(limit);
+        auto tv = q.find_all(ordering);
+        CHECK_EQUAL(tv.size(), std::min(limit, all.size()));
+        for (size_t i = 0; i < tv.size(); i++) {
+            CHECK_EQUAL(tv.get_key(i), all.get_key(i));
+        }
+    };
+    for (size_t limit : {1, 10, 100, 5000}) {
+        for (bool ascending : {true, false}) {
+            check_sorted(table.where(), SortDescriptor({{col_int}}, {ascending}), limit);
+            check_sorted(table.where(), SortDescriptor({{col_opt}}, {ascending}), limit);
+            check_sorted(table.where(), SortDescriptor({{col_date}}, {ascending}), limit);
+            check_sorted(table.where().less(col_int, 300), SortDescriptor({{col_opt}}, {ascending}), limit);
+            check_sorted(table.where().equal(col_int, 7), SortDescriptor({{col_date}}, {ascending}), limit);
+        }
+    }
+}
+
+TEST(OrderedIndex_Persistence)
+{
+    SHARED_GROUP_TEST_PATH(path);
+    ColKey col;
+    {
+        auto db = DB::create(make_in_realm_history(), path);
+        auto wt = db->start_write();
+        auto table = wt->add_table("table");
+        col = table->add_column(type_Int, "int");
+        for (int64_t i = 0; i < 100; i++)
+            table->create_object().set(col, i % 10);
+        table->add_search_index(col, IndexType::Ordered);
+        wt->commit();
+    }
+    {
+        auto db = DB::create(make_in_realm_history(), path);
+        auto rt = db->start_read();
+        auto table = rt->get_table("table");
+        CHECK_EQUAL(table->search_index_type(col), IndexType::Ordered);
+        CHECK(dynamic_cast<const OrderedIndex*>(table->get_search_index(col)));
+        CHECK_EQUAL(table->where().greater(col, 7).count(), 20);
+        rt->verify();
+
+        // Accessors follow a change of index kind made by another transaction
+        auto wt = db->start_write();
+        wt->get_table("table")->add_search_index(col, IndexType::General);
+        wt->commit();
+        rt->advance_read();
+        CHECK_EQUAL(table->search_index_type(col), IndexType::General);
+        CHECK(dynamic_cast<const StringIndex*>(table->get_search_index(col)));
+        CHECK_EQUAL(table->where().equal(col, 7).count(), 10);
+
+        wt = db->start_write();
+        wt->get_table("table")->add_search_index(col, IndexType::Ordered);
+        wt->commit();
+        rt->advance_read();
+        CHECK_EQUAL(table->search_index_type(col), IndexType::Ordered);
+        CHECK_EQUAL(table->where().less(col, 2).count(), 20);
+    }
+}
+
+TEST_TYPES(HashIndex_PrimaryKey, Int, String, ObjectId, UUID)
+{
+    std::deque<std::string> strings;
+    auto pk = [&](int64_t i) -> Mixed {
+        if constexpr (std::is_same_v<TEST_TYPE, Int>) {
+            return i * 7919 - 50000;
+        }
+        else if constexpr (std::is_same_v<TEST_TYPE, String>) {
+            return StringData(strings.emplace_back(util::format("pk %1", i)));
+        }
+        else {
+            std::array<uint8_t, sizeof(TEST_TYPE)> bytes{};
+            for (size_t b = 0; b < 8; b++)
+                bytes[b] = uint8_t(i >> (8 * b));
+            return TEST_TYPE(bytes);
+        }
+    };
+
+    Table table;
+    auto col_pk = table.add_column(ColumnTypeTraits<TEST_TYPE>::id, "pk");
+    auto col_int = table.add_column(type_Int, "int");
+    table.set_primary_key_column(col_pk);
+
+    constexpr int64_t num_objects = 5000;
+    std::vector<ObjKey> keys;
+    for (int64_t i = 0; i < num_objects / 2; i++)
+        keys.push_back(table.create_object_with_primary_key(pk(i)).set(col_int, i).get_key());
+
+    // Only the primary key can have a hash index
+    CHECK_THROW(table.add_search_index(col_int, IndexType::Hash), InvalidColumnKey);
+    table.add_search_index(col_pk, IndexType::Hash);
+    CHECK_EQUAL(table.search_index_type(col_pk), IndexType::Hash);
+    auto index = dynamic_cast<const HashIndex*>(table.get_search_index(col_pk));
+    CHECK(index);
+    CHECK_EQUAL(index->size(), table.size());
+
+    // The table grows over several pages as objects are added
+    for (int64_t i = num_objects / 2; i < num_objects; i++)
+        keys.push_back(table.create_object_with_primary_key(pk(i)).set(col_int, i).get_key());
+    CHECK_EQUAL(index->size(), num_objects);
+    CHECK_GREATER(index->capacity(), 4 * num_objects / 3);
+    index->verify();
+    for (int64_t i = 0; i < num_objects; i++)
+        CHECK_EQUAL(table.find_primary_key(pk(i)), keys[i]);
+    CHECK_NOT(table.find_primary_key(pk(num_objects)));
+
+    // Equality queries on the primary key are answered by the index
+    Query q = table.where().equal(col_pk, pk(17).template get<TEST_TYPE>());
+    CHECK(q.explain().uses_index);
+    CHECK_EQUAL(q.count(), 1);
+    CHECK_EQUAL(q.find(), keys[17]);
+    if constexpr (std::is_same_v<TEST_TYPE, String>) {
+        // ... but not case insensitive ones
+        CHECK_EQUAL(table.where().equal(col_pk, StringData("PK 17"), false).count(), 1);
+    }
+
+    for (int64_t i = 0; i < num_objects; i += 3)
+        table.remove_object(keys[i]);
+    index->verify();
+    CHECK_EQUAL(index->size(), table.size());
+    for (int64_t i = 0; i < num_objects; i++)
+        CHECK_EQUAL(table.find_primary_key(pk(i)), i % 3 ? keys[i] : ObjKey());
+
+    // Switching between the index kinds rebuilds the index from the column
+    table.add_search_index(col_pk, IndexType::General);
+    CHECK_EQUAL(table.search_index_type(col_pk), IndexType::General);
+    CHECK(dynamic_cast<const StringIndex*>(table.get_search_index(col_pk)));
+    table.add_search_index(col_pk, IndexType::Hash);
+    index = dynamic_cast<const HashIndex*>(table.get_search_index(col_pk));
+    CHECK(index);
+    index->verify();
+    CHECK_EQUAL(index->size(), table.size());
+    for (int64_t i = 1; i < num_objects; i += 3)
+        CHECK_EQUAL(table.find_primary_key(pk(i)), keys[i]);
+
+    table.clear();
+    CHECK(index->is_empty());
+    CHECK_NOT(table.find_primary_key(pk(1)));
+    table.create_object_with_primary_key(pk(1));
+    CHECK(table.find_primary_key(pk(1)));
+    index->verify();
+
+    // The index follows the primary key when it is moved
+    table.set_primary_key_column(ColKey());
+    CHECK_EQUAL(table.search_index_type(col_pk), IndexType::None);
+}
+
+TEST(HashIndex_Persistence)
+{
+    SHARED_GROUP_TEST_PATH(path);
+    ColKey col;
+    {
+        auto db = DB::create(make_in_realm_history(), path);
+        auto wt = db->start_write();
+        auto table = wt->add_table_with_primary_key("table", type_String, "pk", true);
+        col = table->get_primary_key_column();
+        table->add_search_index(col, IndexType::Hash);
+        table->create_object_with_primary_key(Mixed());
+        for (int i = 0; i < 100; i++)
+            table->create_object_with_primary_key(util::format("%1", i));
+        wt->commit();
+    }
+    {
+        auto db = DB::create(make_in_realm_history(), path);
+        auto rt = db->start_read();
+        auto table = rt->get_table("table");
+        CHECK_EQUAL(table->search_index_type(col), IndexType::Hash);
+        CHECK(dynamic_cast<const HashIndex*>(table->get_search_index(col)));
+        CHECK(table->find_primary_key(Mixed()));
+        CHECK(table->find_primary_key(StringData("42")));
+        CHECK_NOT(table->find_primary_key(StringData("100")));
+        rt->verify();
+
+        // Accessors follow a change of index kind made by another transaction
+        auto wt = db->start_write();
+        wt->get_table("table")->add_search_index(col, IndexType::General);
+        wt->commit();
+        rt->advance_read();
+        CHECK_EQUAL(table->search_index_type(col), IndexType::General);
+        CHECK(dynamic_cast<const StringIndex*>(table->get_search_index(col)));
+        CHECK(table->find_primary_key(StringData("42")));
+
+        wt = db->start_write();
+        wt->get_table("table")->add_search_index(col, IndexType::Hash);
+        wt->get_table("table")->create_object_with_primary_key(StringData("100"));
+        wt->commit();
+        rt->advance_read();
+        CHECK_EQUAL(table->search_index_type(col), IndexType::Hash);
+        CHECK(table->find_primary_key(StringData("100")));
+        CHECK_EQUAL(table->where().equal(col, StringData("7")).count(), 1);
+        rt->verify();
+    }
+}
+
+TEST(CompositeIndex_Maintenance)
+{
+    Table table;
+    auto col_owner = table.add_column(type_String, "owner");
+    auto col_status = table.add_column(type_Int, "status", true);
+    auto col_created = table.add_column(type_Timestamp, "created", true);
+    auto col_flag = table.add_column(type_Bool, "flag");
+    auto col_double = table.add_column(type_Double, "double");
+
+    CHECK_THROW(table.add_search_index(std::vector<ColKey>{col_owner}), InvalidArgument);
+    CHECK_THROW(table.add_search_index({col_owner, col_status, col_created, col_flag, col_owner}), InvalidArgument);
+    CHECK_THROW(table.add_search_index({col_owner, col_owner}), InvalidArgument);
+    CHECK_THROW(table.add_search_index({col_owner, col_double}), IllegalOperation);
+    CHECK(table.get_composite_indexes().empty());
+
+    for (int i = 0; i < 20; i++) {
+        auto obj = table.create_object();
+        obj.set(col_owner, i % 2 ? "alice" : "bob");
+        obj.set(col_status, i % 3);
+    }
+
+    table.add_search_index({col_owner, col_status, col_created});
+    table.add_search_index({col_flag, col_owner});
+    table.add_search_index({col_owner, col_status, col_created}); // no effect
+    CHECK_EQUAL(table.get_composite_indexes().size(), 2);
+    CHECK(table.get_composite_indexes()[0] == std::vector<ColKey>({col_owner, col_status, col_created}));
+    table.verify();
+
+    // The index follows all kinds of modifications
+    auto obj = table.create_object();
+    obj.set(col_owner, "carol");
+    obj.set(col_created, Timestamp(10, 0));
+    obj.set(col_status, 7);
+    obj.add_int(col_status, 5);
+    obj.add_int(col_status, -2);
+    obj.set(col_flag, true);
+    obj.set_null(col_created);
+    obj.set_null(col_status);
+    table.verify();
+    CHECK_EQUAL(table.where().equal(col_owner, "carol").equal(col_status, null()).count(), 1);
+    CHECK_EQUAL(table.where().equal(col_flag, true).equal(col_owner, "carol").count(), 1);
+
+    table.get_object(3).remove();
+    table.remove_object(table.begin()->get_key());
+    table.verify();
+    CHECK_EQUAL(table.where().equal(col_owner, "alice").equal(col_status, 0).count(), 2);
+
+    table.remove_search_index({col_flag, col_owner});
+    CHECK_EQUAL(table.get_composite_indexes().size(), 1);
+    table.verify();
+
+    // Changing the nullability of a column keeps the indexes covering it
+    table.set_nullability(col_owner, true, false);
+    col_owner = table.get_column_key("owner");
+    CHECK(table.get_composite_indexes()[0] == std::vector<ColKey>({col_owner, col_status, col_created}));
+    table.verify();
+    CHECK_EQUAL(table.where().equal(col_owner, "bob").equal(col_status, 1).count(), 3);
+
+    // Removing a column removes the indexes covering it
+    table.remove_column(col_status);
+    CHECK(table.get_composite_indexes().empty());
+    table.add_search_index({col_owner, col_created});
+    table.clear();
+    table.create_object().set(col_owner, "dave");
+    table.verify();
+    CHECK_EQUAL(table.where().equal(col_owner, "dave").equal(col_created, Timestamp()).count(), 1);
+}
+
+TEST(CompositeIndex_Queries)
+{
+    Group g;
+    auto table = g.add_table("table");
+    auto col_owner = table->add_column(type_String, "owner");
+    auto col_status = table->add_column(type_Int, "status");
+    auto col_created = table->add_column(type_Timestamp, "created", true);
+    auto col_id = table->add_column(type_ObjectId, "id");
+    auto col_value = table->add_column(type_Int, "value");
+    Random random(random_int<unsigned long>());
+
+    std::vector<ObjectId> ids;
+    for (int i = 0; i < 4; i++)
+        ids.push_back(ObjectId::gen());
+    for (int i = 0; i < 3000; i++) {
+        auto obj = table->create_object();
+        obj.set(col_owner, util::to_string(random.draw_int<int>(0, 49)));
+        obj.set(col_status, random.draw_int<int64_t>(0, 3));
+        if (i % 7)
+            obj.set(col_created, Timestamp(random.draw_int<int64_t>(0, 999), 0));
+        obj.set(col_id, ids[random.draw_int<size_t>(0, 3)]);
+        obj.set(col_value, i);
+    }
+
+    std::vector<std::string> queries;
+    for (int owner : {0, 7, 49, 50}) {
+        for (int64_t status : {0, 2, 4}) {
+            for (int64_t created : {-1, 0, 500, 999}) {
+                auto prefix = util::format("owner == '%1' AND status == %2", owner, status);
+                auto ts = util::format("T%1:0", created);
+                queries.push_back(prefix);
+                queries.push_back(util::format("%1 AND created > %2", prefix, ts));
+                queries.push_back(util::format("%1 AND created >= %2 AND created < T700:0", prefix, ts));
+                queries.push_back(util::format("%1 AND created <= %2 AND value > 1000", prefix, ts));
+                queries.push_back(util::format("status == %1 AND created > %2 AND owner == '%3'", status, ts, owner));
+                queries.push_back(util::format("%1 AND created == nil", prefix));
+                queries.push_back(util::format("%1 AND (created > %2 OR value < 100)", prefix, ts));
+            }
+        }
+        queries.push_back(util::format("owner == '%1'", owner));
+        queries.push_back(util::format("owner == '%1' AND id == oid(%2)", owner, ids[1]));
+        queries.push_back(util::format("owner == '%1' AND status > 1", owner));
+    }
+
+    auto run = [&](const std::string& query) {
+        auto q = table->query(query);
+        auto tv = q.find_all();
+        std::vector<ObjKey> keys;
+        for (size_t i = 0; i < tv.size(); i++)
+            keys.push_back(tv.get_key(i));
+        CHECK_EQUAL(q.count(), keys.size());
+        CHECK_EQUAL(q.find(), keys.empty() ? ObjKey() : keys.front());
+        CHECK_EQUAL(q.sum(col_value)->get_int(),
+                    std::accumulate(keys.begin(), keys.end(), int64_t(0), [&](int64_t sum, ObjKey key) {
+                        return sum + table->get_object(key).get<Int>(col_value);
+                    }));
+        return keys;
+    };
+
+    std::vector<std::vector<ObjKey>> expected;
+    for (auto& query : queries)
+        expected.push_back(run(query));
+
+    table->add_search_index({col_owner, col_status, col_created});
+    table->add_search_index({col_owner, col_id});
+    for (size_t i = 0; i < queries.size(); i++)
+        CHECK(run(queries[i]) == expected[i]);
+
+    // Also when some of the columns have a search index of their own
+    table->add_search_index(col_owner);
+    table->add_search_index(col_created, IndexType::Ordered);
+    for (size_t i = 0; i < queries.size(); i++)
+        CHECK(run(queries[i]) == expected[i]);
+}
+
+TEST(CompositeIndex_Persistence)
+{
+    SHARED_GROUP_TEST_PATH(path);
+    ColKey col_owner, col_status;
+    {
+        auto db = DB::create(make_in_realm_history(), path);
+        auto wt = db->start_write();
+        auto table = wt->add_table("table");
+        col_owner = table->add_column(type_String, "owner");
+        col_status = table->add_column(type_Int, "status");
+        for (int64_t i = 0; i < 100; i++) {
+            auto obj = table->create_object();
+            obj.set(col_owner, i % 2 ? "alice" : "bob");
+            obj.set(col_status, i % 10);
+        }
+        table->add_search_index({col_owner, col_status});
+        wt->commit();
+    }
+    {
+        auto db = DB::create(make_in_realm_history(), path);
+        auto rt = db->start_read();
+        auto table = rt->get_table("table");
+        CHECK_EQUAL(table->get_composite_indexes().size(), 1);
+        CHECK_EQUAL(table->where().equal(col_owner, "alice").greater(col_status, 6).count(), 20);
+        rt->verify();
+
+        // Accessors follow changes made by another transaction
+        auto wt = db->start_write();
+        auto wtable = wt->get_table("table");
+        wtable->create_object().set(col_owner, "alice").set(col_status, 9);
+        wtable->add_search_index({col_status, col_owner});
+        wt->commit();
+        rt->advance_read();
+        CHECK_EQUAL(table->get_composite_indexes().size(), 2);
+        CHECK_EQUAL(table->where().equal(col_owner, "alice").greater(col_status, 6).count(), 21);
+        CHECK_EQUAL(table->where().equal(col_status, 9).equal(col_owner, "alice").count(), 11);
+        rt->verify();
+
+        wt = db->start_write();
+        wt->get_table("table")->remove_search_index({col_owner, col_status});
+        wt->commit();
+        rt->advance_read();
+        auto indexes = table->get_composite_indexes();
+        CHECK_EQUAL(indexes.size(), 1);
+        CHECK(indexes[0] == std::vector<ColKey>({col_status, col_owner}));
+        rt->verify();
+    }
+}
+
 #endif // TEST_INDEX_STRING
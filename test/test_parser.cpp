@@ -63,6 +63,7 @@
 #include "test_types_helper.hpp"
 
 #include <chrono>
+#include <deque>
 #include <string>
 #include <thread>
 #include <utility>
@@ -3069,6 +3070,115 @@ TEST(Parser_Limit)
     CHECK_EQUAL(tv2->size(), 1);
 }
 
+TEST(Parser_GroupBy)
+{
+    Group g;
+    TableRef items = g.add_table("item");
+    items->add_column(type_String, "category");
+    items->add_column(type_Int, "region");
+    items->add_column(type_Double, "price");
+    items->add_column_list(type_Int, "list");
+    items->add_column(*items, "link");
+
+    items->create_object().set_all("fruit", 1, 2.5);
+    items->create_object().set_all("bread", 1, 3.0);
+    items->create_object().set_all("fruit", 2, 1.5);
+    items->create_object().set_all("fruit", 1, 4.0);
+    items->create_object().set_all("cheese", 2, 10.0);
+
+    Query q = items->query("price > 2 GROUP BY(category, region) AGGREGATE(@count, price.@sum, price.@max)");
+    CHECK_EQUAL(q.count(), 4);
+    auto result = q.group_by();
+    CHECK_EQUAL(result.size(), 3);
+    CHECK_EQUAL(result.get_key(0, 0), Mixed("fruit"));
+    CHECK_EQUAL(result.get_key(0, 1), Mixed(1));
+    CHECK_EQUAL(result.get_value(0, 0), Mixed(2));
+    CHECK_EQUAL(result.get_value(0, 1), Mixed(6.5));
+    CHECK_EQUAL(result.get_value(0, 2), Mixed(4.0));
+    CHECK_EQUAL(result.get_key(1, 0), Mixed("bread"));
+    CHECK_EQUAL(result.get_value(1, 0), Mixed(1));
+    CHECK_EQUAL(result.get_key(2, 0), Mixed("cheese"));
+    CHECK_EQUAL(result.get_key(2, 1), Mixed(2));
+    CHECK_EQUAL(result.get_value(2, 1), Mixed(10.0));
+
+    // The description can be parsed again
+    std::string description = q.get_description();
+    CHECK(description.find("GROUP BY(category, region) AGGREGATE(@count, price.@sum, price.@max)") !=
+          std::string::npos);
+    Query q2 = items->query(description);
+    CHECK_EQUAL(q2.get_description(), description);
+    CHECK_EQUAL(q2.group_by().size(), 3);
+
+    // The objects of each group are counted when no aggregates are given, keywords ignore case
+    result = items->query("TRUEPREDICATE SORT(price DESC) group by(region)").group_by();
+    CHECK_EQUAL(result.size(), 2);
+    CHECK_EQUAL(result.get_value(0, 0), Mixed(3));
+    CHECK_EQUAL(result.get_value(1, 0), Mixed(2));
+    result = items->query("TRUEPREDICATE GROUP BY(region) AGGREGATE(price.@avg) AGGREGATE(price.@min)").group_by();
+    CHECK_EQUAL(result.size(), 2);
+    CHECK_EQUAL(result.get_value(0, 0), Mixed(9.5 / 3));
+    CHECK_EQUAL(result.get_value(0, 1), Mixed(2.5));
+    CHECK_EQUAL(result.get_value(1, 0), Mixed(5.75));
+    CHECK_EQUAL(result.get_value(1, 1), Mixed(1.5));
+
+    CHECK_THROW(items->query("TRUEPREDICATE GROUP(region)"), query_parser::SyntaxError);
+    CHECK_THROW(items->query("TRUEPREDICATE GROUP BY()"), query_parser::SyntaxError);
+    CHECK_THROW(items->query("TRUEPREDICATE GROUPS BY(region)"), query_parser::SyntaxError);
+    CHECK_THROW(items->query("TRUEPREDICATE GROUP BY(region) AGGREGATES(@count)"), query_parser::SyntaxError);
+    CHECK_THROW(items->query("TRUEPREDICATE GROUP BY(region) AGGREGATE(price)"), query_parser::SyntaxError);
+    CHECK_THROW(items->query("TRUEPREDICATE GROUP BY(region) SORT(price ASC)"), query_parser::SyntaxError);
+    CHECK_THROW(items->query("TRUEPREDICATE GROUP BY(link.region)"), query_parser::InvalidQueryError);
+    CHECK_THROW(items->query("TRUEPREDICATE GROUP BY(weight)"), query_parser::InvalidQueryError);
+    CHECK_THROW(items->query("TRUEPREDICATE GROUP BY(region) AGGREGATE(link.price.@sum)"),
+                query_parser::InvalidQueryError);
+    CHECK_THROW(items->query("TRUEPREDICATE GROUP BY(list)").group_by(), IllegalOperation);
+    CHECK_THROW(items->query("TRUEPREDICATE GROUP BY(region) AGGREGATE(category.@sum)").group_by(),
+                IllegalOperation);
+    CHECK_THROW(items->query("TRUEPREDICATE").group_by(), IllegalOperation);
+}
+
+TEST(Parser_Explain)
+{
+    Group g;
+    TableRef items = g.add_table("item");
+    auto col_region = items->add_column(type_Int, "region");
+    items->add_column(type_Double, "price");
+    items->add_search_index(col_region);
+    for (int i = 0; i < 100; i++) {
+        items->create_object().set_all(i % 10, double(i));
+    }
+
+    Query q = items->query("price > 50 AND region == 3 EXPLAIN");
+    CHECK(q.get_explain() == Query::Explain::Plan);
+    CHECK_EQUAL(q.count(), 5);
+    QueryProfile profile = q.explain_requested();
+    CHECK_EQUAL(profile.conditions.size(), 2);
+    CHECK(profile.uses_index);
+    CHECK_EQUAL(profile.conditions[0].description, "region == 3");
+    CHECK_EQUAL(profile.matches, 0);
+
+    // The description can be parsed again, keywords ignore case
+    std::string description = q.get_description();
+    CHECK(description.find(" EXPLAIN") != std::string::npos);
+    CHECK(items->query(description).get_explain() == Query::Explain::Plan);
+
+    q = items->query("price > 50 AND region == 3 SORT(price DESC) explain analyze");
+    CHECK(q.get_explain() == Query::Explain::Analyze);
+    profile = q.explain_requested();
+    CHECK_EQUAL(profile.matches, 5);
+    CHECK_EQUAL(profile.conditions[1].matches, 5);
+    CHECK(items->query(q.get_description()).get_explain() == Query::Explain::Analyze);
+
+    q = items->query("TRUEPREDICATE GROUP BY(region) EXPLAIN ANALYZE");
+    CHECK(q.get_explain() == Query::Explain::Analyze);
+    CHECK_EQUAL(q.group_by().size(), 10);
+
+    CHECK_THROW(items->query("TRUEPREDICATE EXPLAINS"), query_parser::SyntaxError);
+    CHECK_THROW(items->query("TRUEPREDICATE EXPLAIN ANALYSE"), query_parser::SyntaxError);
+    CHECK_THROW(items->query("TRUEPREDICATE EXPLAIN SORT(price ASC)"), query_parser::SyntaxError);
+    CHECK_THROW(items->query("TRUEPREDICATE").explain_requested(), IllegalOperation);
+}
+
 
 TEST(Parser_Backlinks)
 {
@@ -4093,6 +4203,120 @@ TEST(Parser_OperatorIN)
                    CHECK_EQUAL(e.what(), "The keypath following 'IN' must contain a list. Found 'fav_item.price'"));
 }
 
+
+TEST(Parser_OperatorINLargeLists)
+{
+    Group g;
+    TableRef t = g.add_table("class_Item");
+    ColKey col_int = t->add_column(type_Int, "int", true);
+    ColKey col_str = t->add_column(type_String, "str", true);
+    ColKey col_oid = t->add_column(type_ObjectId, "oid");
+    ColKey col_uuid = t->add_column(type_UUID, "uuid");
+    ColKey col_ts = t->add_column(type_Timestamp, "ts");
+    ColKey col_mixed = t->add_column(type_Mixed, "mixed");
+    ColKey col_list = t->add_column_list(type_String, "list");
+    ColKey col_link = t->add_column(*t, "link");
+
+    std::vector<ObjectId> oids;
+    std::vector<UUID> uuids;
+    ObjKey prev;
+    for (uint8_t i = 0; i < 200; ++i) {
+        Obj obj = t->create_object();
+        if (i % 10) {
+            obj.set(col_int, int64_t(i));
+            obj.set(col_str, util::format("str %1", i));
+        }
+        oids.push_back(ObjectId::gen());
+        obj.set(col_oid, oids.back());
+        uuids.push_back(UUID(UUID::UUIDBytes{i, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15}));
+        obj.set(col_uuid, uuids.back());
+        obj.set(col_ts, Timestamp(i, 0));
+        if (i % 3 == 0)
+            obj.set(col_mixed, Mixed(int64_t(i)));
+        else if (i % 3 == 1)
+            obj.set(col_mixed, Mixed(util::format("str %1", i)));
+        else
+            obj.set(col_mixed, Mixed(double(i)));
+        auto list = obj.get_list<String>(col_list);
+        list.add(util::format("str %1", i));
+        list.add(util::format("str %1", i + 1));
+        obj.set(col_link, prev);
+        prev = obj.get_key();
+    }
+
+    using Vec = std::vector<Mixed>;
+    // The constants must outlive the queries which refer to them
+    std::deque<std::string> buffers;
+    Vec ints{null{}}, strings, oid_values, uuid_values, timestamps, mixed_numbers;
+    for (int64_t i = 0; i < 300; i += 7) {
+        ints.push_back(i);
+        strings.push_back(StringData(buffers.emplace_back(util::format("str %1", i))));
+        mixed_numbers.push_back(i);
+        if (i < 200) {
+            oid_values.push_back(oids[i]);
+            uuid_values.push_back(uuids[i]);
+            timestamps.push_back(Timestamp(i, 0));
+        }
+    }
+    oid_values.push_back(ObjectId::gen());
+    Vec strings_and_null = strings;
+    strings_and_null.push_back(Mixed());
+    Vec strings_and_int = strings;
+    strings_and_int.push_back(int64_t(17));
+
+    auto in_list = [](Mixed value, const Vec& values) {
+        return std::any_of(values.begin(), values.end(), [&](const Mixed& v) {
+            return (value.is_null() && v.is_null()) || (Mixed::types_are_comparable(value, v) && value == v);
+        });
+    };
+    auto expected = [&](ColKey col, const Vec& values) {
+        size_t count = 0;
+        for (auto& obj : *t) {
+            if (col == col_list) {
+                auto list = obj.get_list<String>(col_list);
+                count += std::any_of(list.begin(), list.end(), [&](StringData s) {
+                    return in_list(Mixed(s), values);
+                });
+            }
+            else if (col == col_link) {
+                auto target = obj.get_linked_object(col_link);
+                count += target && in_list(target.get_any(col_str), values);
+            }
+            else {
+                count += in_list(obj.get_any(col), values);
+            }
+        }
+        return count;
+    };
+    auto check = [&] {
+        verify_query(test_context, t, "int IN $0", {ints}, expected(col_int, ints));
+        verify_query(test_context, t, "str IN $0", {strings}, expected(col_str, strings));
+        verify_query(test_context, t, "str IN $0", {strings_and_null}, expected(col_str, strings_and_null));
+        verify_query(test_context, t, "str IN $0", {strings_and_int}, expected(col_str, strings_and_int));
+        verify_query(test_context, t, "NOT str IN $0", {strings_and_null},
+                     t->size() - expected(col_str, strings_and_null));
+        verify_query(test_context, t, "oid IN $0", {oid_values}, expected(col_oid, oid_values));
+        verify_query(test_context, t, "uuid IN $0", {uuid_values}, expected(col_uuid, uuid_values));
+        verify_query(test_context, t, "ts IN $0", {timestamps}, expected(col_ts, timestamps));
+        verify_query(test_context, t, "mixed IN $0", {strings_and_null}, expected(col_mixed, strings_and_null));
+        // Integers also match the doubles held by the Mixed property
+        verify_query(test_context, t, "mixed IN $0", {mixed_numbers}, expected(col_mixed, mixed_numbers));
+        verify_query(test_context, t, "list IN $0", {strings}, expected(col_list, strings));
+        verify_query(test_context, t, "link.str IN $0", {strings}, expected(col_link, strings));
+        verify_query(test_context, t, "int IN $0 AND str IN $1", {ints, strings}, 26);
+    };
+    check();
+
+    // The same results are found through the search indexes
+    t->add_search_index(col_int);
+    t->add_search_index(col_str);
+    t->add_search_index(col_oid);
+    t->add_search_index(col_ts);
+    t->add_search_index(col_mixed);
+    check();
+    // 26 multiples of 7 and the 20 nulls
+    CHECK_EQUAL(expected(col_int, ints), 46);
+}
 TEST(Parser_KeyPathSubstitution)
 {
     Group g;
@@ -6497,4 +6721,84 @@ TEST(Parser_Wildcard)
     CHECK_EQUAL(q.count(), 1);
 }
 
+NONCONCURRENT_TEST(Parser_QueryCache)
+{
+    using namespace realm::query_parser;
+    clear_query_cache();
+
+    Group g;
+    auto person = g.add_table("person");
+    auto col_age = person->add_column(type_Int, "age");
+    auto col_name = person->add_column(type_String, "name");
+    auto col_friends = person->add_column_list(*person, "friends");
+    auto col_scores = person->add_column_list(type_Int, "scores");
+    auto animal = g.add_table("animal");
+    auto col_animal_age = animal->add_column(type_Int, "age");
+    animal->add_column(type_String, "name");
+
+    for (int i = 0; i < 10; i++) {
+        auto obj = person->create_object();
+        obj.set(col_age, i * 10);
+        obj.set(col_name, util::to_string(i));
+        obj.get_list<Int>(col_scores).add(i);
+        obj.get_list<Int>(col_scores).add(10 - i);
+        if (i > 0)
+            obj.get_linklist(col_friends).add(person->get_object(0).get_key());
+        animal->create_object().set(col_animal_age, i);
+    }
+
+    // Later runs of a query reuse the syntax tree with new arguments
+    CHECK_EQUAL(person->query("age > $0", std::vector<Mixed>{Mixed(20)}).count(), 7);
+    CHECK_EQUAL(person->query("age > $0", std::vector<Mixed>{Mixed(60)}).count(), 3);
+    CHECK_EQUAL(animal->query("age > $0", std::vector<Mixed>{Mixed(5)}).count(), 4);
+    auto stats = get_query_cache_stats();
+    CHECK_EQUAL(stats.misses, 1);
+    CHECK_EQUAL(stats.hits, 2);
+    CHECK_EQUAL(stats.size, 1);
+
+    // Queries whose paths are consumed while building the query
+    for (int i = 0; i < 3; i++) {
+        CHECK_EQUAL(person->query("friends.@count > $0", std::vector<Mixed>{Mixed(0)}).count(), 9);
+        CHECK_EQUAL(person->query("@links.@count > 0").count(), 1);
+        CHECK_EQUAL(person->query("friends.name == $0", std::vector<Mixed>{Mixed("0")}).count(), 9);
+        CHECK_EQUAL(person->query("$K0 >= $1", std::vector<Mixed>{Mixed("age"), Mixed(80 - i * 10)}).count(), 2 + i);
+        auto tv = person->query("age < $0 SORT(name DESC)", std::vector<Mixed>{Mixed(30)}).find_all();
+        CHECK_EQUAL(tv.size(), 3);
+        CHECK_EQUAL(tv.get_object(0).get<StringData>(col_name), "2");
+    }
+    stats = get_query_cache_stats();
+    CHECK_EQUAL(stats.misses, 6);
+    CHECK_EQUAL(stats.hits, 12);
+
+    // The syntax tree depends on arguments used as list indexes, so such queries are not cached
+    CHECK_EQUAL(person->query("scores[$0] > 7", std::vector<Mixed>{Mixed(0)}).count(), 2);
+    CHECK_EQUAL(person->query("scores[$0] > 7", std::vector<Mixed>{Mixed(1)}).count(), 3);
+    CHECK_EQUAL(get_query_cache_stats().size, 6);
+
+    // Invalid queries are not cached
+    CHECK_THROW_ANY(person->query("age >"));
+    CHECK_THROW_ANY(animal->query("friends.@count > $0", std::vector<Mixed>{Mixed(0)}));
+    CHECK_EQUAL(person->query("friends.@count > $0", std::vector<Mixed>{Mixed(0)}).count(), 9);
+    CHECK_EQUAL(get_query_cache_stats().size, 6);
+
+    // The least recently used queries are evicted
+    set_query_cache_capacity(2);
+    stats = get_query_cache_stats();
+    CHECK_EQUAL(stats.size, 2);
+    CHECK_EQUAL(stats.evictions, 4);
+    CHECK_EQUAL(person->query("friends.@count > $0", std::vector<Mixed>{Mixed(0)}).count(), 9);
+    CHECK_EQUAL(get_query_cache_stats().hits, stats.hits + 1);
+
+    set_query_cache_capacity(0);
+    CHECK_EQUAL(person->query("age > $0", std::vector<Mixed>{Mixed(20)}).count(), 7);
+    CHECK_EQUAL(person->query("age > $0", std::vector<Mixed>{Mixed(20)}).count(), 7);
+    stats = get_query_cache_stats();
+    CHECK_EQUAL(stats.size, 0);
+    CHECK_EQUAL(stats.capacity, 0);
+
+    set_query_cache_capacity(256);
+    clear_query_cache();
+    CHECK_EQUAL(get_query_cache_stats().hits, 0);
+}
+
 #endif // TEST_PARSER
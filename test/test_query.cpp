@@ -5772,4 +5772,280 @@ TEST(Query_NestedLinkCount)
     CHECK_EQUAL(q.count(), 3);
 }
 
+TEST(Query_LeafValueRanges)
+{
+    // Range queries skip clusters based on the smallest and largest values in
+    // them. Check that the results stay correct as the values change, both
+    // within a write transaction and between versions.
+    SHARED_GROUP_TEST_PATH(path);
+    std::unique_ptr<Replication> hist(make_in_realm_history());
+    DBRef db = DB::create(*hist, path, DBOptions(crypt_key()));
+    const int64_t num_objects = 3000;
+    {
+        auto wt = db->start_write();
+        auto table = wt->add_table("table");
+        table->add_column(type_Int, "int");
+        table->add_column(type_Int, "opt", true);
+        table->add_column(type_Timestamp, "ts");
+        table->add_column(type_Double, "double");
+        wt->commit();
+    }
+
+    auto set_values = [&](TableRef table, int64_t shift) {
+        auto col_int = table->get_column_key("int");
+        auto col_opt = table->get_column_key("opt");
+        auto col_ts = table->get_column_key("ts");
+        auto col_double = table->get_column_key("double");
+        for (int64_t i = 0; i < num_objects; ++i) {
+            Obj obj = table->size() < size_t(num_objects) ? table->create_object() : table->get_object(size_t(i));
+            obj.set(col_int, i + shift);
+            if (i % 100 == 50)
+                obj.set_null(col_opt);
+            else
+                obj.set(col_opt, i + shift);
+            obj.set(col_ts, Timestamp(i + shift, 0));
+            obj.set(col_double, double(i + shift) / 2);
+        }
+    };
+
+    auto check = [&](ConstTableRef table, int64_t shift) {
+        auto col_int = table->get_column_key("int");
+        auto col_opt = table->get_column_key("opt");
+        auto col_ts = table->get_column_key("ts");
+        auto col_double = table->get_column_key("double");
+        for (int i = 0; i < 2; ++i) {
+            CHECK_EQUAL(table->where().greater(col_int, 2500 + shift).count(), 499);
+            CHECK_EQUAL(table->where().greater_equal(col_int, 2500 + shift).count(), 500);
+            CHECK_EQUAL(table->where().less(col_int, 100 + shift).count(), 100);
+            CHECK_EQUAL(table->where().less_equal(col_int, 100 + shift).count(), 101);
+            CHECK_EQUAL(table->where().between(col_int, 1000 + shift, 1099 + shift).count(), 100);
+            CHECK_EQUAL(table->where().greater(col_int, num_objects + shift).count(), 0);
+            CHECK_EQUAL(table->where().greater(col_opt, 2500 + shift).count(), 494);
+            CHECK_EQUAL(table->where().less(col_opt, 100 + shift).count(), 99);
+            CHECK_EQUAL(table->where().greater(col_ts, Timestamp(2500 + shift, 0)).count(), 499);
+            CHECK_EQUAL(table->where().less_equal(col_ts, Timestamp(99 + shift, 0)).count(), 100);
+            CHECK_EQUAL(table->where().greater(col_double, double(2500 + shift) / 2).count(), 499);
+            CHECK_EQUAL(table->where().less(col_double, double(100 + shift) / 2).count(), 100);
+            auto tv = table->where().greater(col_int, 2990 + shift).find_all();
+            CHECK_EQUAL(tv.size(), 9);
+            CHECK_EQUAL(tv.get_object(0).get<Int>(col_int), 2991 + shift);
+        }
+    };
+
+    {
+        auto wt = db->start_write();
+        set_values(wt->get_table("table"), 0);
+        check(wt->get_table("table"), 0);
+        wt->commit();
+    }
+
+    auto rt = db->start_read();
+    check(rt->get_table("table"), 0);
+    for (int64_t shift = 1000; shift <= 5000; shift += 1000) {
+        auto wt = db->start_write();
+        auto table = wt->get_table("table");
+        check(table, shift - 1000);
+        set_values(table, shift);
+        check(table, shift);
+        wt->commit_and_continue_as_read();
+        check(wt->get_table("table"), shift);
+
+        rt->advance_read();
+        check(rt->get_table("table"), shift);
+        check(rt->freeze()->get_table("table"), shift);
+    }
+
+    // Change a single value in a leaf which has been skipped before
+    auto frozen = rt->freeze();
+    check(frozen->get_table("table"), 5000);
+    {
+        auto wt = db->start_write();
+        auto table = wt->get_table("table");
+        table->get_object(10).set("int", int64_t(100000));
+        wt->commit();
+    }
+    rt->advance_read();
+    for (auto tr : {rt, rt->freeze()}) {
+        auto table = tr->get_table("table");
+        CHECK_EQUAL(table->where().greater(table->get_column_key("int"), 90000).count(), 1);
+        CHECK_EQUAL(table->where().less(table->get_column_key("int"), 5011).count(), 10);
+    }
+    check(frozen->get_table("table"), 5000);
+
+    {
+        auto wt = db->start_write();
+        auto table = wt->get_table("table");
+        auto col_int = table->get_column_key("int");
+        auto count_greater = [&](int64_t value) {
+            size_t n = 0;
+            for (auto obj : *table)
+                n += obj.get<Int>(col_int) > value;
+            return n;
+        };
+        Query q = table->where().greater(col_int, 7000);
+        QueryProfile profile = q.profile();
+        CHECK_EQUAL(profile.matches, 1000);
+        CHECK(profile.conditions[0].clusters_skipped > 0);
+
+        // A value set in a skipped cluster is found right away
+        table->get_object(20).set(col_int, int64_t(200000));
+        table->get_object(2000).set_null(table->get_column_key("opt"));
+        table->get_object(2001).set("double", -1e10);
+        CHECK_EQUAL(q.count(), 1001);
+        CHECK_EQUAL(table->where().less(table->get_column_key("double"), -1e9).count(), 1);
+        table->verify();
+
+        // Erasing objects makes the ranges of their clusters unknown until
+        // they are computed again on commit
+        for (int64_t i = num_objects - 1; i >= 0; i -= 7)
+            table->remove_object(table->get_object(size_t(i)).get_key());
+        CHECK_EQUAL(q.count(), count_greater(7000));
+        wt->commit_and_continue_as_read();
+        table = wt->get_table("table");
+        table->verify();
+        CHECK_EQUAL(q.count(), count_greater(7000));
+        profile = q.profile();
+        CHECK(profile.conditions[0].clusters_skipped > 0);
+    }
+}
+
+TEST(Query_Multithreaded)
+{
+    Group g;
+    auto table = g.add_table("table");
+    auto col_int = table->add_column(type_Int, "int");
+    auto col_opt = table->add_column(type_Int, "opt", true);
+    auto col_double = table->add_column(type_Double, "double");
+    auto target = g.add_table("target");
+    auto col_value = target->add_column(type_Int, "value");
+    auto col_link = table->add_column(*target, "link");
+    auto col_list = table->add_column_list(*target, "list");
+    for (int i = 0; i < 100; ++i)
+        target->create_object().set(col_value, i);
+
+    Random random(random_int<unsigned long>()); // Seed from slow global generator
+    constexpr int num_objects = 25000;
+    for (int i = 0; i < num_objects; ++i) {
+        auto obj = table->create_object();
+        obj.set(col_int, random.draw_int_mod(1000));
+        if (i % 7)
+            obj.set(col_opt, random.draw_int_mod(1000) - 500);
+        obj.set(col_double, random.draw_int_mod(100000) / 7.0);
+        if (i % 5)
+            obj.set(col_link, target->get_object(size_t(random.draw_int_mod(100))).get_key());
+        auto list = obj.get_linklist(col_list);
+        for (int j = i % 3; j > 0; --j)
+            list.add(target->get_object(size_t(random.draw_int_mod(100))).get_key());
+    }
+
+    auto check = [&](Query q) {
+        Query serial(q);
+        q.set_threads(4);
+
+        auto tv1 = serial.find_all();
+        auto tv2 = q.find_all();
+        CHECK_EQUAL(tv1.size(), tv2.size());
+        bool same_keys = true;
+        for (size_t i = 0; i < tv1.size() && same_keys; ++i)
+            same_keys = tv1.get_key(i) == tv2.get_key(i);
+        CHECK(same_keys);
+        CHECK_EQUAL(q.find_all_multi().size(), tv1.size());
+        CHECK_EQUAL(q.count(), serial.count());
+        CHECK_EQUAL(q.find_all(10).size(), serial.find_all(10).size());
+
+        for (auto col : {col_int, col_opt, col_double}) {
+            if (col == col_double) {
+                // Every thread adds up its own part of the values, so the sum
+                // of doubles may differ in the last digits
+                Mixed sum = *q.sum(col);
+                Mixed avg = *q.avg(col);
+                CHECK_APPROXIMATELY_EQUAL(sum.get_double(), serial.sum(col)->get_double(), 1e-12);
+                CHECK_EQUAL(avg.is_null(), serial.avg(col)->is_null());
+                if (!avg.is_null())
+                    CHECK_APPROXIMATELY_EQUAL(avg.get_double(), serial.avg(col)->get_double(), 1e-12);
+            }
+            else {
+                CHECK_EQUAL(*q.sum(col), *serial.sum(col));
+                CHECK_EQUAL(*q.avg(col), *serial.avg(col));
+            }
+            ObjKey k1, k2;
+            CHECK_EQUAL(*q.min(col, &k1), *serial.min(col, &k2));
+            CHECK_EQUAL(k1, k2);
+            CHECK_EQUAL(*q.max(col, &k1), *serial.max(col, &k2));
+            CHECK_EQUAL(k1, k2);
+        }
+    };
+
+    check(table->where().greater(col_int, 500));
+    check(table->where().less(col_opt, 0).greater(col_double, 5000.0));
+    check(table->where().equal(col_int, 17).Or().equal(col_opt, 17));
+    check(table->where().greater(col_int, 1000));
+    check(table->where().not_equal(col_double, -1.0));
+    // Conditions evaluated through links, which every thread follows with
+    // its own copy of the query
+    check(table->query("link.value > 50 && int < 500"));
+    check(table->query("list.value < 10 || link == NULL"));
+    check(table->query("SUBQUERY(list, $x, $x.value >= 90).@count > 0"));
+    check(table->query("list.@count == 2 && link.@links.@count > 200"));
+}
+
+TEST(Query_Profile)
+{
+    SHARED_GROUP_TEST_PATH(path);
+    std::unique_ptr<Replication> hist(make_in_realm_history());
+    DBRef db = DB::create(*hist, path, DBOptions(crypt_key()));
+    {
+        auto wt = db->start_write();
+        auto table = wt->add_table("table");
+        auto col_int = table->add_column(type_Int, "sorted");
+        auto col_str = table->add_column(type_String, "name");
+        table->add_search_index(col_str);
+        const char* names[] = {"a", "b", "c", "d"};
+        for (int i = 0; i < 10000; ++i) {
+            table->create_object().set(col_int, i).set(col_str, names[i % 4]);
+        }
+        wt->commit();
+    }
+    auto rt = db->start_read();
+    auto table = rt->get_table("table");
+    auto col_int = table->get_column_key("sorted");
+    auto col_str = table->get_column_key("name");
+
+    // The indexed condition drives the search even if it is specified last
+    Query q = table->where().greater(col_int, 5000).equal(col_str, "a");
+    QueryProfile explanation = q.explain();
+    CHECK(explanation.uses_index);
+    CHECK_EQUAL(explanation.conditions.size(), 2);
+    CHECK(explanation.conditions[0].uses_index);
+    CHECK_EQUAL(explanation.conditions[0].description, "name == \"a\"");
+    CHECK_NOT(explanation.conditions[1].uses_index);
+    CHECK_EQUAL(explanation.conditions[1].description, "sorted > 5000");
+    CHECK_EQUAL(explanation.conditions[0].probes, 0);
+    CHECK_EQUAL(explanation.matches, 0);
+
+    QueryProfile profile = q.profile();
+    CHECK_EQUAL(profile.matches, q.count());
+    CHECK_EQUAL(profile.conditions[0].matches, 2500);
+    CHECK_EQUAL(profile.conditions[1].matches, profile.matches);
+    CHECK(profile.time.count() > 0);
+    CHECK_NOT(profile.to_string().empty());
+
+    // Without an index the values of every cluster are checked, except the clusters
+    // where no value can match
+    q = table->query("sorted >= 9000 and name == 'b' or sorted < 0");
+    profile = q.profile();
+    CHECK_NOT(profile.uses_index);
+    CHECK_EQUAL(profile.matches, 250);
+    CHECK_EQUAL(profile.conditions.size(), 1);
+    CHECK(profile.conditions[0].clusters_visited > 0);
+    CHECK(profile.conditions[0].probes > 0);
+    CHECK_EQUAL(profile.conditions[0].matches, 250);
+
+    q = table->where().greater_equal(col_int, 9000);
+    profile = q.profile();
+    CHECK_EQUAL(profile.matches, 1000);
+    CHECK(profile.conditions[0].clusters_skipped > 0);
+    CHECK(profile.conditions[0].clusters_skipped < profile.conditions[0].clusters_visited);
+}
+
 #endif // TEST_QUERY
@@ -29,6 +29,7 @@
 #include <realm/column_integer.hpp>
 #include <realm/array_bool.hpp>
 #include <realm/query_expression.hpp>
+#include <realm/index_fulltext.hpp>
 #include <realm/index_string.hpp>
 #include <realm/query_expression.hpp>
 #include "test.hpp"
@@ -6214,4 +6215,585 @@ TEST(Query_FullTextPrefix)
     CHECK_EQUAL(q.count(), 1);
 }
 
+TEST(Query_FullTextPostings)
+{
+    Group g;
+    auto table = g.add_table("table");
+    auto col = table->add_column(type_String, "text");
+
+    // A small vocabulary, so that the posting lists of the words span several blocks
+    static const char* words[] = {"alpha", "beta",  "gamma",   "delta", "epsilon", "zeta",
+                                  "eta",   "theta", "iota",    "kappa", "lambda",  "mu",
+                                  "alps",  "alto",  "betamax", "deltoid"};
+    Random random(random_int<unsigned long>());
+    auto random_text = [&] {
+        std::string text;
+        size_t n = random.draw_int<size_t>(0, 8);
+        for (size_t i = 0; i < n; ++i) {
+            text += words[random.draw_int_max<size_t>(std::size(words) - 1)];
+            text += i % 3 == 2 ? ". " : " ";
+        }
+        return text;
+    };
+
+    // Filled in bulk when the index is added
+    for (size_t i = 0; i < 1000; ++i) {
+        table->create_object().set(col, random_text());
+    }
+    table->add_fulltext_index(col);
+    CHECK_EQUAL(table->search_index_type(col), IndexType::Fulltext);
+    auto index = dynamic_cast<FulltextIndex*>(table->get_search_index(col));
+    CHECK(index);
+    index->verify();
+
+    auto expected = [&](StringData terms) {
+        auto tokenizer = Tokenizer::get_instance();
+        auto [includes, excludes] = tokenizer->reset({terms.data(), terms.size()}).get_search_tokens();
+        std::vector<ObjKey> keys;
+        for (auto& obj : *table) {
+            auto text = obj.get<String>(col);
+            auto tokens = tokenizer->reset({text.data(), text.size()}).get_all_tokens();
+            auto has = [&](const std::string& term) {
+                if (term.back() != '*')
+                    return tokens.count(term) > 0;
+                auto prefix = term.substr(0, term.size() - 1);
+                auto it = tokens.lower_bound(prefix);
+                return it != tokens.end() && StringData(*it).begins_with(prefix);
+            };
+            if (std::all_of(includes.begin(), includes.end(), has) &&
+                std::none_of(excludes.begin(), excludes.end(), has))
+                keys.push_back(obj.get_key());
+        }
+        return keys;
+    };
+    auto found = [&](StringData terms) {
+        auto tv = table->where().fulltext(col, terms).find_all();
+        std::vector<ObjKey> keys;
+        for (size_t i = 0; i < tv.size(); ++i)
+            keys.push_back(tv.get_key(i));
+        return keys;
+    };
+    auto check_searches = [&] {
+        index->verify();
+        for (auto terms : {"alpha", "alpha beta", "beta alpha mu", "alp*", "al* -alps", "delta* -delta", "-eta",
+                           "mu -iot* kappa", "betamax", "kappa lambda -theta -zeta", "omega", "al*  bet*"}) {
+            if (!CHECK_EQUAL(found(terms), expected(terms)))
+                std::cout << "  terms: " << terms << std::endl;
+        }
+    };
+    check_searches();
+
+    // Maintained by single updates
+    for (size_t i = 0; i < 500; ++i) {
+        table->create_object().set(col, random_text());
+    }
+    check_searches();
+    for (size_t i = 0; i < 500; ++i) {
+        auto ndx = random.draw_int_max<size_t>(table->size() - 1);
+        auto obj = table->get_object(ndx);
+        if (i % 5 == 0) {
+            obj.remove();
+        }
+        else {
+            obj.set(col, i % 7 ? random_text() : std::string());
+        }
+    }
+    check_searches();
+
+    CHECK_GREATER(index->get_document_frequency("alpha"), FulltextIndex::s_max_block_size);
+    CHECK_EQUAL(index->get_document_frequency("omega"), 0);
+
+    // The layout is kept when the nullability changes
+    col = table->set_nullability(col, true, false);
+    CHECK_EQUAL(table->search_index_type(col), IndexType::Fulltext);
+    index = dynamic_cast<FulltextIndex*>(table->get_search_index(col));
+    CHECK(index);
+    check_searches();
+
+    // Whole values are found through the postings of their tokens
+    auto obj = table->create_object().set(col, "Kappa Lambda");
+    CHECK_EQUAL(table->find_first(col, StringData("Kappa Lambda")), obj.get_key());
+    CHECK_EQUAL(table->where().equal(col, "kappa lambda", false).count(), 1);
+    CHECK_EQUAL(table->where().equal(col, "Lambda Kappa").count(), 0);
+    CHECK_EQUAL(index->count("Kappa Lambda."), 0);
+    CHECK_NOT(index->find_first("Kappa"));
+    for (size_t i = 0; i < 20; ++i) {
+        auto value = table->get_object(random.draw_int_max<size_t>(table->size() - 1)).get_any(col);
+        std::vector<ObjKey> expected_keys;
+        for (auto& o : *table) {
+            if (o.get_any(col) == value)
+                expected_keys.push_back(o.get_key());
+        }
+        std::vector<ObjKey> keys;
+        index->find_all(keys, value);
+        CHECK_EQUAL(keys, expected_keys);
+        CHECK_EQUAL(index->count(value), expected_keys.size());
+        CHECK_EQUAL(index->find_first(value), expected_keys.empty() ? ObjKey() : expected_keys.front());
+    }
+    // Values without tokens are found by scanning the column
+    CHECK_EQUAL(index->count(""), table->where().equal(col, "").count());
+    CHECK_EQUAL(index->count(Mixed()), table->where().equal(col, null()).count());
+
+    table->clear();
+    CHECK(index->is_empty());
+}
+
+TEST(Query_FullTextRanked)
+{
+    Group g;
+    auto table = g.add_table("table");
+    auto col = table->add_column(type_String, "text");
+    table->add_fulltext_index(col);
+
+    auto k0 = table->create_object().set(col, "the cat sat on the mat").get_key();
+    auto k1 = table->create_object().set(col, "the cat saw the other cat and the dog").get_key();
+    auto k2 = table->create_object().set(col, "a dog and a cat and a rare bird").get_key();
+    auto k3 = table->create_object().set(col, "the dog").get_key();
+    table->create_object().set(col, "nothing to see here");
+
+    using Keys = std::vector<ObjKey>;
+    // Ordered by term frequency
+    CHECK_EQUAL(table->find_top_fulltext(col, "cat", 10), Keys({k1, k0, k2}));
+    CHECK_EQUAL(table->find_top_fulltext(col, "cat", 2), Keys({k1, k0}));
+    CHECK_EQUAL(table->find_top_fulltext(col, "cat", 0), Keys());
+    // Rare tokens weigh more
+    CHECK_EQUAL(table->find_top_fulltext(col, "cat bird*", 10), Keys({k2}));
+    CHECK_EQUAL(table->find_top_fulltext(col, "dog -cat", 10), Keys({k3}));
+    CHECK_EQUAL(table->find_top_fulltext(col, "cat dog", 10), Keys({k1, k2}));
+    CHECK_EQUAL(table->find_top_fulltext(col, "c* d*", 10), Keys({k1, k2}));
+    // Ties are ordered by key
+    CHECK_EQUAL(table->find_top_fulltext(col, "dog", 10), Keys({k1, k2, k3}));
+    CHECK_THROW_ANY(table->find_top_fulltext(col, "", 10));
+
+    auto col_other = table->add_column(type_String, "other");
+    CHECK_THROW(table->find_top_fulltext(col_other, "cat", 10), IllegalOperation);
+
+    // Fulltext indexes on lists of strings do not store posting lists
+    auto col_list = table->add_column_list(type_String, "list");
+    table->add_fulltext_index(col_list);
+    CHECK_EQUAL(table->search_index_type(col_list), IndexType::Fulltext);
+    CHECK_NOT(dynamic_cast<FulltextIndex*>(table->get_search_index(col_list)));
+    table->get_object(k3).get_list<String>(col_list).add("cat and dog");
+    table->get_object(k0).get_list<String>(col_list).add("dog");
+    CHECK_EQUAL(table->find_top_fulltext(col_list, "dog", 10), Keys({k0, k3}));
+    CHECK_EQUAL(table->find_top_fulltext(col_list, "dog", 1), Keys({k0}));
+}
+
+TEST(Query_GroupBy)
+{
+    Group g;
+    auto table = g.add_table("table");
+    auto col_category = table->add_column(type_String, "category", true);
+    auto col_region = table->add_column(type_Int, "region");
+    auto col_price = table->add_column(type_Double, "price");
+    auto col_qty = table->add_column(type_Int, "qty", true);
+    auto col_date = table->add_column(type_Timestamp, "date");
+    auto col_mixed = table->add_column(type_Mixed, "mixed", true);
+    auto col_list = table->add_column_list(type_Int, "list");
+
+    const char* categories[] = {"fruit", "bread", "cheese"};
+    Random random(random_int<unsigned long>()); // Seed from slow global generator
+    for (int i = 0; i < 500; ++i) {
+        auto obj = table->create_object();
+        int c = random.draw_int_mod(4);
+        if (c < 3)
+            obj.set(col_category, categories[c]);
+        obj.set(col_region, random.draw_int_mod<int64_t>(5));
+        obj.set(col_price, double(random.draw_int_mod(1000)) / 10);
+        if (random.draw_int_mod(5))
+            obj.set(col_qty, random.draw_int_mod<int64_t>(50));
+        obj.set(col_date, Timestamp(random.draw_int_mod(1000), 0));
+    }
+
+    using Type = GroupByAggregate::Type;
+    std::vector<GroupByAggregate> aggregates = {{Type::Count},
+                                                {Type::Sum, col_price},
+                                                {Type::Min, col_qty},
+                                                {Type::Max, col_date},
+                                                {Type::Average, col_qty}};
+
+    struct Expected {
+        int64_t count = 0;
+        double sum = 0;
+        std::optional<int64_t> min_qty;
+        Timestamp max_date{0, 0};
+        int64_t qty_sum = 0;
+        int64_t qty_count = 0;
+    };
+
+    auto check = [&](Query q, const std::vector<ObjKey>& objects) {
+        std::map<std::pair<std::string, int64_t>, Expected> expected;
+        for (auto key : objects) {
+            auto obj = table->get_object(key);
+            StringData category = obj.get<StringData>(col_category);
+            auto& e = expected[{category.is_null() ? "<null>" : std::string(category), obj.get<Int>(col_region)}];
+            ++e.count;
+            e.sum += obj.get<double>(col_price);
+            if (auto qty = obj.get<std::optional<Int>>(col_qty)) {
+                e.min_qty = e.min_qty ? std::min(*e.min_qty, *qty) : *qty;
+                e.qty_sum += *qty;
+                ++e.qty_count;
+            }
+            e.max_date = std::max(e.max_date, obj.get<Timestamp>(col_date));
+        }
+
+        auto result = q.group_by({col_category, col_region}, aggregates);
+        CHECK_EQUAL(result.size(), expected.size());
+        for (size_t group = 0; group < result.size(); ++group) {
+            Mixed category = result.get_key(group, 0);
+            auto it = expected.find({category.is_null() ? "<null>" : std::string(category.get_string()),
+                                     result.get_key(group, 1).get_int()});
+            if (!CHECK(it != expected.end()))
+                continue;
+            auto& e = it->second;
+            CHECK_EQUAL(result.get_value(group, 0), Mixed(e.count));
+            CHECK_APPROXIMATELY_EQUAL(result.get_value(group, 1).get_double(), e.sum, 1e-9);
+            CHECK_EQUAL(result.get_value(group, 2), e.min_qty ? Mixed(*e.min_qty) : Mixed());
+            CHECK_EQUAL(result.get_value(group, 3), Mixed(e.max_date));
+            if (e.qty_count) {
+                CHECK_APPROXIMATELY_EQUAL(result.get_value(group, 4).get_double(),
+                                          double(e.qty_sum) / e.qty_count, 1e-9);
+            }
+            else {
+                CHECK(result.get_value(group, 4).is_null());
+            }
+        }
+        // The groups are ordered by their first object
+        if (!objects.empty() && result.size()) {
+            auto first = table->get_object(objects.front());
+            CHECK_EQUAL(result.get_key(0, 0), first.get_any(col_category));
+            CHECK_EQUAL(result.get_key(0, 1), first.get_any(col_region));
+        }
+    };
+    auto matches = [&](Query q) {
+        TableView tv = q.find_all();
+        std::vector<ObjKey> keys;
+        for (size_t i = 0; i < tv.size(); ++i)
+            keys.push_back(tv.get_key(i));
+        return keys;
+    };
+
+    check(table->where(), matches(table->where()));
+    Query q = table->where().greater(col_qty, 10);
+    check(q, matches(q));
+    q = table->where().equal(col_category, "bread").Or().less(col_price, 10.0);
+    check(q, matches(q));
+    q = table->where().equal(col_region, 7);
+    check(q, {});
+
+    table->add_search_index(col_region);
+    q = table->where().equal(col_region, 3).greater(col_qty, 20);
+    check(q, matches(q));
+    q = table->where().equal(col_region, 3);
+    check(q, matches(q));
+
+    TableView tv = table->where().less(col_price, 50.0).find_all();
+    q = table->where(tv).not_equal(col_category, "fruit");
+    check(q, matches(q));
+
+    // Numeric values are grouped by value, whatever their type
+    table->get_object(0).set_any(col_mixed, int64_t(1));
+    table->get_object(1).set_any(col_mixed, 1.0);
+    table->get_object(2).set_any(col_mixed, Decimal128(1));
+    table->get_object(3).set_any(col_mixed, "1");
+    table->get_object(4).set_any(col_mixed, 1.5f);
+    table->get_object(5).set_any(col_mixed, 1.5);
+    auto result = table->where().group_by({col_mixed}, {{Type::Count}, {Type::Sum, col_mixed}});
+    CHECK_EQUAL(result.size(), 4);
+    CHECK_EQUAL(result.get_key(0, 0), Mixed(1));
+    CHECK_EQUAL(result.get_value(0, 0), Mixed(3));
+    CHECK_EQUAL(result.get_value(0, 1), Mixed(Decimal128(3)));
+    CHECK_EQUAL(result.get_key(1, 0), Mixed("1"));
+    CHECK_EQUAL(result.get_value(1, 0), Mixed(1));
+    CHECK_EQUAL(result.get_key(2, 0), Mixed(1.5f));
+    CHECK_EQUAL(result.get_value(2, 0), Mixed(2));
+    CHECK(result.get_key(3, 0).is_null());
+    CHECK_EQUAL(result.get_value(3, 0), Mixed(494));
+
+    // Fractions compare to decimals after being rounded to 15 digits for doubles
+    // and to 7 digits for floats, and are grouped the same way
+    table->get_object(0).set_any(col_mixed, 0.1 + 0.2);
+    table->get_object(1).set_any(col_mixed, Decimal128("0.3"));
+    table->get_object(2).set_any(col_mixed, 0.1f);
+    table->get_object(3).set_any(col_mixed, Decimal128("0.1"));
+    table->get_object(4).set_any(col_mixed, Mixed());
+    table->get_object(5).set_any(col_mixed, Mixed());
+    result = table->where().group_by({col_mixed}, {{Type::Count}});
+    CHECK_EQUAL(result.size(), 3);
+    CHECK_EQUAL(result.get_key(0, 0), Mixed(0.1 + 0.2));
+    CHECK_EQUAL(result.get_value(0, 0), Mixed(2));
+    CHECK_EQUAL(result.get_key(1, 0), Mixed(0.1f));
+    CHECK_EQUAL(result.get_value(1, 0), Mixed(2));
+    CHECK(result.get_key(2, 0).is_null());
+    CHECK_EQUAL(result.get_value(2, 0), Mixed(496));
+
+    // The grouping given to the query
+    q = table->where().greater(col_qty, 10);
+    CHECK_THROW(q.group_by(), IllegalOperation);
+    q.set_group_by({{col_region}, {{Type::Count}}});
+    result = q.group_by();
+    int64_t total = 0;
+    for (size_t group = 0; group < result.size(); ++group)
+        total += result.get_value(group, 0).get_int();
+    CHECK_EQUAL(total, q.count());
+
+    CHECK_THROW(table->where().group_by({}, aggregates), InvalidArgument);
+    CHECK_THROW(table->where().group_by({col_list}, aggregates), IllegalOperation);
+    CHECK_THROW(table->where().group_by({col_region}, {{Type::Sum, col_category}}), IllegalOperation);
+    CHECK_THROW(table->where().group_by({col_region}, {{Type::Average, col_date}}), IllegalOperation);
+    CHECK_THROW(table->where().group_by({col_region}, {{Type::Max, col_list}}), IllegalOperation);
+}
+
+TEST(Query_ExpressionBatches)
+{
+    Group g;
+    auto table = g.add_table("table");
+    auto col_int = table->add_column(type_Int, "int");
+    auto col_nint = table->add_column(type_Int, "nint", true);
+    auto col_double = table->add_column(type_Double, "double", true);
+    auto col_double2 = table->add_column(type_Double, "double2");
+
+    Random random(random_int<unsigned long>()); // Seed from slow global generator
+    std::vector<ObjKey> keys;
+    for (int i = 0; i < 3000; ++i) {
+        auto obj = table->create_object();
+        obj.set(col_int, random.draw_int<int64_t>(-100, 100));
+        if (random.draw_int_mod(10))
+            obj.set(col_nint, random.draw_int<int64_t>(-10, 10));
+        int kind = random.draw_int_mod(20);
+        if (kind == 0)
+            obj.set(col_double, std::nan(""));
+        else if (kind != 1)
+            obj.set(col_double, random.draw_int<int64_t>(-1000, 1000) / 10.0);
+        obj.set(col_double2, random.draw_int<int64_t>(-10, 10) / 2.0);
+        keys.push_back(obj.get_key());
+    }
+    table->get_object(keys[5]).set(col_int, std::numeric_limits<int64_t>::max());
+    table->get_object(keys[6]).set(col_int, std::numeric_limits<int64_t>::min()).set(col_nint, 2);
+
+    auto value = [&](ObjKey key, ColKey col) {
+        return QueryValue(table->get_object(key).get_any(col));
+    };
+    // The result of the query must be the objects for which `matches` evaluates the condition with Mixed
+    auto check = [&](const char* query, auto matches) {
+        std::vector<ObjKey> expected;
+        for (auto key : keys) {
+            if (matches(key))
+                expected.push_back(key);
+        }
+        TableView tv = table->query(query).find_all();
+        std::vector<ObjKey> found;
+        for (size_t i = 0; i < tv.size(); ++i)
+            found.push_back(tv.get_key(i));
+        CHECK(found == expected);
+        CHECK_EQUAL(table->query(query).count(), expected.size());
+    };
+
+    check("int + nint > 50", [&](ObjKey k) {
+        return Greater()(value(k, col_int) + value(k, col_nint), QueryValue(50));
+    });
+    check("int * 2 - nint <= 0", [&](ObjKey k) {
+        return LessEqual()(value(k, col_int) * QueryValue(2) - value(k, col_nint), QueryValue(0));
+    });
+    check("int / nint == 3", [&](ObjKey k) {
+        return Equal()(value(k, col_int) / value(k, col_nint), QueryValue(3));
+    });
+    check("int / nint == NULL", [&](ObjKey k) {
+        return Equal()(value(k, col_int) / value(k, col_nint), QueryValue());
+    });
+    check("nint != int", [&](ObjKey k) {
+        return NotEqual()(value(k, col_nint), value(k, col_int));
+    });
+    check("double * int >= 100.5", [&](ObjKey k) {
+        return GreaterEqual()(value(k, col_double) * value(k, col_int), QueryValue(100.5));
+    });
+    check("double + 1 < 5", [&](ObjKey k) {
+        return Less()(value(k, col_double) + QueryValue(1), QueryValue(5));
+    });
+    check("double / double2 != double2", [&](ObjKey k) {
+        return NotEqual()(value(k, col_double) / value(k, col_double2), value(k, col_double2));
+    });
+    check("double / double2 < -1.5", [&](ObjKey k) {
+        return Less()(value(k, col_double) / value(k, col_double2), QueryValue(-1.5));
+    });
+    check("double == double", [&](ObjKey k) {
+        return Equal()(value(k, col_double), value(k, col_double));
+    });
+    check("nint * double2 > 2", [&](ObjKey k) {
+        return Greater()(value(k, col_nint) * value(k, col_double2), QueryValue(2));
+    });
+    // An int compared with a double expression is not evaluated in batches
+    check("int > double2 * 3", [&](ObjKey k) {
+        return Greater()(value(k, col_int), value(k, col_double2) * QueryValue(3));
+    });
+    // Several conditions find the next match of each other
+    check("int + nint > 0 AND double2 * 2 < int AND nint - 1 != 0", [&](ObjKey k) {
+        return Greater()(value(k, col_int) + value(k, col_nint), QueryValue(0)) &&
+               Less()(value(k, col_double2) * QueryValue(2), value(k, col_int)) &&
+               NotEqual()(value(k, col_nint) - QueryValue(1), QueryValue(0));
+    });
+    check("int + nint > 0 OR double * 2 < -150", [&](ObjKey k) {
+        return Greater()(value(k, col_int) + value(k, col_nint), QueryValue(0)) ||
+               Less()(value(k, col_double) * QueryValue(2), QueryValue(-150));
+    });
+
+    // Evaluating single objects, once the query has been initialized by running it
+    Query q = table->query("int - nint >= 10");
+    q.count();
+    for (size_t i = 0; i < 100; ++i) {
+        ObjKey key = keys[random.draw_int_mod(keys.size())];
+        CHECK_EQUAL(q.eval_object(table->get_object(key)),
+                    GreaterEqual()(value(key, col_int) - value(key, col_nint), QueryValue(10)));
+    }
+}
+
 #endif // TEST_QUERY
+
+TEST(Query_LinkSemiJoin)
+{
+    Group g;
+    auto teams = g.add_table("Team");
+    auto persons = g.add_table("Person");
+    auto items = g.add_table("Item");
+    auto col_name = teams->add_column(type_String, "name", true);
+    auto col_rating = teams->add_column(type_Int, "rating", true);
+    auto col_team = persons->add_column(*teams, "team");
+    auto col_teams = persons->add_column_list(*teams, "teams");
+    auto col_owner = items->add_column(*persons, "owner");
+
+    Random random(random_int<unsigned long>()); // Seed from slow global generator
+    std::vector<ObjKey> team_keys;
+    for (int i = 0; i < 20; ++i) {
+        auto team = teams->create_object();
+        if (i % 7)
+            team.set(col_name, util::format("team %1", i)).set(col_rating, i % 10);
+        team_keys.push_back(team.get_key());
+    }
+    std::vector<ObjKey> person_keys;
+    for (int i = 0; i < 60; ++i) {
+        auto person = persons->create_object();
+        if (random.draw_int_mod(8))
+            person.set(col_team, team_keys[random.draw_int_mod(20)]);
+        auto list = person.get_linklist(col_teams);
+        for (int j = random.draw_int_mod(4); j > 0; --j)
+            list.add(team_keys[random.draw_int_mod(20)]);
+        person_keys.push_back(person.get_key());
+    }
+    std::vector<ObjKey> item_keys;
+    for (int i = 0; i < 500; ++i) {
+        auto item = items->create_object();
+        if (random.draw_int_mod(8))
+            item.set(col_owner, person_keys[random.draw_int_mod(60)]);
+        item_keys.push_back(item.get_key());
+    }
+    // Deleting a target object clears the links to it
+    teams->remove_object(team_keys[3]);
+
+    // The values of the teams of the owner of an item
+    auto team_values = [&](ObjKey item, bool list, ColKey col) {
+        std::vector<Mixed> values;
+        ObjKey owner = items->get_object(item).get<ObjKey>(col_owner);
+        if (!owner)
+            return values;
+        auto person = persons->get_object(owner);
+        if (list) {
+            auto lst = person.get_linklist(col_teams);
+            for (size_t i = 0; i < lst.size(); ++i)
+                values.push_back(teams->get_object(lst.get(i)).get_any(col));
+        }
+        else if (ObjKey team = person.get<ObjKey>(col_team)) {
+            values.push_back(teams->get_object(team).get_any(col));
+        }
+        return values;
+    };
+    auto check = [&](const char* query, auto matches) {
+        std::vector<ObjKey> expected;
+        for (auto key : item_keys) {
+            if (matches(key))
+                expected.push_back(key);
+        }
+        TableView tv = items->query(query).find_all();
+        std::vector<ObjKey> found;
+        for (size_t i = 0; i < tv.size(); ++i)
+            found.push_back(tv.get_key(i));
+        CHECK(found == expected);
+        CHECK_EQUAL(items->query(query).count(), expected.size());
+    };
+    auto any_of = [&](bool list, ColKey col, auto pred) {
+        return [=](ObjKey key) {
+            auto values = team_values(key, list, col);
+            return std::any_of(values.begin(), values.end(), pred);
+        };
+    };
+
+    check("owner.team.name == 'team 5'", any_of(false, col_name, [](Mixed m) {
+              return m == Mixed("team 5");
+          }));
+    check("owner.team.rating > 4", any_of(false, col_rating, [](Mixed m) {
+              return !m.is_null() && m.get_int() > 4;
+          }));
+    check("5 >= owner.team.rating", any_of(false, col_rating, [](Mixed m) {
+              return !m.is_null() && m.get_int() <= 5;
+          }));
+    check("owner.team.name BEGINSWITH[c] 'TEAM 1'", any_of(false, col_name, [](Mixed m) {
+              return !m.is_null() && m.get_string().begins_with("team 1");
+          }));
+    check("owner.teams.rating == 2", any_of(true, col_rating, [](Mixed m) {
+              return m == Mixed(2);
+          }));
+    check("owner.teams.name CONTAINS '1'", any_of(true, col_name, [](Mixed m) {
+              return !m.is_null() && m.get_string().contains("1");
+          }));
+    check("owner.teams.rating < 2.5", any_of(true, col_rating, [](Mixed m) {
+              return !m.is_null() && m.get_int() <= 2;
+          }));
+
+    // Null links match a null value, and not-equal matches them, so these follow the links
+    check("owner.team.rating == NULL", [&](ObjKey key) {
+        auto values = team_values(key, false, col_rating);
+        return values.empty() || values[0].is_null();
+    });
+    check("owner.team.rating != 2", [&](ObjKey key) {
+        auto values = team_values(key, false, col_rating);
+        return values.empty() || values[0] != Mixed(2);
+    });
+    check("ALL owner.teams.rating > 2", [&](ObjKey key) {
+        auto values = team_values(key, true, col_rating);
+        return std::all_of(values.begin(), values.end(), [](Mixed m) {
+            return !m.is_null() && m.get_int() > 2;
+        });
+    });
+
+    // Combined with other conditions
+    check("owner.team.rating > 4 AND owner.teams.rating == 2", [&](ObjKey key) {
+        return any_of(false, col_rating,
+                      [](Mixed m) {
+                          return !m.is_null() && m.get_int() > 4;
+                      })(key) &&
+               any_of(true, col_rating, [](Mixed m) {
+                   return m == Mixed(2);
+               })(key);
+    });
+
+    // The target table is not searched when another condition is answered by an index
+    auto col_code = items->add_column(type_Int, "code");
+    for (size_t i = 0; i < item_keys.size(); ++i)
+        items->get_object(item_keys[i]).set(col_code, int64_t(i % 10));
+    items->add_search_index(col_code);
+    auto rating_above_4 = any_of(false, col_rating, [](Mixed m) {
+        return !m.is_null() && m.get_int() > 4;
+    });
+    check("code == 3 AND owner.team.rating > 4", [&](ObjKey key) {
+        return items->get_object(key).get<Int>(col_code) == 3 && rating_above_4(key);
+    });
+    QueryProfile explanation = items->query("owner.team.rating > 4 AND code == 3").explain();
+    CHECK_EQUAL(explanation.conditions.size(), 2);
+    CHECK_EQUAL(explanation.conditions[0].description, "code == 3");
+    CHECK(explanation.conditions[0].uses_index);
+    CHECK_GREATER(explanation.conditions[1].cost, explanation.conditions[0].cost);
+    // Without it, the first condition through links drives the search
+    explanation = items->query("owner.team.rating > 4 AND owner.teams.rating == 2").explain();
+    CHECK_EQUAL(explanation.conditions.size(), 2);
+    CHECK_EQUAL(explanation.conditions[0].description, "owner.team.rating > 4");
+    CHECK_LESS(explanation.conditions[0].cost, explanation.conditions[1].cost);
+}
@@ -404,4 +404,151 @@ TEST(Geospatial_PolygonValidation)
     CHECK(status.is_ok());
 }
 
+TEST(Geospatial_Index)
+{
+    Group g;
+    std::vector<Geospatial> points;
+    Random random(random_int<unsigned long>()); // Seed from slow global generator
+    for (size_t i = 0; i < 2000; ++i) {
+        points.push_back(GeoPoint{random.draw_float(-180.0, 180.0), random.draw_float(-90.0, 90.0)});
+    }
+    // Points on the meridian and at the poles
+    points.push_back(GeoPoint{180.0, 1.0});
+    points.push_back(GeoPoint{-180.0, 1.0});
+    points.push_back(GeoPoint{0.0, 90.0});
+    points.push_back(GeoPoint{0.0, -90.0});
+    TableRef table = setup_with_points(g, points);
+    ColKey location_column_key = table->get_column_key("location");
+    TableRef location_table = g.get_table("Location");
+    ColKey coords_col = location_table->get_column_key("coordinates");
+    // objects without a valid point
+    table->create_object_with_primary_key(-1);
+    table->create_object_with_primary_key(-2).create_and_set_linked_object(location_column_key);
+
+    std::vector<Geospatial> regions = {
+        Geospatial{GeoBox{GeoPoint{-10, -10}, GeoPoint{10, 10}}},
+        Geospatial{GeoBox{GeoPoint{170, -20}, GeoPoint{-170, 20}}},
+        Geospatial{GeoCircle::from_kms(1000.0, GeoPoint{5, 50})},
+        Geospatial{GeoCircle::from_kms(500.0, GeoPoint{0, 90})},
+        Geospatial{GeoPolygon{{{{-178.0, 10.0}, {178.0, 10.0}, {178.0, -10.0}, {-178.0, -10.0}, {-178.0, 10.0}}}}},
+        Geospatial{GeoPolygon{{{{-50, -50}, {50, -50}, {50, 50}, {-50, 50}, {-50, -50}},
+                               {{-10, -10}, {10, -10}, {10, 10}, {-10, 10}, {-10, -10}}}}},
+        Geospatial{GeoBox{GeoPoint{1, 1}, GeoPoint{1.0001, 1.0001}}},
+    };
+    auto find_all = [&](const Geospatial& region) {
+        return table->column<Link>(location_column_key).geo_within(region).find_all();
+    };
+    // Compare the results found through the index with those of a full scan
+    auto check_regions = [&] {
+        CHECK_EQUAL(location_table->search_index_type(coords_col), IndexType::Geospatial);
+        location_table->verify();
+        std::vector<TableView> indexed;
+        for (auto& region : regions) {
+            indexed.push_back(find_all(region));
+        }
+        location_table->remove_search_index(coords_col);
+        for (size_t i = 0; i < regions.size(); ++i) {
+            TableView expected = find_all(regions[i]);
+            CHECK_EQUAL(indexed[i].size(), expected.size());
+            for (size_t j = 0; j < expected.size() && j < indexed[i].size(); ++j) {
+                CHECK_EQUAL(indexed[i].get_key(j), expected.get_key(j));
+            }
+        }
+        location_table->add_search_index(coords_col, IndexType::Geospatial);
+    };
+
+    // The index is built from the existing points
+    CHECK_GREATER(find_all(regions[0]).size(), 0);
+    location_table->add_search_index(coords_col, IndexType::Geospatial);
+    check_regions();
+
+    // Changes to the points are reflected in the index
+    for (size_t i = 0; i < 200; ++i) {
+        Obj obj = table->get_object_with_primary_key(int64_t(random.draw_int_mod(points.size())));
+        switch (random.draw_int_mod(4)) {
+            case 0:
+                obj.set(location_column_key,
+                        Geospatial{GeoPoint{random.draw_float(-180.0, 180.0), random.draw_float(-90.0, 90.0)}});
+                break;
+            case 1: {
+                auto coords = obj.get_linked_object(location_column_key).get_list<double>(coords_col);
+                if (coords.size() == 2) {
+                    coords.swap(0, 1);
+                    coords.set(1, random.draw_float(-90.0, 90.0));
+                }
+                break;
+            }
+            case 2: {
+                auto coords = obj.get_linked_object(location_column_key).get_list<double>(coords_col);
+                if (coords.size() > 0)
+                    coords.remove(0);
+                break;
+            }
+            case 3: {
+                Mixed pk = obj.get_primary_key();
+                obj.remove();
+                table->create_object_with_primary_key(pk).set(
+                    location_column_key, Geospatial{GeoPoint{random.draw_float(-10.0, 10.0), 0.5}});
+                break;
+            }
+        }
+    }
+    check_regions();
+
+    // Points given to new objects are indexed
+    size_t before = find_all(regions[0]).size();
+    for (size_t i = 0; i < 100; ++i) {
+        table->create_object_with_primary_key(int64_t(points.size() + i))
+            .set(location_column_key, Geospatial{GeoPoint{random.draw_float(-10.0, 10.0), 0.5}});
+    }
+    CHECK_EQUAL(find_all(regions[0]).size(), before + 100);
+    check_regions();
+
+    table->clear();
+    CHECK_EQUAL(find_all(regions[0]).size(), 0);
+    location_table->verify();
+
+    CHECK_THROW(table->add_search_index(location_column_key, IndexType::Geospatial), IllegalOperation);
+    CHECK_THROW(location_table->add_search_index(location_table->get_column_key("type"), IndexType::Geospatial),
+                IllegalOperation);
+}
+
+TEST(Geospatial_IndexListOfLinks)
+{
+    Group g;
+    TableRef table = setup_with_points(g, {GeoPoint{0, 0}, GeoPoint{0, 0}, GeoPoint{0, 0}, GeoPoint{0, 0}});
+    TableRef location_table = g.get_table("Location");
+    ColKey list_col = table->add_column_list(*location_table, "locations");
+    location_table->add_search_index(location_table->get_column_key("coordinates"), IndexType::Geospatial);
+    auto obj_it = table->begin();
+    for (auto points : {std::vector<GeoPoint>{{1, 1}, {2, 2}}, std::vector<GeoPoint>{{2, 2}, {3, 3}},
+                        std::vector<GeoPoint>{{1, 1}, {1, 1}, {1, 1}}}) {
+        LnkLst list = obj_it->get_linklist(list_col);
+        for (const GeoPoint& point : points) {
+            Obj location = list.create_and_insert_linked_object(0);
+            Geospatial{point}.assign_to(location);
+        }
+        ++obj_it;
+    }
+    // the fourth object has no elements in the list
+
+    const double r = 0.00872665;
+    auto count = [&](ExpressionComparisonType type, GeoPoint center) {
+        return table->column<Link>(list_col, type).geo_within(GeoCircle{r, center}).count();
+    };
+    CHECK_EQUAL(count(ExpressionComparisonType::Any, {1, 1}), 2);
+    CHECK_EQUAL(count(ExpressionComparisonType::Any, {3, 3}), 1);
+    CHECK_EQUAL(count(ExpressionComparisonType::Any, {4, 4}), 0);
+    CHECK_EQUAL(count(ExpressionComparisonType::All, {1, 1}), 1);
+    CHECK_EQUAL(count(ExpressionComparisonType::All, {2, 2}), 0);
+    CHECK_EQUAL(count(ExpressionComparisonType::None, {1, 1}), 2);
+    CHECK_EQUAL(count(ExpressionComparisonType::None, {3, 3}), 3);
+    CHECK_EQUAL(count(ExpressionComparisonType::None, {4, 4}), 4);
+
+    // Combined with other conditions
+    Query q = table->column<Link>(list_col).geo_within(GeoCircle{r, {2, 2}});
+    CHECK_EQUAL((q && table->column<Int>(table->get_primary_key_column()) == 1).count(), 1);
+    CHECK_EQUAL((q || table->column<Int>(table->get_primary_key_column()) == 3).count(), 3);
+}
+
 #endif
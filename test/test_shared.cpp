@@ -535,6 +535,282 @@ TEST(Shared_ReadOverRead)
     CHECK_EQUAL(table2->get_object(0).get<int64_t>("col"), 1);
 }
 
+TEST(Shared_EncodeIntegerLeaves)
+{
+    SHARED_GROUP_TEST_PATH(path_encoded);
+    SHARED_GROUP_TEST_PATH(path_plain);
+    const int64_t base = 1700000000000LL;
+    const int64_t num_objects = 2000;
+
+    auto populate = [&](DBRef db) {
+        WriteTransaction wt(db);
+        auto table = wt.add_table("table");
+        auto col_ts = table->add_column(type_Int, "ts");
+        auto col_small = table->add_column(type_Int, "small");
+        auto col_opt = table->add_column(type_Int, "opt", true);
+        for (int64_t i = 0; i < num_objects; ++i)
+            table->create_object().set(col_ts, base + i * 1000).set(col_small, i % 7).set(col_opt, base + i);
+        wt.commit();
+    };
+
+    auto check = [&](ConstTableRef table, int64_t modified) {
+        auto col_ts = table->get_column_key("ts");
+        auto col_small = table->get_column_key("small");
+        auto col_opt = table->get_column_key("opt");
+        CHECK_EQUAL(table->size(), num_objects);
+        int64_t i = 0;
+        for (auto& obj : *table) {
+            CHECK_EQUAL(obj.get<int64_t>(col_ts), i == modified ? -1 : base + i * 1000);
+            CHECK_EQUAL(obj.get<int64_t>(col_small), i % 7);
+            CHECK_EQUAL(obj.get<util::Optional<int64_t>>(col_opt), base + i);
+            ++i;
+        }
+        CHECK_EQUAL(table->where().greater(col_ts, base + 1500 * 1000).count(), num_objects - 1501);
+        CHECK_EQUAL(table->where().less(col_ts, base).count(), modified < 0 ? 0 : 1);
+        CHECK_EQUAL(table->where().equal(col_ts, base + 1234 * 1000).count(), 1);
+        CHECK_EQUAL(table->where().not_equal(col_ts, base + 1234 * 1000).count(), num_objects - 1);
+        CHECK_EQUAL(table->where().equal(col_ts, base + 1).count(), 0);
+        CHECK_EQUAL(table->max(col_ts)->get_int(), base + (num_objects - 1) * 1000);
+        CHECK_EQUAL(table->min(col_ts)->get_int(), modified < 0 ? base : -1);
+        CHECK_EQUAL(table->find_first_int(col_ts, base + 77 * 1000), table->get_object(77).get_key());
+    };
+
+    DBOptions options;
+    options.encode_integer_leaves = true;
+    DBRef db = DB::create(path_encoded, false, options);
+    populate(db);
+    {
+        auto rt = db->start_read();
+        rt->verify();
+        check(rt->get_table("table"), -1);
+    }
+
+    // Modify an encoded leaf in a later transaction, and read back the result
+    // in the same transaction after committing.
+    {
+        auto wt = db->start_write();
+        auto table = wt->get_table("table");
+        table->get_object(17).set("ts", int64_t(-1));
+        wt->commit_and_continue_as_read();
+        wt->verify();
+        check(wt->get_table("table"), 17);
+    }
+    {
+        auto rt = db->start_read();
+        check(rt->get_table("table"), 17);
+    }
+
+    // The encoded file is smaller than one holding the same data without encoding
+    DBRef db_plain = get_test_db(path_plain);
+    populate(db_plain);
+    {
+        WriteTransaction wt(db_plain);
+        wt.get_table("table")->get_object(17).set("ts", int64_t(-1));
+        wt.commit();
+    }
+    CHECK(db->compact());
+    CHECK(db_plain->compact());
+    CHECK_LESS(File::get_size_static(path_encoded), File::get_size_static(path_plain));
+    {
+        auto rt = db->start_read();
+        rt->verify();
+        check(rt->get_table("table"), 17);
+    }
+}
+
+TEST(Shared_EnumerateStringColumns)
+{
+    SHARED_GROUP_TEST_PATH(path);
+    const char* statuses[] = {"open", "closed", "pending", "a status which is too long to be a short string"};
+    const size_t num_objects = 2000;
+
+    DBOptions options;
+    options.enumerate_string_columns = true;
+    DBRef db = DB::create(path, false, options);
+    {
+        WriteTransaction wt(db);
+        auto table = wt.add_table("table");
+        auto col_status = table->add_column(type_String, "status", true);
+        auto col_name = table->add_column(type_String, "name");
+        auto col_tags = table->add_column_list(type_String, "tags");
+        auto small = wt.add_table("small");
+        auto col_small = small->add_column(type_String, "status");
+        for (size_t i = 0; i < num_objects; ++i) {
+            auto obj = table->create_object();
+            obj.set(col_status, i % 5 == 4 ? StringData() : StringData(statuses[i % 5]));
+            obj.set(col_name, util::format("name %1", i));
+            obj.get_list<String>(col_tags).add(statuses[i % 2]);
+        }
+        for (size_t i = 0; i < 100; ++i)
+            small->create_object().set(col_small, statuses[0]);
+        wt.commit();
+    }
+
+    auto check = [&](ConstTableRef table) {
+        auto col_status = table->get_column_key("status");
+        auto col_name = table->get_column_key("name");
+        CHECK(table->is_enumerated(col_status));
+        CHECK_NOT(table->is_enumerated(col_name));
+        size_t i = 0;
+        for (auto& obj : *table) {
+            StringData expected = i % 5 == 4 ? StringData() : StringData(statuses[i % 5]);
+            CHECK_EQUAL(obj.get<String>(col_status), expected);
+            CHECK_EQUAL(obj.get<String>(col_name), util::format("name %1", i));
+            ++i;
+        }
+        for (size_t j = 0; j < 4; ++j) {
+            CHECK_EQUAL(table->where().equal(col_status, statuses[j]).count(), num_objects / 5);
+            CHECK_EQUAL(table->find_first_string(col_status, statuses[j]), table->get_object(j).get_key());
+        }
+        CHECK_EQUAL(table->where().equal(col_status, StringData()).count(), num_objects / 5);
+        CHECK_EQUAL(table->where().equal(col_status, "unknown").count(), 0);
+        CHECK_EQUAL(table->where().not_equal(col_status, "open").count(), num_objects - num_objects / 5);
+        CHECK_EQUAL(table->where().equal(col_status, "open").Or().equal(col_status, "closed").count(),
+                    2 * num_objects / 5);
+    };
+
+    {
+        auto rt = db->start_read();
+        rt->verify();
+        check(rt->get_table("table"));
+        // Tables below the size threshold are left alone
+        auto small = rt->get_table("small");
+        CHECK_NOT(small->is_enumerated(small->get_column_key("status")));
+    }
+
+    // Values which are not in the keys yet can still be added and searched for
+    {
+        auto wt = db->start_write();
+        auto table = wt->get_table("table");
+        auto col_status = table->get_column_key("status");
+        Query q = table->where().equal(col_status, "reopened");
+        CHECK_EQUAL(q.count(), 0);
+        table->get_object(3).set(col_status, "reopened");
+        CHECK_EQUAL(q.count(), 1);
+        table->get_object(3).set(col_status, statuses[3]);
+        CHECK_EQUAL(q.count(), 0);
+        wt->commit_and_continue_as_read();
+        wt->verify();
+        check(wt->get_table("table"));
+    }
+}
+
+TEST(Shared_Metrics)
+{
+    SHARED_GROUP_TEST_PATH(path);
+    {
+        // Nothing is collected by default
+        DBRef db = DB::create(path);
+        {
+            WriteTransaction wt(db);
+            wt.add_table("table")->add_column(type_Int, "int");
+            wt.commit();
+        }
+        auto metrics = db->get_metrics();
+        CHECK_EQUAL(metrics.write_lock_wait.count, 0);
+        CHECK_EQUAL(metrics.write_group.count, 0);
+        CHECK_EQUAL(metrics.bytes_written, 0);
+    }
+
+    DBOptions options;
+    options.enable_metrics = true;
+    DBRef db = DB::create(path, false, options);
+    const size_t num_commits = 5;
+    for (size_t i = 0; i < num_commits; ++i) {
+        WriteTransaction wt(db);
+        auto table = wt.get_table("table");
+        for (int j = 0; j < 100; ++j)
+            table->create_object().set("int", j);
+        wt.commit();
+    }
+    auto rt = db->start_read();
+    auto metrics = db->get_metrics();
+
+    CHECK_EQUAL(metrics.write_lock_wait.count, num_commits);
+    CHECK_EQUAL(metrics.write_group.count, num_commits);
+    CHECK_EQUAL(metrics.free_space_search.count, num_commits);
+    CHECK_EQUAL(metrics.sync.count, num_commits);
+    CHECK_GREATER_EQUAL(metrics.read_lock.count, 1);
+    CHECK_GREATER(metrics.bytes_written, 100 * num_commits);
+    CHECK_EQUAL(metrics.live_versions, db->get_number_of_versions());
+    for (auto histogram : {metrics.write_lock_wait, metrics.read_lock, metrics.write_group, metrics.sync}) {
+        uint64_t count = 0;
+        for (auto n : histogram.buckets)
+            count += n;
+        CHECK_EQUAL(count, histogram.count);
+        CHECK_LESS_EQUAL(histogram.average().count(), histogram.max.count());
+        CHECK_LESS_EQUAL(histogram.max.count(), histogram.total.count());
+    }
+    CHECK_GREATER(metrics.write_group.total.count(), 0);
+
+    CHECK_EQUAL(LatencyHistogram::bucket_of(std::chrono::nanoseconds(999)), 0);
+    CHECK_EQUAL(LatencyHistogram::bucket_of(std::chrono::microseconds(1)), 1);
+    CHECK_EQUAL(LatencyHistogram::bucket_of(std::chrono::microseconds(3)), 2);
+    CHECK_EQUAL(LatencyHistogram::bucket_of(std::chrono::microseconds(4)), 3);
+    CHECK_EQUAL(LatencyHistogram::bucket_of(std::chrono::hours(1)), LatencyHistogram::num_buckets - 1);
+    for (size_t i = 0; i + 1 < LatencyHistogram::num_buckets; ++i) {
+        CHECK_EQUAL(LatencyHistogram::bucket_of(LatencyHistogram::bucket_limit(i)), i + 1);
+        CHECK_EQUAL(LatencyHistogram::bucket_of(LatencyHistogram::bucket_limit(i) - std::chrono::nanoseconds(1)), i);
+    }
+}
+
+TEST(Shared_ConcurrentReadLocks)
+{
+    SHARED_GROUP_TEST_PATH(path);
+    DBRef db = DB::create(make_in_realm_history(), path);
+    ColKey col;
+    {
+        WriteTransaction wt(db);
+        auto table = wt.add_table("table");
+        col = table->add_column(type_Int, "value");
+        table->create_object();
+        wt.commit();
+    }
+
+    const int num_readers = 8;
+    const int num_commits = 100;
+    std::atomic<bool> done{false};
+    std::vector<std::thread> readers;
+    for (int i = 0; i < num_readers; ++i) {
+        readers.emplace_back([&] {
+            int64_t last_value = 0;
+            while (!done) {
+                // Readers racing each other for the newest version must all
+                // see a fully committed state, never going back in time
+                auto rt = db->start_read();
+                auto table = rt->get_table("table");
+                int64_t value = table->begin()->get<Int>(col);
+                CHECK_LESS_EQUAL(last_value, value);
+                CHECK_EQUAL(table->size(), size_t(value + 1));
+                last_value = value;
+                auto frozen = rt->freeze();
+                CHECK_EQUAL(frozen->get_version(), rt->get_version());
+            }
+        });
+    }
+    for (int i = 1; i <= num_commits; ++i) {
+        WriteTransaction wt(db);
+        auto table = wt.get_table("table");
+        table->begin()->set(col, i);
+        table->create_object();
+        wt.commit();
+    }
+    done = true;
+    for (auto& t : readers)
+        t.join();
+
+    // All read locks were released, so the DB can be compacted and only the
+    // last two versions are kept after the next commit
+    CHECK(db->compact());
+    {
+        WriteTransaction wt(db);
+        wt.commit();
+    }
+    CHECK_EQUAL(db->get_number_of_versions(), 2);
+    ReadTransaction rt(db);
+    CHECK_EQUAL(rt.get_table("table")->size(), num_commits + 1);
+}
+
 TEST(Shared_ReadOverReadAfterCompact)
 {
     SHARED_GROUP_TEST_PATH(path);
@@ -37,6 +37,7 @@ using namespace std::chrono;
 #include <realm/array_bool.hpp>
 #include <realm/array_string.hpp>
 #include <realm/array_timestamp.hpp>
+#include <realm/index_fulltext.hpp>
 #include <realm/index_string.hpp>
 
 #include "util/misc.hpp"
@@ -5342,8 +5343,8 @@ TEST(Table_FullTextIndex)
         auto t = wt->add_table("foo");
         col = t->add_column(type_String, "str");
         t->add_fulltext_index(col);
-        auto index = t->get_string_index(col);
-        CHECK(index->is_fulltext_index());
+        CHECK_EQUAL(t->search_index_type(col), IndexType::Fulltext);
+        CHECK(dynamic_cast<FulltextIndex*>(t->get_search_index(col)));
 
         t->create_object().set(col, "This is a test, with  spaces!");
         t->create_object().set(col, "More testing, with normal spaces");
@@ -5354,8 +5355,8 @@ TEST(Table_FullTextIndex)
 
     auto rt = db->start_read();
     auto t = rt->get_table("foo");
-    auto index = t->get_string_index(col);
-    CHECK(index->is_fulltext_index());
+    CHECK_EQUAL(t->search_index_type(col), IndexType::Fulltext);
+    CHECK(dynamic_cast<FulltextIndex*>(t->get_search_index(col)));
     TableView res = t->find_all_fulltext(col, "spaces with");
     CHECK_EQUAL(2, res.size());
 }
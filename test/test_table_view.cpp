@@ -1385,6 +1385,136 @@ TEST(TableView_DistinctOverNullLink)
     CHECK_EQUAL(tv.get_object(1).get_linked_object(col_link).get<Int>(col_int), 1);
 }
 
+TEST(TableView_DistinctMixed)
+{
+    Table t;
+    auto col = t.add_column(type_Mixed, "mixed");
+    std::vector<Mixed> values{int64_t(1), 1.0,  Decimal128(1),      StringData("a"),   Mixed(),   StringData("a"), Mixed(), 2.5,
+                              2.5f,       BinaryData("a", 1), Decimal128("2.5"), int64_t(2)};
+    std::vector<ObjKey> keys;
+    for (auto& value : values) {
+        keys.push_back(t.create_object().set_any(col, value).get_key());
+    }
+
+    // Numeric values comparing equal are duplicates, strings and binaries are not
+    TableView tv = t.where().find_all();
+    tv.distinct(DistinctDescriptor({{col}}));
+    std::vector<ObjKey> expected{keys[0], keys[3], keys[4], keys[7], keys[9], keys[11]};
+    CHECK_EQUAL(tv.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        CHECK_EQUAL(tv.get_key(i), expected[i]);
+    }
+
+    // After sorting, the first object of each value in sorted order is kept
+    DescriptorOrdering ordering;
+    ordering.append_sort(SortDescriptor({{col}}, {false}));
+    ordering.append_distinct(DistinctDescriptor({{col}}));
+    tv = t.where().find_all(ordering);
+    expected = {keys[9], keys[3], keys[7], keys[11], keys[0], keys[4]};
+    CHECK_EQUAL(tv.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        CHECK_EQUAL(tv.get_key(i), expected[i]);
+    }
+
+    // Fractions compare to decimals after being rounded to 15 digits for doubles
+    // and to 7 digits for floats
+    t.clear();
+    keys.clear();
+    for (Mixed value : {Mixed(0.1 + 0.2), Mixed(Decimal128("0.3")), Mixed(0.1f), Mixed(Decimal128("0.1"))}) {
+        keys.push_back(t.create_object().set_any(col, value).get_key());
+    }
+    tv = t.where().find_all();
+    tv.distinct(DistinctDescriptor({{col}}));
+    CHECK_EQUAL(tv.size(), 2);
+    CHECK_EQUAL(tv.get_key(0), keys[0]);
+    CHECK_EQUAL(tv.get_key(1), keys[2]);
+}
+
+TEST(TableView_SyncFromChanges)
+{
+    Group g;
+    auto t = g.add_table("table");
+    auto other = g.add_table("other");
+    auto col_int = t->add_column(type_Int, "int");
+    auto col_str = t->add_column(type_String, "str", true);
+    auto col_link = t->add_column(*other, "link");
+    auto col_other = other->add_column(type_Int, "int");
+
+    Random random(random_int<unsigned long>()); // Seed from slow global generator
+    std::vector<ObjKey> keys;
+    for (int i = 0; i < 1000; ++i) {
+        auto obj = t->create_object().set(col_int, random.draw_int_mod(100));
+        if (random.draw_int_mod(10))
+            obj.set(col_str, util::format("s%1", random.draw_int_mod(50)));
+        keys.push_back(obj.get_key());
+    }
+
+    auto get_keys = [](const TableView& tv) {
+        std::vector<ObjKey> result;
+        for (size_t i = 0; i < tv.size(); ++i)
+            result.push_back(tv.get_key(i));
+        return result;
+    };
+    Query q = t->where().greater(col_int, 30);
+    std::vector<DescriptorOrdering> orderings(3);
+    orderings[1].append_sort(SortDescriptor({{col_str}}, {false}));
+    orderings[2].append_sort(SortDescriptor({{col_str}, {col_int}}, {true, false}));
+
+    for (auto& ordering : orderings) {
+        auto previous = get_keys(q.find_all(ordering));
+
+        // Insert, modify and delete some objects
+        std::vector<ObjKey> changed;
+        std::vector<ObjKey> deleted;
+        for (int i = 0; i < 20; ++i) {
+            auto obj = t->create_object().set(col_int, random.draw_int_mod(100));
+            obj.set(col_str, util::format("s%1", random.draw_int_mod(50)));
+            changed.push_back(obj.get_key());
+        }
+        for (int i = 0; i < 20; ++i) {
+            auto key = keys[random.draw_int_mod(keys.size())];
+            if (t->is_valid(key)) {
+                t->get_object(key).set(col_int, random.draw_int_mod(100)).set(col_str, "s25");
+                changed.push_back(key);
+            }
+        }
+        for (int i = 0; i < 10; ++i) {
+            auto key = keys[random.draw_int_mod(keys.size())];
+            if (t->is_valid(key)) {
+                t->remove_object(key);
+                deleted.push_back(key);
+            }
+        }
+
+        TableView tv(q, size_t(-1));
+        CHECK(tv.sync_from_changes(ordering, previous, changed, deleted));
+        CHECK(tv.is_in_sync());
+        CHECK(get_keys(tv) == get_keys(q.find_all(ordering)));
+    }
+
+    auto previous = get_keys(q.find_all());
+    // Too many changes
+    std::vector<ObjKey> changed(keys.begin(), keys.begin() + 100);
+    CHECK_NOT(TableView(q, size_t(-1)).sync_from_changes({}, previous, changed, {}));
+    // The ordering is not a single sort
+    DescriptorOrdering limited;
+    limited.append_limit(LimitDescriptor(10));
+    CHECK_NOT(TableView(q, size_t(-1)).sync_from_changes(limited, previous, {}, {}));
+    // The results depend on another table
+    Query linked = t->where().greater(col_int, 30).and_query(t->link(col_link).column<Int>(col_other) > 5);
+    CHECK_NOT(TableView(linked, size_t(-1)).sync_from_changes({}, get_keys(linked.find_all()), {}, {}));
+    // Changes to the links change the backlinks of their targets, which are not reported as changed
+    Query backlinked = other->query("@links.@count > 0");
+    CHECK_NOT(TableView(backlinked, size_t(-1)).sync_from_changes({}, get_keys(backlinked.find_all()), {}, {}));
+    // Links within the table depend on other objects of the table
+    auto col_self = t->add_column(*t, "self");
+    Query self_linked = t->query("self.int > 5");
+    CHECK_NOT(TableView(self_linked, size_t(-1)).sync_from_changes({}, get_keys(self_linked.find_all()), {}, {}));
+    Query self_backlinked = t->column<BackLink>(*t, col_self).count() > 0;
+    CHECK_NOT(TableView(self_backlinked, size_t(-1))
+                  .sync_from_changes({}, get_keys(self_backlinked.find_all()), {}, {}));
+}
+
 TEST(TableView_IsRowAttachedAfterClear)
 {
     Table t;
@@ -2339,6 +2469,55 @@ TEST(TableView_SortFollowedByLimit)
     }
 }
 
+TEST(TableView_SortFollowedByLimitInQuery)
+{
+    Table table;
+    auto col_int = table.add_column(type_Int, "int");
+    auto col_opt = table.add_column(type_Int, "opt", true);
+    auto col_str = table.add_column(type_String, "str");
+    std::mt19937 random(unit_test_random_seed);
+
+    // Large enough for the query to run on several threads
+    for (int i = 0; i < 12000; i++) {
+        auto obj = table.create_object();
+        obj.set(col_int, int64_t(random() % 1000));
+        if (i % 3)
+            obj.set(col_opt, int64_t(random() % 10));
+        obj.set(col_str, std::string(1, char('a' + random() % 5)));
+    }
+
+    // Compare with sorting all matches and then taking the first ones
+    auto check = [&](Query q, SortDescriptor sort, size_t limit) {
+        auto expected = q.find_all();
+        expected.sort(sort);
+
+        DescriptorOrdering ordering;
+        ordering.append_sort(sort);
+        ordering.append_limit(limit);
+        auto tv = q.find_all(ordering);
+        CHECK_EQUAL(tv.size(), std::min(limit, expected.size()));
+        for (size_t i = 0; i < tv.size(); i++) {
+            CHECK_EQUAL(tv.get_key(i), expected.get_key(i));
+        }
+
+        q.set_threads(4);
+        tv = q.find_all(ordering);
+        CHECK_EQUAL(tv.size(), std::min(limit, expected.size()));
+        for (size_t i = 0; i < tv.size(); i++) {
+            CHECK_EQUAL(tv.get_key(i), expected.get_key(i));
+        }
+    };
+
+    for (size_t limit : {0, 1, 10, 100, 1000, 10000}) {
+        check(table.where(), SortDescriptor({{col_int}}), limit);
+        check(table.where().greater(col_int, 500), SortDescriptor({{col_int}}, {false}), limit);
+        check(table.where(), SortDescriptor({{col_opt}}), limit);
+        check(table.where(), SortDescriptor({{col_opt}}, {false}), limit);
+        check(table.where().less(col_int, 800), SortDescriptor({{col_str}, {col_int}}, {false, true}), limit);
+        check(table.where(), SortDescriptor({{col_str}}), limit);
+    }
+}
+
 TEST(TableView_Filter)
 {
     Table table;
@@ -882,4 +882,54 @@ TEST_IF(Upgrade_Database_23, REALM_MAX_BPNODE_SIZE == 4 || REALM_MAX_BPNODE_SIZE
     g.write(path);
 #endif // TEST_READ_UPGRADE_MODE
 }
+
+NONCONCURRENT_TEST(Upgrade_Database_24_25)
+{
+    SHARED_GROUP_TEST_PATH(path);
+    std::string prefix = realm::BackupHandler::get_prefix_from_path(path);
+    // clear out any leftovers from potential earlier crash of unittest
+    File::try_remove(prefix + "v24.backup.realm");
+
+    // Build a realm file with format 24
+    _impl::GroupFriend::fake_target_file_format(24);
+    {
+        auto db = DB::create(make_in_realm_history(), path);
+        auto tr = db->start_write();
+        auto table = tr->add_table("table");
+        auto col = table->add_column(type_Int, "value");
+        table->create_object().set(col, 5);
+        tr->commit();
+    }
+    _impl::GroupFriend::fake_target_file_format({});
+
+    // Version 24 files can be read without an upgrade
+    {
+        Group g(path);
+        CHECK_EQUAL(g.get_table("table")->size(), 1);
+    }
+
+    // but are upgraded when opened by a DB, as a writer could otherwise add
+    // structures of version 25 to them
+    int old_version = 0;
+    int new_version = 0;
+    DBOptions options;
+    options.upgrade_callback = [&](int from, int to) {
+        old_version = from;
+        new_version = to;
+    };
+    {
+        auto db = DB::create(make_in_realm_history(), path, options);
+        CHECK_EQUAL(old_version, 24);
+        CHECK_EQUAL(new_version, 25);
+        auto rt = db->start_read();
+        auto table = rt->get_table("table");
+        CHECK_EQUAL(table->begin()->get<Int>("value"), 5);
+        CHECK_EQUAL(table->where().greater(table->get_column_key("value"), 4).count(), 1);
+        CHECK_EQUAL(table->where().greater(table->get_column_key("value"), 5).count(), 0);
+        table->verify();
+    }
+    CHECK(File::exists(prefix + "v24.backup.realm"));
+    File::try_remove(prefix + "v24.backup.realm");
+}
+
 #endif // TEST_GROUP